@@ -0,0 +1,237 @@
+/**
+ * @file bench.cpp
+ * @brief dearts_bench 基准测试框架实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "utils/memory_tracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace DearTs {
+namespace Bench {
+
+namespace {
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void appendJsonNumber(std::string& out, const char* key, double value) {
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), ",\"%s\":%.6g", key, value);
+    out += buffer;
+}
+
+const char* compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+BenchmarkRunner::BenchmarkRunner(std::string corpusDirectory)
+    : m_corpusDirectory(std::move(corpusDirectory)) {
+}
+
+bool BenchmarkRunner::isSelected(const std::string& name) const {
+    return m_filter.empty() || name.find(m_filter) != std::string::npos;
+}
+
+void BenchmarkRunner::run(const std::string& name, const BenchmarkFunction& function, const BenchmarkOptions& options) {
+    if (!isSelected(name)) {
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto timeIterations = [&function](uint64_t iterations) {
+        const auto start = Clock::now();
+        function(iterations);
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    // 预热并估算单次耗时：迭代次数每次放大 10 倍，直到一批耗时超过最短时间的 1/10
+    const double minTimeNs = static_cast<double>(m_minTime.count()) * 1.0e6;
+    uint64_t iterations = 1;
+    double elapsed = timeIterations(iterations);
+    while (elapsed < minTimeNs / 10.0 && (options.maxIterations == 0 || iterations < options.maxIterations)) {
+        iterations *= 10;
+        if (options.maxIterations != 0) {
+            iterations = std::min(iterations, options.maxIterations);
+        }
+        elapsed = timeIterations(iterations);
+    }
+    const double estimate = elapsed / static_cast<double>(iterations);
+    iterations = std::max<uint64_t>(1, static_cast<uint64_t>(minTimeNs / std::max(estimate, 1.0)));
+    if (options.maxIterations != 0) {
+        iterations = std::min(iterations, options.maxIterations);
+    }
+
+    std::vector<double> samples;
+    samples.reserve(m_repetitions);
+    const Core::Utils::AllocationCounters allocationsBefore = Core::Utils::MemoryTracker::counters();
+    for (uint32_t i = 0; i < m_repetitions; ++i) {
+        samples.push_back(timeIterations(iterations) / static_cast<double>(iterations));
+    }
+    const Core::Utils::AllocationCounters allocationsAfter = Core::Utils::MemoryTracker::counters();
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.repetitions = m_repetitions;
+    result.nsPerOp = samples[samples.size() / 2];
+    result.nsPerOpMin = samples.front();
+    result.nsPerOpMax = samples.back();
+    result.bytesPerOp = options.bytesPerOp;
+    result.itemsPerOp = options.itemsPerOp;
+    result.counters = options.counters;
+    if (Core::Utils::MemoryTracker::isEnabled()) {
+        result.allocationsPerOp = static_cast<double>(allocationsAfter.allocations - allocationsBefore.allocations) /
+                                  static_cast<double>(iterations * m_repetitions);
+    }
+    record(std::move(result));
+}
+
+void BenchmarkRunner::record(BenchmarkResult result) {
+    const std::string& name = result.name;
+    const uint64_t iterations = result.iterations;
+
+    char line[256];
+    int written = std::snprintf(line, sizeof(line), "%-48s %12.1f ns/op %10llu iter",
+                                name.c_str(), result.nsPerOp, static_cast<unsigned long long>(iterations));
+    std::string text(line, written > 0 ? static_cast<size_t>(written) : 0);
+    if (result.bytesPerOp > 0.0) {
+        std::snprintf(line, sizeof(line), " %10.1f MB/s", result.bytesPerOp / result.nsPerOp * 1.0e3);
+        text += line;
+    }
+    if (result.itemsPerOp > 0.0) {
+        std::snprintf(line, sizeof(line), " %12.0f items/s", result.itemsPerOp / result.nsPerOp * 1.0e9);
+        text += line;
+    }
+    if (result.allocationsPerOp >= 0.0) {
+        std::snprintf(line, sizeof(line), " %10.1f allocs/op", result.allocationsPerOp);
+        text += line;
+    }
+    for (const auto& [counter, value] : result.counters) {
+        std::snprintf(line, sizeof(line), " %s=%.1f", counter.c_str(), value);
+        text += line;
+    }
+    std::fprintf(m_progress, "%s\n", text.c_str());
+    std::fflush(m_progress);
+
+    m_results.push_back(std::move(result));
+}
+
+const std::string& BenchmarkRunner::corpus(const std::string& name) {
+    auto it = m_corpora.find(name);
+    if (it != m_corpora.end()) {
+        return it->second;
+    }
+
+    const std::string path = m_corpusDirectory + "/" + name;
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("无法读取语料文件: " + path);
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return m_corpora.emplace(name, content.str()).first->second;
+}
+
+const std::vector<std::string>& BenchmarkRunner::corpusLines(const std::string& name) {
+    auto it = m_corpusLines.find(name);
+    if (it != m_corpusLines.end()) {
+        return it->second;
+    }
+
+    std::vector<std::string> lines;
+    std::istringstream stream(corpus(name));
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+    }
+    return m_corpusLines.emplace(name, std::move(lines)).first->second;
+}
+
+std::string BenchmarkRunner::toJson() const {
+    std::string out;
+    out += "{\"context\":{\"compiler\":";
+    appendJsonString(out, compilerName());
+#ifdef NDEBUG
+    out += ",\"build\":\"release\"";
+#else
+    out += ",\"build\":\"debug\"";
+#endif
+    out += Core::Utils::MemoryTracker::isEnabled() ? ",\"track_allocations\":true" : ",\"track_allocations\":false";
+
+    char timestamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    out += ",\"date\":";
+    appendJsonString(out, timestamp);
+    appendJsonNumber(out, "min_time_ms", static_cast<double>(m_minTime.count()));
+    appendJsonNumber(out, "repetitions", static_cast<double>(m_repetitions));
+    out += "},\"benchmarks\":[";
+
+    bool first = true;
+    for (const BenchmarkResult& result : m_results) {
+        out += first ? "\n{" : ",\n{";
+        first = false;
+        out += "\"name\":";
+        appendJsonString(out, result.name);
+        appendJsonNumber(out, "iterations", static_cast<double>(result.iterations));
+        appendJsonNumber(out, "repetitions", static_cast<double>(result.repetitions));
+        appendJsonNumber(out, "ns_per_op", result.nsPerOp);
+        appendJsonNumber(out, "ns_per_op_min", result.nsPerOpMin);
+        appendJsonNumber(out, "ns_per_op_max", result.nsPerOpMax);
+        if (result.bytesPerOp > 0.0) {
+            appendJsonNumber(out, "bytes_per_op", result.bytesPerOp);
+            appendJsonNumber(out, "bytes_per_second", result.bytesPerOp / result.nsPerOp * 1.0e9);
+        }
+        if (result.itemsPerOp > 0.0) {
+            appendJsonNumber(out, "items_per_op", result.itemsPerOp);
+            appendJsonNumber(out, "items_per_second", result.itemsPerOp / result.nsPerOp * 1.0e9);
+        }
+        if (result.allocationsPerOp >= 0.0) {
+            appendJsonNumber(out, "allocations_per_op", result.allocationsPerOp);
+        }
+        for (const auto& [counter, value] : result.counters) {
+            appendJsonNumber(out, counter.c_str(), value);
+        }
+        out += "}";
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+} // namespace Bench
+} // namespace DearTs
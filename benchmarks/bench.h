@@ -0,0 +1,171 @@
+/**
+ * @file bench.h
+ * @brief dearts_bench 基准测试框架
+ * @details 每个基准以批量迭代的方式运行：先用少量迭代估算单次耗时，
+ *          再把迭代次数放大到满足最短运行时间，重复若干轮取中位数。
+ *          结果可以输出为 JSON，供回归跟踪脚本比较。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace DearTs {
+namespace Bench {
+
+/**
+ * @brief 单个基准的结果
+ */
+struct BenchmarkResult {
+    std::string name;               ///< 基准名称（Suite/Case）
+    uint64_t iterations = 0;        ///< 每轮迭代次数
+    uint32_t repetitions = 0;       ///< 轮数
+    double nsPerOp = 0.0;           ///< 单次操作耗时中位数（纳秒）
+    double nsPerOpMin = 0.0;        ///< 单次操作耗时最小值（纳秒）
+    double nsPerOpMax = 0.0;        ///< 单次操作耗时最大值（纳秒）
+    double bytesPerOp = 0.0;        ///< 每次操作处理的字节数（0 表示不适用）
+    double itemsPerOp = 0.0;        ///< 每次操作处理的条目数（0 表示不适用）
+    double allocationsPerOp = -1.0; ///< 每次操作的堆分配次数（-1 表示未开启分配跟踪）
+    std::map<std::string, double> counters{}; ///< 基准自定义的附加指标（如抖动分位数）
+};
+
+/**
+ * @brief 基准函数
+ * @details 参数为本次需要执行的迭代次数，函数内部自行循环，避免每次迭代的间接调用开销
+ */
+using BenchmarkFunction = std::function<void(uint64_t iterations)>;
+
+/**
+ * @brief 基准的附加参数
+ */
+struct BenchmarkOptions {
+    double bytesPerOp = 0.0;        ///< 每次操作处理的字节数，用于计算吞吐量
+    double itemsPerOp = 0.0;        ///< 每次操作处理的条目数
+    uint64_t maxIterations = 0;     ///< 每轮迭代次数上限（0 表示不限制），用于开销很大的基准
+    std::map<std::string, double> counters{}; ///< 附加指标，原样写入结果
+};
+
+/**
+ * @brief 基准运行器
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * @brief 构造函数
+     * @param corpusDirectory 语料目录
+     */
+    explicit BenchmarkRunner(std::string corpusDirectory);
+
+    /**
+     * @brief 设置名称过滤（子串匹配，为空时运行全部）
+     */
+    void setFilter(const std::string& filter) { m_filter = filter; }
+
+    /**
+     * @brief 设置每轮最短运行时间
+     */
+    void setMinTime(std::chrono::milliseconds minTime) { m_minTime = minTime; }
+
+    /**
+     * @brief 设置轮数
+     */
+    void setRepetitions(uint32_t repetitions) { m_repetitions = repetitions > 0 ? repetitions : 1; }
+
+    /**
+     * @brief 设置逐条结果的输出流（默认标准输出）
+     */
+    void setProgressOutput(FILE* output) { m_progress = output; }
+
+    /**
+     * @brief 运行一个基准并记录结果
+     * @param name 基准名称
+     * @param function 基准函数
+     * @param options 附加参数
+     */
+    void run(const std::string& name, const BenchmarkFunction& function, const BenchmarkOptions& options = {});
+
+    /**
+     * @brief 名称是否通过过滤
+     * @details 自行计时的基准（如帧率控制抖动）先用它判断是否需要运行
+     */
+    bool isSelected(const std::string& name) const;
+
+    /**
+     * @brief 记录一个自行测量的结果
+     * @param result 结果，至少填写 name、iterations 和 nsPerOp
+     */
+    void record(BenchmarkResult result);
+
+    /**
+     * @brief 读取语料文件（带缓存）
+     * @param name 语料文件名
+     * @return 文件内容，读取失败时抛出 std::runtime_error
+     */
+    const std::string& corpus(const std::string& name);
+
+    /**
+     * @brief 语料按行拆分（带缓存，跳过空行）
+     */
+    const std::vector<std::string>& corpusLines(const std::string& name);
+
+    /**
+     * @brief 已记录的结果
+     */
+    const std::vector<BenchmarkResult>& results() const { return m_results; }
+
+    /**
+     * @brief 以 JSON 格式输出全部结果
+     */
+    std::string toJson() const;
+
+private:
+    std::string m_corpusDirectory;
+    std::string m_filter;
+    std::chrono::milliseconds m_minTime{200};
+    uint32_t m_repetitions = 3;
+    FILE* m_progress = stdout;
+    std::vector<BenchmarkResult> m_results;
+    std::map<std::string, std::string> m_corpora;                   // std::map 保证返回的引用稳定
+    std::map<std::string, std::vector<std::string>> m_corpusLines;
+};
+
+/**
+ * @brief 阻止编译器把基准中的计算结果优化掉
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// 各组基准
+void runStringUtilsBenchmarks(BenchmarkRunner& runner);
+void runFileUtilsBenchmarks(BenchmarkRunner& runner);
+void runTextBenchmarks(BenchmarkRunner& runner);
+void runClipboardBenchmarks(BenchmarkRunner& runner);
+void runLoggerBenchmarks(BenchmarkRunner& runner);
+void runEventBenchmarks(BenchmarkRunner& runner);
+void runEventManagerBenchmarks(BenchmarkRunner& runner);
+void runTaskSchedulerBenchmarks(BenchmarkRunner& runner);
+void runCoroutineTaskBenchmarks(BenchmarkRunner& runner);
+void runLayoutRegistryBenchmarks(BenchmarkRunner& runner);
+void runLayoutMessageBusBenchmarks(BenchmarkRunner& runner);
+void runFramePacerBenchmarks(BenchmarkRunner& runner);
+void runImGuiBenchmarks(BenchmarkRunner& runner);
+void runRenderBatchBenchmarks(BenchmarkRunner& runner);
+void runAtlasBenchmarks(BenchmarkRunner& runner);
+
+} // namespace Bench
+} // namespace DearTs
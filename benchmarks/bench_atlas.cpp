@@ -0,0 +1,99 @@
+/**
+ * @file bench_atlas.cpp
+ * @brief 图集装箱基准：天际线装箱的插入耗时与占用率
+ * @details 把一组图标尺寸（16~64 像素，含 1 像素边距）依次放进 1024x1024 的页面，放满后开新页。
+ *          ns/op 为放入全部图片的耗时，counters 中 occupancy_pct 为已用页面的平均占用率，pages 为所需页数。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "resource/skyline_packer.h"
+#include <random>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Resource::PackedRect;
+using Core::Resource::SkylinePacker;
+
+namespace {
+
+constexpr int PAGE_SIZE = 1024;
+constexpr int PADDING = 1;
+constexpr size_t IMAGE_COUNT = 2000;
+
+struct Size {
+    int w;
+    int h;
+};
+
+std::vector<Size> iconSizes(bool uniform) {
+    std::mt19937 rng(42);
+    const int common[] = {16, 20, 24, 32, 48, 64};
+    std::uniform_int_distribution<size_t> pick(0, sizeof(common) / sizeof(common[0]) - 1);
+    std::uniform_int_distribution<int> any(8, 64);
+    std::vector<Size> sizes;
+    sizes.reserve(IMAGE_COUNT);
+    for (size_t i = 0; i < IMAGE_COUNT; ++i) {
+        if (uniform) {
+            const int side = common[pick(rng)];
+            sizes.push_back({side + 2 * PADDING, side + 2 * PADDING});
+        } else {
+            sizes.push_back({any(rng) + 2 * PADDING, any(rng) + 2 * PADDING});
+        }
+    }
+    return sizes;
+}
+
+/**
+ * @brief 放入全部图片，返回所需页数和平均占用率
+ */
+std::pair<size_t, double> packAll(const std::vector<Size>& sizes) {
+    std::vector<SkylinePacker> pages;
+    pages.emplace_back(PAGE_SIZE, PAGE_SIZE);
+    PackedRect rect;
+    for (const Size& size : sizes) {
+        if (!pages.back().insert(size.w, size.h, rect)) {
+            pages.emplace_back(PAGE_SIZE, PAGE_SIZE);
+            pages.back().insert(size.w, size.h, rect);
+        }
+    }
+    double occupancy = 0.0;
+    for (const SkylinePacker& page : pages) {
+        occupancy += page.getOccupancy();
+    }
+    return {pages.size(), occupancy / static_cast<double>(pages.size())};
+}
+
+} // namespace
+
+void runAtlasBenchmarks(BenchmarkRunner& runner) {
+    const struct {
+        const char* name;
+        bool uniform;
+    } cases[] = {
+        {"Atlas/skyline_icon_sizes", true},
+        {"Atlas/skyline_random_sizes", false},
+    };
+    for (const auto& c : cases) {
+        if (!runner.isSelected(c.name)) {
+            continue;
+        }
+        const std::vector<Size> sizes = iconSizes(c.uniform);
+        const auto [pages, occupancy] = packAll(sizes);
+
+        BenchmarkOptions options;
+        options.itemsPerOp = static_cast<double>(sizes.size());
+        options.counters["pages"] = static_cast<double>(pages);
+        options.counters["occupancy_pct"] = occupancy * 100.0;
+        runner.run(c.name, [&sizes](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(packAll(sizes));
+            }
+        }, options);
+    }
+}
+
+} // namespace Bench
+} // namespace DearTs
@@ -0,0 +1,93 @@
+/**
+ * @file bench_clipboard.cpp
+ * @brief ClipboardManager 基准：添加、搜索、保存、加载历史记录
+ * @details 不初始化系统剪切板监听，直接驱动历史记录相关的接口
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "clipboard/clipboard_manager.h"
+#include <filesystem>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Window::Widgets::Clipboard::ClipboardManager;
+
+namespace {
+
+constexpr size_t HISTORY_ITEMS = 1000;   ///< 与 ClipboardManager 默认的历史记录上限一致
+
+} // namespace
+
+void runClipboardBenchmarks(BenchmarkRunner& runner) {
+    namespace fs = std::filesystem;
+
+    // 剪切板条目：两份语料的行交替排列，约三分之一带 URL
+    std::vector<std::string> items;
+    const std::vector<std::string>& textLines = runner.corpusLines("mixed_cjk_latin.txt");
+    const std::vector<std::string>& urlLines = runner.corpusLines("urls.txt");
+    for (size_t i = 0; items.size() < HISTORY_ITEMS; ++i) {
+        items.push_back(i % 3 == 2 ? urlLines[i % urlLines.size()] : textLines[i % textLines.size()]);
+        // 保证内容互不相同
+        items.back() += " #" + std::to_string(i);
+    }
+
+    const fs::path root = fs::temp_directory_path() / "dearts_bench_clipboard";
+    std::error_code ec;
+    fs::create_directories(root, ec);
+    const std::string historyPath = (root / "clipboard_history.txt").string();
+
+    // 添加：历史记录满后每次添加都会淘汰最旧的一条
+    runner.run("ClipboardManager/add_item", [&items](uint64_t iterations) {
+        ClipboardManager manager;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(manager.addClipboardItem(items[static_cast<size_t>(i % items.size())]));
+        }
+    });
+
+    ClipboardManager full;
+    full.setHistoryFilePath(historyPath);
+    for (const std::string& item : items) {
+        full.addClipboardItem(item);
+    }
+
+    runner.run("ClipboardManager/search_latin", [&full](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(full.searchHistory("render"));
+        }
+    }, {0.0, static_cast<double>(HISTORY_ITEMS)});
+
+    runner.run("ClipboardManager/search_cjk", [&full](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(full.searchHistory("剪切板"));
+        }
+    }, {0.0, static_cast<double>(HISTORY_ITEMS)});
+
+    runner.run("ClipboardManager/search_miss", [&full](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(full.searchHistory("不存在的关键词"));
+        }
+    }, {0.0, static_cast<double>(HISTORY_ITEMS)});
+
+    runner.run("ClipboardManager/save_history", [&full](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(full.saveHistory());
+        }
+    }, {0.0, static_cast<double>(HISTORY_ITEMS)});
+
+    full.saveHistory();
+    runner.run("ClipboardManager/load_history", [&historyPath](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            ClipboardManager manager;
+            manager.setHistoryFilePath(historyPath);
+            doNotOptimize(manager.loadHistory());
+        }
+    }, {0.0, static_cast<double>(HISTORY_ITEMS)});
+
+    fs::remove_all(root, ec);
+}
+
+} // namespace Bench
+} // namespace DearTs
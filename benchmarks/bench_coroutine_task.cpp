@@ -0,0 +1,194 @@
+/**
+ * @file bench_coroutine_task.cpp
+ * @brief 协程任务基准：co_await 后台工作的往返（工作线程执行、主线程恢复），
+ *        nextFrame 让出的开销，以及 co_await 子协程（对称转移，不经过调度器）的开销
+ * @details 主线程循环由基准自身驱动：反复调用 runMainThreadContinuations() 直到协程结束，
+ *          对应 ApplicationManager 每帧执行一次的续体队列。
+ *          idle_loop_search 按 GUIApplication::run 的结构驱动：没有工作时阻塞，只靠调度器的唤醒回调和
+ *          最早的主线程定时回调（Application::prepareIdleWait()）醒来，再执行续体（Application::pumpFrameWork()）；
+ *          协程在限定时间内没有结束时基准失败，用于检查后台任务完成后协程确实在真实主循环中恢复。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "app/coroutine_task.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::App::Task;
+using Core::App::TaskScheduler;
+
+namespace {
+
+constexpr int CHAIN_LENGTH = 16;
+constexpr int NEXT_FRAME_COUNT = 256;
+constexpr int CHILD_COUNT = 256;
+constexpr auto IDLE_LOOP_STALL_LIMIT = std::chrono::seconds(2);
+
+/**
+ * @brief 启动协程并在当前线程驱动主线程续体队列直到其结束
+ */
+template <typename T>
+void runToCompletion(TaskScheduler& scheduler, Task<T>& task) {
+    task.start();
+    while (!task.isReady()) {
+        if (scheduler.runMainThreadContinuations() == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief 模拟 FrameScheduler 的空闲等待：阻塞到被唤醒或到达截止时间
+ */
+class IdleWaiter {
+public:
+    void wakeUp() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_woken = true;
+        }
+        m_condition.notify_one();
+    }
+
+    /**
+     * @return 是否被唤醒（false 表示等到了截止时间）
+     */
+    bool waitUntil(std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const bool woken = m_condition.wait_until(lock, deadline, [this]() { return m_woken; });
+        m_woken = false;
+        return woken;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_woken = false;
+};
+
+/**
+ * @brief 按主循环的顺序驱动协程：空闲等待 → 执行续体；长时间既没有唤醒也没有到期的定时回调时视为卡死
+ */
+template <typename T>
+void runInIdleLoop(TaskScheduler& scheduler, IdleWaiter& waiter, Task<T>& task) {
+    task.start();
+    while (!task.isReady()) {
+        const auto stallDeadline = std::chrono::steady_clock::now() + IDLE_LOOP_STALL_LIMIT;
+        auto deadline = stallDeadline;
+        if (auto timer = scheduler.getNextMainThreadDeadline()) {
+            deadline = std::min(deadline, *timer);
+        }
+        if (!waiter.waitUntil(deadline) && deadline == stallDeadline && !task.isReady()) {
+            throw std::runtime_error("协程在空闲等待的主循环中没有恢复");
+        }
+        scheduler.runMainThreadContinuations();
+    }
+}
+
+/**
+ * @brief 与 ExchangeRecordLayout 的搜索相同的形状：后台执行带上下文的工作，回到主线程后再等一个定时回调
+ */
+Task<uint64_t> searchLikeTask() {
+    const uint64_t found = co_await Core::App::runInBackground([](Core::App::TaskContext& context) {
+        uint64_t value = 0;
+        for (uint64_t i = 0; i < 64 && !context.isCancelled(); ++i) {
+            value += i * 0x9E3779B97F4A7C15ull;
+        }
+        return value;
+    });
+    co_await Core::App::delay(std::chrono::microseconds(100));
+    co_return found;
+}
+
+Task<uint64_t> backgroundChain(int steps) {
+    uint64_t sum = 0;
+    for (int i = 0; i < steps; ++i) {
+        sum += co_await Core::App::runInBackground([i]() { return static_cast<uint64_t>(i) * 0x9E3779B97F4A7C15ull; });
+    }
+    co_return sum;
+}
+
+Task<void> yieldFrames(int frames) {
+    for (int i = 0; i < frames; ++i) {
+        co_await Core::App::nextFrame();
+    }
+}
+
+Task<int> childValue(int value) {
+    co_return value * 2;
+}
+
+Task<int> awaitChildren(int count) {
+    int sum = 0;
+    for (int i = 0; i < count; ++i) {
+        sum += co_await childValue(i);
+    }
+    co_return sum;
+}
+
+} // namespace
+
+void runCoroutineTaskBenchmarks(BenchmarkRunner& runner) {
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    scheduler.initialize();
+
+    runner.run("Coroutine/background_round_trip", [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Task<uint64_t> task = backgroundChain(1);
+            runToCompletion(scheduler, task);
+            doNotOptimize(task.get());
+        }
+    });
+
+    BenchmarkOptions chainOptions;
+    chainOptions.itemsPerOp = CHAIN_LENGTH;
+    runner.run("Coroutine/background_chain_" + std::to_string(CHAIN_LENGTH), [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Task<uint64_t> task = backgroundChain(CHAIN_LENGTH);
+            runToCompletion(scheduler, task);
+            doNotOptimize(task.get());
+        }
+    }, chainOptions);
+
+    BenchmarkOptions frameOptions;
+    frameOptions.itemsPerOp = NEXT_FRAME_COUNT;
+    runner.run("Coroutine/next_frame_" + std::to_string(NEXT_FRAME_COUNT), [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Task<void> task = yieldFrames(NEXT_FRAME_COUNT);
+            runToCompletion(scheduler, task);
+        }
+    }, frameOptions);
+
+    BenchmarkOptions childOptions;
+    childOptions.itemsPerOp = CHILD_COUNT;
+    runner.run("Coroutine/await_child_" + std::to_string(CHILD_COUNT), [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Task<int> task = awaitChildren(CHILD_COUNT);
+            runToCompletion(scheduler, task);
+            doNotOptimize(task.get());
+        }
+    }, childOptions);
+
+    // 主循环只在被唤醒时执行续体：后台任务完成和定时回调都必须能唤醒它
+    IdleWaiter waiter;
+    scheduler.setWakeCallback([&waiter]() { waiter.wakeUp(); });
+    runner.run("Coroutine/idle_loop_search", [&scheduler, &waiter](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            Task<uint64_t> task = searchLikeTask();
+            runInIdleLoop(scheduler, waiter, task);
+            doNotOptimize(task.get());
+        }
+    });
+    scheduler.setWakeCallback(nullptr);
+}
+
+} // namespace Bench
+} // namespace DearTs
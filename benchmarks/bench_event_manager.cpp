@@ -0,0 +1,161 @@
+/**
+ * @file bench_event_manager.cpp
+ * @brief 插件事件管理器基准：dearts::EventManager::post 在多个线程同时发布时的吞吐量
+ * @details EventManager/post_N_threads 为 N 个线程各自发布固定数量的事件，ns/op 为每个事件的平均墙钟耗时，
+ *          线程数增加时该值应随之下降（受可用核心数限制）。locked_post_N_threads 是改造前的实现
+ *          （全局递归锁 + multimap，回调在锁内执行）作为对照。每个回调做少量计算，模拟真实处理器。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include <dearts/api/event_manager.hpp>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+EVENT_DEF_NO_LOG(BenchPluginEvent, uint64_t);
+
+}
+
+namespace DearTs {
+namespace Bench {
+
+namespace {
+
+constexpr uint64_t POSTS_PER_THREAD = 200000;
+constexpr int SUBSCRIBERS = 4;
+
+/**
+ * @brief 模拟处理器内的少量计算
+ */
+uint64_t handlerWork(uint64_t value) {
+    uint64_t hash = value;
+    for (int i = 0; i < 16; ++i) {
+        hash = (hash ^ (hash >> 31)) * 0x9E3779B97F4A7C15ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief 对照实现：全局递归锁保护的 multimap，post 在锁内调用回调
+ */
+class LockedEventManager {
+public:
+    using Callback = std::function<void(uint64_t)>;
+
+    void subscribe(uint32_t id, Callback callback) {
+        std::scoped_lock lock(m_mutex);
+        m_events.emplace(id, std::move(callback));
+    }
+
+    void post(uint32_t id, uint64_t value) {
+        std::scoped_lock lock(m_mutex);
+        auto range = m_events.equal_range(id);
+        for (auto it = range.first; it != range.second; ++it) {
+            it->second(value);
+        }
+    }
+
+private:
+    std::recursive_mutex m_mutex;
+    std::multimap<uint32_t, Callback> m_events;
+};
+
+/**
+ * @brief 多个线程同时发布
+ * @return 每个事件的平均墙钟耗时（纳秒）
+ */
+template <typename Post>
+double runPosters(int threads, Post&& post) {
+    std::atomic<bool> start{false};
+    std::vector<std::thread> posters;
+    for (int t = 0; t < threads; ++t) {
+        posters.emplace_back([&start, &post, t]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = 0; i < POSTS_PER_THREAD; ++i) {
+                post(static_cast<uint64_t>(t) * POSTS_PER_THREAD + i);
+            }
+        });
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (std::thread& poster : posters) {
+        poster.join();
+    }
+    const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+    return elapsed / static_cast<double>(threads * POSTS_PER_THREAD);
+}
+
+void recordPosters(BenchmarkRunner& runner, const std::string& name, int threads, double nsPerPost) {
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = threads * POSTS_PER_THREAD;
+    result.repetitions = 1;
+    result.nsPerOp = nsPerPost;
+    result.nsPerOpMin = nsPerPost;
+    result.nsPerOpMax = nsPerPost;
+    result.itemsPerOp = 1.0;
+    result.counters["threads"] = threads;
+    result.counters["subscribers"] = SUBSCRIBERS;
+    result.counters["hardware_threads"] = std::thread::hardware_concurrency();
+    runner.record(std::move(result));
+}
+
+} // namespace
+
+void runEventManagerBenchmarks(BenchmarkRunner& runner) {
+    const int threadCounts[] = {1, 2, 4, 8};
+
+    for (const int threads : threadCounts) {
+        const std::string name = "EventManager/post_" + std::to_string(threads) + "_threads";
+        if (!runner.isSelected(name)) {
+            continue;
+        }
+        std::atomic<uint64_t> sink{0};
+        std::vector<dearts::EventManager::SubscriptionToken> tokens;
+        for (int s = 0; s < SUBSCRIBERS; ++s) {
+            tokens.push_back(BenchPluginEvent::subscribe([&sink](uint64_t value) {
+                if (handlerWork(value) == 0) {
+                    sink.fetch_add(1, std::memory_order_relaxed);
+                }
+            }));
+        }
+        const double nsPerPost = runPosters(threads, [](uint64_t value) { BenchPluginEvent::post(value); });
+        for (const auto& token : tokens) {
+            BenchPluginEvent::unsubscribe(token);
+        }
+        doNotOptimize(sink.load());
+        recordPosters(runner, name, threads, nsPerPost);
+    }
+
+    for (const int threads : threadCounts) {
+        const std::string name = "EventManager/locked_post_" + std::to_string(threads) + "_threads";
+        if (!runner.isSelected(name)) {
+            continue;
+        }
+        std::atomic<uint64_t> sink{0};
+        LockedEventManager manager;
+        for (int s = 0; s < SUBSCRIBERS; ++s) {
+            manager.subscribe(1, [&sink](uint64_t value) {
+                if (handlerWork(value) == 0) {
+                    sink.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        const double nsPerPost = runPosters(threads, [&manager](uint64_t value) { manager.post(1, value); });
+        doNotOptimize(sink.load());
+        recordPosters(runner, name, threads, nsPerPost);
+    }
+}
+
+} // namespace Bench
+} // namespace DearTs
@@ -0,0 +1,354 @@
+/**
+ * @file bench_events.cpp
+ * @brief 事件基准：EventDelegate 与 std::function 的调用开销，EventDispatcher 不同订阅者数量下的分发开销
+ *        及订阅增删开销，EventQueue 的投递/取出吞吐量
+ * @details EventQueue/mpsc_* 为多个生产者线程同时投递、主线程持续取出，ns/op 为每个事件的平均耗时；
+ *          mutex_vector_* 是同样负载下“互斥锁 + vector 交换”的对照实现。
+ *          *_paced 版本中积压超过 PACED_MAX_PENDING 时生产者让出时间片，模拟主循环按帧取出的稳态，
+ *          此时取出的节点应经全局池回到生产者手中，nodes_allocated 接近积压上限而不是事件总数。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "events/event_queue.h"
+#include "events/event_system.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Events::Event;
+using Core::Events::EventDelegate;
+using Core::Events::EventDispatcher;
+using Core::Events::EventHandler;
+using Core::Events::EventQueue;
+using Core::Events::EventType;
+
+namespace {
+
+class BenchEvent : public Event {
+public:
+    explicit BenchEvent(EventType type) : Event(type) {}
+    const char* getName() const override { return "BenchEvent"; }
+};
+
+constexpr int QUEUE_PRODUCERS = 4;
+constexpr uint64_t EVENTS_PER_PRODUCER = 200000;
+constexpr size_t PACED_MAX_PENDING = 4096;  ///< 限速版本允许积压的事件数
+
+/**
+ * @brief 对照实现：互斥锁保护的 vector，取出时整体交换
+ */
+class MutexVectorQueue {
+public:
+    void post(std::unique_ptr<Event> event) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(std::move(event));
+    }
+
+    template <typename Sink>
+    size_t drain(Sink&& sink) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.swap(m_draining);
+        }
+        for (const auto& event : m_draining) {
+            sink(*event);
+        }
+        const size_t count = m_draining.size();
+        m_draining.clear();
+        return count;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Event>> m_pending;
+    std::vector<std::unique_ptr<Event>> m_draining;
+};
+
+/**
+ * @brief 多个生产者线程同时投递，当前线程持续取出直到收齐
+ * @param canPost 生产者每次投递前调用，返回 false 时让出时间片后重试（限速）
+ * @return 每个事件的平均耗时（纳秒）
+ */
+template <typename Post, typename Drain, typename CanPost>
+double runProducers(Post&& post, Drain&& drain, CanPost&& canPost, uint64_t& drains) {
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < QUEUE_PRODUCERS; ++p) {
+        producers.emplace_back([&start, &post, &canPost]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                while (!canPost()) {
+                    std::this_thread::yield();
+                }
+                post();
+            }
+        });
+    }
+
+    const uint64_t total = QUEUE_PRODUCERS * EVENTS_PER_PRODUCER;
+    uint64_t received = 0;
+    drains = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    while (received < total) {
+        const size_t count = drain();
+        received += count;
+        ++drains;
+        if (count == 0) {
+            // 相当于主循环等下一帧，让出时间片给生产者
+            std::this_thread::yield();
+        }
+    }
+    const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    return elapsed / static_cast<double>(total);
+}
+
+void recordProducers(BenchmarkRunner& runner, const std::string& name, double nsPerEvent, uint64_t drains,
+                     std::map<std::string, double> counters) {
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = QUEUE_PRODUCERS * EVENTS_PER_PRODUCER;
+    result.repetitions = 1;
+    result.nsPerOp = nsPerEvent;
+    result.nsPerOpMin = nsPerEvent;
+    result.nsPerOpMax = nsPerEvent;
+    result.itemsPerOp = 1.0;
+    result.counters = std::move(counters);
+    result.counters["drains"] = static_cast<double>(drains);
+    result.counters["producers"] = QUEUE_PRODUCERS;
+    runner.record(std::move(result));
+}
+
+void runEventQueueBenchmarks(BenchmarkRunner& runner) {
+    // 单线程：每帧投递 64 个事件后取出一次
+    runner.run("EventQueue/post_drain", [](uint64_t iterations) {
+        EventQueue queue;
+        uint64_t received = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            queue.emplace<BenchEvent>(EventType::EVT_KEY_PRESSED);
+            if ((i & 63) == 63) {
+                queue.drain([&received](const Event&) { ++received; });
+            }
+        }
+        queue.drain([&received](const Event&) { ++received; });
+        doNotOptimize(received);
+    }, {0.0, 1.0, 0, {}});
+
+    // 每帧 64 个鼠标移动事件合并为 1 个
+    runner.run("EventQueue/post_drain_coalesced", [](uint64_t iterations) {
+        EventQueue queue;
+        uint64_t received = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            queue.emplace<BenchEvent>(EventType::EVT_MOUSE_MOVED);
+            if ((i & 63) == 63) {
+                queue.drain([&received](const Event&) { ++received; });
+            }
+        }
+        queue.drain([&received](const Event&) { ++received; });
+        doNotOptimize(received);
+    }, {0.0, 1.0, 0, {}});
+
+    const auto unlimited = []() { return true; };
+    for (const bool paced : {false, true}) {
+        const std::string mpscName =
+            "EventQueue/mpsc_" + std::to_string(QUEUE_PRODUCERS) + "_producers" + (paced ? "_paced" : "");
+        if (!runner.isSelected(mpscName)) {
+            continue;
+        }
+        EventQueue queue;
+        const auto before = queue.getStats();
+        uint64_t drains = 0;
+        const double nsPerEvent = runProducers(
+            [&queue]() { queue.emplace<BenchEvent>(EventType::EVT_CUSTOM); },
+            [&queue]() { return queue.drain([](const Event& event) { doNotOptimize(event); }); },
+            [&queue, paced]() { return !paced || queue.getPendingCount() < PACED_MAX_PENDING; },
+            drains);
+        const auto stats = queue.getStats();
+        recordProducers(runner, mpscName, nsPerEvent, drains,
+                        {{"max_batch", static_cast<double>(stats.maxBatch)},
+                         {"nodes_allocated", static_cast<double>(stats.nodesAllocated - before.nodesAllocated)},
+                         {"nodes_freed", static_cast<double>(stats.nodesFreed - before.nodesFreed)},
+                         {"nodes_pooled", static_cast<double>(stats.nodesPooled)}});
+    }
+
+    const std::string mutexName = "EventQueue/mutex_vector_" + std::to_string(QUEUE_PRODUCERS) + "_producers";
+    if (runner.isSelected(mutexName)) {
+        MutexVectorQueue queue;
+        uint64_t drains = 0;
+        const double nsPerEvent = runProducers(
+            [&queue]() { queue.post(std::make_unique<BenchEvent>(EventType::EVT_CUSTOM)); },
+            [&queue]() { return queue.drain([](const Event& event) { doNotOptimize(event); }); },
+            unlimited, drains);
+        recordProducers(runner, mutexName, nsPerEvent, drains, {});
+    }
+}
+
+} // namespace
+
+void runEventBenchmarks(BenchmarkRunner& runner) {
+    // 捕获 this 大小的 lambda：EventDelegate 内联存放，std::function 作为对照
+    runner.run("EventDelegate/invoke", [](uint64_t iterations) {
+        uint64_t received = 0;
+        const EventHandler handler = [&received](const Event&) {
+            ++received;
+            return false;
+        };
+        const BenchEvent event(EventType::EVT_MOUSE_MOVED);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(handler(event));
+        }
+        doNotOptimize(received);
+    });
+
+    runner.run("EventDelegate/std_function_invoke", [](uint64_t iterations) {
+        uint64_t received = 0;
+        const std::function<bool(const Event&)> handler = [&received](const Event&) {
+            ++received;
+            return false;
+        };
+        const BenchEvent event(EventType::EVT_MOUSE_MOVED);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(handler(event));
+        }
+        doNotOptimize(received);
+    });
+
+    // 订阅时复制处理器：24 字节的捕获（如 [this, &state, id]）超出 std::function 的内部缓冲区，
+    // EventDelegate 仍内联存放，不分配内存
+    runner.run("EventDelegate/copy", [](uint64_t iterations) {
+        uint64_t received = 0;
+        const uint64_t first = 1;
+        const uint64_t second = 2;
+        const EventHandler handler = [&received, first, second](const Event&) {
+            received += first + second;
+            return false;
+        };
+        for (uint64_t i = 0; i < iterations; ++i) {
+            EventHandler copy(handler);
+            doNotOptimize(copy);
+        }
+    });
+
+    runner.run("EventDelegate/std_function_copy", [](uint64_t iterations) {
+        uint64_t received = 0;
+        const uint64_t first = 1;
+        const uint64_t second = 2;
+        const std::function<bool(const Event&)> handler = [&received, first, second](const Event&) {
+            received += first + second;
+            return false;
+        };
+        for (uint64_t i = 0; i < iterations; ++i) {
+            std::function<bool(const Event&)> copy(handler);
+            doNotOptimize(copy);
+        }
+    });
+
+    const int handlerCounts[] = {1, 8, 64};
+    for (const int handlers : handlerCounts) {
+        runner.run("EventDispatcher/dispatch_" + std::to_string(handlers) + "_handlers", [handlers](uint64_t iterations) {
+            EventDispatcher dispatcher;
+            uint64_t received = 0;
+            for (int h = 0; h < handlers; ++h) {
+                dispatcher.subscribe(EventType::EVT_MOUSE_MOVED, [&received](const Event&) {
+                    ++received;
+                    return false;
+                });
+            }
+            // 其他类型的订阅者，使查找表不止一个条目
+            for (uint32_t type = static_cast<uint32_t>(EventType::EVT_LAYOUT_SHOW_REQUEST);
+                 type <= static_cast<uint32_t>(EventType::EVT_LAYOUT_MOVED); ++type) {
+                dispatcher.subscribe(static_cast<EventType>(type), [](const Event&) { return true; });
+            }
+
+            const BenchEvent event(EventType::EVT_MOUSE_MOVED);
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(dispatcher.dispatch(event));
+            }
+            doNotOptimize(received);
+        }, {0.0, static_cast<double>(handlers), 0, {}});
+    }
+
+    // 布局事件段（1000 起）同样按下标直接取出
+    runner.run("EventDispatcher/dispatch_layout_event", [](uint64_t iterations) {
+        EventDispatcher dispatcher;
+        uint64_t received = 0;
+        dispatcher.subscribe(EventType::EVT_LAYOUT_UPDATED, [&received](const Event&) {
+            ++received;
+            return true;
+        });
+        const BenchEvent event(EventType::EVT_LAYOUT_UPDATED);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(dispatcher.dispatch(event));
+        }
+        doNotOptimize(received);
+    });
+
+    // 布局显示/隐藏时的订阅与取消：槽位复用，处理器内联存放
+    runner.run("EventDispatcher/scoped_subscribe_release", [](uint64_t iterations) {
+        EventDispatcher dispatcher;
+        uint64_t received = 0;
+        for (int h = 0; h < 8; ++h) {
+            dispatcher.subscribe(EventType::EVT_WINDOW_RESIZED, [&received](const Event&) {
+                ++received;
+                return false;
+            });
+        }
+        for (uint64_t i = 0; i < iterations; ++i) {
+            auto subscription = dispatcher.subscribeScoped(EventType::EVT_WINDOW_RESIZED, [&received](const Event&) {
+                ++received;
+                return true;
+            });
+            doNotOptimize(subscription);
+        }
+        doNotOptimize(received);
+    });
+
+    // 处理器在分发中取消自己并订阅一个新的（延迟到分发结束后生效）
+    runner.run("EventDispatcher/dispatch_with_resubscribe", [](uint64_t iterations) {
+        EventDispatcher dispatcher;
+        uint64_t received = 0;
+        Core::Events::SubscriptionId current = Core::Events::INVALID_SUBSCRIPTION;
+        EventHandler handler;
+        handler = [&](const Event&) {
+            ++received;
+            dispatcher.unsubscribe(current);
+            current = dispatcher.subscribe(EventType::EVT_KEY_PRESSED, handler);
+            return true;
+        };
+        current = dispatcher.subscribe(EventType::EVT_KEY_PRESSED, handler);
+
+        const BenchEvent event(EventType::EVT_KEY_PRESSED);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(dispatcher.dispatch(event));
+        }
+        doNotOptimize(received);
+    });
+
+    runner.run("EventDispatcher/dispatch_unsubscribed", [](uint64_t iterations) {
+        EventDispatcher dispatcher;
+        dispatcher.subscribe(EventType::EVT_WINDOW_RESIZE, [](const Event&) { return true; });
+
+        const BenchEvent event(EventType::EVT_MOUSE_MOVED);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(dispatcher.dispatch(event));
+        }
+    });
+
+    runEventQueueBenchmarks(runner);
+}
+
+} // namespace Bench
+} // namespace DearTs
@@ -0,0 +1,95 @@
+/**
+ * @file bench_file_utils.cpp
+ * @brief FileUtils 基准：读取文件、递归搜索
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "utils/file_utils.h"
+#include <filesystem>
+#include <fstream>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Utils::FileSearchOptions;
+using Core::Utils::FileUtils;
+
+namespace {
+
+constexpr int TREE_DIRECTORIES = 16;       ///< 搜索用目录树的子目录数
+constexpr int TREE_FILES_PER_DIRECTORY = 32; ///< 每个子目录的文件数
+
+void writeText(const std::filesystem::path& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+} // namespace
+
+void runFileUtilsBenchmarks(BenchmarkRunner& runner) {
+    namespace fs = std::filesystem;
+
+    const fs::path root = fs::temp_directory_path() / "dearts_bench_files";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root);
+
+    // 单个语料文件与约 1 MB 的大文件
+    const std::string& text = runner.corpus("mixed_cjk_latin.txt");
+    const fs::path smallFile = root / "small.txt";
+    writeText(smallFile, text);
+
+    std::string large;
+    while (large.size() < (1u << 20)) {
+        large += text;
+    }
+    const fs::path largeFile = root / "large.txt";
+    writeText(largeFile, large);
+
+    // 目录树：每个目录中混合 .txt/.log/.json 三种扩展名
+    const char* extensions[] = {".txt", ".log", ".json"};
+    for (int d = 0; d < TREE_DIRECTORIES; ++d) {
+        const fs::path directory = root / "tree" / ("dir" + std::to_string(d)) / "nested";
+        fs::create_directories(directory);
+        for (int f = 0; f < TREE_FILES_PER_DIRECTORY; ++f) {
+            writeText(directory / ("file" + std::to_string(f) + extensions[f % 3]), "x");
+        }
+    }
+    const std::string treePath = (root / "tree").string();
+
+    const std::string smallPath = smallFile.string();
+    runner.run("FileUtils/read_file_48k", [&smallPath](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(FileUtils::readFile(smallPath));
+        }
+    }, {static_cast<double>(text.size())});
+
+    const std::string largePath = largeFile.string();
+    runner.run("FileUtils/read_file_1m", [&largePath](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(FileUtils::readFile(largePath));
+        }
+    }, {static_cast<double>(large.size())});
+
+    const double treeFiles = static_cast<double>(TREE_DIRECTORIES * TREE_FILES_PER_DIRECTORY);
+    runner.run("FileUtils/search_files_glob", [&treePath](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(FileUtils::searchFiles(treePath, "*.log"));
+        }
+    }, {0.0, treeFiles});
+
+    runner.run("FileUtils/search_files_extension", [&treePath](uint64_t iterations) {
+        FileSearchOptions options;
+        options.include_extensions = {".json"};
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(FileUtils::searchFiles(treePath, "*", options));
+        }
+    }, {0.0, treeFiles});
+
+    fs::remove_all(root, ec);
+}
+
+} // namespace Bench
+} // namespace DearTs
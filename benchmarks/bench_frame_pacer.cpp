@@ -0,0 +1,135 @@
+/**
+ * @file bench_frame_pacer.cpp
+ * @brief 帧率控制基准：测量帧间隔抖动分布
+ * @details 以 240Hz 运行固定帧数，每帧先忙等约 1ms 模拟渲染工作，再调用帧率控制等待。
+ *          抖动 = |实际帧间隔 - 目标周期|；ns/op 为平均帧间隔。对比三种实现：
+ *          - relative_sleep：旧的 limitFrameRate，按上一帧开始时间相对睡眠；
+ *          - sleep_only：FramePacer 绝对截止时间排程，只睡眠；
+ *          - hybrid：FramePacer 睡眠 + 自旋（默认）。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "app/frame_pacer.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <thread>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::App::FramePacer;
+
+namespace {
+
+constexpr uint32_t TARGET_FPS = 240;
+constexpr size_t FRAMES = FramePacer::ERROR_HISTORY;
+constexpr auto SIMULATED_WORK = std::chrono::microseconds(1000);
+
+using Clock = std::chrono::steady_clock;
+
+void simulateWork() {
+    const Clock::time_point end = Clock::now() + SIMULATED_WORK;
+    while (Clock::now() < end) {
+    }
+}
+
+/**
+ * @brief 运行 FRAMES 帧，wait 负责等待到下一帧，返回每帧间隔（纳秒）
+ */
+template <typename WaitFunction>
+std::vector<double> measureIntervals(WaitFunction&& wait) {
+    std::vector<double> intervals;
+    intervals.reserve(FRAMES);
+    Clock::time_point last = Clock::now();
+    // 第一帧用于建立排程，不计入统计
+    for (size_t frame = 0; frame <= FRAMES; ++frame) {
+        simulateWork();
+        wait();
+        const Clock::time_point now = Clock::now();
+        if (frame > 0) {
+            intervals.push_back(std::chrono::duration<double, std::nano>(now - last).count());
+        }
+        last = now;
+    }
+    return intervals;
+}
+
+/**
+ * @param counters 额外的计数（FramePacer 自身的误差统计，包括错过截止时间的帧）
+ */
+void recordIntervals(BenchmarkRunner& runner, const std::string& name, const std::vector<double>& intervals,
+                     std::map<std::string, double> counters = {}) {
+    const double periodNs = 1.0e9 / TARGET_FPS;
+    std::vector<double> jitter;
+    jitter.reserve(intervals.size());
+    double total = 0.0;
+    for (const double interval : intervals) {
+        total += interval;
+        jitter.push_back(std::fabs(interval - periodNs));
+    }
+    std::sort(jitter.begin(), jitter.end());
+    auto percentile = [&jitter](double p) {
+        return jitter[std::min(jitter.size() - 1, static_cast<size_t>(p * static_cast<double>(jitter.size())))] / 1.0e3;
+    };
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = intervals.size();
+    result.repetitions = 1;
+    result.nsPerOp = total / static_cast<double>(intervals.size());
+    result.nsPerOpMin = *std::min_element(intervals.begin(), intervals.end());
+    result.nsPerOpMax = *std::max_element(intervals.begin(), intervals.end());
+    result.counters = std::move(counters);
+    result.counters["jitter_p50_us"] = percentile(0.50);
+    result.counters["jitter_p95_us"] = percentile(0.95);
+    result.counters["jitter_p99_us"] = percentile(0.99);
+    result.counters["jitter_max_us"] = jitter.back() / 1.0e3;
+    runner.record(std::move(result));
+}
+
+} // namespace
+
+void runFramePacerBenchmarks(BenchmarkRunner& runner) {
+    const std::string prefix = "FramePacer/" + std::to_string(TARGET_FPS) + "hz_";
+
+    if (runner.isSelected(prefix + "relative_sleep")) {
+        const auto period = std::chrono::duration<double>(1.0 / TARGET_FPS);
+        Clock::time_point frameStart = Clock::now();
+        recordIntervals(runner, prefix + "relative_sleep", measureIntervals([&frameStart, period] {
+            const auto elapsed = Clock::now() - frameStart;
+            if (elapsed < period) {
+                std::this_thread::sleep_for(period - elapsed);
+            }
+            frameStart = Clock::now();
+        }));
+    }
+
+    const struct {
+        const char* name;
+        bool spin;
+    } modes[] = {
+        {"sleep_only", false},
+        {"hybrid", true},
+    };
+    for (const auto& mode : modes) {
+        const std::string name = prefix + mode.name;
+        if (!runner.isSelected(name)) {
+            continue;
+        }
+        FramePacer pacer;
+        pacer.setTargetFps(TARGET_FPS);
+        pacer.setSpinEnabled(mode.spin);
+        const std::vector<double> intervals = measureIntervals([&pacer] { pacer.waitForNextFrame(); });
+        const auto stats = pacer.getStats();
+        recordIntervals(runner, name, intervals,
+                        {{"missed_deadlines", static_cast<double>(stats.missed_deadlines)},
+                         {"error_p99_us", stats.p99_error_us},
+                         {"error_max_us", stats.max_error_us}});
+    }
+}
+
+} // namespace Bench
+} // namespace DearTs
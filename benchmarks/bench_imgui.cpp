@@ -0,0 +1,172 @@
+/**
+ * @file bench_imgui.cpp
+ * @brief 无窗口 ImGui 基准：绘制数据哈希与“画面未变化”检测
+ * @details 不创建窗口也不链接渲染后端，用一个空后端（只把纹理请求标记为已完成）驱动完整的
+ *          NewFrame/Render 流程。对比静态界面与每帧变化的界面：
+ *          - hash_draw_data：单次 hashDrawData 的耗时，bytes/op 为顶点 + 索引缓冲大小；
+ *          - frame_static / frame_animated：一帧完整的 ImGui 逻辑 + 检测，
+ *            counters 中的 skipped_pct 为被判定为“未变化”而跳过提交的帧百分比。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "render/draw_data_hash.h"
+#include <imgui.h>
+#include <chrono>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Render::UnchangedFrameFilter;
+using Core::Render::hashDrawData;
+
+namespace {
+
+constexpr int WIDGET_ROWS = 200;    ///< 测试界面的行数，每行若干控件
+constexpr uint64_t FRAMES = 600;    ///< 整帧基准运行的帧数
+
+/**
+ * @brief 空后端：立即完成纹理的创建、更新和销毁请求
+ */
+void completeTextureRequests(ImDrawData* drawData) {
+    if (!drawData->Textures) {
+        return;
+    }
+    for (ImTextureData* texture : *drawData->Textures) {
+        switch (texture->Status) {
+        case ImTextureStatus_WantCreate:
+            texture->SetTexID(static_cast<ImTextureID>(1));
+            texture->SetStatus(ImTextureStatus_OK);
+            break;
+        case ImTextureStatus_WantUpdates:
+            texture->SetStatus(ImTextureStatus_OK);
+            break;
+        case ImTextureStatus_WantDestroy:
+            texture->SetTexID(ImTextureID_Invalid);
+            texture->SetStatus(ImTextureStatus_Destroyed);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 无窗口的 ImGui 上下文
+ */
+class HeadlessImGui {
+public:
+    HeadlessImGui() {
+        m_context = ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.LogFilename = nullptr;
+        io.DisplaySize = ImVec2(1280.0f, 720.0f);
+        io.DeltaTime = 1.0f / 60.0f;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    }
+
+    ~HeadlessImGui() { ImGui::DestroyContext(m_context); }
+
+    HeadlessImGui(const HeadlessImGui&) = delete;
+    HeadlessImGui& operator=(const HeadlessImGui&) = delete;
+
+    /**
+     * @brief 运行一帧并返回绘制数据
+     * @param animated 是否让界面内容随帧变化
+     */
+    ImDrawData* frame(bool animated) {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin("Bench", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+        for (int row = 0; row < WIDGET_ROWS; ++row) {
+            ImGui::PushID(row);
+            ImGui::Text("第 %d 行", row);
+            ImGui::SameLine();
+            ImGui::Button("按钮");
+            ImGui::SameLine();
+            const float progress = animated ? static_cast<float>((m_frame + row) % 100) / 100.0f : 0.5f;
+            ImGui::ProgressBar(progress, ImVec2(200.0f, 0.0f));
+            ImGui::PopID();
+        }
+        ImGui::End();
+        ImGui::Render();
+        ++m_frame;
+
+        ImDrawData* drawData = ImGui::GetDrawData();
+        completeTextureRequests(drawData);
+        return drawData;
+    }
+
+private:
+    ImGuiContext* m_context = nullptr;
+    uint64_t m_frame = 0;
+};
+
+double drawDataBytes(const ImDrawData* drawData) {
+    double bytes = 0.0;
+    for (const ImDrawList* list : drawData->CmdLists) {
+        bytes += static_cast<double>(list->VtxBuffer.Size) * sizeof(ImDrawVert);
+        bytes += static_cast<double>(list->IdxBuffer.Size) * sizeof(ImDrawIdx);
+    }
+    return bytes;
+}
+
+} // namespace
+
+void runImGuiBenchmarks(BenchmarkRunner& runner) {
+    if (runner.isSelected("ImGui/hash_draw_data")) {
+        HeadlessImGui imgui;
+        // 前几帧完成字体纹理创建和窗口布局
+        for (int i = 0; i < 3; ++i) {
+            imgui.frame(false);
+        }
+        ImDrawData* drawData = imgui.frame(false);
+        runner.run("ImGui/hash_draw_data", [drawData](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(hashDrawData(drawData));
+            }
+        }, {drawDataBytes(drawData)});
+    }
+
+    const struct {
+        const char* name;
+        bool animated;
+    } modes[] = {
+        {"ImGui/frame_static", false},
+        {"ImGui/frame_animated", true},
+    };
+    for (const auto& mode : modes) {
+        if (!runner.isSelected(mode.name)) {
+            continue;
+        }
+        HeadlessImGui imgui;
+        UnchangedFrameFilter filter;
+        for (int i = 0; i < 3; ++i) {
+            filter.shouldSubmit(imgui.frame(mode.animated));
+        }
+        const uint64_t skippedBefore = filter.getSkippedFrameCount();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t frame = 0; frame < FRAMES; ++frame) {
+            doNotOptimize(filter.shouldSubmit(imgui.frame(mode.animated)));
+        }
+        const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        BenchmarkResult result;
+        result.name = mode.name;
+        result.iterations = FRAMES;
+        result.repetitions = 1;
+        result.nsPerOp = elapsed / static_cast<double>(FRAMES);
+        result.nsPerOpMin = result.nsPerOp;
+        result.nsPerOpMax = result.nsPerOp;
+        result.counters["skipped_pct"] =
+            100.0 * static_cast<double>(filter.getSkippedFrameCount() - skippedBefore) / static_cast<double>(FRAMES);
+        runner.record(std::move(result));
+    }
+}
+
+} // namespace Bench
+} // namespace DearTs
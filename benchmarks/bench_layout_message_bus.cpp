@@ -0,0 +1,161 @@
+/**
+ * @file bench_layout_message_bus.cpp
+ * @brief 布局消息总线基准：广播吞吐量和点对点发送延迟
+ * @details 64 个订阅者。对比改造前 LayoutManager 的消息机制（窗口ID -> (布局名称 -> 处理器) 的嵌套哈希表，
+ *          消息为字符串，广播时按布局名称逐个查找处理器）：
+ *          - broadcast：一条消息交给所有订阅者；
+ *          - send：按窗口ID和布局名称发送给单个布局，总线使用预先解析的端点；
+ *          - post_deliver：一帧内排队 16 条消息，下一帧统一投递；
+ *          - shared_payload：64KB 的不可变缓冲区交给所有订阅者，对比按值排队时每条消息复制一份。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "window/layouts/layout_message_bus.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Window::LayoutChannel;
+using Core::Window::LayoutEndpoint;
+using Core::Window::LayoutMessageBus;
+using Core::Window::MessageSubscription;
+using Core::Window::SharedPayload;
+using Core::Window::makeSharedPayload;
+
+namespace {
+
+constexpr size_t SUBSCRIBER_COUNT = 64;
+constexpr size_t QUEUED_PER_FRAME = 16;
+constexpr size_t PAYLOAD_BYTES = 64 * 1024;
+
+/**
+ * @brief 带类型的消息：列表选中项变化
+ */
+struct SelectionChanged {
+    uint32_t index;
+    float scrollOffset;
+};
+
+using LegacyHandler = std::function<void(const std::string&, const std::string&, const std::string&)>;
+
+std::string subscriberName(size_t index) {
+    return "Layout_" + std::to_string(index);
+}
+
+} // namespace
+
+void runLayoutMessageBusBenchmarks(BenchmarkRunner& runner) {
+    const std::string suffix = "_" + std::to_string(SUBSCRIBER_COUNT);
+    BenchmarkOptions broadcastOptions;
+    broadcastOptions.itemsPerOp = static_cast<double>(SUBSCRIBER_COUNT);
+
+    uint64_t sink = 0;
+
+    // 改造前：嵌套哈希表 + 布局名称列表，消息序列化为字符串
+    std::unordered_map<std::string, std::unordered_map<std::string, LegacyHandler>> legacyHandlers;
+    std::vector<std::string> legacyLayouts;
+    for (size_t i = 0; i < SUBSCRIBER_COUNT; ++i) {
+        legacyLayouts.push_back(subscriberName(i));
+        legacyHandlers["MainWindow"][subscriberName(i)] =
+            [&sink](const std::string&, const std::string&, const std::string& message) { sink += message.size(); };
+    }
+
+    LayoutMessageBus bus;
+    LayoutChannel<SelectionChanged>& selection = bus.channel<SelectionChanged>("selection");
+    std::vector<MessageSubscription> subscriptions;
+    for (size_t i = 0; i < SUBSCRIBER_COUNT; ++i) {
+        subscriptions.push_back(selection.subscribe(
+            [&sink](const SelectionChanged& message) { sink += message.index; }, subscriberName(i)));
+    }
+
+    runner.run("LayoutMessageBus/legacy_broadcast" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const std::string message = "selection:" + std::to_string(i % 1000) + ":0.5";
+            for (const std::string& layoutName : legacyLayouts) {
+                auto& handlers = legacyHandlers["MainWindow"];
+                auto handlerIt = handlers.find(layoutName);
+                if (handlerIt != handlers.end()) {
+                    handlerIt->second("MainWindow", "Sidebar", message);
+                }
+            }
+        }
+    }, broadcastOptions);
+
+    runner.run("LayoutMessageBus/broadcast" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            selection.publish(SelectionChanged{static_cast<uint32_t>(i % 1000), 0.5f});
+        }
+    }, broadcastOptions);
+
+    const std::string target = subscriberName(SUBSCRIBER_COUNT / 2);
+    runner.run("LayoutMessageBus/legacy_send", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const std::string message = "selection:" + std::to_string(i % 1000) + ":0.5";
+            auto windowIt = legacyHandlers.find("MainWindow");
+            auto handlerIt = windowIt->second.find(target);
+            handlerIt->second("MainWindow", "Sidebar", message);
+        }
+    });
+
+    const LayoutEndpoint<SelectionChanged> endpoint = selection.endpoint(target);
+    runner.run("LayoutMessageBus/endpoint_send", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            endpoint.send(SelectionChanged{static_cast<uint32_t>(i % 1000), 0.5f});
+        }
+    });
+
+    BenchmarkOptions queuedOptions;
+    queuedOptions.itemsPerOp = static_cast<double>(QUEUED_PER_FRAME * SUBSCRIBER_COUNT);
+    runner.run("LayoutMessageBus/post_deliver" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (size_t j = 0; j < QUEUED_PER_FRAME; ++j) {
+                selection.post(SelectionChanged{static_cast<uint32_t>(j), 0.5f});
+            }
+            doNotOptimize(bus.deliverQueued());
+        }
+    }, queuedOptions);
+
+    // 大负载：按值排队时每条消息复制一份，共享负载只增加引用计数
+    const std::vector<uint8_t> buffer(PAYLOAD_BYTES, 0x5A);
+    LayoutChannel<std::vector<uint8_t>>& copied = bus.channel<std::vector<uint8_t>>("buffer_copied");
+    LayoutChannel<SharedPayload<std::vector<uint8_t>>>& shared =
+        bus.channel<SharedPayload<std::vector<uint8_t>>>("buffer_shared");
+    for (size_t i = 0; i < SUBSCRIBER_COUNT; ++i) {
+        subscriptions.push_back(copied.subscribe(
+            [&sink](const std::vector<uint8_t>& message) { sink += message[0]; }));
+        subscriptions.push_back(shared.subscribe(
+            [&sink](const SharedPayload<std::vector<uint8_t>>& message) { sink += (*message)[0]; }));
+    }
+
+    BenchmarkOptions payloadOptions;
+    payloadOptions.bytesPerOp = static_cast<double>(PAYLOAD_BYTES * QUEUED_PER_FRAME);
+    runner.run("LayoutMessageBus/copied_payload_64KB", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (size_t j = 0; j < QUEUED_PER_FRAME; ++j) {
+                copied.post(buffer);
+            }
+            doNotOptimize(bus.deliverQueued());
+        }
+    }, payloadOptions);
+
+    const SharedPayload<std::vector<uint8_t>> payload = makeSharedPayload<std::vector<uint8_t>>(buffer);
+    runner.run("LayoutMessageBus/shared_payload_64KB", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (size_t j = 0; j < QUEUED_PER_FRAME; ++j) {
+                shared.post(payload);
+            }
+            doNotOptimize(bus.deliverQueued());
+        }
+    }, payloadOptions);
+
+    doNotOptimize(sink);
+}
+
+} // namespace Bench
+} // namespace DearTs
@@ -0,0 +1,262 @@
+/**
+ * @file bench_layout_registry.cpp
+ * @brief 布局注册表基准：每帧遍历布局和按名称查找的开销
+ * @details 512 个空布局放在同一窗口中，其中 2 个为系统布局。对比 LayoutRegistry 与改造前
+ *          LayoutManager 的存储方式（窗口ID -> (布局名称 -> 布局) 的嵌套哈希表，系统布局靠 std::find 比较名称）：
+ *          - update_scan：对所有可见布局调用 updateLayout，即窗口尺寸变化时的 LayoutManager::updateAll；
+ *          - update_invalid_scan：每帧只有 4 个布局失效，尺寸不变时 updateAll 只更新这些布局；
+ *          - system_render_scan：找出可见的系统布局，对应 LayoutManager::renderAll；
+ *          - lookup：API 边界按窗口ID和名称取布局；
+ *          - lookup_cached_handle：每帧取布局的地方缓存句柄，只校验句柄仍指向同一窗口中的同名布局；
+ *          - collect_by_priority：重建事件分发顺序；
+ *          - hit_test_scan / hit_test_grid：布局平铺在 1280x640 区域时，为一次鼠标移动找出指针下的布局，
+ *            对比逐个调用 hitTest() 与先查 LayoutHitGrid 再确认。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "window/layouts/layout_base.h"
+#include "window/layouts/layout_hit_grid.h"
+#include "window/layouts/layout_registry.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Window::LayoutBase;
+using Core::Window::LayoutHandle;
+using Core::Window::LayoutHitGrid;
+using Core::Window::LayoutPriority;
+using Core::Window::LayoutRegistry;
+
+namespace {
+
+constexpr size_t LAYOUT_COUNT = 512;
+constexpr size_t LOOKUPS_PER_OP = 64;
+
+/**
+ * @brief 只累计调用次数的布局
+ */
+class CountingLayout : public LayoutBase {
+public:
+    explicit CountingLayout(const std::string& name) : LayoutBase(name) {}
+
+    void render() override { ++renders; }
+    void updateLayout(float width, float height) override { updates += static_cast<uint64_t>(width + height); }
+    void handleEvent(const SDL_Event&) override {}
+
+    uint64_t renders = 0;
+    uint64_t updates = 0;
+};
+
+std::string layoutName(size_t index) {
+    switch (index) {
+        case 0: return "TitleBar";
+        case 1: return "Sidebar";
+        default: return "Layout_" + std::to_string(index);
+    }
+}
+
+/**
+ * @brief 改造前的存储方式
+ */
+struct LegacyLayouts {
+    std::unordered_map<std::string, std::unordered_map<std::string, std::unique_ptr<LayoutBase>>> windowLayouts;
+    std::unordered_map<std::string, std::vector<std::string>> systemLayoutNames;
+};
+
+void fillLegacy(LegacyLayouts& legacy) {
+    legacy.systemLayoutNames["MainWindow"] = {"TitleBar", "Sidebar"};
+    auto& layouts = legacy.windowLayouts["MainWindow"];
+    for (size_t i = 0; i < LAYOUT_COUNT; ++i) {
+        auto layout = std::make_unique<CountingLayout>(layoutName(i));
+        layout->setVisible(i % 4 != 3);
+        layouts[layoutName(i)] = std::move(layout);
+    }
+}
+
+LayoutRegistry::WindowIndex fillRegistry(LayoutRegistry& registry) {
+    const LayoutRegistry::WindowIndex window = registry.internWindow("MainWindow");
+    for (size_t i = 0; i < LAYOUT_COUNT; ++i) {
+        auto layout = std::make_unique<CountingLayout>(layoutName(i));
+        layout->setVisible(i % 4 != 3);
+        const LayoutPriority priority = i < 2 ? LayoutPriority::HIGH : static_cast<LayoutPriority>(i % 5 * 25);
+        registry.insert(window, registry.internName(layoutName(i)), std::move(layout), priority, i < 2);
+    }
+    return window;
+}
+
+std::vector<std::string> lookupNames() {
+    std::vector<std::string> names;
+    names.reserve(LOOKUPS_PER_OP);
+    for (size_t i = 0; i < LOOKUPS_PER_OP; ++i) {
+        names.push_back(layoutName(i * 7 % LAYOUT_COUNT));
+    }
+    return names;
+}
+
+} // namespace
+
+void runLayoutRegistryBenchmarks(BenchmarkRunner& runner) {
+    std::string suffix = "_";
+    suffix += std::to_string(LAYOUT_COUNT);
+    BenchmarkOptions scanOptions;
+    scanOptions.itemsPerOp = static_cast<double>(LAYOUT_COUNT);
+
+    LegacyLayouts legacy;
+    fillLegacy(legacy);
+    LayoutRegistry registry;
+    const LayoutRegistry::WindowIndex window = fillRegistry(registry);
+
+    runner.run("LayoutRegistry/legacy_update_scan" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            auto windowIt = legacy.windowLayouts.find("MainWindow");
+            for (auto& [name, layout] : windowIt->second) {
+                if (layout && layout->isVisible()) {
+                    layout->updateLayout(1280.0f, 720.0f);
+                }
+            }
+        }
+    }, scanOptions);
+
+    runner.run("LayoutRegistry/update_scan" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const LayoutRegistry::WindowIndex target = registry.findWindow("MainWindow");
+            registry.forEach(target, LayoutRegistry::FLAG_VISIBLE, [](LayoutHandle, LayoutBase& layout) {
+                layout.updateLayout(1280.0f, 720.0f);
+            });
+        }
+    }, scanOptions);
+
+    // 每帧使少量布局失效（内容变化、动画），其余布局不做任何工作
+    std::vector<LayoutBase*> animated;
+    registry.forEach(window, LayoutRegistry::FLAG_VISIBLE, [&](LayoutHandle, LayoutBase& layout) {
+        layout.refreshLayout(1280.0f, 720.0f);
+        if (animated.size() < 4) {
+            animated.push_back(&layout);
+        }
+    });
+    runner.run("LayoutRegistry/update_invalid_scan" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (LayoutBase* layout : animated) {
+                layout->invalidateLayout();
+            }
+            registry.forEach(window, LayoutRegistry::FLAG_VISIBLE | LayoutRegistry::FLAG_NEEDS_UPDATE,
+                             [](LayoutHandle, LayoutBase& layout) { layout.refreshLayout(1280.0f, 720.0f); });
+        }
+    }, scanOptions);
+
+    runner.run("LayoutRegistry/legacy_system_render_scan" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            auto windowIt = legacy.windowLayouts.find("MainWindow");
+            const auto& systemLayouts = legacy.systemLayoutNames["MainWindow"];
+            for (const auto& [name, layout] : windowIt->second) {
+                if (layout && layout->isVisible()) {
+                    bool isSystemLayout = std::find(systemLayouts.begin(), systemLayouts.end(), name) != systemLayouts.end();
+                    if (isSystemLayout) {
+                        layout->render();
+                    }
+                }
+            }
+        }
+    }, scanOptions);
+
+    runner.run("LayoutRegistry/system_render_scan" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const LayoutRegistry::WindowIndex target = registry.findWindow("MainWindow");
+            registry.forEach(target, LayoutRegistry::FLAG_VISIBLE | LayoutRegistry::FLAG_SYSTEM,
+                             [](LayoutHandle, LayoutBase& layout) { layout.render(); });
+        }
+    }, scanOptions);
+
+    const std::vector<std::string> names = lookupNames();
+    BenchmarkOptions lookupOptions;
+    lookupOptions.itemsPerOp = static_cast<double>(LOOKUPS_PER_OP);
+
+    runner.run("LayoutRegistry/legacy_lookup", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (const std::string& name : names) {
+                auto windowIt = legacy.windowLayouts.find("MainWindow");
+                auto layoutIt = windowIt->second.find(name);
+                doNotOptimize(layoutIt->second.get());
+            }
+        }
+    }, lookupOptions);
+
+    runner.run("LayoutRegistry/lookup", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (const std::string& name : names) {
+                doNotOptimize(registry.get(registry.find("MainWindow", name)));
+            }
+        }
+    }, lookupOptions);
+
+    std::vector<LayoutHandle> cachedHandles;
+    for (const std::string& name : names) {
+        cachedHandles.push_back(registry.find(window, registry.findName(name)));
+    }
+    const std::string windowId = "MainWindow";
+    runner.run("LayoutRegistry/lookup_cached_handle", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (size_t j = 0; j < names.size(); ++j) {
+                if (registry.matches(cachedHandles[j], windowId, names[j])) {
+                    doNotOptimize(registry.get(cachedHandles[j]));
+                }
+            }
+        }
+    }, lookupOptions);
+
+    std::vector<LayoutHandle> order;
+    runner.run("LayoutRegistry/collect_by_priority" + suffix, [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            registry.collectByPriority(window, order);
+            doNotOptimize(order.data());
+        }
+    }, scanOptions);
+
+    // 布局按分发顺序平铺成 32 x 16 个 40x40 的格子，鼠标在区域内移动
+    for (size_t i = 0; i < order.size(); ++i) {
+        LayoutBase* layout = registry.get(order[i]);
+        layout->setPosition(static_cast<float>(i % 32) * 40.0f, static_cast<float>(i / 32) * 40.0f);
+        layout->setSize(40.0f, 40.0f);
+    }
+    std::vector<std::pair<float, float>> pointers;
+    for (size_t i = 0; i < LOOKUPS_PER_OP; ++i) {
+        pointers.emplace_back(static_cast<float>(i * 97 % 1280), static_cast<float>(i * 53 % 640));
+    }
+
+    runner.run("LayoutRegistry/hit_test_scan", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& [x, y] : pointers) {
+                for (const LayoutHandle handle : order) {
+                    if (registry.hasFlags(handle, LayoutRegistry::FLAG_VISIBLE) && registry.get(handle)->hitTest(x, y)) {
+                        doNotOptimize(handle);
+                    }
+                }
+            }
+        }
+    }, lookupOptions);
+
+    LayoutHitGrid grid;
+    grid.rebuild(registry, order);
+    runner.run("LayoutRegistry/hit_test_grid", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            for (const auto& [x, y] : pointers) {
+                for (const uint32_t index : grid.query(x, y)) {
+                    const LayoutHandle handle = order[index];
+                    if (registry.get(handle)->hitTest(x, y)) {
+                        doNotOptimize(handle);
+                    }
+                }
+            }
+        }
+    }, lookupOptions);
+}
+
+} // namespace Bench
+} // namespace DearTs
@@ -0,0 +1,205 @@
+/**
+ * @file bench_logger.cpp
+ * @brief Logger 基准：过滤开销、单线程与多线程写文件吞吐量
+ * @details 多线程基准的 ns/op 是所有线程合计的墙钟时间除以记录总数（含最后一次 flush），
+ *          即整体吞吐量的倒数。
+ *          filtered_frame 按 GUIApplication::run 每帧的日志调用（均低于当前级别）重放一帧，
+ *          filtered_frame_eager 以改用 DEARTS_LOG_* 宏之前的写法（先拼接消息）重放同样的调用作为对照；
+ *          以 DEARTS_TRACK_ALLOCATIONS 构建时 allocs/op 即每帧的堆分配次数，前者应为 0
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "utils/logger.h"
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace DearTs {
+namespace Bench {
+
+using Utils::LogFileFormat;
+using Utils::LogLevel;
+using Utils::Logger;
+
+namespace {
+
+// GUIApplication::run 每帧（无输入事件、一个窗口、内容布局可见）的日志调用，全部低于 INFO：
+// processSDLEvents 和 update 各调用一次 WindowManager::hasWindowsToClose，
+// 每次记录开始、每个窗口一条、结果；MainWindow::render 记录 6 条
+constexpr int FRAME_WINDOW_COUNT = 1;
+constexpr int FRAME_WINDOW_CHECKS = 2;
+constexpr int FRAME_LOGS_PER_WINDOW_CHECK = 2 + FRAME_WINDOW_COUNT;
+constexpr int FRAME_MAIN_WINDOW_RENDER_LOGS = 6;
+constexpr double FRAME_LOG_CALLS = FRAME_WINDOW_CHECKS * FRAME_LOGS_PER_WINDOW_CHECK + FRAME_MAIN_WINDOW_RENDER_LOGS;
+
+/**
+ * @brief 当前写法：重放 WindowManager::hasWindowsToClose 的日志调用，参数与原调用点相同
+ */
+void replayWindowCheckLogs(int windowId, bool shouldClose) {
+    DEARTS_LOG_DEBUG("Checking hasWindowsToClose, window count: {}", static_cast<size_t>(FRAME_WINDOW_COUNT));
+    DEARTS_LOG_DEBUG("Window ID {} shouldClose: {}", windowId, shouldClose);
+    DEARTS_LOG_DEBUG("hasWindowsToClose result: {}", shouldClose);
+}
+
+/**
+ * @brief 当前写法：重放 GUIApplication::run 一帧的日志调用
+ */
+void replayFrameLogs(int windowId, const std::string& windowName, const std::string& currentLayout, bool visible) {
+    for (int check = 0; check < FRAME_WINDOW_CHECKS; ++check) {
+        replayWindowCheckLogs(windowId, false);
+    }
+
+    // MainWindow::render
+    DEARTS_LOG_TRACE("MainWindow::render 开始 - 使用窗口ID: {}", windowName);
+    DEARTS_LOG_TRACE("MainWindow渲染 - 当前布局: {} (窗口ID: {})", currentLayout.empty() ? "无" : currentLayout,
+                     windowName);
+    DEARTS_LOG_TRACE("布局存在: {} 可见性: {}", currentLayout, visible ? "可见" : "隐藏");
+    DEARTS_LOG_TRACE("开始渲染固定内容区域 - 布局: {}", currentLayout);
+    DEARTS_LOG_TRACE("调用renderInFixedArea - 布局: {}", currentLayout);
+    DEARTS_LOG_TRACE("renderInFixedArea完成 - 布局: {}", currentLayout);
+}
+
+/**
+ * @brief 旧写法：同样的调用点和级别，先拼接消息再交给 Logger 检查级别（改用 DEARTS_LOG_* 宏之前的行为）
+ */
+void replayFrameLogsEager(int windowId, const std::string& windowName, const std::string& currentLayout, bool visible) {
+    Logger& logger = Logger::getInstance();
+    for (int check = 0; check < FRAME_WINDOW_CHECKS; ++check) {
+        const bool shouldClose = false;
+        logger.debug("Checking hasWindowsToClose, window count: " + std::to_string(FRAME_WINDOW_COUNT), __FILE__, __LINE__);
+        logger.debug("Window ID " + std::to_string(windowId) + " shouldClose: " + std::to_string(shouldClose),
+                     __FILE__, __LINE__);
+        logger.debug("hasWindowsToClose result: " + std::to_string(shouldClose), __FILE__, __LINE__);
+    }
+
+    logger.trace("MainWindow::render 开始 - 使用窗口ID: " + windowName, __FILE__, __LINE__);
+    logger.trace("MainWindow渲染 - 当前布局: " + (currentLayout.empty() ? "无" : currentLayout) + " (窗口ID: " +
+                 windowName + ")", __FILE__, __LINE__);
+    logger.trace("布局存在: " + currentLayout + " 可见性: " + std::string(visible ? "可见" : "隐藏"), __FILE__, __LINE__);
+    logger.trace("开始渲染固定内容区域 - 布局: " + currentLayout, __FILE__, __LINE__);
+    logger.trace("调用renderInFixedArea - 布局: " + currentLayout, __FILE__, __LINE__);
+    logger.trace("renderInFixedArea完成 - 布局: " + currentLayout, __FILE__, __LINE__);
+}
+
+/**
+ * @brief 在 threadCount 个线程中共写入 iterations 条记录，结束后等待落盘
+ * @param concatenate 为 true 时按旧写法由调用方拼接同样的消息（同样的参数）后写入
+ */
+void logFromThreads(uint64_t iterations, unsigned threadCount, bool concatenate = false) {
+    auto produce = [concatenate](uint64_t count, unsigned thread) {
+        const double elapsedMs = 1.5;
+        const std::string status = "ok";
+        if (concatenate) {
+            for (uint64_t i = 0; i < count; ++i) {
+                DEARTS_LOG_INFO("线程 " + std::to_string(thread) + " 第 " + std::to_string(i) + " 条记录，耗时 " +
+                                std::to_string(elapsedMs) + " ms，状态 " + status);
+            }
+        } else {
+            for (uint64_t i = 0; i < count; ++i) {
+                DEARTS_LOG_INFO("线程 {} 第 {} 条记录，耗时 {} ms，状态 {}", thread, i, elapsedMs, status);
+            }
+        }
+        Logger::getInstance().flush();
+    };
+
+    if (threadCount == 1) {
+        produce(iterations, 0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (unsigned t = 0; t < threadCount; ++t) {
+        const uint64_t count = iterations / threadCount + (t < iterations % threadCount ? 1 : 0);
+        threads.emplace_back(produce, count, t);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+void runLoggerBenchmarks(BenchmarkRunner& runner) {
+    namespace fs = std::filesystem;
+
+    Logger& logger = Logger::getInstance();
+    const LogLevel previousLevel = logger.getLevel();
+    logger.setLevel(LogLevel::LOG_INFO);
+
+    // 低于当前级别的调用应当只有一次原子读取
+    runner.run("Logger/filtered", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            DEARTS_LOG_DEBUG("被过滤的记录 {} {}", i, 2.5);
+        }
+    });
+
+    // 一帧的全部日志调用都被过滤：当前写法不应分配内存，旧写法每条消息都先拼接字符串
+    const int windowId = 1;
+    const std::string windowName = "Window_1";
+    const std::string currentLayout = "ClipboardHelperLayout";
+    BenchmarkOptions frameOptions;
+    frameOptions.counters["log_calls_per_frame"] = FRAME_LOG_CALLS;
+    runner.run("Logger/filtered_frame", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            replayFrameLogs(windowId, windowName, currentLayout, true);
+        }
+    }, frameOptions);
+    runner.run("Logger/filtered_frame_eager", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            replayFrameLogsEager(windowId, windowName, currentLayout, true);
+        }
+    }, frameOptions);
+
+    const fs::path root = fs::temp_directory_path() / "dearts_bench_logs";
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+
+    logger.setConsoleOutput(false);
+
+    logger.setFileFormat(LogFileFormat::TEXT);
+    logger.enableFileOutput((root / "bench.log").string());
+
+    // 延迟格式化：生产者只编码参数，不构造字符串
+    runner.run("Logger/text_deferred", [](uint64_t iterations) {
+        logFromThreads(iterations, 1);
+    }, {0.0, 1.0});
+
+    // 旧写法：调用方用同样的参数拼接出消息后再写入
+    runner.run("Logger/text_concatenated", [](uint64_t iterations) {
+        logFromThreads(iterations, 1, true);
+    }, {0.0, 1.0});
+
+    const unsigned contendedThreads[] = {2, 4, 8};
+    for (const unsigned threads : contendedThreads) {
+        runner.run("Logger/text_contended_" + std::to_string(threads) + "_threads", [threads](uint64_t iterations) {
+            logFromThreads(iterations, threads);
+        }, {0.0, 1.0});
+    }
+
+    logger.enableFileOutput("", false);
+
+    logger.setFileFormat(LogFileFormat::BINARY);
+    logger.enableFileOutput((root / "bench.dlog").string());
+
+    runner.run("Logger/binary_deferred", [](uint64_t iterations) {
+        logFromThreads(iterations, 1);
+    }, {0.0, 1.0});
+
+    runner.run("Logger/binary_contended_4_threads", [](uint64_t iterations) {
+        logFromThreads(iterations, 4);
+    }, {0.0, 1.0});
+
+    logger.enableFileOutput("", false);
+    logger.setFileFormat(LogFileFormat::TEXT);
+    logger.setConsoleOutput(true);
+    logger.setLevel(previousLevel);
+
+    fs::remove_all(root, ec);
+}
+
+} // namespace Bench
+} // namespace DearTs
@@ -0,0 +1,116 @@
+/**
+ * @file bench_main.cpp
+ * @brief dearts_bench 入口
+ * @details 用法：dearts_bench [--filter 子串] [--json 输出路径|-] [--corpus 语料目录]
+ *                             [--min-time 毫秒] [--repetitions 轮数]
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "utils/logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+
+#ifndef DEARTS_BENCH_CORPUS_DIR
+#define DEARTS_BENCH_CORPUS_DIR "corpus"
+#endif
+
+namespace {
+
+void printUsage() {
+    std::printf("用法: dearts_bench [选项]\n"
+                "  --filter <子串>       只运行名称包含该子串的基准\n"
+                "  --json <路径|->       把结果以 JSON 格式写入文件（- 表示标准输出）\n"
+                "  --corpus <目录>       语料目录（默认 %s）\n"
+                "  --min-time <毫秒>     每轮最短运行时间（默认 200）\n"
+                "  --repetitions <轮数>  每个基准的轮数，取中位数（默认 3）\n",
+                DEARTS_BENCH_CORPUS_DIR);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace DearTs::Bench;
+
+    std::string filter;
+    std::string jsonPath;
+    std::string corpusDirectory = DEARTS_BENCH_CORPUS_DIR;
+    long minTimeMs = 200;
+    long repetitions = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(arg, "--corpus") == 0 && hasValue) {
+            corpusDirectory = argv[++i];
+        } else if (std::strcmp(arg, "--min-time") == 0 && hasValue) {
+            minTimeMs = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--repetitions") == 0 && hasValue) {
+            repetitions = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage();
+            return 0;
+        } else {
+            std::fprintf(stderr, "未知参数: %s\n", arg);
+            printUsage();
+            return 2;
+        }
+    }
+
+    // 被测代码中的 INFO/DEBUG 日志会干扰计时，只保留警告及以上
+    DearTs::Utils::Logger::getInstance().setLevel(DearTs::Utils::LogLevel::LOG_WARN);
+
+    BenchmarkRunner runner(corpusDirectory);
+    runner.setFilter(filter);
+    runner.setMinTime(std::chrono::milliseconds(minTimeMs > 0 ? minTimeMs : 1));
+    runner.setRepetitions(static_cast<uint32_t>(repetitions > 0 ? repetitions : 1));
+    if (jsonPath == "-") {
+        // JSON 占用标准输出时，逐条结果改写到标准错误
+        runner.setProgressOutput(stderr);
+    }
+
+    try {
+        runStringUtilsBenchmarks(runner);
+        runFileUtilsBenchmarks(runner);
+        runTextBenchmarks(runner);
+        runClipboardBenchmarks(runner);
+        runLoggerBenchmarks(runner);
+        runEventBenchmarks(runner);
+        runEventManagerBenchmarks(runner);
+        runTaskSchedulerBenchmarks(runner);
+        runCoroutineTaskBenchmarks(runner);
+        runLayoutRegistryBenchmarks(runner);
+        runLayoutMessageBusBenchmarks(runner);
+        runFramePacerBenchmarks(runner);
+        runImGuiBenchmarks(runner);
+        runRenderBatchBenchmarks(runner);
+        runAtlasBenchmarks(runner);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "基准运行失败: %s\n", e.what());
+        return 1;
+    }
+
+    if (!jsonPath.empty()) {
+        const std::string json = runner.toJson();
+        if (jsonPath == "-") {
+            std::fwrite(json.data(), 1, json.size(), stdout);
+        } else {
+            std::ofstream output(jsonPath, std::ios::binary | std::ios::trunc);
+            if (!output.is_open()) {
+                std::fprintf(stderr, "无法写入 %s\n", jsonPath.c_str());
+                return 1;
+            }
+            output.write(json.data(), static_cast<std::streamsize>(json.size()));
+            std::printf("结果已写入 %s\n", jsonPath.c_str());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file bench_string_utils.cpp
+ * @brief StringUtils 基准：分割、替换、查找、编辑距离
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "utils/string_utils.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Utils::StringReplaceOptions;
+using Core::Utils::StringSplitOptions;
+using Core::Utils::StringUtils;
+
+void runStringUtilsBenchmarks(BenchmarkRunner& runner) {
+    const std::string& text = runner.corpus("mixed_cjk_latin.txt");
+    const std::vector<std::string>& lines = runner.corpusLines("mixed_cjk_latin.txt");
+    const double textBytes = static_cast<double>(text.size());
+
+    runner.run("StringUtils/split_lines", [&text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::split(text, "\n"));
+        }
+    }, {textBytes, static_cast<double>(lines.size())});
+
+    runner.run("StringUtils/split_words", [&text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::split(text, " "));
+        }
+    }, {textBytes});
+
+    runner.run("StringUtils/split_regex", [&text](uint64_t iterations) {
+        StringSplitOptions options;
+        options.use_regex = true;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::split(text, "[，。！？.!?]", options));
+        }
+    }, {textBytes});
+
+    runner.run("StringUtils/replace_cjk", [&text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::replace(text, "日志", "记录"));
+        }
+    }, {textBytes});
+
+    runner.run("StringUtils/replace_ignore_case", [&text](uint64_t iterations) {
+        StringReplaceOptions options;
+        options.case_sensitive = false;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::replace(text, "RENDER", "draw", options));
+        }
+    }, {textBytes});
+
+    // 查找语料末尾附近的内容，扫描几乎整段文本
+    const std::string needle = lines.back().substr(0, std::min<size_t>(24, lines.back().size()));
+    runner.run("StringUtils/find", [&text, &needle](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::find(text, needle));
+        }
+    }, {textBytes});
+
+    runner.run("StringUtils/find_ignore_case", [&text, &needle](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::find(text, needle, 0, true));
+        }
+    }, {textBytes});
+
+    runner.run("StringUtils/find_all", [&text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(StringUtils::findAll(text, "the"));
+        }
+    }, {textBytes});
+
+    // 相邻两行前 200 字节之间的编辑距离
+    std::vector<std::string> prefixes;
+    prefixes.reserve(lines.size());
+    for (const std::string& line : lines) {
+        prefixes.push_back(line.substr(0, 200));
+    }
+    runner.run("StringUtils/edit_distance", [&prefixes](uint64_t iterations) {
+        const size_t count = prefixes.size() - 1;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const size_t index = static_cast<size_t>(i % count);
+            doNotOptimize(StringUtils::editDistance(prefixes[index], prefixes[index + 1]));
+        }
+    });
+}
+
+} // namespace Bench
+} // namespace DearTs
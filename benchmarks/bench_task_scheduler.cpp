@@ -0,0 +1,148 @@
+/**
+ * @file bench_task_scheduler.cpp
+ * @brief 任务调度器基准：提交-等待往返延迟，扇出小任务的吞吐量（对照每个任务一个 std::async），
+ *        工作线程内嵌套提交（本地队列与窃取），以及主线程续体的投递开销
+ * @details fan_out_N / std_async_fan_out_N 每次操作提交 N 个小任务并等待全部完成；
+ *          nested_fan_out 由一个任务在工作线程内提交子任务并等待，子任务进入本地队列，空闲线程窃取。
+ *          多核下的伸缩性受可用核心数限制，hardware_threads 计数器记录测量时的核心数。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "app/task_scheduler.h"
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace DearTs {
+namespace Bench {
+
+using Core::App::TaskContext;
+using Core::App::TaskHandle;
+using Core::App::TaskPriority;
+using Core::App::TaskScheduler;
+
+namespace {
+
+constexpr size_t FAN_OUT = 256;
+
+/**
+ * @brief 模拟任务内的少量计算
+ */
+uint64_t taskWork(uint64_t value) {
+    uint64_t hash = value;
+    for (int i = 0; i < 64; ++i) {
+        hash = (hash ^ (hash >> 31)) * 0x9E3779B97F4A7C15ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+void runTaskSchedulerBenchmarks(BenchmarkRunner& runner) {
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    scheduler.initialize();
+
+    BenchmarkOptions poolOptions;
+    poolOptions.counters["workers"] = static_cast<double>(scheduler.getWorkerCount());
+    poolOptions.counters["hardware_threads"] = std::thread::hardware_concurrency();
+
+    runner.run("TaskScheduler/submit_wait", [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            auto task = scheduler.submit([i]() { return taskWork(i); });
+            doNotOptimize(task.get());
+        }
+    }, poolOptions);
+
+    BenchmarkOptions fanOutOptions = poolOptions;
+    fanOutOptions.itemsPerOp = FAN_OUT;
+
+    runner.run("TaskScheduler/fan_out_" + std::to_string(FAN_OUT), [&scheduler](uint64_t iterations) {
+        std::vector<TaskHandle<uint64_t>> tasks;
+        tasks.reserve(FAN_OUT);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            tasks.clear();
+            for (size_t t = 0; t < FAN_OUT; ++t) {
+                tasks.push_back(scheduler.submit([t]() { return taskWork(t); }));
+            }
+            uint64_t sum = 0;
+            for (auto& task : tasks) {
+                sum += task.get();
+            }
+            doNotOptimize(sum);
+        }
+    }, fanOutOptions);
+
+    runner.run("TaskScheduler/std_async_fan_out_" + std::to_string(FAN_OUT), [](uint64_t iterations) {
+        std::vector<std::future<uint64_t>> futures;
+        futures.reserve(FAN_OUT);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            futures.clear();
+            for (size_t t = 0; t < FAN_OUT; ++t) {
+                futures.push_back(std::async(std::launch::async, [t]() { return taskWork(t); }));
+            }
+            uint64_t sum = 0;
+            for (auto& future : futures) {
+                sum += future.get();
+            }
+            doNotOptimize(sum);
+        }
+    }, fanOutOptions);
+
+    runner.run("TaskScheduler/nested_fan_out_" + std::to_string(FAN_OUT), [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            auto parent = scheduler.submit([&scheduler]() {
+                std::vector<TaskHandle<uint64_t>> children;
+                children.reserve(FAN_OUT);
+                for (size_t t = 0; t < FAN_OUT; ++t) {
+                    children.push_back(scheduler.submit([t]() { return taskWork(t); }, TaskPriority::HIGH));
+                }
+                uint64_t sum = 0;
+                for (auto& child : children) {
+                    sum += child.get();
+                }
+                return sum;
+            });
+            doNotOptimize(parent.get());
+        }
+    }, fanOutOptions);
+
+    runner.run("TaskScheduler/continuation_" + std::to_string(FAN_OUT), [&scheduler](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            size_t completed = 0;
+            for (size_t t = 0; t < FAN_OUT; ++t) {
+                scheduler.submit([t](TaskContext&) { return taskWork(t); })
+                    .then([&completed](uint64_t& value) {
+                        doNotOptimize(value);
+                        ++completed;
+                    });
+            }
+            while (completed < FAN_OUT) {
+                if (scheduler.runMainThreadContinuations() == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }, fanOutOptions);
+
+    // 以上基准累计的调度器统计：ns/op 为任务从提交到开始执行的平均等待
+    const auto metrics = scheduler.getMetrics();
+    if (metrics.submitted > 0 && runner.isSelected("TaskScheduler/queue_latency")) {
+        BenchmarkResult result;
+        result.name = "TaskScheduler/queue_latency";
+        result.iterations = metrics.completed;
+        result.repetitions = 1;
+        result.nsPerOp = metrics.avgLatencyUs * 1000.0;
+        result.nsPerOpMin = result.nsPerOp;
+        result.nsPerOpMax = metrics.maxLatencyUs * 1000.0;
+        result.counters["workers"] = static_cast<double>(metrics.workers);
+        result.counters["steals"] = static_cast<double>(metrics.steals);
+        result.counters["max_queue_depth"] = static_cast<double>(metrics.maxQueueDepth);
+        result.counters["avg_run_us"] = metrics.avgRunUs;
+        runner.record(std::move(result));
+    }
+}
+
+} // namespace Bench
+} // namespace DearTs
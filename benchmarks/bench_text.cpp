@@ -0,0 +1,98 @@
+/**
+ * @file bench_text.cpp
+ * @brief 文本处理基准：TextSegmenter 各分词方法与 UrlExtractor
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "bench.h"
+#include "clipboard/text_segmenter.h"
+#include "clipboard/url_extractor.h"
+
+namespace DearTs {
+namespace Bench {
+
+using Core::Window::Widgets::Clipboard::TextSegmenter;
+using Core::Window::Widgets::Clipboard::UrlExtractor;
+
+void runTextBenchmarks(BenchmarkRunner& runner) {
+    const std::vector<std::string>& lines = runner.corpusLines("mixed_cjk_latin.txt");
+    const std::string& text = runner.corpus("mixed_cjk_latin.txt");
+
+    // 剪切板条目通常是一两行文本，按行轮流分词；整段语料单独测一次
+    double averageLineBytes = 0.0;
+    for (const std::string& line : lines) {
+        averageLineBytes += static_cast<double>(line.size());
+    }
+    averageLineBytes /= static_cast<double>(lines.size());
+
+    TextSegmenter segmenter;
+    segmenter.initialize();
+
+    // 正则分词的耗时随输入长度超线性增长，整段语料单次要数十秒，只取开头约 4KB（按行截断）
+    std::string regexText;
+    for (const std::string& line : lines) {
+        if (regexText.size() + line.size() > 4096) {
+            break;
+        }
+        regexText += line;
+        regexText += '\n';
+    }
+
+    const struct {
+        const char* name;
+        TextSegmenter::Method method;
+        const std::string* corpusText;
+    } methods[] = {
+        {"simple", TextSegmenter::Method::SIMPLE_SPLIT, &text},
+        {"regex", TextSegmenter::Method::REGEX_BASED, &regexText},
+        {"mixed", TextSegmenter::Method::MIXED_MODE, &text},
+    };
+
+    for (const auto& entry : methods) {
+        const TextSegmenter::Method method = entry.method;
+        runner.run(std::string("TextSegmenter/") + entry.name + "_line", [&segmenter, &lines, method](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(segmenter.segmentText(lines[static_cast<size_t>(i % lines.size())], method));
+            }
+        }, {averageLineBytes});
+
+        const std::string& corpusText = *entry.corpusText;
+        runner.run(std::string("TextSegmenter/") + entry.name + "_corpus", [&segmenter, &corpusText, method](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(segmenter.segmentText(corpusText, method));
+            }
+        }, {static_cast<double>(corpusText.size())});
+    }
+
+    const std::vector<std::string>& urlLines = runner.corpusLines("urls.txt");
+    const std::string& urlText = runner.corpus("urls.txt");
+    double averageUrlLineBytes = 0.0;
+    for (const std::string& line : urlLines) {
+        averageUrlLineBytes += static_cast<double>(line.size());
+    }
+    averageUrlLineBytes /= static_cast<double>(urlLines.size());
+
+    UrlExtractor extractor;
+    runner.run("UrlExtractor/extract_line", [&extractor, &urlLines](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(extractor.extractUrls(urlLines[static_cast<size_t>(i % urlLines.size())]));
+        }
+    }, {averageUrlLineBytes});
+
+    runner.run("UrlExtractor/extract_corpus", [&extractor, &urlText](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(extractor.extractUrls(urlText));
+        }
+    }, {static_cast<double>(urlText.size())});
+
+    // 不含 URL 的文本：衡量没有命中时的扫描开销
+    runner.run("UrlExtractor/extract_no_match", [&extractor, &text](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            doNotOptimize(extractor.extractUrls(text));
+        }
+    }, {static_cast<double>(text.size())});
+}
+
+} // namespace Bench
+} // namespace DearTs
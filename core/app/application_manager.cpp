@@ -13,6 +13,7 @@
 #include "../core.h"
 #include "../utils/string_utils.h"
 #include "../utils/file_utils.h"
+#include "../window/layouts/layout_manager.h"
 #include <SDL.h>
 #include <imgui.h>
 #include <imgui_impl_sdl2.h>
@@ -23,6 +24,8 @@
 #include <filesystem>
 #include <thread>
 #include <csignal>
+#include <cstdio>
+#include <cstdlib>
 
 #ifdef DEARTS_PLATFORM_WINDOWS
     #include <windows.h>
@@ -153,6 +156,7 @@ Application::Application()
     , m_shouldExit(false)
     , m_exitCode(0)
     , m_fpsFrameCount(0)
+    , m_lastAllocationCount(0)
     , m_configManager(nullptr)
     , m_profiler(nullptr) {
 
@@ -179,6 +183,7 @@ bool Application::initialize(const ApplicationConfig& config) {
 
     m_state = ApplicationState::INITIALIZING;
     m_config = config;
+    applyFramePacing();
     
     DEARTS_LOG_INFO("🔧 正在初始化应用程序: " + m_config.name);
     
@@ -228,8 +233,7 @@ void DearTs::Core::App::Application::shutdown() {
 }
 
 void DearTs::Core::App::Application::update(double delta_time) {
-    if (m_profiler) {
-    }
+    DEARTS_PROFILE_SCOPE("Application::update");
 
     auto& plugin_manager = PluginManager::getInstance();
     plugin_manager.updateAllPlugins(delta_time);
@@ -239,8 +243,7 @@ void DearTs::Core::App::Application::update(double delta_time) {
 }
 
 void DearTs::Core::App::Application::render() {
-    if (m_profiler) {
-    }
+    DEARTS_PROFILE_SCOPE("Application::render");
 
     auto& window_manager = Window::WindowManager::getInstance();
     window_manager.renderAllWindows();
@@ -301,6 +304,7 @@ void DearTs::Core::App::Application::resume() {
 
 void DearTs::Core::App::Application::setConfig(const ApplicationConfig& config) {
     m_config = config;
+    applyFramePacing();
 
     if (m_configManager) {
     }
@@ -320,6 +324,10 @@ void DearTs::Core::App::Application::loadConfig(const std::string& file_path) {
         m_config.version = m_configManager->getValue<std::string>("app.version", m_config.version);
         m_config.target_fps = m_configManager->getValue<uint32_t>("app.target_fps", m_config.target_fps);
         m_config.enable_vsync = m_configManager->getValue<bool>("app.enable_vsync", m_config.enable_vsync);
+        m_config.enable_idle_wait = m_configManager->getValue<bool>("app.enable_idle_wait", m_config.enable_idle_wait);
+        m_config.idle_refresh_ms = m_configManager->getValue<uint32_t>("app.idle_refresh_ms", m_config.idle_refresh_ms);
+        FrameScheduler::getInstance().configure(m_config.enable_idle_wait, m_config.idle_refresh_ms);
+        applyFramePacing();
         
         DEARTS_LOG_INFO("Config loaded from: " + file_path);
     } else {
@@ -338,6 +346,8 @@ void DearTs::Core::App::Application::saveConfig(const std::string& file_path) {
     m_configManager->setValue("app.version", m_config.version);
     m_configManager->setValue("app.target_fps", m_config.target_fps);
     m_configManager->setValue("app.enable_vsync", m_config.enable_vsync);
+    m_configManager->setValue("app.enable_idle_wait", m_config.enable_idle_wait);
+    m_configManager->setValue("app.idle_refresh_ms", m_config.idle_refresh_ms);
     
     m_configManager->saveToFile(file_path);
     std::ostringstream oss;
@@ -362,10 +372,24 @@ void DearTs::Core::App::Application::initializeSubsystems() {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) != 0) {
         throw std::runtime_error("Failed to initialize SDL: " + std::string(SDL_GetError()));
     }
+
+    // 空闲时主循环阻塞等待事件，而不是按目标帧率重绘
+    FrameScheduler::getInstance().configure(m_config.enable_idle_wait, m_config.idle_refresh_ms);
     
     // 初始化事件系统
     auto event_system = DearTs::Core::Events::EventSystem::getInstance();
     event_system->initialize();
+    // 其他线程投递延迟事件时唤醒空闲等待中的主循环
+    event_system->getQueue().setWakeCallback([]() {
+        FrameScheduler::getInstance().wakeUp();
+    });
+
+    // 启动后台任务调度器；任务完成回调排队时同样唤醒主循环
+    auto& task_scheduler = TaskScheduler::getInstance();
+    task_scheduler.setWakeCallback([]() {
+        FrameScheduler::getInstance().wakeUp();
+    });
+    task_scheduler.initialize();
     
     // 初始化窗口管理器
     auto& window_manager = DearTs::Core::Window::WindowManager::getInstance();
@@ -376,13 +400,19 @@ void DearTs::Core::App::Application::initializeSubsystems() {
     // 初始化配置管理器
     m_configManager = &Utils::ConfigManager::getInstance();
 
-    // 初始化性能分析器
-    if (m_config.enable_profiling) {
-        m_profiler = &Utils::Profiler::getInstance();
-        m_profiler->initialize();
-    } else {
-        m_profiler = nullptr;
+    // 初始化性能分析器（设置 DEARTS_PROFILE_OUTPUT 时由 initialize() 自动开始会话）
+#ifdef DEARTS_ENABLE_PROFILING
+    m_profiler = &Utils::Profiler::getInstance();
+    m_profiler->initialize();
+    if (m_config.enable_profiling && !m_profiler->isRecording()) {
+        m_profiler->beginSession("DearTs");
     }
+#else
+    m_profiler = nullptr;
+#endif
+
+    // 设置 DEARTS_ALLOC_CALLSITES 时开启分配调用点采样
+    Utils::MemoryTracker::initializeFromEnvironment();
     
     // 初始化插件管理器
     auto& plugin_manager = PluginManager::getInstance();
@@ -407,12 +437,27 @@ void DearTs::Core::App::Application::shutdownSubsystems() {
         m_profiler = nullptr;
     }
 
+    // 设置 DEARTS_MEMORY_REPORT 时把内存报告写入指定路径
+    if (Utils::MemoryTracker::isEnabled()) {
+        const char* report_path = std::getenv("DEARTS_MEMORY_REPORT");
+        if (report_path && *report_path) {
+            if (Utils::MemoryTracker::writeReport(report_path)) {
+                DEARTS_LOG_INFO("内存报告已写入: {}", report_path);
+            } else {
+                DEARTS_LOG_ERROR("无法写入内存报告: {}", report_path);
+            }
+        }
+    }
+
     // 关闭配置管理器
     m_configManager = nullptr;
     
     // 关闭窗口管理器
     auto& window_manager = DearTs::Core::Window::WindowManager::getInstance();
     window_manager.shutdown();
+
+    // 停止后台任务调度器（布局已随窗口销毁，未开始的任务直接取消）
+    TaskScheduler::getInstance().shutdown();
     
     // 关闭事件系统
     auto event_system = DearTs::Core::Events::EventSystem::getInstance();
@@ -444,6 +489,21 @@ void DearTs::Core::App::Application::updateStats() {
         m_stats.current_fps = m_fpsFrameCount / std::chrono::duration<double>(fps_duration).count();
         m_stats.average_fps = m_stats.frame_count / std::chrono::duration<double>(m_stats.uptime).count();
 
+        // 堆分配统计与帧率同周期更新
+        if (Utils::MemoryTracker::isEnabled()) {
+            const Utils::AllocationCounters counters = Utils::MemoryTracker::counters();
+            m_stats.heap_live_bytes = static_cast<size_t>(counters.liveBytes());
+            m_stats.heap_allocation_rate = (counters.allocations - m_lastAllocationCount) /
+                std::chrono::duration<double>(fps_duration).count();
+            m_lastAllocationCount = counters.allocations;
+            for (size_t i = 0; i < Utils::MEMORY_TAG_COUNT; ++i) {
+                m_stats.tagged_live_bytes[i] = static_cast<size_t>(
+                    Utils::MemoryTracker::tagCounters(static_cast<Utils::MemoryTag>(i)).liveBytes());
+            }
+        }
+
+        m_stats.pacing = m_framePacer.getStats();
+
         m_fpsFrameCount = 0;
         m_fpsTimer = current_time;
     }
@@ -456,17 +516,43 @@ void DearTs::Core::App::Application::updateStats() {
         m_stats.peak_memory_usage = std::max(m_stats.peak_memory_usage, m_stats.memory_usage);
     }
 #else
+    // ru_maxrss 是峰值而非当前值，优先读取 /proc/self/statm 的常驻页数
+    size_t resident_bytes = 0;
+    if (FILE* statm = std::fopen("/proc/self/statm", "r")) {
+        unsigned long total_pages = 0;
+        unsigned long resident_pages = 0;
+        if (std::fscanf(statm, "%lu %lu", &total_pages, &resident_pages) == 2) {
+            resident_bytes = static_cast<size_t>(resident_pages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        }
+        std::fclose(statm);
+    }
+
     struct rusage usage;
     if (getrusage(RUSAGE_SELF, &usage) == 0) {
-        m_stats.memory_usage = usage.ru_maxrss * 1024; // Linux返回KB，转换为字节
-        m_stats.peak_memory_usage = std::max(m_stats.peak_memory_usage, m_stats.memory_usage);
+#ifdef __APPLE__
+        const size_t peak_bytes = static_cast<size_t>(usage.ru_maxrss);        // macOS 返回字节
+#else
+        const size_t peak_bytes = static_cast<size_t>(usage.ru_maxrss) * 1024; // Linux 返回 KB
+#endif
+        m_stats.peak_memory_usage = std::max(m_stats.peak_memory_usage, peak_bytes);
+        if (resident_bytes == 0) {
+            resident_bytes = peak_bytes;
+        }
     }
+    m_stats.memory_usage = resident_bytes;
+    m_stats.peak_memory_usage = std::max(m_stats.peak_memory_usage, m_stats.memory_usage);
 #endif
 }
 
 void DearTs::Core::App::Application::processEvents() {
+    auto& scheduler = FrameScheduler::getInstance();
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
+        // 调度器的唤醒事件只用于打断等待，不需要继续分发
+        if (scheduler.notifyEvent(event)) {
+            continue;
+        }
+
         // 将事件传递给ImGui SDL2绑定
         ImGui_ImplSDL2_ProcessEvent(&event);
 
@@ -510,18 +596,52 @@ void DearTs::Core::App::Application::processEvents() {
 }
 
 void DearTs::Core::App::Application::limitFrameRate() {
-    if (m_config.target_fps > 0) {
-        auto target_frame_time = std::chrono::duration<double>(1.0 / m_config.target_fps);
-        auto current_time = std::chrono::steady_clock::now();
-        auto elapsed = current_time - m_lastFrameTime;
-        
-        if (elapsed < target_frame_time) {
-            auto sleep_time = target_frame_time - elapsed;
-            std::this_thread::sleep_for(sleep_time);
+    // 按绝对截止时间排程，睡眠后自旋补齐最后不足一毫秒的部分
+    m_framePacer.waitForNextFrame();
+}
+
+void DearTs::Core::App::Application::prepareIdleWait() {
+    // 上一帧排队的布局消息要在下一帧投递，不能进入空闲等待
+    if (DearTs::Core::Window::LayoutManager::getInstance().getMessageBus().hasQueuedMessages()) {
+        FrameScheduler::getInstance().requestRedraw();
+    }
+
+    // 主线程定时回调（协程的 delay/超时）到期时唤醒
+    if (auto deadline = TaskScheduler::getInstance().getNextMainThreadDeadline()) {
+        FrameScheduler::getInstance().requestRedrawAt(*deadline);
+    }
+}
+
+void DearTs::Core::App::Application::pumpFrameWork() {
+    // 分发其他线程投递的延迟事件（剪切板变化、搜索进度等），事件处理器会修改界面状态
+    {
+        DEARTS_PROFILE_SCOPE("EventSystem::processEvents");
+        if (DearTs::Core::Events::EventSystem::getInstance()->processEvents() > 0) {
+            FrameScheduler::getInstance().requestRedraw();
+        }
+    }
+
+    // 执行后台任务投递到主线程的回调，界面状态因此变化时重绘
+    {
+        DEARTS_PROFILE_SCOPE("TaskScheduler::runMainThreadContinuations");
+        if (TaskScheduler::getInstance().runMainThreadContinuations() > 0) {
+            FrameScheduler::getInstance().requestRedraw();
+        }
+    }
+
+    // 投递排队的布局消息（包括上面的回调中排队的）
+    {
+        DEARTS_PROFILE_SCOPE("LayoutMessageBus::deliverQueued");
+        if (DearTs::Core::Window::LayoutManager::getInstance().getMessageBus().deliverQueued() > 0) {
+            FrameScheduler::getInstance().requestRedraw();
         }
     }
 }
 
+void DearTs::Core::App::Application::applyFramePacing() {
+    m_framePacer.setTargetFps(m_config.target_fps);
+}
+
 // ============================================================================
 // PluginManager 实现
 // ============================================================================
@@ -1158,14 +1278,23 @@ int DearTs::Core::App::Application::run() {
     
     // 获取核心系统管理器实例
     auto& window_manager = DearTs::Core::Window::WindowManager::getInstance();
+    auto& scheduler = FrameScheduler::getInstance();
     
     // 主循环
     int frame_count = 0;
     while (!m_shouldExit && m_state == DearTs::Core::App::ApplicationState::RUNNING) {
+        // 没有待绘制的内容时阻塞，直到输入、唤醒事件或下一次定时重绘
+        {
+            DEARTS_PROFILE_SCOPE("Application::waitForWork");
+            prepareIdleWait();
+            scheduler.waitForWork();
+        }
+
+        DEARTS_PROFILE_SCOPE("Frame");
         frame_count++;
         if (frame_count % 100 == 0) {
-            DEARTS_LOG_DEBUG("Application main loop running, frame count: " + std::to_string(frame_count));
-            DEARTS_LOG_DEBUG("should_exit_: " + std::to_string(m_shouldExit.load()) + ", window count: " + std::to_string(window_manager.getWindowCount()));
+            DEARTS_LOG_DEBUG("Application main loop running, frame count: {}", frame_count);
+            DEARTS_LOG_DEBUG("should_exit_: {}, window count: {}", m_shouldExit.load(), window_manager.getWindowCount());
         }
 
         auto current_time = std::chrono::steady_clock::now();
@@ -1173,12 +1302,18 @@ int DearTs::Core::App::Application::run() {
         m_lastFrameTime = current_time;
         
         // 处理事件
-        DEARTS_LOG_DEBUG("Processing events");
-        processEvents();
-        DEARTS_LOG_DEBUG("Events processed");
+        DEARTS_LOG_TRACE("Processing events");
+        {
+            DEARTS_PROFILE_SCOPE("Application::processEvents");
+            processEvents();
+        }
+        DEARTS_LOG_TRACE("Events processed");
+
+        // 延迟事件、主线程回调、排队的布局消息
+        pumpFrameWork();
         
         // 检查窗口是否需要关闭
-        DEARTS_LOG_DEBUG("Checking windows to close");
+        DEARTS_LOG_TRACE("Checking windows to close");
         if (window_manager.hasWindowsToClose()) {
             window_manager.closeWindowsToClose();
             if (window_manager.getWindowCount() == 0) {
@@ -1186,38 +1321,47 @@ int DearTs::Core::App::Application::run() {
                 requestExit();
             }
         }
-        DEARTS_LOG_DEBUG("Windows check completed");
+        DEARTS_LOG_TRACE("Windows check completed");
         
         // 更新应用程序
         if (m_state == DearTs::Core::App::ApplicationState::RUNNING) {
-            DEARTS_LOG_DEBUG("Updating application");
+            DEARTS_LOG_TRACE("Updating application");
             update(delta_time);
-            DEARTS_LOG_DEBUG("Application update completed");
+            DEARTS_LOG_TRACE("Application update completed");
             onUpdate(delta_time);
-            DEARTS_LOG_DEBUG("Application onUpdate completed");
+            DEARTS_LOG_TRACE("Application onUpdate completed");
+        }
+
+        // 画面没有变化时跳过渲染、统计和帧率限制；空闲之后帧率控制重新排程
+        if (!scheduler.beginFrame()) {
+            m_framePacer.reset();
+            continue;
         }
 
         // 渲染应用程序
         if (m_state == DearTs::Core::App::ApplicationState::RUNNING) {
-            DEARTS_LOG_DEBUG("Rendering application");
+            DEARTS_LOG_TRACE("Rendering application");
             render();
-            DEARTS_LOG_DEBUG("Application render completed");
+            DEARTS_LOG_TRACE("Application render completed");
             onRender();
-            DEARTS_LOG_DEBUG("Application onRender completed");
+            DEARTS_LOG_TRACE("Application onRender completed");
         }
         
         // 更新统计信息
-        DEARTS_LOG_DEBUG("Updating stats");
-        updateStats();
-        DEARTS_LOG_DEBUG("Stats updated");
+        DEARTS_LOG_TRACE("Updating stats");
+        {
+            DEARTS_PROFILE_SCOPE("Application::updateStats");
+            updateStats();
+        }
+        DEARTS_LOG_TRACE("Stats updated");
         
         // 限制帧率
-        DEARTS_LOG_DEBUG("Limiting frame rate");
-        limitFrameRate();
-        DEARTS_LOG_DEBUG("Frame rate limited");
-        
-        // 处理事件队列
-        // event_system->processEvents(); // TODO: Implement proper event processing
+        DEARTS_LOG_TRACE("Limiting frame rate");
+        {
+            DEARTS_PROFILE_SCOPE("Application::limitFrameRate");
+            limitFrameRate();
+        }
+        DEARTS_LOG_TRACE("Frame rate limited");
     }
     
     DEARTS_LOG_INFO("🏁 应用程序主循环结束，退出代码: " + std::to_string(m_exitCode.load()));
@@ -16,6 +16,10 @@
 // Logger removed - using simple output instead
 #include "../utils/config_manager.h"
 #include "../utils/profiler.h"
+#include "../utils/memory_tracker.h"
+#include "frame_scheduler.h"
+#include "frame_pacer.h"
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -115,6 +119,8 @@ struct ApplicationConfig {
     uint32_t target_fps = 60;                         ///< 目标帧率
     bool enable_vsync = true;                          ///< 启用垂直同步
     bool enable_profiling = false;                    ///< 启用性能分析
+    bool enable_idle_wait = true;                     ///< 无事可做时阻塞等待事件，不重绘相同的画面
+    uint32_t idle_refresh_ms = 1000;                  ///< 空闲时两帧之间的最长间隔（毫秒），0 表示无限期等待
     
     // 日志配置
     std::string log_level = "INFO";                   ///< 日志级别 (简化为字符串)
@@ -143,8 +149,15 @@ struct ApplicationStats {
     double current_fps = 0.0;                         ///< 当前帧率
     double average_fps = 0.0;                         ///< 平均帧率
     double frame_time = 0.0;                          ///< 帧时间（毫秒）
-    size_t memory_usage = 0;                          ///< 内存使用量（字节）
+    size_t memory_usage = 0;                          ///< 内存使用量（当前常驻内存，字节）
     size_t peak_memory_usage = 0;                     ///< 峰值内存使用量
+
+    // 堆分配统计（需要 DEARTS_TRACK_ALLOCATIONS，每秒更新一次）
+    size_t heap_live_bytes = 0;                       ///< 存活的堆内存（字节）
+    double heap_allocation_rate = 0.0;                ///< 堆分配速率（次/秒）
+    std::array<size_t, Utils::MEMORY_TAG_COUNT> tagged_live_bytes{}; ///< 各子系统存活的堆内存（字节）
+
+    FramePacingStats pacing;                          ///< 帧率控制误差（关闭垂直同步时有效，每秒更新一次）
 };
 
 /**
@@ -315,6 +328,19 @@ protected:
     void processEvents();
     void updateStats();
     void limitFrameRate();
+    void applyFramePacing();
+
+    /**
+     * @brief 空闲等待之前调用：有排队的布局消息时不进入空闲，并按最早的主线程定时回调安排唤醒
+     * Application::run() 和子类的主循环都要调用，否则排队的布局消息和 delay/超时等定时回调不会按时执行
+     */
+    void prepareIdleWait();
+
+    /**
+     * @brief 每帧等待结束后调用一次：分发延迟事件、执行后台任务投递到主线程的回调、投递排队的布局消息，界面状态因此变化时请求重绘
+     * Application::run() 和子类的主循环都要调用，否则 postEvent() 的事件、then()/onFinished 回调和协程续体永远不会执行
+     */
+    void pumpFrameWork();
 
     ApplicationConfig m_config;                         ///< 应用程序配置
     ApplicationState m_state;                           ///< 应用程序状态
@@ -326,6 +352,8 @@ protected:
     std::chrono::steady_clock::time_point m_lastFrameTime; ///< 上一帧时间
     std::chrono::steady_clock::time_point m_fpsTimer;       ///< FPS计时器
     uint32_t m_fpsFrameCount;                                ///< FPS帧计数
+    uint64_t m_lastAllocationCount;                          ///< 上次统计时的累计分配次数
+    FramePacer m_framePacer;                                 ///< 帧率控制器
 
     // 子系统
     Utils::ConfigManager* m_configManager; ///< 配置管理器
@@ -0,0 +1,31 @@
+/**
+ * @file coroutine_task.cpp
+ * @brief 协程任务的非模板部分
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "coroutine_task.h"
+#include "../utils/logger.h"
+
+namespace DearTs {
+namespace Core {
+namespace App {
+namespace detail {
+
+void reportUnhandledCoroutineError(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const TaskCancelledError&) {
+        DEARTS_LOG_DEBUG("协程任务已取消");
+    } catch (const std::exception& e) {
+        DEARTS_LOG_ERROR("协程任务以异常结束: " + std::string(e.what()));
+    } catch (...) {
+        DEARTS_LOG_ERROR("协程任务以未知异常结束");
+    }
+}
+
+} // namespace detail
+} // namespace App
+} // namespace Core
+} // namespace DearTs
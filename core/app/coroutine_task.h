@@ -0,0 +1,426 @@
+/**
+ * @file coroutine_task.h
+ * @brief 界面异步流程的协程任务
+ * @details 多阶段的后台流程（如路径搜索）写成一个返回 Task<T> 的协程，按顺序 co_await 各个阶段：
+ *          - co_await runInBackground(fn)：fn 在 TaskScheduler 工作线程执行，结果返回后协程在主线程恢复；
+ *          - co_await nextFrame() / co_await delay(d)：让出到下一帧 / 一段时间后在主线程恢复；
+ *          - runInBackground(fn).withTimeout(d)：超时时请求取消 fn 并抛出 TaskTimeoutError；
+ *          - 传入 CancellationToken 的等待在令牌取消后抛出 TaskCancelledError；
+ *          - co_await 另一个 Task<U>：子协程结束后继续执行。
+ *          协程在主线程 start() 后，两次等待之间的代码都在主线程执行，可以直接修改界面状态、写进度，无需加锁，
+ *          也不需要每帧轮询 future。
+ *
+ *          生命周期：Task 拥有协程帧。销毁尚未结束的 Task 会销毁协程帧，不再恢复；
+ *          它正在等待的后台工作会被取消并等待其结束，因此后台工作可以安全地捕获 this。
+ *          超时返回后，后台工作只收到取消请求而不等待，须只捕获值或自行保证所引用对象有效。
+ *          协程体内不能销毁或重新赋值拥有它自己的 Task。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "dearts/dearts_config.h"
+#include "task_scheduler.h"
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+/**
+ * @brief 等待超时时抛出
+ */
+class TaskTimeoutError : public std::runtime_error {
+public:
+    TaskTimeoutError() : std::runtime_error("等待超时") {}
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief 协程以异常结束且结果从未被取得时记录日志；TaskCancelledError 不记录
+ */
+DEARTS_API void reportUnhandledCoroutineError(const std::exception_ptr& error);
+
+/**
+ * @brief 协程承诺对象的公共部分：惰性启动，结束时把控制权交还等待者
+ */
+class CoroutinePromiseBase {
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            CoroutinePromiseBase& promise = handle.promise();
+            if (promise.m_continuation) {
+                return promise.m_continuation;
+            }
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { m_error = std::current_exception(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept { m_continuation = continuation; }
+
+    /**
+     * @brief 协程帧销毁前调用：异常从未被等待者或 get() 取得时记录
+     */
+    void reportUnobservedError() const noexcept {
+        if (m_error && !m_errorObserved) {
+            reportUnhandledCoroutineError(m_error);
+        }
+    }
+
+protected:
+    void rethrowIfFailed() {
+        if (m_error) {
+            m_errorObserved = true;
+            std::rethrow_exception(m_error);
+        }
+    }
+
+private:
+    std::coroutine_handle<> m_continuation;
+    std::exception_ptr m_error;
+    bool m_errorObserved = false;
+};
+
+template <typename T>
+class CoroutinePromise : public CoroutinePromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+    void return_value(T value) { m_value.emplace(std::move(value)); }
+
+    T& result() {
+        rethrowIfFailed();
+        return *m_value;
+    }
+
+private:
+    std::optional<T> m_value;
+};
+
+template <>
+class CoroutinePromise<void> : public CoroutinePromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+    void return_void() noexcept {}
+    void result() { rethrowIfFailed(); }
+};
+
+/**
+ * @brief 等待中的协程句柄，由主线程回调共享；协程帧销毁时清空，迟到的回调不会恢复已销毁的协程
+ * @details 恢复与清空都在主线程进行，无需同步
+ */
+struct ResumeState {
+    std::coroutine_handle<> handle;
+    bool timedOut = false;
+
+    void resume() {
+        if (handle) {
+            std::exchange(handle, nullptr).resume();
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief 协程任务
+ * @tparam T 结果类型
+ */
+template <typename T>
+class Task {
+public:
+    using promise_type = detail::CoroutinePromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) noexcept : m_handle(handle) {}
+
+    Task(Task&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, nullptr)), m_started(std::exchange(other.m_started, false)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            m_handle = std::exchange(other.m_handle, nullptr);
+            m_started = std::exchange(other.m_started, false);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { destroy(); }
+
+    bool isValid() const noexcept { return static_cast<bool>(m_handle); }
+    explicit operator bool() const noexcept { return isValid(); }
+
+    /**
+     * @brief 是否已结束（正常返回或抛出异常）
+     */
+    bool isReady() const noexcept { return m_handle && m_handle.done(); }
+
+    /**
+     * @brief 是否已启动且尚未结束
+     */
+    bool isRunning() const noexcept { return m_started && !isReady(); }
+
+    /**
+     * @brief 在当前线程（通常是主线程）开始执行，直到第一次等待
+     */
+    void start() {
+        if (m_handle && !m_started) {
+            m_started = true;
+            m_handle.resume();
+        }
+    }
+
+    /**
+     * @brief 取得结果；协程抛出的异常原样重新抛出
+     * @details 只能在 isReady() 之后调用
+     */
+    T get() {
+        if (!isReady()) {
+            throw std::logic_error("协程任务尚未结束");
+        }
+        if constexpr (std::is_void_v<T>) {
+            m_handle.promise().result();
+        } else {
+            return std::move(m_handle.promise().result());
+        }
+    }
+
+    /**
+     * @brief 销毁协程帧（尚未结束时不再恢复，正在等待的后台工作被取消并等待结束）
+     */
+    void reset() noexcept { destroy(); }
+
+    /**
+     * @brief 等待子协程：子协程从头执行，结束后恢复等待者
+     */
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            Handle handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+                handle.promise().setContinuation(caller);
+                return handle;
+            }
+
+            T await_resume() {
+                if (!handle) {
+                    throw TaskCancelledError();
+                }
+                if constexpr (std::is_void_v<T>) {
+                    handle.promise().result();
+                } else {
+                    return std::move(handle.promise().result());
+                }
+            }
+        };
+        m_started = true;
+        return Awaiter{m_handle};
+    }
+
+private:
+    void destroy() noexcept {
+        if (m_handle) {
+            if (m_handle.done()) {
+                m_handle.promise().reportUnobservedError();
+            }
+            m_handle.destroy();
+            m_handle = nullptr;
+        }
+        m_started = false;
+    }
+
+    Handle m_handle;
+    bool m_started = false;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> CoroutinePromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<CoroutinePromise<T>>::from_promise(*this));
+}
+
+inline Task<void> CoroutinePromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+/**
+ * @brief 等待后台工作：提交到 TaskScheduler，结束后在主线程恢复协程
+ * @tparam F 可调用对象，签名为 R() 或 R(TaskContext&)
+ */
+template <typename F>
+class BackgroundAwaiter {
+public:
+    using Result = typename detail::TaskInvokeResult<F>::type;
+
+    BackgroundAwaiter(F function, TaskPriority priority, CancellationToken token)
+        : m_function(std::move(function)), m_priority(priority), m_token(std::move(token)) {}
+
+    BackgroundAwaiter(BackgroundAwaiter&&) = default;
+    BackgroundAwaiter& operator=(BackgroundAwaiter&&) = delete;
+
+    ~BackgroundAwaiter() {
+        if (m_state && m_state->handle) {
+            // 协程在等待期间被销毁：不再恢复，后台工作可能引用协程的局部变量或所属对象，等它结束
+            m_state->handle = nullptr;
+            if (m_task.isPending()) {
+                m_task.cancel();
+                m_task.wait();
+            }
+        }
+    }
+
+    /**
+     * @brief 设置超时：到期时请求取消后台工作，协程恢复并抛出 TaskTimeoutError
+     */
+    BackgroundAwaiter withTimeout(std::chrono::steady_clock::duration timeout) && {
+        m_timeout = timeout;
+        return std::move(*this);
+    }
+
+    bool await_ready() const noexcept { return m_token.isCancelled(); }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        m_state = std::make_shared<detail::ResumeState>();
+        m_state->handle = handle;
+
+        TaskScheduler& scheduler = TaskScheduler::getInstance();
+        m_task = scheduler.submit(std::move(m_function), m_priority, m_token);
+        if (m_timeout) {
+            scheduler.runOnMainThreadAfter(*m_timeout, [state = m_state, task = m_task]() mutable {
+                if (!state->handle) {
+                    return;
+                }
+                state->timedOut = true;
+                task.cancel();
+                state->resume();
+            });
+        }
+        m_task.onFinished([state = m_state]() { state->resume(); });
+    }
+
+    Result await_resume() {
+        if (m_state && m_state->timedOut) {
+            throw TaskTimeoutError();
+        }
+        if (!m_task) {
+            // 等待前令牌已取消，没有提交
+            throw TaskCancelledError();
+        }
+        // 任务已结束，get() 不会阻塞；失败时重新抛出，取消时抛出 TaskCancelledError
+        return m_task.get();
+    }
+
+private:
+    F m_function;
+    TaskPriority m_priority;
+    CancellationToken m_token;
+    std::optional<std::chrono::steady_clock::duration> m_timeout;
+    TaskHandle<Result> m_task;
+    std::shared_ptr<detail::ResumeState> m_state;
+};
+
+/**
+ * @brief 等待到下一帧或一段时间之后，在主线程恢复
+ */
+class DelayAwaiter {
+public:
+    DelayAwaiter(std::optional<std::chrono::steady_clock::duration> delay, CancellationToken token)
+        : m_delay(delay), m_token(std::move(token)) {}
+
+    DelayAwaiter(DelayAwaiter&&) = default;
+    DelayAwaiter& operator=(DelayAwaiter&&) = delete;
+
+    ~DelayAwaiter() {
+        if (m_state) {
+            m_state->handle = nullptr;
+        }
+    }
+
+    bool await_ready() const noexcept { return m_token.isCancelled(); }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        m_state = std::make_shared<detail::ResumeState>();
+        m_state->handle = handle;
+        auto resume = [state = m_state]() { state->resume(); };
+        if (m_delay) {
+            TaskScheduler::getInstance().runOnMainThreadAfter(*m_delay, std::move(resume));
+        } else {
+            TaskScheduler::getInstance().runOnMainThread(std::move(resume));
+        }
+    }
+
+    /**
+     * @details 令牌在等待期间取消时，到期恢复后抛出 TaskCancelledError
+     */
+    void await_resume() const {
+        if (m_token.isCancelled()) {
+            throw TaskCancelledError();
+        }
+    }
+
+private:
+    std::optional<std::chrono::steady_clock::duration> m_delay;
+    CancellationToken m_token;
+    std::shared_ptr<detail::ResumeState> m_state;
+};
+
+/**
+ * @brief 在工作线程执行 function，协程在主线程取得其结果
+ * @param function 签名为 R() 或 R(TaskContext&)
+ * @param priority 优先级
+ * @param token 取消令牌，取消后协程恢复时抛出 TaskCancelledError
+ */
+template <typename F>
+BackgroundAwaiter<std::decay_t<F>> runInBackground(F&& function, TaskPriority priority = TaskPriority::NORMAL,
+                                                   CancellationToken token = {}) {
+    return BackgroundAwaiter<std::decay_t<F>>(std::forward<F>(function), priority, std::move(token));
+}
+
+/**
+ * @brief 让出到下一帧（下一次 runMainThreadContinuations()）
+ */
+inline DelayAwaiter nextFrame(CancellationToken token = {}) {
+    return DelayAwaiter(std::nullopt, std::move(token));
+}
+
+/**
+ * @brief 一段时间后在主线程恢复
+ */
+template <typename Rep, typename Period>
+DelayAwaiter delay(std::chrono::duration<Rep, Period> duration, CancellationToken token = {}) {
+    return DelayAwaiter(std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration), std::move(token));
+}
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
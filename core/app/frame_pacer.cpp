@@ -0,0 +1,166 @@
+/**
+ * @file frame_pacer.cpp
+ * @brief 高精度帧率控制器实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "frame_pacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+namespace {
+
+constexpr auto SLEEP_QUANTUM = std::chrono::milliseconds(1);   ///< 粗粒度睡眠的单次时长
+constexpr double SLEEP_ESTIMATE_WEIGHT = 0.05;                 ///< 睡眠误差估计的加权系数
+
+} // namespace
+
+FramePacer::FramePacer() {
+#ifdef _WIN32
+    // 默认的系统定时器精度约 15.6ms，1ms 睡眠会被拉长到一个完整的时钟周期
+    timeBeginPeriod(1);
+#endif
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+    timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::setTargetFps(uint32_t fps) {
+    m_period = fps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps))
+                       : Clock::duration::zero();
+    reset();
+}
+
+void FramePacer::reset() {
+    m_scheduled = false;
+}
+
+void FramePacer::waitForNextFrame() {
+    const Clock::time_point now = Clock::now();
+    if (m_period == Clock::duration::zero()) {
+        m_lastWake = now;
+        return;
+    }
+
+    if (!m_scheduled) {
+        m_scheduled = true;
+        m_nextDeadline = now + m_period;
+        m_lastWake = now;
+    } else if (now >= m_nextDeadline) {
+        // 已经错过截止时间：不等待直接开始这一帧，并从当前时间重新排程。
+        // 若沿用 deadline += period，之后几帧的截止时间都已过去，会连续不等待地补帧
+        ++m_missedDeadlines;
+        recordError(static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_nextDeadline).count()));
+        m_droppedFrames += static_cast<uint64_t>((now - m_nextDeadline) / m_period);
+        updateSmoothedFrameTime(now);
+        m_nextDeadline = now + m_period;
+        ++m_frames;
+        return;
+    }
+
+    const Clock::time_point deadline = m_nextDeadline;
+    waitUntil(deadline);
+
+    const Clock::time_point wake = Clock::now();
+    recordError(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wake - deadline).count()));
+    updateSmoothedFrameTime(wake);
+
+    m_nextDeadline += m_period;
+    ++m_frames;
+}
+
+void FramePacer::updateSmoothedFrameTime(Clock::time_point wake) {
+    const double interval = std::chrono::duration<double>(wake - m_lastWake).count();
+    m_smoothedFrameTime = m_smoothedFrameTime == 0.0
+        ? interval
+        : m_smoothedFrameTime + SMOOTHING_FACTOR * (interval - m_smoothedFrameTime);
+    m_lastWake = wake;
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline) {
+    if (!m_spinEnabled) {
+        std::this_thread::sleep_until(deadline);
+        return;
+    }
+
+    // 粗粒度睡眠：剩余时间大于一次睡眠可能的耗时才睡
+    for (;;) {
+        const Clock::time_point before = Clock::now();
+        const double remainingNs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - before).count());
+        const double estimateNs = m_sleepMeanNs + std::sqrt(m_sleepVarianceNs2);
+        if (remainingNs <= estimateNs) {
+            break;
+        }
+        std::this_thread::sleep_for(SLEEP_QUANTUM);
+        updateSleepEstimate(static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count()));
+    }
+
+    // 最后不足一次睡眠的时间让出 CPU 自旋
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::updateSleepEstimate(double observedNs) {
+    const double delta = observedNs - m_sleepMeanNs;
+    m_sleepMeanNs += SLEEP_ESTIMATE_WEIGHT * delta;
+    m_sleepVarianceNs2 = (1.0 - SLEEP_ESTIMATE_WEIGHT) * (m_sleepVarianceNs2 + SLEEP_ESTIMATE_WEIGHT * delta * delta);
+}
+
+void FramePacer::recordError(double errorNs) {
+    m_errors[m_errorCount % ERROR_HISTORY] = errorNs;
+    ++m_errorCount;
+}
+
+FramePacingStats FramePacer::getStats() const {
+    FramePacingStats stats;
+    stats.frames = m_frames;
+    stats.missed_deadlines = m_missedDeadlines;
+    stats.dropped_frames = m_droppedFrames;
+    stats.sleep_estimate_us = (m_sleepMeanNs + std::sqrt(m_sleepVarianceNs2)) / 1.0e3;
+    stats.smoothed_frame_time_ms = m_smoothedFrameTime * 1.0e3;
+
+    const size_t count = std::min(m_errorCount, ERROR_HISTORY);
+    if (count == 0) {
+        return stats;
+    }
+
+    std::vector<double> errors(m_errors.begin(), m_errors.begin() + static_cast<std::ptrdiff_t>(count));
+    std::sort(errors.begin(), errors.end());
+    double sum = 0.0;
+    for (const double error : errors) {
+        sum += error;
+    }
+    auto percentile = [&errors](double p) {
+        const size_t index = std::min(errors.size() - 1, static_cast<size_t>(p * static_cast<double>(errors.size())));
+        return errors[index] / 1.0e3;
+    };
+    stats.mean_error_us = sum / static_cast<double>(count) / 1.0e3;
+    stats.p50_error_us = percentile(0.50);
+    stats.p95_error_us = percentile(0.95);
+    stats.p99_error_us = percentile(0.99);
+    stats.max_error_us = errors.back() / 1.0e3;
+    return stats;
+}
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
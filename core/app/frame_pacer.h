@@ -0,0 +1,128 @@
+/**
+ * @file frame_pacer.h
+ * @brief 高精度帧率控制器
+ * @details 按绝对截止时间排程（deadline += period），单帧的超时不会累积成漂移；
+ *          等待时先粗粒度睡眠，剩余时间小于“睡眠误差估计”后改为让出 CPU 自旋到截止时间。
+ *          睡眠误差估计取最近几次 1ms 睡眠实测耗时的均值加一个标准差，随系统定时器精度自适应。
+ *          错过截止时间的帧不等待直接开始，并从当前时间重新排程，不连续补帧。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "dearts/dearts_config.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+/**
+ * @brief 帧率控制误差统计
+ * @details 误差 = 实际唤醒时间 - 截止时间，正数表示迟到；错过截止时间的帧按开始时间计入。
+ *          百分位基于最近 ERROR_HISTORY 帧
+ */
+struct FramePacingStats {
+    uint64_t frames = 0;              ///< 已排程的帧数
+    uint64_t missed_deadlines = 0;    ///< 进入等待时已经错过截止时间的帧数
+    uint64_t dropped_frames = 0;      ///< 错过截止时间后重新排程时跳过的整周期数
+    double mean_error_us = 0.0;       ///< 平均误差（微秒）
+    double p50_error_us = 0.0;        ///< 误差中位数（微秒）
+    double p95_error_us = 0.0;        ///< 误差 95 分位（微秒）
+    double p99_error_us = 0.0;        ///< 误差 99 分位（微秒）
+    double max_error_us = 0.0;        ///< 最大误差（微秒）
+    double sleep_estimate_us = 0.0;   ///< 当前的睡眠误差估计（微秒）
+    double smoothed_frame_time_ms = 0.0; ///< 平滑后的帧间隔（毫秒）
+};
+
+/**
+ * @brief 帧率控制器
+ * @details 非线程安全，只在主循环线程使用
+ */
+class DEARTS_API FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t ERROR_HISTORY = 256;       ///< 参与百分位统计的帧数
+    static constexpr double SMOOTHING_FACTOR = 0.1;    ///< 帧间隔指数平滑系数
+
+    FramePacer();
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /**
+     * @brief 设置目标帧率，0 表示不限制
+     */
+    void setTargetFps(uint32_t fps);
+
+    /**
+     * @brief 设置是否在最后一段时间自旋（关闭时只睡眠，用于对比）
+     */
+    void setSpinEnabled(bool enabled) { m_spinEnabled = enabled; }
+
+    /**
+     * @brief 从当前时间重新排程，例如空闲等待结束后
+     */
+    void reset();
+
+    /**
+     * @brief 等待到下一帧的截止时间
+     */
+    void waitForNextFrame();
+
+    /**
+     * @brief 平滑后的帧间隔（秒），供更新逻辑使用，避免单帧抖动影响动画
+     */
+    double getSmoothedDeltaTime() const { return m_smoothedFrameTime; }
+
+    /**
+     * @brief 获取误差统计
+     */
+    FramePacingStats getStats() const;
+
+private:
+    /**
+     * @brief 睡眠 + 自旋等待到指定时间
+     */
+    void waitUntil(Clock::time_point deadline);
+
+    /**
+     * @brief 用一次实测的睡眠耗时更新睡眠误差估计
+     */
+    void updateSleepEstimate(double observedNs);
+
+    /**
+     * @brief 用本帧的唤醒时间更新平滑帧间隔（包括错过截止时间的帧）
+     */
+    void updateSmoothedFrameTime(Clock::time_point wake);
+
+    void recordError(double errorNs);
+
+    Clock::duration m_period{};                    ///< 帧周期，0 表示不限制
+    bool m_spinEnabled = true;                     ///< 是否自旋
+    bool m_scheduled = false;                      ///< 是否已开始排程
+    Clock::time_point m_nextDeadline;              ///< 下一帧截止时间
+    Clock::time_point m_lastWake;                  ///< 上一帧唤醒时间
+
+    // 睡眠误差估计（指数加权的均值与方差）
+    double m_sleepMeanNs = 1.0e6;
+    double m_sleepVarianceNs2 = 0.0;
+
+    double m_smoothedFrameTime = 0.0;              ///< 平滑后的帧间隔（秒）
+
+    uint64_t m_frames = 0;
+    uint64_t m_missedDeadlines = 0;
+    uint64_t m_droppedFrames = 0;
+    std::array<double, ERROR_HISTORY> m_errors{};  ///< 最近的误差（纳秒），环形缓冲
+    size_t m_errorCount = 0;                       ///< 已记录的误差数（可超过容量）
+};
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,154 @@
+/**
+ * @file frame_scheduler.cpp
+ * @brief 主循环帧调度器实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "frame_scheduler.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+namespace {
+
+int64_t toTicks(FrameScheduler::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+FrameScheduler::Clock::time_point fromTicks(int64_t ticks) {
+    return FrameScheduler::Clock::time_point(
+        std::chrono::duration_cast<FrameScheduler::Clock::duration>(std::chrono::nanoseconds(ticks)));
+}
+
+} // namespace
+
+FrameScheduler& FrameScheduler::getInstance() {
+    static FrameScheduler instance;
+    return instance;
+}
+
+FrameScheduler::FrameScheduler()
+    : m_enabled(true)
+    , m_idleRefreshMs(DEFAULT_IDLE_REFRESH_MS)
+    , m_pendingFrames(INPUT_REDRAW_FRAMES)
+    , m_redrawAt(NO_DEADLINE)
+    , m_wakePending(false)
+    , m_wakeEventType(SDL_RegisterEvents(1))
+    , m_lastFrameTime(Clock::now())
+    , m_skippedFrames(0) {
+    if (m_wakeEventType == static_cast<uint32_t>(-1)) {
+        m_wakeEventType = SDL_USEREVENT;
+    }
+}
+
+void FrameScheduler::configure(bool enabled, uint32_t idleRefreshMs) {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+    m_idleRefreshMs.store(idleRefreshMs, std::memory_order_relaxed);
+    wakeUp();
+}
+
+void FrameScheduler::requestRedraw(uint32_t frames) {
+    uint32_t current = m_pendingFrames.load(std::memory_order_relaxed);
+    while (current < frames &&
+           !m_pendingFrames.compare_exchange_weak(current, frames, std::memory_order_relaxed)) {
+    }
+    wakeUp();
+}
+
+void FrameScheduler::requestRedrawAt(Clock::time_point when) {
+    const int64_t ticks = toTicks(when);
+    int64_t current = m_redrawAt.load(std::memory_order_relaxed);
+    while (ticks < current) {
+        if (m_redrawAt.compare_exchange_weak(current, ticks, std::memory_order_relaxed)) {
+            // 截止时间提前了，阻塞中的主循环需要按新的超时重新等待
+            wakeUp();
+            return;
+        }
+    }
+}
+
+void FrameScheduler::wakeUp() {
+    if (m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = m_wakeEventType;
+    if (SDL_PushEvent(&event) != 1) {
+        // 事件子系统未初始化或队列已满，下次仍可重试
+        m_wakePending.store(false, std::memory_order_release);
+    }
+}
+
+FrameScheduler::Clock::time_point FrameScheduler::nextDeadline() const {
+    Clock::time_point deadline = fromTicks(m_redrawAt.load(std::memory_order_relaxed));
+    const uint32_t refreshMs = m_idleRefreshMs.load(std::memory_order_relaxed);
+    if (refreshMs > 0) {
+        deadline = std::min(deadline, m_lastFrameTime + std::chrono::milliseconds(refreshMs));
+    }
+    return deadline;
+}
+
+void FrameScheduler::waitForWork() {
+    if (!isIdleWaitEnabled() || m_pendingFrames.load(std::memory_order_relaxed) > 0) {
+        return;
+    }
+
+    const Clock::time_point deadline = nextDeadline();
+    if (deadline == fromTicks(NO_DEADLINE)) {
+        SDL_WaitEvent(nullptr);
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (deadline <= now) {
+        return;
+    }
+    // 向上取整到毫秒，避免提前醒来后空转
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+    const int timeoutMs = static_cast<int>(std::min<int64_t>(remaining, INT32_MAX));
+    SDL_WaitEventTimeout(nullptr, timeoutMs);
+}
+
+bool FrameScheduler::notifyEvent(const SDL_Event& event) {
+    if (event.type == m_wakeEventType) {
+        m_wakePending.store(false, std::memory_order_release);
+        return true;
+    }
+
+    // 已在主线程上，不需要再投递唤醒事件
+    uint32_t current = m_pendingFrames.load(std::memory_order_relaxed);
+    while (current < INPUT_REDRAW_FRAMES &&
+           !m_pendingFrames.compare_exchange_weak(current, INPUT_REDRAW_FRAMES, std::memory_order_relaxed)) {
+    }
+    return false;
+}
+
+bool FrameScheduler::beginFrame() {
+    const Clock::time_point now = Clock::now();
+    if (isIdleWaitEnabled()) {
+        uint32_t pending = m_pendingFrames.load(std::memory_order_relaxed);
+        while (pending > 0 &&
+               !m_pendingFrames.compare_exchange_weak(pending, pending - 1, std::memory_order_relaxed)) {
+        }
+        if (pending == 0 && nextDeadline() > now) {
+            ++m_skippedFrames;
+            return false;
+        }
+    }
+
+    // 本帧会绘制，已到期的定时重绘随之完成
+    int64_t redrawAt = m_redrawAt.load(std::memory_order_relaxed);
+    while (redrawAt <= toTicks(now) &&
+           !m_redrawAt.compare_exchange_weak(redrawAt, NO_DEADLINE, std::memory_order_relaxed)) {
+    }
+    m_lastFrameTime = now;
+    return true;
+}
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
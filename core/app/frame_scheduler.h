@@ -0,0 +1,128 @@
+/**
+ * @file frame_scheduler.h
+ * @brief 主循环帧调度器
+ * @details 主循环在没有待绘制内容时阻塞在 SDL_WaitEventTimeout 上，而不是按固定帧率空转重绘。
+ *          以下情况会唤醒主循环并绘制：
+ *          - 任意 SDL 输入/窗口事件（之后连续绘制几帧，让 ImGui 的交互状态稳定下来）；
+ *          - requestRedraw()：数据变化（剪切板更新、后台任务完成等）或逐帧动画（侧边栏展开/收起），可在任意线程调用；
+ *          - requestRedrawAt()/requestRedrawIn()：定时重绘（番茄时钟每秒刷新、光标闪烁等）；
+ *          - 兜底刷新：空闲时每隔 idleRefreshMs 至少绘制一帧，未接入调度器的状态变化也不会长时间不显示。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "dearts/dearts_config.h"
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+/**
+ * @brief 主循环帧调度器（单例）
+ * @details requestRedraw*()、wakeUp() 线程安全；waitForWork()、notifyEvent()、beginFrame() 只在主线程调用。
+ */
+class DEARTS_API FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t INPUT_REDRAW_FRAMES = 3;      ///< 每个输入事件之后连续绘制的帧数
+    static constexpr uint32_t DEFAULT_IDLE_REFRESH_MS = 1000; ///< 默认兜底刷新间隔（毫秒）
+
+    static FrameScheduler& getInstance();
+
+    /**
+     * @brief 配置空闲等待
+     * @param enabled 是否启用；关闭时每次循环都绘制（旧行为）
+     * @param idleRefreshMs 空闲时两帧之间的最长间隔，0 表示无事件时无限期等待
+     */
+    void configure(bool enabled, uint32_t idleRefreshMs = DEFAULT_IDLE_REFRESH_MS);
+
+    /**
+     * @brief 是否启用空闲等待
+     */
+    bool isIdleWaitEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 请求接下来绘制若干帧并唤醒主循环
+     * @param frames 帧数
+     */
+    void requestRedraw(uint32_t frames = 1);
+
+    /**
+     * @brief 请求在指定时间点绘制一帧，多个请求取最早的一个
+     * @param when 时间点
+     */
+    void requestRedrawAt(Clock::time_point when);
+
+    /**
+     * @brief 请求在一段时间后绘制一帧
+     * @param delay 延迟
+     */
+    template <typename Rep, typename Period>
+    void requestRedrawIn(std::chrono::duration<Rep, Period> delay) {
+        requestRedrawAt(Clock::now() + std::chrono::duration_cast<Clock::duration>(delay));
+    }
+
+    /**
+     * @brief 向 SDL 事件队列投递唤醒事件，使阻塞中的主循环立即返回
+     * @details 同一时刻队列中最多只有一个唤醒事件
+     */
+    void wakeUp();
+
+    /**
+     * @brief 阻塞直到有事件到达或下一帧到期
+     * @details 有待绘制的帧或定时重绘已到期时立即返回；事件留在队列中由调用方照常轮询
+     */
+    void waitForWork();
+
+    /**
+     * @brief 主循环轮询到的每个 SDL 事件都要交给调度器
+     * @param event SDL 事件
+     * @return 是否为调度器自己的唤醒事件（调用方可以忽略它）
+     */
+    bool notifyEvent(const SDL_Event& event);
+
+    /**
+     * @brief 判断本次循环是否需要绘制，需要时消耗一帧待绘制计数
+     * @return 是否绘制
+     */
+    bool beginFrame();
+
+    /**
+     * @brief 获取因空闲而跳过绘制的循环次数
+     */
+    uint64_t getSkippedFrameCount() const { return m_skippedFrames; }
+
+private:
+    FrameScheduler();
+    ~FrameScheduler() = default;
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /**
+     * @brief 下一次必须绘制的时间点（定时重绘与兜底刷新中较早的一个）
+     */
+    Clock::time_point nextDeadline() const;
+
+    static constexpr int64_t NO_DEADLINE = INT64_MAX;
+
+    std::atomic<bool> m_enabled;                  ///< 是否启用空闲等待
+    std::atomic<uint32_t> m_idleRefreshMs;        ///< 兜底刷新间隔（毫秒）
+    std::atomic<uint32_t> m_pendingFrames;        ///< 待绘制的帧数
+    std::atomic<int64_t> m_redrawAt;              ///< 最早的定时重绘（steady_clock 纳秒），NO_DEADLINE 表示无
+    std::atomic<bool> m_wakePending;              ///< 队列中是否已有唤醒事件
+    uint32_t m_wakeEventType;                     ///< 唤醒事件类型（SDL_RegisterEvents 分配）
+
+    Clock::time_point m_lastFrameTime;            ///< 上次绘制的时间（仅主线程）
+    uint64_t m_skippedFrames;                     ///< 跳过绘制的循环次数（仅主线程）
+};
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,594 @@
+/**
+ * @file task_scheduler.cpp
+ * @brief 后台任务调度器实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "task_scheduler.h"
+#include "../utils/logger.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+namespace {
+
+constexpr size_t NOT_A_WORKER = SIZE_MAX;
+
+thread_local const TaskScheduler* t_scheduler = nullptr;    ///< 当前线程所属的调度器
+thread_local size_t t_workerIndex = NOT_A_WORKER;           ///< 当前线程的工作线程序号
+
+std::string describeException(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "未知异常";
+    }
+}
+
+/**
+ * @brief 主线程定时回调堆的比较：到期晚的排在后面，同时到期的按投递顺序
+ */
+constexpr auto laterTimer = [](const auto& a, const auto& b) {
+    return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+};
+
+void updateMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// TaskStateBase
+// ============================================================================
+
+namespace detail {
+
+bool TaskStateBase::execute() {
+    if (m_claimed.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    if (isCancellationRequested()) {
+        releaseCallable();
+        finish(TaskStatus::CANCELLED, nullptr);
+        return true;
+    }
+
+    m_status.store(TaskStatus::RUNNING, std::memory_order_release);
+    TaskContext context(*this);
+    TaskStatus status = TaskStatus::COMPLETED;
+    std::exception_ptr error;
+    try {
+        run(context);
+    } catch (const TaskCancelledError&) {
+        status = TaskStatus::CANCELLED;
+    } catch (...) {
+        status = TaskStatus::FAILED;
+        error = std::current_exception();
+    }
+    releaseCallable();
+    finish(status, error);
+    return true;
+}
+
+bool TaskStateBase::cancel() {
+    m_cancelRequested.store(true, std::memory_order_release);
+    if (m_claimed.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    // 任务仍留在队列中，工作线程取出时发现已被认领会直接丢弃
+    releaseCallable();
+    finish(TaskStatus::CANCELLED, nullptr);
+    return true;
+}
+
+void TaskStateBase::finish(TaskStatus status, std::exception_ptr error) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = std::move(error);
+        m_status.store(status, std::memory_order_release);
+    }
+    m_finished.notify_all();
+    postContinuation(status);
+}
+
+void TaskStateBase::postContinuation(TaskStatus status) {
+    std::function<void()> onCompleted;
+    std::function<void(const std::string&)> onFailed;
+    std::function<void()> onFinished;
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        onCompleted = std::move(m_onCompleted);
+        onFailed = std::move(m_onFailed);
+        onFinished = std::move(m_onFinished);
+        m_onCompleted = nullptr;
+        m_onFailed = nullptr;
+        m_onFinished = nullptr;
+        error = m_error;
+    }
+
+    if (onFinished) {
+        TaskScheduler::getInstance().runOnMainThread(std::move(onFinished));
+    }
+
+    if (status == TaskStatus::COMPLETED && onCompleted) {
+        // 回调排队期间任务可能被取消（如布局已关闭），执行前再检查一次
+        TaskScheduler::getInstance().runOnMainThread(
+            [self = shared_from_this(), callback = std::move(onCompleted)]() {
+                if (!self->isCancellationRequested()) {
+                    callback();
+                }
+            });
+    } else if (status == TaskStatus::FAILED) {
+        const std::string message = describeException(error);
+        if (onFailed) {
+            TaskScheduler::getInstance().runOnMainThread(
+                [self = shared_from_this(), callback = std::move(onFailed), message]() {
+                    if (!self->isCancellationRequested()) {
+                        callback(message);
+                    }
+                });
+        } else {
+            DEARTS_LOG_ERROR("后台任务执行失败: " + message);
+        }
+    }
+}
+
+void TaskStateBase::wait() const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this]() { return isFinished(); });
+}
+
+bool TaskStateBase::waitFor(std::chrono::microseconds timeout) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_finished.wait_for(lock, timeout, [this]() { return isFinished(); });
+}
+
+void TaskStateBase::setProgress(float fraction, std::string message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_progress.fraction = std::clamp(fraction, 0.0f, 1.0f);
+    m_progress.message = std::move(message);
+}
+
+TaskProgress TaskStateBase::getProgress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_progress;
+}
+
+std::exception_ptr TaskStateBase::getError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+void TaskStateBase::setContinuation(std::function<void()> onCompleted,
+                                    std::function<void(const std::string&)> onFailed) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_onCompleted = std::move(onCompleted);
+        m_onFailed = std::move(onFailed);
+        if (!isFinished()) {
+            return;
+        }
+    }
+    // 注册时任务已经结束，直接投递
+    postContinuation(getStatus());
+}
+
+void TaskStateBase::setFinishCallback(std::function<void()> onFinished) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_onFinished = std::move(onFinished);
+        if (!isFinished()) {
+            return;
+        }
+    }
+    postContinuation(getStatus());
+}
+
+} // namespace detail
+
+// ============================================================================
+// TaskScheduler
+// ============================================================================
+
+TaskScheduler& TaskScheduler::getInstance() {
+    static TaskScheduler instance;
+    return instance;
+}
+
+TaskScheduler::~TaskScheduler() {
+    // 静态析构阶段日志器可能已经销毁，这里不记录日志
+    size_t cancelledTasks = 0;
+    size_t droppedCallbacks = 0;
+    stop(cancelledTasks, droppedCallbacks);
+}
+
+void TaskScheduler::initialize(size_t workerCount) {
+    std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+    m_shutDown = false;
+    if (m_running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    if (workerCount == 0) {
+        const size_t hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    m_stopping.store(false, std::memory_order_release);
+    m_workers.clear();
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    // 全部 Worker 建好后再启动线程：窃取时会遍历 m_workers
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers[i]->thread = std::thread(&TaskScheduler::workerLoop, this, i);
+    }
+    m_workerCount.store(workerCount, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_release);
+    DEARTS_LOG_INFO("任务调度器已启动，工作线程数: " + std::to_string(workerCount));
+}
+
+void TaskScheduler::shutdown() {
+    size_t cancelledTasks = 0;
+    size_t droppedCallbacks = 0;
+    if (stop(cancelledTasks, droppedCallbacks)) {
+        DEARTS_LOG_INFO("任务调度器已停止，取消未开始的任务 " + std::to_string(cancelledTasks) +
+                        " 个，丢弃主线程回调 " + std::to_string(droppedCallbacks) + " 个");
+    }
+}
+
+bool TaskScheduler::stop(size_t& cancelledTasks, size_t& droppedCallbacks) {
+    std::vector<TaskPtr> leftovers;
+    {
+        std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+        m_shutDown = true;
+        if (!m_running.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> sleepLock(m_sleepMutex);
+            m_stopping.store(true, std::memory_order_release);
+        }
+        m_sleepCondition.notify_all();
+        for (const auto& worker : m_workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+
+        // 线程都已退出，剩余队列不再有并发访问
+        for (const auto& worker : m_workers) {
+            for (auto& queue : worker->queues) {
+                leftovers.insert(leftovers.end(), queue.begin(), queue.end());
+                queue.clear();
+            }
+        }
+        m_workers.clear();
+        m_workerCount.store(0, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> globalLock(m_globalMutex);
+            for (auto& queue : m_globalQueues) {
+                leftovers.insert(leftovers.end(), queue.begin(), queue.end());
+                queue.clear();
+            }
+            m_running.store(false, std::memory_order_release);
+        }
+        m_queued.store(0, std::memory_order_relaxed);
+    }
+
+    // 在生命周期锁之外取消：取消会释放任务捕获的对象，析构函数可能再提交任务
+    for (const TaskPtr& task : leftovers) {
+        if (task->cancel()) {
+            m_cancelled.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::function<void()>> dropped;
+    std::vector<MainThreadTimer> droppedTimers;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        dropped.swap(m_mainQueue);
+        droppedTimers.swap(m_mainTimers);
+    }
+    cancelledTasks = leftovers.size();
+    droppedCallbacks = dropped.size() + droppedTimers.size();
+    return true;
+}
+
+void TaskScheduler::enqueue(TaskPtr task) {
+    if (!m_running.load(std::memory_order_acquire)) {
+        bool shutDown = false;
+        {
+            std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+            shutDown = m_shutDown;
+        }
+        if (shutDown) {
+            task->cancel();
+            m_cancelled.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        initialize();
+    }
+
+    task->markSubmitted();
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    const size_t priority = static_cast<size_t>(task->getPriority());
+
+    // 工作线程提交的子任务进入本地队列，其余进入全局队列
+    if (t_scheduler == this && t_workerIndex < m_workers.size()) {
+        Worker& worker = *m_workers[t_workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.queues[priority].push_back(std::move(task));
+    } else {
+        std::unique_lock<std::mutex> lock(m_globalMutex);
+        if (!m_running.load(std::memory_order_acquire)) {
+            // 与 shutdown() 竞争时调度器已停止，任务不会再有线程执行
+            lock.unlock();
+            task->cancel();
+            m_cancelled.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_globalQueues[priority].push_back(std::move(task));
+    }
+
+    const size_t queued = m_queued.fetch_add(1, std::memory_order_seq_cst) + 1;
+    size_t maxQueued = m_maxQueued.load(std::memory_order_relaxed);
+    while (queued > maxQueued && !m_maxQueued.compare_exchange_weak(maxQueued, queued, std::memory_order_relaxed)) {
+    }
+
+    // 先增加计数再检查休眠线程：工作线程在休眠锁内先登记再检查计数，两边至少有一方看到对方
+    if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+        { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+        m_sleepCondition.notify_one();
+    }
+}
+
+TaskScheduler::TaskPtr TaskScheduler::findTask(size_t self) {
+    if (m_queued.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    const size_t workerCount = m_workers.size();
+    for (size_t priority = 0; priority < TASK_PRIORITY_COUNT; ++priority) {
+        if (self < workerCount) {
+            Worker& worker = *m_workers[self];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.queues[priority];
+            if (!queue.empty()) {
+                TaskPtr task = std::move(queue.back());
+                queue.pop_back();
+                return task;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_globalMutex);
+            auto& queue = m_globalQueues[priority];
+            if (!queue.empty()) {
+                TaskPtr task = std::move(queue.front());
+                queue.pop_front();
+                return task;
+            }
+        }
+
+        // 窃取：从下一个线程开始轮询，正被占用的队列直接跳过
+        for (size_t offset = 1; offset <= workerCount; ++offset) {
+            const size_t victim = (self == NOT_A_WORKER ? offset - 1 : self + offset) % workerCount;
+            if (victim == self) {
+                continue;
+            }
+            Worker& worker = *m_workers[victim];
+            std::unique_lock<std::mutex> lock(worker.mutex, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                continue;
+            }
+            auto& queue = worker.queues[priority];
+            if (!queue.empty()) {
+                TaskPtr task = std::move(queue.front());
+                queue.pop_front();
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool TaskScheduler::runPendingTask(size_t self) {
+    TaskPtr task = findTask(self);
+    if (!task) {
+        return false;
+    }
+    m_queued.fetch_sub(1, std::memory_order_acq_rel);
+    runTask(task);
+    return true;
+}
+
+void TaskScheduler::runTask(const TaskPtr& task) {
+    const Clock::time_point start = Clock::now();
+    if (!task->execute()) {
+        // 排队期间已通过句柄取消
+        m_cancelled.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const Clock::time_point end = Clock::now();
+
+    switch (task->getStatus()) {
+        case TaskStatus::COMPLETED:
+            m_completed.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case TaskStatus::FAILED:
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+            break;
+        default:
+            m_cancelled.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+
+    const auto latency = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(start - task->getSubmitTime()).count());
+    const auto runTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+    m_latencyTotalNs.fetch_add(latency, std::memory_order_relaxed);
+    m_runTotalNs.fetch_add(runTime, std::memory_order_relaxed);
+    updateMax(m_latencyMaxNs, latency);
+}
+
+void TaskScheduler::workerLoop(size_t index) {
+    t_scheduler = this;
+    t_workerIndex = index;
+
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        if (runPendingTask(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_sleepCondition.wait(lock, [this]() {
+            return m_stopping.load(std::memory_order_acquire) || m_queued.load(std::memory_order_seq_cst) > 0;
+        });
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    t_scheduler = nullptr;
+    t_workerIndex = NOT_A_WORKER;
+}
+
+void TaskScheduler::wait(detail::TaskStateBase& task) {
+    if (!isWorkerThread()) {
+        task.wait();
+        return;
+    }
+    // 工作线程上阻塞等待可能让所有线程都在等别人，改为边等边执行其他任务
+    while (!task.isFinished()) {
+        if (!runPendingTask(t_workerIndex)) {
+            task.waitFor(std::chrono::microseconds(200));
+        }
+    }
+}
+
+bool TaskScheduler::isWorkerThread() const noexcept {
+    return t_scheduler == this && t_workerIndex != NOT_A_WORKER;
+}
+
+size_t TaskScheduler::getWorkerCount() const {
+    // 不加生命周期锁：stop() 持锁等待工作线程退出，工作线程里的任务或统计查询在此时调用会死锁
+    return m_workerCount.load(std::memory_order_relaxed);
+}
+
+void TaskScheduler::runOnMainThread(std::function<void()> callback) {
+    if (!callback) {
+        return;
+    }
+    std::function<void()> wake;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        if (m_mainQueue.empty()) {
+            wake = m_wakeCallback;
+        }
+        m_mainQueue.push_back(std::move(callback));
+    }
+    if (wake) {
+        wake();
+    }
+}
+
+void TaskScheduler::runOnMainThreadAfter(Clock::duration delay, std::function<void()> callback) {
+    if (!callback) {
+        return;
+    }
+    std::function<void()> wake;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        const Clock::time_point deadline = Clock::now() + delay;
+        // 新的定时回调最早到期时，主循环需要按新的截止时间安排下一帧
+        if (m_mainTimers.empty() || deadline < m_mainTimers.front().deadline) {
+            wake = m_wakeCallback;
+        }
+        m_mainTimers.push_back({deadline, m_timerSequence++, std::move(callback)});
+        std::push_heap(m_mainTimers.begin(), m_mainTimers.end(), laterTimer);
+    }
+    if (wake) {
+        wake();
+    }
+}
+
+std::optional<TaskScheduler::Clock::time_point> TaskScheduler::getNextMainThreadDeadline() const {
+    std::lock_guard<std::mutex> lock(m_mainMutex);
+    if (m_mainTimers.empty()) {
+        return std::nullopt;
+    }
+    return m_mainTimers.front().deadline;
+}
+
+size_t TaskScheduler::runMainThreadContinuations() {
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        batch.swap(m_mainQueue);
+        const Clock::time_point now = Clock::now();
+        while (!m_mainTimers.empty() && m_mainTimers.front().deadline <= now) {
+            std::pop_heap(m_mainTimers.begin(), m_mainTimers.end(), laterTimer);
+            batch.push_back(std::move(m_mainTimers.back().callback));
+            m_mainTimers.pop_back();
+        }
+        if (batch.empty()) {
+            return 0;
+        }
+    }
+
+    for (auto& callback : batch) {
+        try {
+            callback();
+        } catch (const std::exception& e) {
+            DEARTS_LOG_ERROR("主线程任务回调抛出异常: " + std::string(e.what()));
+        }
+    }
+    m_continuations.fetch_add(batch.size(), std::memory_order_relaxed);
+    return batch.size();
+}
+
+void TaskScheduler::setWakeCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(m_mainMutex);
+    m_wakeCallback = std::move(callback);
+}
+
+TaskSchedulerMetrics TaskScheduler::getMetrics() const {
+    TaskSchedulerMetrics metrics;
+    metrics.workers = getWorkerCount();
+    metrics.queueDepth = m_queued.load(std::memory_order_relaxed);
+    metrics.maxQueueDepth = m_maxQueued.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        metrics.mainThreadPending = m_mainQueue.size() + m_mainTimers.size();
+    }
+    metrics.submitted = m_submitted.load(std::memory_order_relaxed);
+    metrics.completed = m_completed.load(std::memory_order_relaxed);
+    metrics.failed = m_failed.load(std::memory_order_relaxed);
+    metrics.cancelled = m_cancelled.load(std::memory_order_relaxed);
+    metrics.steals = m_steals.load(std::memory_order_relaxed);
+    metrics.continuations = m_continuations.load(std::memory_order_relaxed);
+
+    const uint64_t executed = m_executed.load(std::memory_order_relaxed);
+    if (executed > 0) {
+        metrics.avgLatencyUs = static_cast<double>(m_latencyTotalNs.load(std::memory_order_relaxed)) / executed / 1000.0;
+        metrics.avgRunUs = static_cast<double>(m_runTotalNs.load(std::memory_order_relaxed)) / executed / 1000.0;
+    }
+    metrics.maxLatencyUs = static_cast<double>(m_latencyMaxNs.load(std::memory_order_relaxed)) / 1000.0;
+    return metrics;
+}
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
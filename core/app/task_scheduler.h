@@ -0,0 +1,614 @@
+/**
+ * @file task_scheduler.h
+ * @brief 后台任务调度器：工作窃取线程池 + 主线程续体队列
+ * @details 后台工作（路径搜索、文本分词、历史记录保存、字体读取等）统一交给这里，而不是各自开线程：
+ *          - 每个工作线程有自己的任务双端队列，线程内提交的子任务压入本地队列尾部并优先执行（LIFO），
+ *            空闲线程从其他线程队列头部窃取；非工作线程（主线程）提交的任务进入全局队列；
+ *          - 三档优先级，每档独立排队，工作线程总是先取高优先级任务；
+ *          - 任务可取消：开始前取消的任务不再执行，执行中的任务通过 TaskContext 检查取消标志自行退出；
+ *          - 任务通过 TaskContext 报告进度，界面通过 TaskHandle::getProgress() 读取；
+ *          - then() 注册的回调在主线程执行（Application::pumpFrameWork() 每帧调用 runMainThreadContinuations()，
+ *            Application::run() 和 GUIApplication::run() 的主循环都调用它），
+ *            回调里可以直接修改界面状态，无需加锁；runOnMainThreadAfter() 提供主线程定时回调；
+ *          - getMetrics() 提供队列深度、窃取次数、排队延迟等统计。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "dearts/dearts_config.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace App {
+
+/**
+ * @brief 任务优先级
+ */
+enum class TaskPriority : uint8_t {
+    HIGH = 0,       ///< 用户正在等待结果（分词、界面字体）
+    NORMAL = 1,     ///< 一般后台工作（路径搜索）
+    LOW = 2         ///< 可以推迟的工作（持久化）
+};
+
+constexpr size_t TASK_PRIORITY_COUNT = 3;
+
+/**
+ * @brief 任务状态
+ */
+enum class TaskStatus : uint8_t {
+    PENDING,        ///< 排队中
+    RUNNING,        ///< 执行中
+    COMPLETED,      ///< 正常完成
+    FAILED,         ///< 抛出异常
+    CANCELLED       ///< 开始前被取消，或执行中抛出 TaskCancelledError
+};
+
+/**
+ * @brief 任务进度
+ */
+struct TaskProgress {
+    float fraction = 0.0f;      ///< 完成比例 [0, 1]
+    std::string message;        ///< 当前阶段描述
+};
+
+/**
+ * @brief 任务中途响应取消时抛出（TaskContext::throwIfCancelled），任务以 CANCELLED 结束
+ */
+class TaskCancelledError : public std::runtime_error {
+public:
+    TaskCancelledError() : std::runtime_error("任务已取消") {}
+};
+
+/**
+ * @brief 取消令牌（只读），默认构造的令牌永远不会被取消
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    bool isCancelled() const noexcept { return m_flag && m_flag->load(std::memory_order_acquire); }
+
+private:
+    friend class CancellationSource;
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> flag) : m_flag(std::move(flag)) {}
+
+    std::shared_ptr<const std::atomic<bool>> m_flag;
+};
+
+/**
+ * @brief 取消源：一次取消多个任务（如布局关闭时取消它提交的全部任务）
+ */
+class CancellationSource {
+public:
+    CancellationSource() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    CancellationToken getToken() const { return CancellationToken(m_flag); }
+    void cancel() noexcept { m_flag->store(true, std::memory_order_release); }
+    bool isCancelled() const noexcept { return m_flag->load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_flag;
+};
+
+/**
+ * @brief 调度器统计
+ */
+struct TaskSchedulerMetrics {
+    size_t workers = 0;             ///< 工作线程数
+    size_t queueDepth = 0;          ///< 当前排队的任务数
+    size_t maxQueueDepth = 0;       ///< 排队任务数峰值
+    size_t mainThreadPending = 0;   ///< 等待在主线程执行的回调数
+    uint64_t submitted = 0;         ///< 提交的任务数
+    uint64_t completed = 0;         ///< 正常完成的任务数
+    uint64_t failed = 0;            ///< 抛出异常的任务数
+    uint64_t cancelled = 0;         ///< 取消的任务数
+    uint64_t steals = 0;            ///< 从其他工作线程窃取的任务数
+    uint64_t continuations = 0;     ///< 在主线程执行的回调数
+    double avgLatencyUs = 0.0;      ///< 从提交到开始执行的平均等待（微秒）
+    double maxLatencyUs = 0.0;      ///< 从提交到开始执行的最长等待（微秒）
+    double avgRunUs = 0.0;          ///< 平均执行时间（微秒）
+};
+
+class TaskContext;
+class TaskScheduler;
+
+namespace detail {
+
+/**
+ * @brief 任务的共享状态（调度器、句柄、回调共同持有）
+ */
+class DEARTS_API TaskStateBase : public std::enable_shared_from_this<TaskStateBase> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TaskStateBase(TaskPriority priority, CancellationToken token)
+        : m_priority(priority), m_token(std::move(token)) {}
+    virtual ~TaskStateBase() = default;
+
+    TaskStateBase(const TaskStateBase&) = delete;
+    TaskStateBase& operator=(const TaskStateBase&) = delete;
+
+    /**
+     * @brief 在工作线程执行任务
+     * @return false 表示任务开始前已被取消，没有执行
+     */
+    bool execute();
+
+    /**
+     * @brief 请求取消
+     * @return 任务尚未开始、因此不会再执行时返回 true
+     */
+    bool cancel();
+
+    bool isCancellationRequested() const noexcept {
+        return m_cancelRequested.load(std::memory_order_acquire) || m_token.isCancelled();
+    }
+
+    TaskStatus getStatus() const noexcept { return m_status.load(std::memory_order_acquire); }
+    bool isFinished() const noexcept { return getStatus() >= TaskStatus::COMPLETED; }
+
+    /**
+     * @brief 阻塞直到任务结束（不帮助执行其他任务，工作线程上请用 TaskScheduler::wait）
+     */
+    void wait() const;
+
+    /**
+     * @brief 最多阻塞一段时间
+     * @return 任务是否已结束
+     */
+    bool waitFor(std::chrono::microseconds timeout) const;
+
+    void setProgress(float fraction, std::string message);
+    TaskProgress getProgress() const;
+
+    /**
+     * @brief 任务失败时的异常（未失败时为空）
+     */
+    std::exception_ptr getError() const;
+
+    /**
+     * @brief 设置结束回调，在主线程执行；任务已结束时立即投递
+     * @param onCompleted 正常完成且未被取消时调用
+     * @param onFailed 任务抛出异常时调用，参数为异常描述
+     */
+    void setContinuation(std::function<void()> onCompleted, std::function<void(const std::string&)> onFailed);
+
+    /**
+     * @brief 设置结束通知，在主线程执行；无论完成、失败还是取消都会调用（协程据此恢复）
+     */
+    void setFinishCallback(std::function<void()> onFinished);
+
+    TaskPriority getPriority() const noexcept { return m_priority; }
+    Clock::time_point getSubmitTime() const noexcept { return m_submitTime; }
+    void markSubmitted() noexcept { m_submitTime = Clock::now(); }
+
+protected:
+    virtual void run(TaskContext& context) = 0;
+    /**
+     * @brief 执行或取消后立即释放可调用对象及其捕获
+     */
+    virtual void releaseCallable() noexcept = 0;
+
+private:
+    void finish(TaskStatus status, std::exception_ptr error);
+    void postContinuation(TaskStatus status);
+
+    const TaskPriority m_priority;
+    const CancellationToken m_token;
+    Clock::time_point m_submitTime;
+
+    std::atomic<bool> m_claimed{false};             ///< 已被执行或取消（两者只有一个成功）
+    std::atomic<bool> m_cancelRequested{false};
+    std::atomic<TaskStatus> m_status{TaskStatus::PENDING};
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_finished;
+    TaskProgress m_progress;
+    std::exception_ptr m_error;
+    std::function<void()> m_onCompleted;
+    std::function<void(const std::string&)> m_onFailed;
+    std::function<void()> m_onFinished;
+};
+
+/**
+ * @brief 带返回值的任务状态
+ */
+template <typename T>
+class TaskResultState : public TaskStateBase {
+public:
+    using TaskStateBase::TaskStateBase;
+
+    /**
+     * @brief 结果（任务正常完成后才能访问）
+     */
+    T& result() { return *m_result; }
+
+protected:
+    std::optional<T> m_result;
+};
+
+template <>
+class TaskResultState<void> : public TaskStateBase {
+public:
+    using TaskStateBase::TaskStateBase;
+};
+
+/**
+ * @brief 可调用对象的返回类型，可调用对象可以接受 TaskContext& 参数，也可以不接受
+ */
+template <typename F, typename = void>
+struct TaskInvokeResult {
+    using type = std::invoke_result_t<F&>;
+};
+
+template <typename F>
+struct TaskInvokeResult<F, std::enable_if_t<std::is_invocable_v<F&, TaskContext&>>> {
+    using type = std::invoke_result_t<F&, TaskContext&>;
+};
+
+template <typename T, typename F>
+class TaskState final : public TaskResultState<T> {
+public:
+    template <typename Callable>
+    TaskState(Callable&& callable, TaskPriority priority, CancellationToken token)
+        : TaskResultState<T>(priority, std::move(token)), m_callable(std::forward<Callable>(callable)) {}
+
+protected:
+    void run(TaskContext& context) override {
+        if constexpr (std::is_void_v<T>) {
+            invoke(context);
+        } else {
+            this->m_result.emplace(invoke(context));
+        }
+    }
+
+    void releaseCallable() noexcept override { m_callable.reset(); }
+
+private:
+    decltype(auto) invoke(TaskContext& context) {
+        if constexpr (std::is_invocable_v<F&, TaskContext&>) {
+            return (*m_callable)(context);
+        } else {
+            return (*m_callable)();
+        }
+    }
+
+    std::optional<F> m_callable;
+};
+
+} // namespace detail
+
+/**
+ * @brief 任务执行上下文，传给接受 TaskContext& 参数的任务
+ */
+class TaskContext {
+public:
+    explicit TaskContext(detail::TaskStateBase& state) : m_state(state) {}
+
+    /**
+     * @brief 是否已请求取消（句柄 cancel() 或提交时传入的令牌）
+     */
+    bool isCancelled() const noexcept { return m_state.isCancellationRequested(); }
+
+    /**
+     * @brief 已请求取消时抛出 TaskCancelledError
+     */
+    void throwIfCancelled() const {
+        if (isCancelled()) {
+            throw TaskCancelledError();
+        }
+    }
+
+    /**
+     * @brief 报告进度
+     * @param fraction 完成比例 [0, 1]
+     * @param message 阶段描述
+     */
+    void reportProgress(float fraction, std::string message = {}) { m_state.setProgress(fraction, std::move(message)); }
+
+private:
+    detail::TaskStateBase& m_state;
+};
+
+/**
+ * @brief 任务句柄
+ * @details 句柄析构不会取消或等待任务；持有 this 的任务须在对象析构时 cancel() 并 wait()。
+ */
+template <typename T>
+class TaskHandle {
+public:
+    TaskHandle() = default;
+    explicit TaskHandle(std::shared_ptr<detail::TaskResultState<T>> state) : m_state(std::move(state)) {}
+
+    bool isValid() const noexcept { return m_state != nullptr; }
+    explicit operator bool() const noexcept { return isValid(); }
+
+    /**
+     * @brief 任务是否已结束（完成、失败或取消）
+     */
+    bool isReady() const noexcept { return m_state && m_state->isFinished(); }
+
+    /**
+     * @brief 任务是否已提交且尚未结束
+     */
+    bool isPending() const noexcept { return m_state && !m_state->isFinished(); }
+
+    TaskStatus getStatus() const noexcept { return m_state ? m_state->getStatus() : TaskStatus::CANCELLED; }
+
+    TaskProgress getProgress() const { return m_state ? m_state->getProgress() : TaskProgress{}; }
+
+    /**
+     * @brief 请求取消；未开始的任务不再执行，已排队的 then() 回调也不再调用
+     */
+    void cancel() {
+        if (m_state) {
+            m_state->cancel();
+        }
+    }
+
+    /**
+     * @brief 阻塞直到任务结束；在工作线程上调用时，等待期间帮助执行其他任务
+     */
+    void wait() const;
+
+    /**
+     * @brief 等待并取得结果
+     * @details 任务抛出的异常原样重新抛出；任务被取消时抛出 TaskCancelledError
+     */
+    T get();
+
+    /**
+     * @brief 注册在主线程执行的回调
+     * @param onCompleted 正常完成且未被取消时调用，参数为结果的引用（void 任务无参数）
+     * @param onFailed 任务抛出异常时调用，参数为异常描述；为空时只记录日志
+     */
+    template <typename F>
+    TaskHandle& then(F&& onCompleted, std::function<void(const std::string&)> onFailed = nullptr) {
+        if (!m_state) {
+            return *this;
+        }
+        // 回调只捕获裸指针：执行时由主线程队列中的包装持有任务状态
+        detail::TaskResultState<T>* state = m_state.get();
+        m_state->setContinuation(
+            [state, callback = std::forward<F>(onCompleted)]() mutable {
+                if constexpr (std::is_void_v<T>) {
+                    (void)state;
+                    callback();
+                } else {
+                    callback(state->result());
+                }
+            },
+            std::move(onFailed));
+        return *this;
+    }
+
+    /**
+     * @brief 注册在主线程执行的结束通知，任务完成、失败或取消都会调用
+     */
+    TaskHandle& onFinished(std::function<void()> callback) {
+        if (m_state) {
+            m_state->setFinishCallback(std::move(callback));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 释放句柄（不取消任务）
+     */
+    void reset() noexcept { m_state.reset(); }
+
+private:
+    std::shared_ptr<detail::TaskResultState<T>> m_state;
+};
+
+/**
+ * @brief 后台任务调度器（单例）
+ * @details submit()、runOnMainThread()、getMetrics() 线程安全；
+ *          runMainThreadContinuations() 只在主线程调用。
+ */
+class DEARTS_API TaskScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static TaskScheduler& getInstance();
+
+    /**
+     * @brief 启动工作线程；第一次 submit() 时若尚未启动会自动以默认线程数启动
+     * @param workerCount 工作线程数，0 表示硬件线程数减一（主线程自己占一个），至少一个
+     */
+    void initialize(size_t workerCount = 0);
+
+    /**
+     * @brief 停止工作线程：等待正在执行的任务结束，尚未开始的任务取消，未执行的主线程回调丢弃
+     * @details 之后提交的任务立即以 CANCELLED 结束，直到再次调用 initialize()
+     */
+    void shutdown();
+
+    /**
+     * @brief 提交任务
+     * @param function 可调用对象，签名为 R() 或 R(TaskContext&)
+     * @param priority 优先级
+     * @param token 额外的取消令牌（如布局级的 CancellationSource）
+     */
+    template <typename F>
+    auto submit(F&& function, TaskPriority priority = TaskPriority::NORMAL, CancellationToken token = {}) {
+        using Callable = std::decay_t<F>;
+        using Result = typename detail::TaskInvokeResult<Callable>::type;
+        auto state = std::make_shared<detail::TaskState<Result, Callable>>(std::forward<F>(function), priority,
+                                                                           std::move(token));
+        enqueue(state);
+        return TaskHandle<Result>(std::move(state));
+    }
+
+    /**
+     * @brief 把回调投递到主线程，下一次 runMainThreadContinuations() 时执行
+     */
+    void runOnMainThread(std::function<void()> callback);
+
+    /**
+     * @brief 一段时间后在主线程执行回调（到期后的第一次 runMainThreadContinuations() 执行）
+     */
+    void runOnMainThreadAfter(Clock::duration delay, std::function<void()> callback);
+
+    /**
+     * @brief 最早一个主线程定时回调的到期时间，主循环据此安排下一帧
+     */
+    std::optional<Clock::time_point> getNextMainThreadDeadline() const;
+
+    /**
+     * @brief 执行已投递到主线程的全部回调及已到期的定时回调（主循环每帧调用一次）
+     * @return 执行的回调数；回调中再投递的回调留到下一次
+     */
+    size_t runMainThreadContinuations();
+
+    /**
+     * @brief 设置唤醒回调，主线程回调队列由空变为非空时在投递线程调用（用于唤醒阻塞中的主循环）
+     * @details 须在开始提交任务之前设置
+     */
+    void setWakeCallback(std::function<void()> callback);
+
+    /**
+     * @brief 等待任务结束；在工作线程上调用时帮助执行其他任务，避免所有线程互相等待
+     */
+    void wait(detail::TaskStateBase& task);
+
+    /**
+     * @brief 当前线程是否为本调度器的工作线程
+     */
+    bool isWorkerThread() const noexcept;
+
+    size_t getWorkerCount() const;
+
+    TaskSchedulerMetrics getMetrics() const;
+
+private:
+    TaskScheduler() = default;
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    using TaskPtr = std::shared_ptr<detail::TaskStateBase>;
+    using TaskQueues = std::array<std::deque<TaskPtr>, TASK_PRIORITY_COUNT>;
+
+    /**
+     * @brief 工作线程及其本地队列；本线程从尾部取，其他线程从头部窃取
+     */
+    struct Worker {
+        std::mutex mutex;
+        TaskQueues queues;
+        std::thread thread;
+    };
+
+    /**
+     * @brief 停止工作线程并清空队列
+     * @return 调度器原先是否在运行
+     */
+    bool stop(size_t& cancelledTasks, size_t& droppedCallbacks);
+    void enqueue(TaskPtr task);
+    void workerLoop(size_t index);
+
+    /**
+     * @brief 按优先级依次查找：本地队列、全局队列、窃取其他线程
+     * @param self 当前工作线程序号，非工作线程传 SIZE_MAX
+     */
+    TaskPtr findTask(size_t self);
+    /**
+     * @brief 取出并执行一个任务
+     * @return 是否找到任务
+     */
+    bool runPendingTask(size_t self);
+    void runTask(const TaskPtr& task);
+
+    mutable std::mutex m_lifecycleMutex;            ///< 保护启动与停止
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_workerCount{0};           ///< 工作线程数，供 getWorkerCount()/getMetrics() 无锁读取
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_stopping{false};
+    bool m_shutDown = false;                        ///< 显式 shutdown() 之后不再自动启动
+
+    std::mutex m_globalMutex;
+    TaskQueues m_globalQueues;                      ///< 非工作线程提交的任务
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<size_t> m_sleeping{0};
+    std::atomic<size_t> m_queued{0};                ///< 所有队列中的任务数（含已取消未取出的）
+
+    /**
+     * @brief 主线程定时回调
+     */
+    struct MainThreadTimer {
+        Clock::time_point deadline;
+        uint64_t sequence;                          ///< 同一时刻到期的按投递顺序执行
+        std::function<void()> callback;
+    };
+
+    mutable std::mutex m_mainMutex;
+    std::vector<std::function<void()>> m_mainQueue;
+    std::vector<MainThreadTimer> m_mainTimers;      ///< 按到期时间排列的小顶堆
+    uint64_t m_timerSequence = 0;
+    std::function<void()> m_wakeCallback;
+
+    // 统计
+    std::atomic<size_t> m_maxQueued{0};
+    std::atomic<uint64_t> m_submitted{0};
+    std::atomic<uint64_t> m_completed{0};
+    std::atomic<uint64_t> m_failed{0};
+    std::atomic<uint64_t> m_cancelled{0};
+    std::atomic<uint64_t> m_steals{0};
+    std::atomic<uint64_t> m_continuations{0};
+    std::atomic<uint64_t> m_executed{0};
+    std::atomic<uint64_t> m_latencyTotalNs{0};
+    std::atomic<uint64_t> m_latencyMaxNs{0};
+    std::atomic<uint64_t> m_runTotalNs{0};
+};
+
+template <typename T>
+void TaskHandle<T>::wait() const {
+    if (m_state) {
+        TaskScheduler::getInstance().wait(*m_state);
+    }
+}
+
+template <typename T>
+T TaskHandle<T>::get() {
+    if (!m_state) {
+        throw TaskCancelledError();
+    }
+    wait();
+    switch (m_state->getStatus()) {
+        case TaskStatus::FAILED:
+            std::rethrow_exception(m_state->getError());
+        case TaskStatus::CANCELLED:
+            throw TaskCancelledError();
+        default:
+            break;
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(m_state->result());
+    }
+}
+
+} // namespace App
+} // namespace Core
+} // namespace DearTs
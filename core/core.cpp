@@ -100,6 +100,8 @@ bool InitializeCore(const std::string& config) {
         // 初始化日志系统 - 启用文件输出
         auto& logger = DearTs::Utils::getLogger();
         logger.setLevel(DearTs::Utils::LogLevel::LOG_INFO);
+        // 按 10MB 或跨天轮转，保留最近 10 个压缩后的历史文件
+        logger.setRotationPolicy({10 * 1024 * 1024, true, 10, true});
         logger.enableFileOutput("logs/dearts.log");
         logger.info("正在初始化DearTs核心系统...");
         
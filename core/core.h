@@ -141,14 +141,7 @@ namespace DearTs {
 // 现代C++日志系统 - 已移除宏定义，使用Logger类
 // 日志功能现在通过 DearTs::Log 命名空间提供
 
-// 性能分析宏
-#ifdef DEARTS_DEBUG
-    #define DEARTS_PROFILE_SCOPE(name) DearTs::ProfilerScope _prof_scope(name)
-    #define DEARTS_PROFILE_FUNCTION() DEARTS_PROFILE_SCOPE(__FUNCTION__)
-#else
-    #define DEARTS_PROFILE_SCOPE(name) ((void)0)
-    #define DEARTS_PROFILE_FUNCTION() ((void)0)
-#endif
+// 性能分析宏（DEARTS_PROFILE_SCOPE / DEARTS_PROFILE_FUNCTION 等）定义在 utils/profiler.h
 
 // 标准库头文件
 #include <memory>
@@ -179,9 +172,12 @@ namespace DearTs {
 
 // 事件系统
 #include "events/event_system.h"
+#include "events/event_queue.h"
 
 // 应用程序管理
 #include "app/application_manager.h"
+#include "app/task_scheduler.h"
+#include "app/coroutine_task.h"
 
 // 窗口管理
 #include "window/window_manager.h"
@@ -0,0 +1,205 @@
+/**
+ * @file event_delegate.h
+ * @brief 小缓冲区委托，事件处理器的轻量替代
+ * @details 与 std::function 用法相同，区别在于：
+ *          - 不超过 INLINE_SIZE 字节、可无异常移动的可调用对象直接存放在委托内部，
+ *            捕获 this 或少量引用的 lambda 不会分配内存；更大的对象才放到堆上；
+ *          - 调用只经过一次函数指针跳转，复制、移动、析构走单独的操作表，不影响调用路径。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace DearTs {
+namespace Core {
+namespace Events {
+
+template <typename Signature>
+class EventDelegate;
+
+/**
+ * @brief 小缓冲区委托
+ * @tparam R 返回类型
+ * @tparam Args 参数类型
+ */
+template <typename R, typename... Args>
+class EventDelegate<R(Args...)> {
+public:
+    static constexpr size_t INLINE_SIZE = 4 * sizeof(void*);   ///< 内联存放的可调用对象最大字节数
+
+    EventDelegate() noexcept = default;
+    EventDelegate(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief 由任意可调用对象构造（空函数指针、空 std::function 得到空委托）
+     */
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, EventDelegate> &&
+                                          std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    EventDelegate(F&& callable) {
+        using Callable = std::decay_t<F>;
+        if constexpr (isNullable<Callable>()) {
+            if (!callable) {
+                return;
+            }
+        }
+        if constexpr (fitsInline<Callable>()) {
+            new (m_storage) Callable(std::forward<F>(callable));
+            m_invoke = &invokeInline<Callable>;
+            m_ops = &INLINE_OPS<Callable>;
+        } else {
+            *reinterpret_cast<Callable**>(m_storage) = new Callable(std::forward<F>(callable));
+            m_invoke = &invokeHeap<Callable>;
+            m_ops = &HEAP_OPS<Callable>;
+        }
+    }
+
+    EventDelegate(const EventDelegate& other) {
+        if (other.m_ops) {
+            other.m_ops->copy(m_storage, other.m_storage);
+            m_invoke = other.m_invoke;
+            m_ops = other.m_ops;
+        }
+    }
+
+    EventDelegate(EventDelegate&& other) noexcept {
+        moveFrom(other);
+    }
+
+    EventDelegate& operator=(const EventDelegate& other) {
+        if (this != &other) {
+            EventDelegate copy(other);
+            reset();
+            moveFrom(copy);
+        }
+        return *this;
+    }
+
+    EventDelegate& operator=(EventDelegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    EventDelegate& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~EventDelegate() { reset(); }
+
+    /**
+     * @brief 调用委托，委托为空时抛出 std::bad_function_call
+     */
+    R operator()(Args... args) const {
+        if (!m_invoke) {
+            throw std::bad_function_call();
+        }
+        return m_invoke(const_cast<unsigned char*>(m_storage), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return m_invoke != nullptr; }
+
+    /**
+     * @brief 可调用对象是否存放在委托内部（未分配内存）
+     */
+    bool isInline() const noexcept { return m_ops && m_ops->inlineStorage; }
+
+private:
+    /**
+     * @brief 复制、移动、析构操作表，每种可调用对象一份
+     */
+    struct Ops {
+        void (*copy)(unsigned char* dst, const unsigned char* src);
+        void (*move)(unsigned char* dst, unsigned char* src) noexcept;
+        void (*destroy)(unsigned char* storage) noexcept;
+        bool inlineStorage;
+    };
+
+    template <typename Callable>
+    static constexpr bool isNullable() {
+        return std::is_pointer_v<Callable> || std::is_member_pointer_v<Callable> ||
+               std::is_same_v<Callable, std::function<R(Args...)>>;
+    }
+
+    template <typename Callable>
+    static constexpr bool fitsInline() {
+        return sizeof(Callable) <= INLINE_SIZE && alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    template <typename Callable>
+    static R invokeInline(unsigned char* storage, Args&&... args) {
+        return std::invoke(*std::launder(reinterpret_cast<Callable*>(storage)), std::forward<Args>(args)...);
+    }
+
+    template <typename Callable>
+    static R invokeHeap(unsigned char* storage, Args&&... args) {
+        return std::invoke(**reinterpret_cast<Callable**>(storage), std::forward<Args>(args)...);
+    }
+
+    template <typename Callable>
+    static constexpr Ops INLINE_OPS = {
+        [](unsigned char* dst, const unsigned char* src) {
+            new (dst) Callable(*std::launder(reinterpret_cast<const Callable*>(src)));
+        },
+        [](unsigned char* dst, unsigned char* src) noexcept {
+            Callable* source = std::launder(reinterpret_cast<Callable*>(src));
+            new (dst) Callable(std::move(*source));
+            source->~Callable();
+        },
+        [](unsigned char* storage) noexcept {
+            std::launder(reinterpret_cast<Callable*>(storage))->~Callable();
+        },
+        true,
+    };
+
+    template <typename Callable>
+    static constexpr Ops HEAP_OPS = {
+        [](unsigned char* dst, const unsigned char* src) {
+            *reinterpret_cast<Callable**>(dst) = new Callable(**reinterpret_cast<Callable* const*>(src));
+        },
+        [](unsigned char* dst, unsigned char* src) noexcept {
+            *reinterpret_cast<Callable**>(dst) = *reinterpret_cast<Callable**>(src);
+        },
+        [](unsigned char* storage) noexcept {
+            delete *reinterpret_cast<Callable**>(storage);
+        },
+        false,
+    };
+
+    void moveFrom(EventDelegate& other) noexcept {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_invoke = other.m_invoke;
+            m_ops = other.m_ops;
+            other.m_invoke = nullptr;
+            other.m_ops = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_invoke = nullptr;
+            m_ops = nullptr;
+        }
+    }
+
+    R (*m_invoke)(unsigned char*, Args&&...) = nullptr;
+    const Ops* m_ops = nullptr;
+    alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+};
+
+} // namespace Events
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,261 @@
+/**
+ * @file event_queue.cpp
+ * @brief 跨线程的延迟事件队列实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "event_queue.h"
+#include <algorithm>
+#include <mutex>
+
+namespace DearTs {
+namespace Core {
+namespace Events {
+
+namespace {
+
+constexpr size_t THREAD_CACHE_SIZE = 64;    ///< 每个线程缓存的节点数，也是一次补充的数量
+constexpr size_t MAX_POOLED_NODES = 65536;  ///< 全局池保留的节点上限，超出的直接释放
+
+/**
+ * @brief 全局节点池
+ * @details 所有队列共用，进程结束前不销毁：线程缓存可能在静态对象析构之后才归还节点
+ */
+struct NodePool {
+    std::mutex mutex;
+    std::vector<void*> free;
+    std::atomic<uint64_t> allocated{0};
+    std::atomic<uint64_t> freed{0};
+};
+
+NodePool& nodePool() {
+    static NodePool* pool = new NodePool();
+    return *pool;
+}
+
+/**
+ * @brief 线程本地节点缓存，线程结束时归还全局池
+ */
+struct ThreadCache {
+    std::vector<void*> nodes;
+
+    ~ThreadCache() {
+        if (nodes.empty()) {
+            return;
+        }
+        // 每个线程最多归还 THREAD_CACHE_SIZE 个，这里不受全局池上限约束
+        NodePool& pool = nodePool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.free.insert(pool.free.end(), nodes.begin(), nodes.end());
+    }
+};
+
+ThreadCache& threadCache() {
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+} // namespace
+
+EventQueue::EventQueue()
+    : m_head(acquireNode()) {
+    m_tail.store(m_head, std::memory_order_relaxed);
+    setCoalescing(EventType::EVT_WINDOW_RESIZED, true);
+    setCoalescing(EventType::EVT_MOUSE_MOVED, true);
+    setCoalescing(EventType::EVT_LAYOUT_UPDATED, true);
+    setCoalescing(EventType::EVT_SEARCH_PROGRESS, true);
+}
+
+EventQueue::~EventQueue() {
+    clear();
+    destroyEvent(m_head);
+    releaseNodes(&m_head, 1);
+}
+
+EventQueue::Node* EventQueue::acquireNode() {
+    ThreadCache& cache = threadCache();
+    if (cache.nodes.empty()) {
+        NodePool& pool = nodePool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        const size_t take = std::min(pool.free.size(), THREAD_CACHE_SIZE);
+        cache.nodes.insert(cache.nodes.end(), pool.free.end() - static_cast<std::ptrdiff_t>(take), pool.free.end());
+        pool.free.resize(pool.free.size() - take);
+    }
+
+    Node* node = nullptr;
+    if (cache.nodes.empty()) {
+        node = new Node();
+        nodePool().allocated.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        node = static_cast<Node*>(cache.nodes.back());
+        cache.nodes.pop_back();
+    }
+    node->event = nullptr;
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+}
+
+void EventQueue::releaseNodes(Node* const* nodes, size_t count) {
+    // 先填满本线程缓存（主线程自己也会投递事件），其余一次性还给全局池；持锁期间只做指针拷贝
+    ThreadCache& cache = threadCache();
+    const size_t cached = std::min(count, THREAD_CACHE_SIZE - std::min(cache.nodes.size(), THREAD_CACHE_SIZE));
+    cache.nodes.insert(cache.nodes.end(), nodes, nodes + cached);
+    if (cached == count) {
+        return;
+    }
+
+    size_t pooled = 0;
+    {
+        NodePool& pool = nodePool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pooled = std::min(count - cached, MAX_POOLED_NODES - std::min(pool.free.size(), MAX_POOLED_NODES));
+        pool.free.insert(pool.free.end(), nodes + cached, nodes + cached + pooled);
+    }
+    for (size_t i = cached + pooled; i < count; ++i) {
+        delete nodes[i];
+    }
+    if (cached + pooled < count) {
+        nodePool().freed.fetch_add(count - cached - pooled, std::memory_order_relaxed);
+    }
+}
+
+void EventQueue::destroyEvent(Node* node) {
+    if (!node->event) {
+        return;
+    }
+    if (node->inlineEvent) {
+        node->event->~Event();
+    } else {
+        delete node->event;
+    }
+    node->event = nullptr;
+}
+
+void EventQueue::post(std::unique_ptr<Event> event, uint64_t coalesceKey) {
+    if (!event) {
+        return;
+    }
+    Node* node = acquireNode();
+    node->event = event.release();
+    node->inlineEvent = false;
+    m_heapEvents.fetch_add(1, std::memory_order_relaxed);
+    push(node, coalesceKey);
+}
+
+void EventQueue::push(Node* node, uint64_t coalesceKey) {
+    node->coalesceKey = coalesceKey;
+    node->type = node->event->getType();
+    const bool wasEmpty = m_pending.fetch_add(1, std::memory_order_acq_rel) == 0;
+
+    // 交换尾指针后再链接到前一个节点；两步之间消费者看到的链表暂时在这里断开，本次取出到此为止
+    Node* previous = m_tail.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+
+    if (wasEmpty && m_wakeCallback) {
+        m_wakeCallback();
+    }
+}
+
+size_t EventQueue::collect(bool coalesce) {
+    m_batch.clear();
+    bool hasCoalescing = false;
+    for (Node* next = m_head->next.load(std::memory_order_acquire); next;
+         next = next->next.load(std::memory_order_acquire)) {
+        m_batch.push_back({next, next->type, next->coalesceKey, false});
+        hasCoalescing = hasCoalescing || isCoalescing(next->type);
+    }
+    if (m_batch.empty()) {
+        return 0;
+    }
+    m_pending.fetch_sub(m_batch.size(), std::memory_order_acq_rel);
+    m_collected += m_batch.size();
+    m_maxBatch = std::max(m_maxBatch, m_batch.size());
+    if (!coalesce || !hasCoalescing) {
+        return m_batch.size();
+    }
+
+    // 从后往前，同类型同键的事件只保留最后一个
+    m_seenKeys.clear();
+    for (auto it = m_batch.rbegin(); it != m_batch.rend(); ++it) {
+        if (!isCoalescing(it->type)) {
+            continue;
+        }
+        const std::pair<EventType, uint64_t> key(it->type, it->coalesceKey);
+        if (std::find(m_seenKeys.begin(), m_seenKeys.end(), key) != m_seenKeys.end()) {
+            it->superseded = true;
+            ++m_coalesced;
+        } else {
+            m_seenKeys.push_back(key);
+        }
+    }
+    return m_batch.size();
+}
+
+void EventQueue::finishBatch(size_t destroyed) {
+    // 分发中途抛出异常或直接丢弃时，剩余事件在这里销毁
+    m_recycle.clear();
+    m_recycle.push_back(m_head);
+    for (size_t i = 0; i < m_batch.size(); ++i) {
+        if (i >= destroyed) {
+            destroyEvent(m_batch[i].node);
+        }
+        m_recycle.push_back(m_batch[i].node);
+    }
+
+    // 最后一个节点成为新的哨兵（它的 next 可能正被生产者写入），其余节点连同旧哨兵回收
+    m_head = m_recycle.back();
+    m_recycle.pop_back();
+    releaseNodes(m_recycle.data(), m_recycle.size());
+    m_batch.clear();
+
+    // 有生产者尚未完成链接时，让主循环再来取一次
+    if (m_pending.load(std::memory_order_acquire) > 0 && m_wakeCallback) {
+        m_wakeCallback();
+    }
+}
+
+size_t EventQueue::clear() {
+    const size_t count = collect(false);
+    if (count > 0) {
+        finishBatch(0);
+    }
+    return count;
+}
+
+void EventQueue::setCoalescing(EventType type, bool enabled) {
+    const size_t index = static_cast<size_t>(type);
+    if (index >= m_coalesce.size()) {
+        if (!enabled) {
+            return;
+        }
+        m_coalesce.resize(index + 1, false);
+    }
+    m_coalesce[index] = enabled;
+}
+
+bool EventQueue::isCoalescing(EventType type) const {
+    const size_t index = static_cast<size_t>(type);
+    return index < m_coalesce.size() && m_coalesce[index];
+}
+
+EventQueueStats EventQueue::getStats() const {
+    EventQueueStats stats;
+    stats.posted = m_collected + m_pending.load(std::memory_order_relaxed);
+    stats.dispatched = m_dispatched;
+    stats.coalesced = m_coalesced;
+    stats.heapEvents = m_heapEvents.load(std::memory_order_relaxed);
+    NodePool& pool = nodePool();
+    stats.nodesAllocated = pool.allocated.load(std::memory_order_relaxed);
+    stats.nodesFreed = pool.freed.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        stats.nodesPooled = pool.free.size();
+    }
+    stats.maxBatch = m_maxBatch;
+    return stats;
+}
+
+} // namespace Events
+} // namespace Core
+} // namespace DearTs
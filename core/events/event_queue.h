@@ -0,0 +1,237 @@
+/**
+ * @file event_queue.h
+ * @brief 跨线程的延迟事件队列
+ * @details 任意线程投递事件，主循环每帧取出一次并分发（多生产者单消费者）：
+ *          - 入队为无锁链表（Vyukov MPSC），生产者之间只竞争一次原子交换；
+ *          - 队列节点来自全局节点池，每个线程先从本线程缓存取节点，缓存空了才批量加锁补充；
+ *            取出后的节点先填满消费线程的缓存，其余还给全局池供生产者补充，全局池超出上限的部分直接释放；
+ *            不超过 INLINE_EVENT_SIZE 的事件直接构造在节点内，不单独分配内存；
+ *          - 取出时合并冗余事件：开启合并的事件类型，同一合并键在一批中只分发最后一个
+ *            （默认 EVT_WINDOW_RESIZED、EVT_MOUSE_MOVED、EVT_LAYOUT_UPDATED、EVT_SEARCH_PROGRESS）；
+ *          - 分发期间新投递的事件留到下一次取出，不会在本次循环中无限追加。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "event_system.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Events {
+
+/**
+ * @brief 事件队列统计
+ */
+struct EventQueueStats {
+    uint64_t posted = 0;        ///< 投递的事件数
+    uint64_t dispatched = 0;    ///< 分发的事件数
+    uint64_t coalesced = 0;     ///< 被同类更新事件合并掉的事件数
+    uint64_t heapEvents = 0;    ///< 放不进节点、单独分配的事件数
+    uint64_t nodesAllocated = 0; ///< 节点池新分配的节点数（所有队列共用一个节点池）
+    uint64_t nodesFreed = 0;    ///< 全局池已满、直接释放的节点数
+    size_t nodesPooled = 0;     ///< 全局池中空闲的节点数（不超过上限）
+    size_t maxBatch = 0;        ///< 单次取出的最大事件数
+};
+
+/**
+ * @brief 多生产者单消费者的延迟事件队列
+ * @details post/emplace 可在任意线程调用；drain、setCoalescing 只能在消费线程（主线程）调用
+ */
+class EventQueue {
+public:
+    static constexpr size_t INLINE_EVENT_SIZE = 128;    ///< 节点内联存放事件的最大字节数
+
+    EventQueue();
+
+    /**
+     * @brief 析构时丢弃未分发的事件
+     */
+    ~EventQueue();
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    /**
+     * @brief 在队列节点中构造并投递事件
+     * @tparam T 事件类型（Event 的派生类）
+     */
+    template <typename T, typename... Args>
+    void emplace(Args&&... args) {
+        emplaceWithKey<T>(0, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 构造并投递事件，指定合并键
+     * @param coalesceKey 合并键（如窗口ID），同类型且键相同的事件才会合并
+     */
+    template <typename T, typename... Args>
+    void emplaceWithKey(uint64_t coalesceKey, Args&&... args) {
+        static_assert(std::is_base_of_v<Event, T>, "T 必须派生自 Event");
+        Node* node = acquireNode();
+        try {
+            if constexpr (sizeof(T) <= INLINE_EVENT_SIZE && alignof(T) <= alignof(std::max_align_t)) {
+                node->event = new (node->storage) T(std::forward<Args>(args)...);
+                node->inlineEvent = true;
+            } else {
+                node->event = new T(std::forward<Args>(args)...);
+                node->inlineEvent = false;
+                m_heapEvents.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (...) {
+            node->event = nullptr;
+            releaseNodes(&node, 1);
+            throw;
+        }
+        push(node, coalesceKey);
+    }
+
+    /**
+     * @brief 投递已创建的事件
+     * @param event 事件，为空时忽略
+     * @param coalesceKey 合并键
+     */
+    void post(std::unique_ptr<Event> event, uint64_t coalesceKey = 0);
+
+    /**
+     * @brief 取出当前全部事件，合并后依次交给 sink
+     * @param sink 可调用对象，签名为 void(const Event&)
+     * @return 分发的事件数
+     */
+    template <typename Sink>
+    size_t drain(Sink&& sink) {
+        if (collect() == 0) {
+            return 0;
+        }
+        BatchGuard guard(*this);
+        size_t dispatched = 0;
+        for (const BatchEntry& entry : m_batch) {
+            if (!entry.superseded) {
+                sink(static_cast<const Event&>(*entry.node->event));
+                ++dispatched;
+            }
+            destroyEvent(entry.node);
+            ++guard.destroyed;
+        }
+        m_dispatched += dispatched;
+        return dispatched;
+    }
+
+    /**
+     * @brief 丢弃当前全部事件
+     * @return 丢弃的事件数
+     */
+    size_t clear();
+
+    /**
+     * @brief 设置某类事件是否合并
+     */
+    void setCoalescing(EventType type, bool enabled);
+
+    /**
+     * @brief 某类事件是否合并
+     */
+    bool isCoalescing(EventType type) const;
+
+    /**
+     * @brief 设置唤醒回调，队列由空变为非空时在投递线程调用（用于唤醒阻塞中的主循环）
+     * @details 须在生产者开始投递之前设置
+     */
+    void setWakeCallback(std::function<void()> callback) { m_wakeCallback = std::move(callback); }
+
+    /**
+     * @brief 尚未取出的事件数（近似值）
+     */
+    size_t getPendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取统计（在消费线程调用）
+     */
+    EventQueueStats getStats() const;
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        Event* event = nullptr;         ///< 指向 storage 或堆上的事件
+        uint64_t coalesceKey = 0;
+        EventType type = EventType::NONE;
+        bool inlineEvent = false;
+        alignas(std::max_align_t) unsigned char storage[INLINE_EVENT_SIZE];
+    };
+
+    /**
+     * @brief 本批取出的一个事件；合并只读这里的副本，不再访问节点
+     */
+    struct BatchEntry {
+        Node* node;
+        EventType type;
+        uint64_t coalesceKey;
+        bool superseded;                ///< 本批中有更新的同类事件
+    };
+
+    /**
+     * @brief 分发结束（包括 sink 抛出异常）时回收本批节点
+     */
+    class BatchGuard {
+    public:
+        explicit BatchGuard(EventQueue& queue) : m_queue(queue) {}
+        ~BatchGuard() { m_queue.finishBatch(destroyed); }
+
+        size_t destroyed = 0;           ///< 已销毁事件的条目数（从头开始）
+
+    private:
+        EventQueue& m_queue;
+    };
+
+    static Node* acquireNode();
+    /**
+     * @brief 回收节点，节点中的事件须已销毁
+     */
+    static void releaseNodes(Node* const* nodes, size_t count);
+    static void destroyEvent(Node* node);
+
+    void push(Node* node, uint64_t coalesceKey);
+
+    /**
+     * @brief 把已链接的节点全部移入 m_batch
+     * @param coalesce 是否标记被合并的事件
+     * @return 取出的事件数
+     */
+    size_t collect(bool coalesce = true);
+    /**
+     * @brief 销毁剩余事件，回收本批节点
+     * @param destroyed 前多少个条目的事件已经销毁
+     */
+    void finishBatch(size_t destroyed);
+
+    // 生产者一侧
+    std::atomic<Node*> m_tail;
+    std::atomic<size_t> m_pending{0};
+    std::atomic<uint64_t> m_heapEvents{0};
+    std::function<void()> m_wakeCallback;
+
+    // 消费者一侧（m_head 是已取出的最后一个节点，作为链表的哨兵）
+    Node* m_head;
+    std::vector<BatchEntry> m_batch;
+    std::vector<Node*> m_recycle;
+    std::vector<std::pair<EventType, uint64_t>> m_seenKeys;
+    std::vector<bool> m_coalesce;
+    uint64_t m_collected = 0;
+    uint64_t m_dispatched = 0;
+    uint64_t m_coalesced = 0;
+    size_t m_maxBatch = 0;
+};
+
+} // namespace Events
+} // namespace Core
+} // namespace DearTs
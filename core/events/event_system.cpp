@@ -6,21 +6,157 @@
  */
 
 #include "event_system.h"
+#include "event_queue.h"
 #include "../utils/logger.h"
+#include <algorithm>
 
 namespace DearTs {
 namespace Core {
 namespace Events {
 
+namespace {
+
+uint32_t slotOf(SubscriptionId id) {
+    return static_cast<uint32_t>(id & 0xFFFFFFFFu);
+}
+
+uint32_t generationOf(SubscriptionId id) {
+    return static_cast<uint32_t>(id >> 32);
+}
+
+} // namespace
+
+// ScopedSubscription实现
+
+ScopedSubscription::ScopedSubscription(EventDispatcher& dispatcher, SubscriptionId id)
+    : m_dispatcher(dispatcher.m_self)
+    , m_id(id) {
+}
+
+ScopedSubscription::ScopedSubscription(ScopedSubscription&& other) noexcept
+    : m_dispatcher(std::move(other.m_dispatcher))
+    , m_id(other.m_id) {
+    other.m_id = INVALID_SUBSCRIPTION;
+}
+
+ScopedSubscription& ScopedSubscription::operator=(ScopedSubscription&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_dispatcher = std::move(other.m_dispatcher);
+        m_id = other.m_id;
+        other.m_id = INVALID_SUBSCRIPTION;
+    }
+    return *this;
+}
+
+/**
+ * @brief 取消订阅
+ */
+void ScopedSubscription::reset() {
+    if (m_id != INVALID_SUBSCRIPTION) {
+        if (auto dispatcher = m_dispatcher.lock()) {
+            (*dispatcher)->unsubscribe(m_id);
+        }
+        m_id = INVALID_SUBSCRIPTION;
+    }
+    m_dispatcher.reset();
+}
+
+/**
+ * @brief 放弃所有权
+ * @return 订阅标识
+ */
+SubscriptionId ScopedSubscription::release() {
+    const SubscriptionId id = m_id;
+    m_id = INVALID_SUBSCRIPTION;
+    m_dispatcher.reset();
+    return id;
+}
+
+/**
+ * @brief 订阅是否仍然有效
+ */
+bool ScopedSubscription::isConnected() const {
+    auto dispatcher = m_dispatcher.lock();
+    return dispatcher && (*dispatcher)->isSubscribed(m_id);
+}
+
 // EventDispatcher实现
 
+EventDispatcher::EventDispatcher()
+    : m_self(std::make_shared<EventDispatcher*>(this)) {
+}
+
 /**
  * @brief 订阅事件
  * @param type 事件类型
  * @param handler 事件处理器
+ * @return 订阅标识
+ */
+SubscriptionId EventDispatcher::subscribe(EventType type, EventHandler handler) {
+    if (!handler) {
+        return INVALID_SUBSCRIPTION;
+    }
+    const SubscriptionId id = acquireSlot(type);
+    if (m_dispatchDepth > 0) {
+        // 分发期间不改动正在遍历的列表
+        m_pendingAdds.push_back({type, std::move(handler), id});
+    } else {
+        HandlerList& handlers = findOrCreateHandlers(type);
+        handlers.handlers.push_back(std::move(handler));
+        handlers.ids.push_back(id);
+    }
+    return id;
+}
+
+/**
+ * @brief 订阅事件并返回自动取消订阅的连接
+ * @param type 事件类型
+ * @param handler 事件处理器
+ * @return 订阅连接
+ */
+ScopedSubscription EventDispatcher::subscribeScoped(EventType type, EventHandler handler) {
+    return ScopedSubscription(*this, subscribe(type, std::move(handler)));
+}
+
+/**
+ * @brief 取消单个订阅
+ * @param id 订阅标识
+ * @return 是否取消成功
  */
-void EventDispatcher::subscribe(EventType type, const EventHandler& handler) {
-    m_handlers[type].push_back(handler);
+bool EventDispatcher::unsubscribe(SubscriptionId id) {
+    const SlotInfo* slot = findSlot(id);
+    if (!slot) {
+        return false;
+    }
+    const EventType type = slot->type;
+    releaseSlot(id);
+
+    for (PendingAdd& pending : m_pendingAdds) {
+        if (pending.id == id) {
+            pending.id = INVALID_SUBSCRIPTION;
+            return true;
+        }
+    }
+
+    HandlerList* handlers = findHandlers(type);
+    if (!handlers) {
+        return true;
+    }
+    const auto it = std::find(handlers->ids.begin(), handlers->ids.end(), id);
+    if (it == handlers->ids.end()) {
+        return true;
+    }
+    if (m_dispatchDepth > 0) {
+        // 处理器可能正在执行（例如在处理器里取消自己），分发结束后再销毁
+        *it = INVALID_SUBSCRIPTION;
+        markDirty(*handlers);
+    } else {
+        const auto index = it - handlers->ids.begin();
+        handlers->handlers.erase(handlers->handlers.begin() + index);
+        handlers->ids.erase(it);
+    }
+    return true;
 }
 
 /**
@@ -28,7 +164,23 @@ void EventDispatcher::subscribe(EventType type, const EventHandler& handler) {
  * @param type 事件类型
  */
 void EventDispatcher::unsubscribe(EventType type) {
-    m_handlers.erase(type);
+    for (PendingAdd& pending : m_pendingAdds) {
+        if (pending.type == type && pending.id != INVALID_SUBSCRIPTION) {
+            releaseSlot(pending.id);
+            pending.id = INVALID_SUBSCRIPTION;
+        }
+    }
+    if (HandlerList* handlers = findHandlers(type)) {
+        removeAll(*handlers);
+    }
+}
+
+/**
+ * @brief 订阅标识是否仍然有效
+ * @param id 订阅标识
+ */
+bool EventDispatcher::isSubscribed(SubscriptionId id) const {
+    return findSlot(id) != nullptr;
 }
 
 /**
@@ -37,18 +189,24 @@ void EventDispatcher::unsubscribe(EventType type) {
  * @return 是否被处理
  */
 bool EventDispatcher::dispatch(const Event& event) {
-    auto it = m_handlers.find(event.getType());
-    if (it == m_handlers.end()) {
+    const HandlerList* handlers = findHandlers(event.getType());
+    if (!handlers || handlers->empty()) {
         return false;
     }
 
+    // 分发期间列表只会被标记、不会增删，数组地址保持有效
+    DispatchGuard guard(*this);
+    return invokeHandlers(handlers->handlers.data(), handlers->ids.data(), handlers->size(), event);
+}
+
+bool EventDispatcher::invokeHandlers(const EventHandler* handlers, const SubscriptionId* ids, size_t count,
+                                     const Event& event) {
     bool handled = false;
-    for (const auto& handler : it->second) {
-        if (handler(event)) {
+    for (size_t i = 0; i < count; ++i) {
+        if (ids[i] != INVALID_SUBSCRIPTION && handlers[i](event)) {
             handled = true;
         }
     }
-
     return handled;
 }
 
@@ -56,12 +214,172 @@ bool EventDispatcher::dispatch(const Event& event) {
  * @brief 清除所有订阅
  */
 void EventDispatcher::clear() {
-    m_handlers.clear();
+    for (HandlerList& handlers : m_handlers) {
+        removeAll(handlers);
+    }
+    for (auto& entry : m_extraHandlers) {
+        removeAll(entry.second);
+    }
+    for (PendingAdd& pending : m_pendingAdds) {
+        if (pending.id != INVALID_SUBSCRIPTION) {
+            releaseSlot(pending.id);
+            pending.id = INVALID_SUBSCRIPTION;
+        }
+    }
+    if (m_dispatchDepth == 0) {
+        m_extraHandlers.clear();
+        m_pendingAdds.clear();
+    }
+}
+
+/**
+ * @brief 某类事件的处理器数量
+ * @param type 事件类型
+ * @return 处理器数量
+ */
+size_t EventDispatcher::getHandlerCount(EventType type) const {
+    size_t count = 0;
+    if (const HandlerList* handlers = findHandlers(type)) {
+        count = handlers->size() -
+                static_cast<size_t>(std::count(handlers->ids.begin(), handlers->ids.end(), INVALID_SUBSCRIPTION));
+    }
+    for (const PendingAdd& pending : m_pendingAdds) {
+        if (pending.type == type && pending.id != INVALID_SUBSCRIPTION) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+EventDispatcher::HandlerList* EventDispatcher::findHandlers(EventType type) {
+    return const_cast<HandlerList*>(static_cast<const EventDispatcher*>(this)->findHandlers(type));
+}
+
+const EventDispatcher::HandlerList* EventDispatcher::findHandlers(EventType type) const {
+    const uint32_t slot = slotIndex(type);
+    if (slot < SLOT_COUNT) {
+        return &m_handlers[slot];
+    }
+    for (const auto& entry : m_extraHandlers) {
+        if (entry.first == type) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+EventDispatcher::HandlerList& EventDispatcher::findOrCreateHandlers(EventType type) {
+    if (HandlerList* handlers = findHandlers(type)) {
+        return *handlers;
+    }
+    m_extraHandlers.emplace_back(type, HandlerList());
+    return m_extraHandlers.back().second;
+}
+
+SubscriptionId EventDispatcher::acquireSlot(EventType type) {
+    uint32_t index = 0;
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    SlotInfo& slot = m_slots[index];
+    slot.type = type;
+    slot.used = true;
+    return (static_cast<SubscriptionId>(slot.generation) << 32) | (index + 1);
+}
+
+void EventDispatcher::releaseSlot(SubscriptionId id) {
+    const uint32_t index = slotOf(id) - 1;
+    SlotInfo& slot = m_slots[index];
+    slot.used = false;
+    // 代数为 0 时的标识可能与 INVALID_SUBSCRIPTION 混淆，跳过
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    m_freeSlots.push_back(index);
+}
+
+const EventDispatcher::SlotInfo* EventDispatcher::findSlot(SubscriptionId id) const {
+    const uint32_t index = slotOf(id);
+    if (index == 0 || index > m_slots.size()) {
+        return nullptr;
+    }
+    const SlotInfo& slot = m_slots[index - 1];
+    return slot.used && slot.generation == generationOf(id) ? &slot : nullptr;
+}
+
+void EventDispatcher::removeAll(HandlerList& handlers) {
+    for (SubscriptionId& id : handlers.ids) {
+        if (id != INVALID_SUBSCRIPTION) {
+            releaseSlot(id);
+            id = INVALID_SUBSCRIPTION;
+        }
+    }
+    if (m_dispatchDepth > 0) {
+        if (!handlers.empty()) {
+            markDirty(handlers);
+        }
+    } else {
+        handlers.clear();
+    }
+}
+
+void EventDispatcher::markDirty(HandlerList& handlers) {
+    if (m_dirtyLists.empty() || m_dirtyLists.back() != &handlers) {
+        m_dirtyLists.push_back(&handlers);
+    }
+}
+
+void EventDispatcher::compact(HandlerList& handlers) {
+    size_t kept = 0;
+    for (size_t i = 0; i < handlers.size(); ++i) {
+        if (handlers.ids[i] == INVALID_SUBSCRIPTION) {
+            continue;
+        }
+        if (kept != i) {
+            handlers.handlers[kept] = std::move(handlers.handlers[i]);
+            handlers.ids[kept] = handlers.ids[i];
+        }
+        ++kept;
+    }
+    handlers.handlers.resize(kept);
+    handlers.ids.resize(kept);
+}
+
+void EventDispatcher::applyPendingChanges() {
+    // 销毁处理器时可能再次取消订阅（例如处理器持有 ScopedSubscription），这期间仍按分发中处理
+    ++m_dispatchDepth;
+    while (!m_dirtyLists.empty()) {
+        m_compacting.swap(m_dirtyLists);
+        for (HandlerList* handlers : m_compacting) {
+            compact(*handlers);
+        }
+        m_compacting.clear();
+    }
+    --m_dispatchDepth;
+
+    for (PendingAdd& add : m_pendingAdds) {
+        if (add.id != INVALID_SUBSCRIPTION) {
+            HandlerList& handlers = findOrCreateHandlers(add.type);
+            handlers.handlers.push_back(std::move(add.handler));
+            handlers.ids.push_back(add.id);
+        }
+    }
+    m_pendingAdds.clear();
 }
 
 // EventSystem实现
 EventSystem* EventSystem::s_instance = nullptr;
 
+EventSystem::EventSystem()
+    : m_queue(std::make_unique<EventQueue>()) {
+}
+
+EventSystem::~EventSystem() = default;
+
 /**
  * @brief 获取单例实例
  * @return EventSystem实例指针
@@ -84,6 +402,10 @@ void EventSystem::initialize() {
  * @brief 关闭事件系统
  */
 void EventSystem::shutdown() {
+    const size_t discarded = m_queue->clear();
+    if (discarded > 0) {
+        DEARTS_LOG_DEBUG("丢弃未分发的延迟事件 {} 个", discarded);
+    }
     m_dispatcher.clear();
     DEARTS_LOG_INFO("事件系统关闭");
 }
@@ -97,6 +419,25 @@ bool EventSystem::dispatchEvent(const Event& event) {
     return m_dispatcher.dispatch(event);
 }
 
+/**
+ * @brief 投递延迟事件
+ * @param event 事件对象
+ * @param coalesceKey 合并键
+ */
+void EventSystem::postEvent(std::unique_ptr<Event> event, uint64_t coalesceKey) {
+    m_queue->post(std::move(event), coalesceKey);
+}
+
+/**
+ * @brief 分发延迟队列中的事件
+ * @return 分发的事件数
+ */
+size_t EventSystem::processEvents() {
+    return m_queue->drain([this](const Event& event) {
+        m_dispatcher.dispatch(event);
+    });
+}
+
 } // namespace Events
 } // namespace Core
 } // namespace DearTs
\ No newline at end of file
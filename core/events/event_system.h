@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include "event_delegate.h"
+#include <array>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -49,6 +51,10 @@ namespace Events {
         EVT_MOUSE_BUTTON_RELEASED,
         EVT_MOUSE_MOVED,
         EVT_MOUSE_SCROLLED,
+
+        // 后台数据事件（由监听线程、工作线程经延迟队列投递）
+        EVT_CLIPBOARD_CHANGED,
+        EVT_SEARCH_PROGRESS,
         EVT_CUSTOM,
 
         // 布局事件 (1000-1099)
@@ -77,6 +83,7 @@ struct EventTypeHash {
 
 /**
  * @brief 基础事件类
+ * @details 事件对象一般直接在栈上构造后同步分发，getName 返回静态字符串，分发路径上不分配内存
  */
 class Event {
 public:
@@ -84,7 +91,7 @@ public:
     virtual ~Event() = default;
 
     EventType getType() const { return type_; }
-    virtual std::string getName() const = 0;
+    virtual const char* getName() const = 0;
 
 private:
     EventType type_;
@@ -93,27 +100,229 @@ private:
 /**
  * @brief 事件处理器类型定义
  */
-using EventHandler = std::function<bool(const Event&)>;
+using EventHandler = EventDelegate<bool(const Event&)>;
+
+/**
+ * @brief 订阅标识，由 EventDispatcher::subscribe 返回
+ * @details 低 32 位为处理器槽位下标 + 1，高 32 位为槽位代数；取消订阅后槽位代数递增，
+ *          旧标识即使槽位被复用也不会误删新的处理器
+ */
+using SubscriptionId = uint64_t;
+constexpr SubscriptionId INVALID_SUBSCRIPTION = 0;
+
+class EventDispatcher;
+
+/**
+ * @brief 订阅连接（RAII），析构时自动取消订阅
+ * @details 只能移动不能复制；调度器先于连接销毁时析构不做任何事
+ */
+class ScopedSubscription {
+public:
+    ScopedSubscription() = default;
+    ScopedSubscription(EventDispatcher& dispatcher, SubscriptionId id);
+    ~ScopedSubscription() { reset(); }
+
+    ScopedSubscription(ScopedSubscription&& other) noexcept;
+    ScopedSubscription& operator=(ScopedSubscription&& other) noexcept;
+    ScopedSubscription(const ScopedSubscription&) = delete;
+    ScopedSubscription& operator=(const ScopedSubscription&) = delete;
+
+    /**
+     * @brief 立即取消订阅
+     */
+    void reset();
+
+    /**
+     * @brief 放弃所有权，不再自动取消订阅
+     * @return 订阅标识
+     */
+    SubscriptionId release();
+
+    SubscriptionId getId() const { return m_id; }
+
+    /**
+     * @brief 订阅是否仍然有效
+     */
+    bool isConnected() const;
+
+private:
+    std::weak_ptr<EventDispatcher*> m_dispatcher;
+    SubscriptionId m_id = INVALID_SUBSCRIPTION;
+};
 
 /**
  * @brief 简化的事件调度器
+ * @details 处理器按事件类型存放在定长数组中，分发时直接按下标取出，不做哈希查找：
+ *          EVT_CUSTOM 及之前的核心事件、1000 起的布局事件段各占一段连续下标，
+ *          其他取值（自定义扩展）放在按类型线性查找的备用表中。
+ *          分发期间（包括处理器中再次分发）订阅的处理器从下一次分发开始生效；
+ *          取消订阅的处理器立即不再调用，等最外层分发结束后才销毁。
  */
 class EventDispatcher {
 public:
-    EventDispatcher() = default;
+    static constexpr uint32_t CORE_EVENT_COUNT = static_cast<uint32_t>(EventType::EVT_CUSTOM) + 1;
+    static constexpr uint32_t LAYOUT_EVENT_BASE = static_cast<uint32_t>(EventType::EVT_LAYOUT_SHOW_REQUEST);
+    static constexpr uint32_t LAYOUT_EVENT_COUNT = 100;    ///< 布局事件段 1000-1099
+
+    EventDispatcher();
     ~EventDispatcher() = default;
 
-    void subscribe(EventType type, const EventHandler& handler);
+    EventDispatcher(const EventDispatcher&) = delete;
+    EventDispatcher& operator=(const EventDispatcher&) = delete;
+
+    /**
+     * @brief 订阅事件
+     * @return 订阅标识，处理器为空时返回 INVALID_SUBSCRIPTION
+     */
+    SubscriptionId subscribe(EventType type, EventHandler handler);
+
+    /**
+     * @brief 订阅事件，返回的连接析构时自动取消订阅
+     */
+    ScopedSubscription subscribeScoped(EventType type, EventHandler handler);
+
+    /**
+     * @brief 取消单个订阅
+     * @return 标识有效并已取消时返回 true
+     */
+    bool unsubscribe(SubscriptionId id);
+
+    /**
+     * @brief 取消某类事件的全部订阅
+     */
     void unsubscribe(EventType type);
+
+    /**
+     * @brief 订阅标识是否仍然有效
+     */
+    bool isSubscribed(SubscriptionId id) const;
+
     bool dispatch(const Event& event);
     void clear();
 
+    /**
+     * @brief 某类事件的处理器数量（包括分发期间新订阅、尚未生效的处理器）
+     */
+    size_t getHandlerCount(EventType type) const;
+
+    /**
+     * @brief 是否正在分发
+     */
+    bool isDispatching() const { return m_dispatchDepth > 0; }
+
 private:
-    std::unordered_map<EventType, std::vector<EventHandler>, EventTypeHash> m_handlers;
+    friend class ScopedSubscription;
+
+    /**
+     * @brief 一类事件的处理器及其订阅标识（两个数组下标对应）
+     * @details 标识为 INVALID_SUBSCRIPTION 表示已取消、等待清理；处理器单独连续存放，分发时步长与委托大小一致
+     */
+    struct HandlerList {
+        std::vector<EventHandler> handlers;
+        std::vector<SubscriptionId> ids;
+
+        size_t size() const { return ids.size(); }
+        bool empty() const { return ids.empty(); }
+        void clear() {
+            handlers.clear();
+            ids.clear();
+        }
+    };
+
+    /**
+     * @brief 订阅槽位，记录标识对应的事件类型
+     */
+    struct SlotInfo {
+        uint32_t generation = 1;
+        EventType type = EventType::NONE;
+        bool used = false;
+    };
+
+    /**
+     * @brief 分发期间订阅、等待加入处理器列表的处理器
+     */
+    struct PendingAdd {
+        EventType type;
+        EventHandler handler;
+        SubscriptionId id;
+    };
+
+    /**
+     * @brief 最外层分发结束（包括处理器抛出异常）时应用延迟的增删
+     */
+    class DispatchGuard {
+    public:
+        explicit DispatchGuard(EventDispatcher& dispatcher) : m_dispatcher(dispatcher) {
+            ++m_dispatcher.m_dispatchDepth;
+        }
+        ~DispatchGuard() {
+            if (--m_dispatcher.m_dispatchDepth == 0 &&
+                (!m_dispatcher.m_dirtyLists.empty() || !m_dispatcher.m_pendingAdds.empty())) {
+                m_dispatcher.applyPendingChanges();
+            }
+        }
+
+    private:
+        EventDispatcher& m_dispatcher;
+    };
+
+    /**
+     * @brief 事件类型在定长数组中的下标，不在固定范围内时返回 SLOT_COUNT
+     */
+    static uint32_t slotIndex(EventType type) {
+        const uint32_t value = static_cast<uint32_t>(type);
+        if (value < CORE_EVENT_COUNT) {
+            return value;
+        }
+        if (value - LAYOUT_EVENT_BASE < LAYOUT_EVENT_COUNT) {
+            return CORE_EVENT_COUNT + (value - LAYOUT_EVENT_BASE);
+        }
+        return SLOT_COUNT;
+    }
+
+    HandlerList* findHandlers(EventType type);
+    const HandlerList* findHandlers(EventType type) const;
+    HandlerList& findOrCreateHandlers(EventType type);
+
+    SubscriptionId acquireSlot(EventType type);
+    void releaseSlot(SubscriptionId id);
+    const SlotInfo* findSlot(SubscriptionId id) const;
+
+    /**
+     * @brief 取消列表中的全部处理器：分发期间只做标记，否则直接清空
+     */
+    void removeAll(HandlerList& handlers);
+    void markDirty(HandlerList& handlers);
+    /**
+     * @brief 依次调用处理器，跳过已取消的
+     */
+    static bool invokeHandlers(const EventHandler* handlers, const SubscriptionId* ids, size_t count,
+                               const Event& event);
+    /**
+     * @brief 移除列表中已取消的处理器
+     */
+    static void compact(HandlerList& handlers);
+    void applyPendingChanges();
+
+    static constexpr uint32_t SLOT_COUNT = CORE_EVENT_COUNT + LAYOUT_EVENT_COUNT;
+
+    std::array<HandlerList, SLOT_COUNT> m_handlers;
+    std::vector<std::pair<EventType, HandlerList>> m_extraHandlers;  ///< 固定范围以外的事件类型
+    std::vector<SlotInfo> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<PendingAdd> m_pendingAdds;
+    uint32_t m_dispatchDepth = 0;
+    std::vector<HandlerList*> m_dirtyLists;     ///< 分发期间有处理器被取消、等待清理的列表
+    std::vector<HandlerList*> m_compacting;
+    std::shared_ptr<EventDispatcher*> m_self;   ///< 供 ScopedSubscription 判断调度器是否还在
 };
 
+class EventQueue;
+
 /**
  * @brief 事件系统管理器
+ * @details dispatchEvent 在调用线程同步分发；postEvent 可在任意线程调用，
+ *          事件进入延迟队列，由主循环每帧（Application::pumpFrameWork()）调用 processEvents 统一分发
  */
 class EventSystem {
 public:
@@ -125,12 +334,31 @@ public:
     EventDispatcher& getDispatcher() { return m_dispatcher; }
     bool dispatchEvent(const Event& event);
 
+    /**
+     * @brief 投递延迟事件（线程安全）
+     * @param event 事件
+     * @param coalesceKey 合并键，同类型且键相同的事件在一帧内只分发最后一个
+     */
+    void postEvent(std::unique_ptr<Event> event, uint64_t coalesceKey = 0);
+
+    /**
+     * @brief 延迟事件队列（需要在节点内直接构造事件时使用 EventQueue::emplace）
+     */
+    EventQueue& getQueue() { return *m_queue; }
+
+    /**
+     * @brief 分发延迟队列中的全部事件（主线程每帧调用一次）
+     * @return 分发的事件数
+     */
+    size_t processEvents();
+
 private:
-    EventSystem() = default;
-    ~EventSystem() = default;
+    EventSystem();
+    ~EventSystem();
 
     static EventSystem* s_instance;
     EventDispatcher m_dispatcher;
+    std::unique_ptr<EventQueue> m_queue;
 };
 
 // 便利宏定义
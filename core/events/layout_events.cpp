@@ -39,7 +39,7 @@ bool LayoutEventDispatcher::dispatch(const LayoutEvent& event) {
     }
 
     bool handled = false;
-    DEARTS_LOG_DEBUG("分发布局事件: " + event.getName() +
+    DEARTS_LOG_DEBUG("分发布局事件: " + std::string(event.getName()) +
                     " 到 " + std::to_string(it->second.size()) + " 个处理器");
 
     // 复制处理器列表，避免在处理过程中修改原列表
@@ -181,7 +181,7 @@ public:
         : LayoutEvent(LayoutEventType::LAYOUT_SHOW_REQUEST,
                     LayoutVisibilityData(layoutName, true, reason)) {}
 
-    std::string getName() const override { return "LayoutShowRequest"; }
+    const char* getName() const override { return "LayoutShowRequest"; }
 };
 
 /**
@@ -193,7 +193,7 @@ public:
         : LayoutEvent(LayoutEventType::LAYOUT_HIDE_REQUEST,
                     LayoutVisibilityData(layoutName, false, reason)) {}
 
-    std::string getName() const override { return "LayoutHideRequest"; }
+    const char* getName() const override { return "LayoutHideRequest"; }
 };
 
 /**
@@ -206,7 +206,7 @@ public:
         : LayoutEvent(LayoutEventType::LAYOUT_SWITCH_REQUEST,
                     LayoutSwitchData(fromLayout, toLayout, reason, animated)) {}
 
-    std::string getName() const override { return "LayoutSwitchRequest"; }
+    const char* getName() const override { return "LayoutSwitchRequest"; }
 };
 
 /**
@@ -0,0 +1,167 @@
+/**
+ * @file draw_data_hash.cpp
+ * @brief ImGui 绘制数据哈希实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "draw_data_hash.h"
+#include <cstring>
+
+namespace DearTs {
+namespace Core {
+namespace Render {
+
+namespace {
+
+constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+
+inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t mixRound(uint64_t acc, uint64_t input) {
+    acc += input * PRIME_2;
+    return rotl(acc, 31) * PRIME_1;
+}
+
+inline uint64_t read64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief 把一段内存并入哈希
+ * @details 四路独立累加（每步 32 字节）以利用指令级并行，顶点缓冲通常有几百 KB
+ */
+uint64_t hashBytes(uint64_t seed, const void* data, size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+
+    uint64_t h;
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME_1 + PRIME_2;
+        uint64_t v2 = seed + PRIME_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME_1;
+        const unsigned char* const limit = end - 32;
+        do {
+            v1 = mixRound(v1, read64(p));
+            v2 = mixRound(v2, read64(p + 8));
+            v3 = mixRound(v3, read64(p + 16));
+            v4 = mixRound(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    } else {
+        h = seed + PRIME_3;
+    }
+
+    h += static_cast<uint64_t>(size);
+    while (p + 8 <= end) {
+        h ^= mixRound(0, read64(p));
+        h = rotl(h, 27) * PRIME_1 + PRIME_3;
+        p += 8;
+    }
+    while (p < end) {
+        h ^= static_cast<uint64_t>(*p) * PRIME_3;
+        h = rotl(h, 11) * PRIME_1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME_2;
+    h ^= h >> 29;
+    return h;
+}
+
+template <typename T>
+inline uint64_t hashValue(uint64_t seed, const T& value) {
+    return hashBytes(seed, &value, sizeof(value));
+}
+
+} // namespace
+
+uint64_t hashDrawData(const ImDrawData* draw_data) {
+    if (!draw_data || !draw_data->Valid) {
+        return 0;
+    }
+
+    uint64_t h = 0;
+    h = hashValue(h, draw_data->DisplayPos);
+    h = hashValue(h, draw_data->DisplaySize);
+    h = hashValue(h, draw_data->FramebufferScale);
+    h = hashValue(h, draw_data->CmdListsCount);
+
+    for (const ImDrawList* list : draw_data->CmdLists) {
+        h = hashBytes(h, list->VtxBuffer.Data, static_cast<size_t>(list->VtxBuffer.Size) * sizeof(ImDrawVert));
+        h = hashBytes(h, list->IdxBuffer.Data, static_cast<size_t>(list->IdxBuffer.Size) * sizeof(ImDrawIdx));
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            // 逐字段而不是整块哈希，避免结构体填充字节和回调数据偏移干扰结果
+            h = hashValue(h, cmd.ClipRect);
+            h = hashValue(h, cmd.TexRef._TexData);
+            h = hashValue(h, cmd.TexRef._TexID);
+            h = hashValue(h, cmd.VtxOffset);
+            h = hashValue(h, cmd.IdxOffset);
+            h = hashValue(h, cmd.ElemCount);
+        }
+    }
+    return h == 0 ? 1 : h;
+}
+
+bool drawDataHasPendingTextureUpdates(const ImDrawData* draw_data) {
+    if (!draw_data || !draw_data->Textures) {
+        return false;
+    }
+    for (const ImTextureData* texture : *draw_data->Textures) {
+        if (texture->Status != ImTextureStatus_OK && texture->Status != ImTextureStatus_Destroyed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::atomic<uint64_t> UnchangedFrameFilter::s_generation{0};
+
+bool UnchangedFrameFilter::shouldSubmit(const ImDrawData* draw_data) {
+    if (!m_enabled) {
+        ++m_submittedFrames;
+        return true;
+    }
+
+    const uint64_t generation = s_generation.load(std::memory_order_relaxed);
+    if (generation != m_generation) {
+        m_generation = generation;
+        m_hasLastHash = false;
+    }
+
+    bool submit = !m_hasLastHash || drawDataHasPendingTextureUpdates(draw_data);
+    if (draw_data) {
+        for (int i = 0; i < draw_data->CmdListsCount && !submit; ++i) {
+            for (const ImDrawCmd& cmd : draw_data->CmdLists[i]->CmdBuffer) {
+                if (cmd.UserCallback) {
+                    submit = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    const uint64_t hash = hashDrawData(draw_data);
+    if (!submit && hash == m_lastHash) {
+        ++m_skippedFrames;
+        return false;
+    }
+
+    m_lastHash = hash;
+    m_hasLastHash = true;
+    ++m_submittedFrames;
+    return true;
+}
+
+} // namespace Render
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,80 @@
+/**
+ * @file draw_data_hash.h
+ * @brief ImGui 绘制数据哈希与“画面未变化”检测
+ * @details 对 ImDrawData 的顶点/索引缓冲、绘制命令（裁剪矩形、纹理、偏移）和视口参数计算 64 位哈希。
+ *          与上一帧相同时可以跳过后端提交和 present，ImGui 帧本身（输入处理、布局逻辑）照常进行。
+ *          只依赖 imgui.h，不依赖任何渲染后端，可在无窗口环境中使用。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <imgui.h>
+#include <atomic>
+#include <cstdint>
+
+namespace DearTs {
+namespace Core {
+namespace Render {
+
+/**
+ * @brief 计算绘制数据的哈希
+ * @param draw_data ImGui 绘制数据
+ * @return 哈希值；draw_data 为空或无效时返回 0
+ */
+uint64_t hashDrawData(const ImDrawData* draw_data);
+
+/**
+ * @brief 绘制数据是否要求后端更新纹理（新建、增量上传或销毁）
+ */
+bool drawDataHasPendingTextureUpdates(const ImDrawData* draw_data);
+
+/**
+ * @brief 画面未变化检测
+ * @details 每个渲染目标（窗口）持有一个实例。以下情况总是提交：
+ *          首帧、被禁用、纹理需要更新、含用户回调的绘制命令（无法知道回调画了什么）、
+ *          调用 invalidate()/invalidateAll() 之后（窗口暴露、尺寸变化等后端缓冲可能已失效的情况）。
+ */
+class UnchangedFrameFilter {
+public:
+    /**
+     * @brief 判断本帧是否需要提交给后端并 present
+     * @param draw_data ImGui 绘制数据（ImGui::Render() 之后）
+     * @return true 表示需要提交；false 表示与上一次提交的画面相同
+     */
+    bool shouldSubmit(const ImDrawData* draw_data);
+
+    /**
+     * @brief 下一帧强制提交
+     */
+    void invalidate() { m_hasLastHash = false; }
+
+    /**
+     * @brief 所有实例的下一帧都强制提交（可在任意线程调用）
+     */
+    static void invalidateAll() { s_generation.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief 启用或禁用检测（禁用时每帧都提交）
+     */
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    uint64_t getSubmittedFrameCount() const { return m_submittedFrames; }
+    uint64_t getSkippedFrameCount() const { return m_skippedFrames; }
+
+private:
+    bool m_enabled = true;
+    bool m_hasLastHash = false;
+    uint64_t m_lastHash = 0;
+    uint64_t m_generation = 0;
+    uint64_t m_submittedFrames = 0;
+    uint64_t m_skippedFrames = 0;
+
+    static std::atomic<uint64_t> s_generation;
+};
+
+} // namespace Render
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,180 @@
+/**
+ * @file render_batch.cpp
+ * @brief 绘制命令缓冲与批处理实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "render_batch.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Core {
+namespace Render {
+
+namespace {
+
+inline bool intersects(const SDL_FRect& a, const SDL_FRect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+inline SDL_FRect unite(const SDL_FRect& a, const SDL_FRect& b) {
+    const float x1 = std::min(a.x, b.x);
+    const float y1 = std::min(a.y, b.y);
+    const float x2 = std::max(a.x + a.w, b.x + b.w);
+    const float y2 = std::max(a.y + a.h, b.y + b.h);
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+inline SDL_FRect quadBounds(const SDL_Vertex (&vertices)[4]) {
+    float x1 = vertices[0].position.x;
+    float y1 = vertices[0].position.y;
+    float x2 = x1;
+    float y2 = y1;
+    for (int i = 1; i < 4; ++i) {
+        x1 = std::min(x1, vertices[i].position.x);
+        y1 = std::min(y1, vertices[i].position.y);
+        x2 = std::max(x2, vertices[i].position.x);
+        y2 = std::max(y2, vertices[i].position.y);
+    }
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+} // namespace
+
+RenderBatcher::RenderBatcher() {
+    ensureIndices();
+}
+
+void RenderBatcher::setMaxBatchQuads(size_t quads) {
+    flush();
+    max_batch_quads_ = std::max<size_t>(quads, 1);
+    ensureIndices();
+}
+
+void RenderBatcher::setViewportSize(int width, int height) {
+    viewport_width_ = width;
+    viewport_height_ = height;
+}
+
+void RenderBatcher::setClipRect(const SDL_Rect* rect) {
+    clip_enabled_ = rect != nullptr;
+    clip_rect_ = rect ? *rect : SDL_Rect{0, 0, 0, 0};
+}
+
+bool RenderBatcher::isCulled(const SDL_FRect& bounds) const {
+    if (!culling_enabled_) {
+        return false;
+    }
+    if (viewport_width_ > 0 && viewport_height_ > 0) {
+        const SDL_FRect viewport = {0.0f, 0.0f, static_cast<float>(viewport_width_), static_cast<float>(viewport_height_)};
+        if (!intersects(bounds, viewport)) {
+            return true;
+        }
+    }
+    if (clip_enabled_) {
+        const SDL_FRect clip = {static_cast<float>(clip_rect_.x), static_cast<float>(clip_rect_.y),
+                                static_cast<float>(clip_rect_.w), static_cast<float>(clip_rect_.h)};
+        if (!intersects(bounds, clip)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RenderBatcher::addQuad(SDL_Texture* texture, SDL_BlendMode texture_blend_mode, const SDL_Vertex (&vertices)[4]) {
+    const SDL_FRect bounds = quadBounds(vertices);
+    if (isCulled(bounds)) {
+        ++stats_.quads_culled;
+        return false;
+    }
+    ++stats_.quads_submitted;
+
+    BatchState state;
+    state.texture = texture;
+    state.blend_mode = texture ? texture_blend_mode : blend_mode_;
+    state.clip_enabled = clip_enabled_;
+    state.clip_rect = clip_rect_;
+
+    // 从最近的批次向前找同状态且未满的批次；途中遇到与新图元相交的批次就停止，保持重叠部分的先后顺序
+    Batch* target = nullptr;
+    const size_t lookback = std::min(batch_count_, MERGE_LOOKBACK);
+    for (size_t n = 1; n <= lookback; ++n) {
+        Batch& batch = batches_[batch_count_ - n];
+        if (batch.state == state && quadCount(batch) < max_batch_quads_) {
+            target = &batch;
+            break;
+        }
+        if (intersects(batch.bounds, bounds)) {
+            break;
+        }
+    }
+
+    if (target) {
+        target->bounds = unite(target->bounds, bounds);
+    } else {
+        if (batch_count_ >= MAX_PENDING_BATCHES) {
+            flush();
+        }
+        target = &appendBatch(state, bounds);
+    }
+    target->vertices.insert(target->vertices.end(), vertices, vertices + 4);
+    return true;
+}
+
+RenderBatcher::Batch& RenderBatcher::appendBatch(const BatchState& state, const SDL_FRect& bounds) {
+    if (batch_count_ == batches_.size()) {
+        batches_.emplace_back();
+    }
+    Batch& batch = batches_[batch_count_++];
+    batch.state = state;
+    batch.bounds = bounds;
+    batch.vertices.clear();
+    return batch;
+}
+
+void RenderBatcher::ensureIndices() {
+    static constexpr int QUAD_INDICES[6] = {0, 1, 2, 2, 3, 0};
+    const size_t needed = max_batch_quads_ * 6;
+    if (indices_.size() == needed) {
+        return;
+    }
+    indices_.resize(needed);
+    for (size_t i = 0; i < needed; ++i) {
+        indices_[i] = static_cast<int>((i / 6) * 4) + QUAD_INDICES[i % 6];
+    }
+}
+
+void RenderBatcher::flush() {
+    for (size_t i = 0; i < batch_count_; ++i) {
+        const Batch& batch = batches_[i];
+        const int quads = static_cast<int>(quadCount(batch));
+        if (quads == 0) {
+            continue;
+        }
+        if (has_submitted_state_ && batch.state != submitted_state_) {
+            ++stats_.state_changes;
+            if (batch.state.texture != submitted_state_.texture) {
+                ++stats_.texture_changes;
+            }
+        }
+        submitted_state_ = batch.state;
+        has_submitted_state_ = true;
+
+        if (submit_) {
+            submit_(batch.state, batch.vertices.data(), quads * 4, indices_.data(), quads * 6);
+        }
+        ++stats_.draw_calls;
+        stats_.vertices += static_cast<uint64_t>(quads) * 4;
+        stats_.indices += static_cast<uint64_t>(quads) * 6;
+    }
+    batch_count_ = 0;
+}
+
+void RenderBatcher::discard() {
+    batch_count_ = 0;
+}
+
+} // namespace Render
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,172 @@
+/**
+ * @file render_batch.h
+ * @brief 绘制命令缓冲与批处理
+ * @details SDLRenderer 的矩形、点和纹理绘制先转换成四边形加入命令缓冲，在 flush 时按批通过
+ *          SDL_RenderGeometry 提交，把每个图元一次的 SDL 调用合并成每批一次。
+ *          - 裁剪：完全落在视口与裁剪矩形之外的图元直接丢弃；
+ *          - 合批：相同纹理、混合模式和裁剪矩形的图元进入同一批。新图元可以并入更早的同状态批次，
+ *            前提是它与之后加入的所有批次都不相交，因此重排不会改变重叠部分的绘制顺序；
+ *          - 单批最多 max_batch_quads 个四边形，超过时开新批。
+ *          本类只依赖 SDL 头文件中的类型，不调用 SDL 函数，实际提交由 SubmitFunction 完成。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <SDL_blendmode.h>
+#include <SDL_rect.h>
+#include <SDL_render.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Render {
+
+/**
+ * @brief 一批图元共享的渲染状态
+ */
+struct BatchState {
+    SDL_Texture* texture = nullptr;                 ///< 纹理，nullptr 表示纯色
+    SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;  ///< 混合模式（有纹理时为纹理的混合模式）
+    bool clip_enabled = false;                      ///< 是否裁剪
+    SDL_Rect clip_rect = {0, 0, 0, 0};              ///< 裁剪矩形（视口坐标）
+
+    bool operator==(const BatchState& other) const {
+        return texture == other.texture && blend_mode == other.blend_mode && clip_enabled == other.clip_enabled &&
+               (!clip_enabled || (clip_rect.x == other.clip_rect.x && clip_rect.y == other.clip_rect.y &&
+                                  clip_rect.w == other.clip_rect.w && clip_rect.h == other.clip_rect.h));
+    }
+    bool operator!=(const BatchState& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 批处理统计（累计值）
+ */
+struct BatchStats {
+    uint64_t quads_submitted = 0;   ///< 加入命令缓冲的四边形数
+    uint64_t quads_culled = 0;      ///< 被裁剪丢弃的四边形数
+    uint64_t draw_calls = 0;        ///< 提交次数（SDL_RenderGeometry 调用数）
+    uint64_t vertices = 0;          ///< 提交的顶点数
+    uint64_t indices = 0;           ///< 提交的索引数
+    uint64_t state_changes = 0;     ///< 相邻两次提交之间的状态切换次数
+    uint64_t texture_changes = 0;   ///< 其中纹理切换的次数
+};
+
+/**
+ * @brief 绘制命令缓冲
+ * @details 非线程安全，与所属的 SDLRenderer 在同一线程使用
+ */
+class RenderBatcher {
+public:
+    /**
+     * @brief 提交一批图元
+     * @details 顶点按四边形排列（每 4 个一组），索引为 0,1,2, 2,3,0 的重复
+     */
+    using SubmitFunction = std::function<void(const BatchState& state, const SDL_Vertex* vertices, int vertex_count,
+                                              const int* indices, int index_count)>;
+
+    static constexpr size_t MERGE_LOOKBACK = 16;     ///< 向前查找可并入批次的最大数量
+    static constexpr size_t MAX_PENDING_BATCHES = 256; ///< 待提交批次超过该数量时自动 flush
+
+    RenderBatcher();
+
+    void setSubmitFunction(SubmitFunction submit) { submit_ = std::move(submit); }
+
+    /**
+     * @brief 设置单批最多的四边形数（0 视为 1）
+     */
+    void setMaxBatchQuads(size_t quads);
+    size_t getMaxBatchQuads() const { return max_batch_quads_; }
+
+    /**
+     * @brief 启用或禁用裁剪
+     */
+    void setCullingEnabled(bool enabled) { culling_enabled_ = enabled; }
+    bool isCullingEnabled() const { return culling_enabled_; }
+
+    /**
+     * @brief 设置视口尺寸，用于裁剪；宽或高为 0 时只按裁剪矩形裁剪
+     */
+    void setViewportSize(int width, int height);
+
+    /**
+     * @brief 设置裁剪矩形（视口坐标），nullptr 表示不裁剪；只影响之后加入的图元
+     */
+    void setClipRect(const SDL_Rect* rect);
+
+    /**
+     * @brief 设置纯色图元的混合模式；只影响之后加入的图元
+     */
+    void setBlendMode(SDL_BlendMode mode) { blend_mode_ = mode; }
+
+    /**
+     * @brief 加入一个四边形
+     * @param texture 纹理，nullptr 表示纯色
+     * @param texture_blend_mode 纹理的混合模式（texture 为空时忽略）
+     * @param vertices 四个顶点，按顺时针或逆时针顺序
+     * @return false 表示被裁剪丢弃
+     */
+    bool addQuad(SDL_Texture* texture, SDL_BlendMode texture_blend_mode, const SDL_Vertex (&vertices)[4]);
+
+    /**
+     * @brief 包围盒是否完全落在可见区域之外（未启用裁剪时总是 false）
+     */
+    bool isCulled(const SDL_FRect& bounds) const;
+
+    /**
+     * @brief 提交全部待处理的批次
+     */
+    void flush();
+
+    /**
+     * @brief 丢弃全部待处理的批次（例如整个目标即将被清除）
+     */
+    void discard();
+
+    bool empty() const { return batch_count_ == 0; }
+
+    const BatchStats& getStats() const { return stats_; }
+    void resetStats() { stats_ = BatchStats(); }
+
+    /**
+     * @brief 下一次提交视为状态切换（外部直接修改了 SDL 渲染状态之后调用）
+     */
+    void resetSubmittedState() { has_submitted_state_ = false; }
+
+private:
+    struct Batch {
+        BatchState state;
+        SDL_FRect bounds = {0.0f, 0.0f, 0.0f, 0.0f};  ///< 所有图元的包围盒
+        std::vector<SDL_Vertex> vertices;
+    };
+
+    size_t quadCount(const Batch& batch) const { return batch.vertices.size() / 4; }
+    Batch& appendBatch(const BatchState& state, const SDL_FRect& bounds);
+    void ensureIndices();
+
+    SubmitFunction submit_;
+    size_t max_batch_quads_ = 1000;
+    bool culling_enabled_ = true;
+    int viewport_width_ = 0;
+    int viewport_height_ = 0;
+    SDL_BlendMode blend_mode_ = SDL_BLENDMODE_NONE;
+    bool clip_enabled_ = false;
+    SDL_Rect clip_rect_ = {0, 0, 0, 0};
+
+    // 批次对象在帧间复用，避免每帧重新分配顶点缓冲
+    std::vector<Batch> batches_;
+    size_t batch_count_ = 0;
+    std::vector<int> indices_;            ///< 共享的四边形索引（max_batch_quads_ 个）
+
+    bool has_submitted_state_ = false;
+    BatchState submitted_state_;
+    BatchStats stats_;
+};
+
+} // namespace Render
+} // namespace Core
+} // namespace DearTs
@@ -4,6 +4,8 @@
 #include <SDL_image.h>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <new>
 
 // ImGui includes
 #include <imgui.h>
@@ -156,12 +158,31 @@ TextureInfo SDLTexture::getInfo() const {
 }
 
 // SDLRenderer 实现
+namespace {
+
+inline SDL_FRect toFRect(const Rect& rect) {
+    return {static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h)};
+}
+
+} // namespace
+
 SDLRenderer::SDLRenderer()
     : renderer_(nullptr)
     , window_(nullptr)
     , current_target_(nullptr)
     , imgui_initialized_(false)
+    , blend_mode_(BlendMode::NONE)
+    , clip_enabled_(false)
+    , clip_rect_{0, 0, 0, 0}
+    , applied_clip_valid_(false)
+    , applied_clip_enabled_(false)
+    , applied_clip_rect_{0, 0, 0, 0}
+    , frame_quads_(0)
     , next_texture_id_(1) {
+    batcher_.setSubmitFunction([this](const BatchState& state, const SDL_Vertex* vertices, int vertex_count,
+                                      const int* indices, int index_count) {
+        submitBatch(state, vertices, vertex_count, indices, index_count);
+    });
 }
 
 SDLRenderer::~SDLRenderer() {
@@ -175,6 +196,9 @@ bool SDLRenderer::initialize(SDL_Window* window, const RendererConfig& config) {
     
     window_ = window;
     config_ = config;
+    frame_filter_.setEnabled(config.skip_unchanged_frames);
+    batcher_.setMaxBatchQuads(config.max_batch_size);
+    batcher_.setCullingEnabled(config.enable_culling);
     
     // 创建SDL渲染器
     Uint32 flags = 0;
@@ -205,6 +229,8 @@ bool SDLRenderer::initialize(SDL_Window* window, const RendererConfig& config) {
             SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "2");
             break;
     }
+
+    refreshViewportSize();
     
     return true;
 }
@@ -224,6 +250,8 @@ bool SDLRenderer::isInitialized() const {
 }
 
 void SDLRenderer::shutdown() {
+    batcher_.discard();
+    batched_textures_.clear();
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
         renderer_ = nullptr;
@@ -237,11 +265,13 @@ void SDLRenderer::shutdown() {
 void SDLRenderer::beginFrame() {
     DEARTS_LOG_DEBUG("SDLRenderer::beginFrame() called");
     frame_start_time_ = std::chrono::steady_clock::now();
+    beginBatchFrame();
     DEARTS_LOG_DEBUG("SDLRenderer::beginFrame() completed");
 }
 
 void SDLRenderer::endFrame() {
     DEARTS_LOG_DEBUG("SDLRenderer::endFrame() called");
+    flushBatches();
     updateStats();
     DEARTS_LOG_DEBUG("SDLRenderer::endFrame() completed");
 }
@@ -249,6 +279,7 @@ void SDLRenderer::endFrame() {
 void SDLRenderer::present() {
     DEARTS_LOG_DEBUG("SDLRenderer::present() called");
     if (renderer_) {
+        flushBatches();
         SDL_RenderPresent(renderer_);
         DEARTS_LOG_DEBUG("SDL_RenderPresent() called successfully");
     } else {
@@ -264,8 +295,12 @@ void SDLRenderer::clear(const Color& color) {
                      std::to_string(color.b) + ", " + 
                      std::to_string(color.a) + ")");
     if (renderer_) {
+        // SDL_RenderClear 忽略视口和裁剪矩形清除整个目标，之前尚未提交的图元不会再可见
+        batcher_.discard();
+        batched_textures_.clear();
         SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
         SDL_RenderClear(renderer_);
+        SDL_SetRenderDrawColor(renderer_, draw_color_.r, draw_color_.g, draw_color_.b, draw_color_.a);
         DEARTS_LOG_DEBUG("SDL_RenderClear() called successfully");
     } else {
         DEARTS_LOG_ERROR("SDLRenderer::clear() - renderer_ is null");
@@ -280,16 +315,16 @@ void SDLRenderer::clear(float r, float g, float b, float a) {
 }
 
 void SDLRenderer::setViewport(const Rect& viewport) {
-    if (renderer_) {
-        SDL_Rect rect = { viewport.x, viewport.y, viewport.w, viewport.h };
-        SDL_RenderSetViewport(renderer_, &rect);
-    }
+    setViewport(viewport.x, viewport.y, viewport.w, viewport.h);
 }
 
 void SDLRenderer::setViewport(int x, int y, int width, int height) {
     if (renderer_) {
+        // 顶点坐标相对于视口，切换前先提交
+        flushBatches();
         SDL_Rect rect = { x, y, width, height };
         SDL_RenderSetViewport(renderer_, &rect);
+        refreshViewportSize();
     }
 }
 
@@ -307,61 +342,77 @@ Rect SDLRenderer::getViewport() const {
 }
 
 void SDLRenderer::setClipRect(const Rect& rect) {
-    if (renderer_) {
-        SDL_Rect sdlRect = { rect.x, rect.y, rect.w, rect.h };
-        SDL_RenderSetClipRect(renderer_, &sdlRect);
-    }
+    // 裁剪矩形随批次记录，提交时才设置到 SDL
+    clip_enabled_ = true;
+    clip_rect_ = { rect.x, rect.y, rect.w, rect.h };
+    batcher_.setClipRect(&clip_rect_);
 }
 
 void SDLRenderer::clearClipRect() {
-    if (renderer_) {
-        SDL_RenderSetClipRect(renderer_, nullptr);
-    }
+    clip_enabled_ = false;
+    batcher_.setClipRect(nullptr);
 }
 
 void SDLRenderer::setDrawColor(const Color& color) {
+    draw_color_ = color;
     if (renderer_) {
         SDL_SetRenderDrawColor(renderer_, color.r, color.g, color.b, color.a);
     }
 }
 
 Color SDLRenderer::getDrawColor() const {
-    Color color;
-    if (renderer_) {
-        SDL_GetRenderDrawColor(renderer_, &color.r, &color.g, &color.b, &color.a);
-    }
-    return color;
+    return draw_color_;
 }
 
 void SDLRenderer::setBlendMode(BlendMode mode) {
-    // 在SDL渲染器中，混合模式通常在纹理级别设置
-    // 这里可以留空或者实现其他逻辑
+    // 纯色图元的混合模式；纹理的混合模式仍在纹理上设置（ITexture::setBlendMode）
+    blend_mode_ = mode;
+    batcher_.setBlendMode(convertBlendMode(mode));
+    if (renderer_) {
+        SDL_SetRenderDrawBlendMode(renderer_, convertBlendMode(mode));
+    }
 }
 
 BlendMode SDLRenderer::getBlendMode() const {
-    // 在SDL渲染器中，混合模式通常在纹理级别设置
-    return BlendMode::NONE;
+    return blend_mode_;
 }
 
 void SDLRenderer::drawPoint(int x, int y) {
-    if (renderer_) {
-        SDL_RenderDrawPoint(renderer_, x, y);
+    if (!renderer_) {
+        return;
+    }
+    if (config_.enable_batching) {
+        batchRect(static_cast<float>(x), static_cast<float>(y), 1.0f, 1.0f);
+        return;
     }
+    applyClip(clip_enabled_, clip_rect_);
+    SDL_RenderDrawPoint(renderer_, x, y);
 }
 
 void SDLRenderer::drawPoints(const Point* points, int count) {
-    if (renderer_ && points && count > 0) {
-        std::vector<SDL_Point> sdlPoints(count);
+    if (!renderer_ || !points || count <= 0) {
+        return;
+    }
+    if (config_.enable_batching) {
         for (int i = 0; i < count; ++i) {
-            sdlPoints[i].x = points[i].x;
-            sdlPoints[i].y = points[i].y;
+            batchRect(static_cast<float>(points[i].x), static_cast<float>(points[i].y), 1.0f, 1.0f);
         }
-        SDL_RenderDrawPoints(renderer_, sdlPoints.data(), count);
+        return;
     }
+    std::vector<SDL_Point> sdlPoints(count);
+    for (int i = 0; i < count; ++i) {
+        sdlPoints[i].x = points[i].x;
+        sdlPoints[i].y = points[i].y;
+    }
+    applyClip(clip_enabled_, clip_rect_);
+    SDL_RenderDrawPoints(renderer_, sdlPoints.data(), count);
 }
 
 void SDLRenderer::drawLine(int x1, int y1, int x2, int y2) {
     if (renderer_) {
+        // 任意角度的线段不转换成四边形，先提交之前的图元以保持绘制顺序
+        flushBatches();
+        applyClip(clip_enabled_, clip_rect_);
         SDL_RenderDrawLine(renderer_, x1, y1, x2, y2);
     }
 }
@@ -373,47 +424,101 @@ void SDLRenderer::drawLines(const Point* points, int count) {
             sdlPoints[i].x = points[i].x;
             sdlPoints[i].y = points[i].y;
         }
+        flushBatches();
+        applyClip(clip_enabled_, clip_rect_);
         SDL_RenderDrawLines(renderer_, sdlPoints.data(), count);
     }
 }
 
 void SDLRenderer::drawRect(const Rect& rect) {
-    if (renderer_) {
-        SDL_Rect sdlRect = { rect.x, rect.y, rect.w, rect.h };
-        SDL_RenderDrawRect(renderer_, &sdlRect);
+    if (!renderer_ || rect.w <= 0 || rect.h <= 0) {
+        return;
     }
+    if (config_.enable_batching) {
+        // 与 SDL_RenderDrawRect 相同：矩形内侧 1 像素宽的边框
+        const float x = static_cast<float>(rect.x);
+        const float y = static_cast<float>(rect.y);
+        const float w = static_cast<float>(rect.w);
+        const float h = static_cast<float>(rect.h);
+        batchRect(x, y, w, 1.0f);
+        if (rect.h > 1) {
+            batchRect(x, y + h - 1.0f, w, 1.0f);
+        }
+        if (rect.h > 2) {
+            batchRect(x, y + 1.0f, 1.0f, h - 2.0f);
+            if (rect.w > 1) {
+                batchRect(x + w - 1.0f, y + 1.0f, 1.0f, h - 2.0f);
+            }
+        }
+        return;
+    }
+    SDL_Rect sdlRect = { rect.x, rect.y, rect.w, rect.h };
+    applyClip(clip_enabled_, clip_rect_);
+    SDL_RenderDrawRect(renderer_, &sdlRect);
 }
 
 void SDLRenderer::fillRect(const Rect& rect) {
-    if (renderer_) {
-        SDL_Rect sdlRect = { rect.x, rect.y, rect.w, rect.h };
-        SDL_RenderFillRect(renderer_, &sdlRect);
+    if (!renderer_) {
+        return;
+    }
+    if (config_.enable_batching) {
+        batchRect(static_cast<float>(rect.x), static_cast<float>(rect.y),
+                  static_cast<float>(rect.w), static_cast<float>(rect.h));
+        return;
+    }
+    if (batcher_.isCulled(toFRect(rect))) {
+        stats_.primitives_culled++;
+        return;
     }
+    SDL_Rect sdlRect = { rect.x, rect.y, rect.w, rect.h };
+    applyClip(clip_enabled_, clip_rect_);
+    SDL_RenderFillRect(renderer_, &sdlRect);
 }
 
 void SDLRenderer::drawRects(const Rect* rects, int count) {
-    if (renderer_ && rects && count > 0) {
-        std::vector<SDL_Rect> sdlRects(count);
+    if (!renderer_ || !rects || count <= 0) {
+        return;
+    }
+    if (config_.enable_batching) {
         for (int i = 0; i < count; ++i) {
-            sdlRects[i].x = rects[i].x;
-            sdlRects[i].y = rects[i].y;
-            sdlRects[i].w = rects[i].w;
-            sdlRects[i].h = rects[i].h;
+            drawRect(rects[i]);
         }
-        SDL_RenderDrawRects(renderer_, sdlRects.data(), count);
+        return;
+    }
+    std::vector<SDL_Rect> sdlRects(count);
+    for (int i = 0; i < count; ++i) {
+        sdlRects[i].x = rects[i].x;
+        sdlRects[i].y = rects[i].y;
+        sdlRects[i].w = rects[i].w;
+        sdlRects[i].h = rects[i].h;
     }
+    applyClip(clip_enabled_, clip_rect_);
+    SDL_RenderDrawRects(renderer_, sdlRects.data(), count);
 }
 
 void SDLRenderer::fillRects(const Rect* rects, int count) {
-    if (renderer_ && rects && count > 0) {
-        std::vector<SDL_Rect> sdlRects(count);
+    if (!renderer_ || !rects || count <= 0) {
+        return;
+    }
+    if (config_.enable_batching) {
         for (int i = 0; i < count; ++i) {
-            sdlRects[i].x = rects[i].x;
-            sdlRects[i].y = rects[i].y;
-            sdlRects[i].w = rects[i].w;
-            sdlRects[i].h = rects[i].h;
+            batchRect(static_cast<float>(rects[i].x), static_cast<float>(rects[i].y),
+                      static_cast<float>(rects[i].w), static_cast<float>(rects[i].h));
+        }
+        return;
+    }
+    std::vector<SDL_Rect> sdlRects;
+    sdlRects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (batcher_.isCulled(toFRect(rects[i]))) {
+            stats_.primitives_culled++;
+            continue;
         }
-        SDL_RenderFillRects(renderer_, sdlRects.data(), count);
+        sdlRects.push_back({ rects[i].x, rects[i].y, rects[i].w, rects[i].h });
+    }
+    if (!sdlRects.empty()) {
+        applyClip(clip_enabled_, clip_rect_);
+        SDL_RenderFillRects(renderer_, sdlRects.data(), static_cast<int>(sdlRects.size()));
     }
 }
 
@@ -426,6 +531,15 @@ void SDLRenderer::drawTexture(ITexture* texture, const Rect* src_rect, const Rec
     if (!sdlTexture) {
         return;
     }
+
+    if (dst_rect && config_.enable_batching) {
+        batchTexture(sdlTexture, src_rect, toFRect(*dst_rect), 0.0, nullptr, FlipMode::NONE);
+        return;
+    }
+    if (dst_rect && batcher_.isCulled(toFRect(*dst_rect))) {
+        stats_.primitives_culled++;
+        return;
+    }
     
     SDL_Rect srcRect, dstRect;
     SDL_Rect* srcPtr = nullptr;
@@ -447,6 +561,9 @@ void SDLRenderer::drawTexture(ITexture* texture, const Rect* src_rect, const Rec
         dstPtr = &dstRect;
     }
     
+    // 未指定目标矩形（铺满整个目标）时直接绘制
+    flushBatches();
+    applyClip(clip_enabled_, clip_rect_);
     SDL_RenderCopy(renderer_, sdlTexture->getSDLTexture(), srcPtr, dstPtr);
 }
 
@@ -460,13 +577,25 @@ void SDLRenderer::drawTextureEx(ITexture* texture, const Rect* src_rect, const R
     if (!sdlTexture) {
         return;
     }
+
+    SDL_FPoint centerPoint;
+    SDL_FPoint* centerPtr = nullptr;
+    if (center) {
+        centerPoint.x = center->x;
+        centerPoint.y = center->y;
+        centerPtr = &centerPoint;
+    }
+
+    if (dst_rect && config_.enable_batching) {
+        const SDL_FRect dst = { dst_rect->x, dst_rect->y, dst_rect->w, dst_rect->h };
+        batchTexture(sdlTexture, src_rect, dst, angle, centerPtr, flip);
+        return;
+    }
     
-    SDL_Rect srcRect, dstRect;
+    SDL_Rect srcRect;
     SDL_FRect dstRectF;
-    SDL_FPoint centerPoint;
     SDL_Rect* srcPtr = nullptr;
     SDL_FRect* dstPtr = nullptr;
-    SDL_FPoint* centerPtr = nullptr;
     
     if (src_rect) {
         srcRect.x = src_rect->x;
@@ -484,24 +613,159 @@ void SDLRenderer::drawTextureEx(ITexture* texture, const Rect* src_rect, const R
         dstPtr = &dstRectF;
     }
     
-    // 简化实现，不使用center参数
-    SDL_RendererFlip sdlFlip = SDL_FLIP_NONE;
-    switch (flip) {
-        case FlipMode::HORIZONTAL:
-            sdlFlip = SDL_FLIP_HORIZONTAL;
-            break;
-        case FlipMode::VERTICAL:
-            sdlFlip = SDL_FLIP_VERTICAL;
-            break;
-        case FlipMode::BOTH:
-            sdlFlip = static_cast<SDL_RendererFlip>(SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL);
-            break;
-        default:
-            sdlFlip = SDL_FLIP_NONE;
-            break;
+    flushBatches();
+    applyClip(clip_enabled_, clip_rect_);
+    SDL_RenderCopyExF(renderer_, sdlTexture->getSDLTexture(), srcPtr, dstPtr, angle, centerPtr, convertFlipMode(flip));
+}
+
+void SDLRenderer::flushBatches() {
+    batcher_.flush();
+    batched_textures_.clear();
+
+    const BatchStats& batchStats = batcher_.getStats();
+    if (batchStats.draw_calls == recorded_batch_stats_.draw_calls &&
+        batchStats.quads_culled == recorded_batch_stats_.quads_culled) {
+        return;
+    }
+    stats_.addBatchStats(recorded_batch_stats_, batchStats);
+    RenderManager::getInstance().recordBatchStats(recorded_batch_stats_, batchStats);
+    recorded_batch_stats_ = batchStats;
+
+    // 提交时按批次切换过纯色混合模式，恢复为当前设置供直接绘制使用
+    if (renderer_) {
+        SDL_SetRenderDrawBlendMode(renderer_, convertBlendMode(blend_mode_));
+    }
+}
+
+void SDLRenderer::beginBatchFrame() {
+    stats_.reset();
+    frame_quads_ = 0;
+    // 窗口尺寸变化会重置视口，其他代码（如 ImGui 后端）也可能改动过裁剪矩形
+    refreshViewportSize();
+    applied_clip_valid_ = false;
+}
+
+void SDLRenderer::refreshViewportSize() {
+    if (!renderer_) {
+        return;
+    }
+    SDL_Rect viewport;
+    SDL_RenderGetViewport(renderer_, &viewport);
+    batcher_.setViewportSize(viewport.w, viewport.h);
+}
+
+void SDLRenderer::submitBatch(const BatchState& state, const SDL_Vertex* vertices, int vertex_count,
+                              const int* indices, int index_count) {
+    if (!renderer_) {
+        return;
+    }
+    applyClip(state.clip_enabled, state.clip_rect);
+    if (state.texture) {
+        SDL_SetTextureBlendMode(state.texture, state.blend_mode);
+    } else {
+        SDL_SetRenderDrawBlendMode(renderer_, state.blend_mode);
+    }
+    if (SDL_RenderGeometry(renderer_, state.texture, vertices, vertex_count, indices, index_count) != 0) {
+        DEARTS_LOG_WARN(std::string("SDL_RenderGeometry 失败: ") + SDL_GetError());
+    }
+}
+
+void SDLRenderer::applyClip(bool enabled, const SDL_Rect& rect) {
+    if (applied_clip_valid_ && applied_clip_enabled_ == enabled &&
+        (!enabled || (applied_clip_rect_.x == rect.x && applied_clip_rect_.y == rect.y &&
+                      applied_clip_rect_.w == rect.w && applied_clip_rect_.h == rect.h))) {
+        return;
+    }
+    SDL_RenderSetClipRect(renderer_, enabled ? &rect : nullptr);
+    applied_clip_valid_ = true;
+    applied_clip_enabled_ = enabled;
+    applied_clip_rect_ = rect;
+}
+
+void SDLRenderer::batchRect(float x, float y, float w, float h) {
+    if (w <= 0.0f || h <= 0.0f) {
+        return;
+    }
+    const SDL_Color color = { draw_color_.r, draw_color_.g, draw_color_.b, draw_color_.a };
+    const SDL_Vertex vertices[4] = {
+        { { x, y }, color, { 0.0f, 0.0f } },
+        { { x + w, y }, color, { 0.0f, 0.0f } },
+        { { x + w, y + h }, color, { 0.0f, 0.0f } },
+        { { x, y + h }, color, { 0.0f, 0.0f } },
+    };
+    if (batcher_.addQuad(nullptr, SDL_BLENDMODE_NONE, vertices)) {
+        frame_quads_++;
+    }
+}
+
+void SDLRenderer::batchTexture(SDLTexture* texture, const Rect* src_rect, const SDL_FRect& dst,
+                               double angle, const SDL_FPoint* center, FlipMode flip) {
+    SDL_Texture* sdlTexture = texture->getSDLTexture();
+    const float textureWidth = static_cast<float>(texture->getWidth());
+    const float textureHeight = static_cast<float>(texture->getHeight());
+    if (!sdlTexture || textureWidth <= 0.0f || textureHeight <= 0.0f || dst.w <= 0.0f || dst.h <= 0.0f) {
+        return;
+    }
+
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src_rect) {
+        u0 = static_cast<float>(src_rect->x) / textureWidth;
+        v0 = static_cast<float>(src_rect->y) / textureHeight;
+        u1 = static_cast<float>(src_rect->x + src_rect->w) / textureWidth;
+        v1 = static_cast<float>(src_rect->y + src_rect->h) / textureHeight;
+    }
+    if (flip == FlipMode::HORIZONTAL || flip == FlipMode::BOTH) {
+        std::swap(u0, u1);
+    }
+    if (flip == FlipMode::VERTICAL || flip == FlipMode::BOTH) {
+        std::swap(v0, v1);
+    }
+
+    // SDL_RenderGeometry 不应用纹理的颜色/Alpha 调制，折算进顶点颜色
+    SDL_Color color = { 255, 255, 255, 255 };
+    SDL_GetTextureColorMod(sdlTexture, &color.r, &color.g, &color.b);
+    SDL_GetTextureAlphaMod(sdlTexture, &color.a);
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    SDL_GetTextureBlendMode(sdlTexture, &blendMode);
+
+    SDL_FPoint corners[4] = {
+        { 0.0f, 0.0f }, { dst.w, 0.0f }, { dst.w, dst.h }, { 0.0f, dst.h },
+    };
+    if (angle != 0.0) {
+        // 绕中心点（相对目标矩形左上角，默认为矩形中心）顺时针旋转，与 SDL_RenderCopyEx 一致
+        const SDL_FPoint pivot = center ? *center : SDL_FPoint{ dst.w * 0.5f, dst.h * 0.5f };
+        const double radians = angle * 3.14159265358979323846 / 180.0;
+        const float c = static_cast<float>(std::cos(radians));
+        const float s = static_cast<float>(std::sin(radians));
+        for (SDL_FPoint& corner : corners) {
+            const float dx = corner.x - pivot.x;
+            const float dy = corner.y - pivot.y;
+            corner.x = pivot.x + dx * c - dy * s;
+            corner.y = pivot.y + dx * s + dy * c;
+        }
+    }
+
+    const SDL_Vertex vertices[4] = {
+        { { dst.x + corners[0].x, dst.y + corners[0].y }, color, { u0, v0 } },
+        { { dst.x + corners[1].x, dst.y + corners[1].y }, color, { u1, v0 } },
+        { { dst.x + corners[2].x, dst.y + corners[2].y }, color, { u1, v1 } },
+        { { dst.x + corners[3].x, dst.y + corners[3].y }, color, { u0, v1 } },
+    };
+    if (!batcher_.addQuad(sdlTexture, blendMode, vertices)) {
+        return;
+    }
+    frame_quads_++;
+
+    // 批次只保存 SDL_Texture*，持有纹理直到提交，避免调用方在 flush 之前释放纹理后访问已销毁的 SDL 纹理
+    if (!batched_textures_.empty() && batched_textures_.back().get() == texture) {
+        return;
+    }
+    if (auto owner = texture->weak_from_this().lock()) {
+        batched_textures_.push_back(std::move(owner));
+    } else {
+        // 不是由 shared_ptr 持有的纹理无法延长生命周期，立即提交
+        flushBatches();
     }
-    
-    SDL_RenderCopyExF(renderer_, sdlTexture->getSDLTexture(), srcPtr, dstPtr, angle, nullptr, sdlFlip);
 }
 
 std::shared_ptr<ITexture> SDLRenderer::createTexture(int width, int height, TextureFormat format, TextureAccess access) {
@@ -644,9 +908,12 @@ bool SDLRenderer::setRenderTarget(ITexture* target) {
         sdlTexture = sdlTarget->getSDLTexture();
     }
     
+    flushBatches();
     int result = SDL_SetRenderTarget(renderer_, sdlTexture);
     if (result == 0) {
         current_target_ = target;
+        refreshViewportSize();
+        applied_clip_valid_ = false;
         return true;
     }
     
@@ -659,8 +926,11 @@ ITexture* SDLRenderer::getRenderTarget() const {
 
 void SDLRenderer::resetRenderTarget() {
     if (renderer_) {
+        flushBatches();
         SDL_SetRenderTarget(renderer_, nullptr);
         current_target_ = nullptr;
+        refreshViewportSize();
+        applied_clip_valid_ = false;
     }
 }
 
@@ -810,6 +1080,13 @@ bool SDLRenderer::initializeImGui(SDL_Window* window, SDL_Renderer* renderer) {
     // 检查ImGui版本
     IMGUI_CHECKVERSION();
     
+#ifdef DEARTS_TRACK_ALLOCATIONS
+    // 让 ImGui 的分配（字体图集、绘制缓冲）经过全局 operator new，计入分配统计
+    ImGui::SetAllocatorFunctions(
+        [](size_t size, void*) -> void* { return ::operator new(size, std::nothrow); },
+        [](void* ptr, void*) { ::operator delete(ptr); });
+#endif
+
     // 创建ImGui上下文
     ImGui::CreateContext();
     
@@ -853,6 +1130,8 @@ void SDLRenderer::newImGuiFrame() {
         return;
     }
     
+    beginBatchFrame();
+
     // 开始ImGui帧
     ImGui_ImplSDL2_NewFrame();
     ImGui_ImplSDLRenderer2_NewFrame();
@@ -861,24 +1140,43 @@ void SDLRenderer::newImGuiFrame() {
     DEARTS_LOG_DEBUG("SDLRenderer::newImGuiFrame() - ImGui帧已启动");
 }
 
-void SDLRenderer::renderImGui(ImDrawData* draw_data) {
+bool SDLRenderer::renderImGui(ImDrawData* draw_data) {
     DEARTS_LOG_DEBUG("SDLRenderer::renderImGui() - 渲染ImGui，draw_data: " + std::to_string(reinterpret_cast<uintptr_t>(draw_data)));
     
     if (!imgui_initialized_ || !renderer_) {
         DEARTS_LOG_ERROR("SDLRenderer::renderImGui() - ImGui未初始化或渲染器无效");
-        return;
+        return false;
     }
     
     if (!draw_data) {
         DEARTS_LOG_WARN("SDLRenderer::renderImGui() - 无效的绘制数据");
-        return;
+        return false;
+    }
+
+    // ImGui 绘制在本帧其他图元之上
+    flushBatches();
+
+    // 本帧还直接绘制了图元时无法只凭 ImGui 绘制数据判断画面是否变化
+    if (frame_quads_ > 0) {
+        frame_filter_.invalidate();
+    }
+
+    // 画面与上一帧相同：ImGui 帧（输入、布局逻辑）已经执行，只跳过后端提交
+    if (!frame_filter_.shouldSubmit(draw_data)) {
+        stats_.frames_skipped++;
+        RenderManager::getInstance().recordSkippedFrame();
+        return false;
     }
     
-    // 渲染ImGui
-    ImGui::Render();
+    // 渲染ImGui（ImGui::Render() 由调用方完成）
     ImGui_ImplSDLRenderer2_RenderDrawData(draw_data, renderer_);
+
+    // 本帧绘制统计（帧开始时清零，frame_count/frame_time 由 endFrame 更新）
+    stats_.addDrawData(draw_data);
+    RenderManager::getInstance().recordDrawData(draw_data);
     
     DEARTS_LOG_DEBUG("SDLRenderer::renderImGui() - ImGui已渲染");
+    return true;
 }
 
 // RenderContext 实现
@@ -1005,12 +1303,29 @@ void RenderManager::setGlobalConfig(const RendererConfig& config) {
 }
 
 RenderStats RenderManager::getGlobalStats() const {
-    RenderStats stats;
-    return stats;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return global_stats_;
 }
 
 void RenderManager::resetGlobalStats() {
-    // 重置所有上下文的统计信息
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    global_stats_ = RenderStats();
+}
+
+void RenderManager::recordDrawData(const ImDrawData* draw_data) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    global_stats_.addDrawData(draw_data);
+    global_stats_.frame_count++;
+}
+
+void RenderManager::recordSkippedFrame() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    global_stats_.frames_skipped++;
+}
+
+void RenderManager::recordBatchStats(const BatchStats& before, const BatchStats& after) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    global_stats_.addBatchStats(before, after);
 }
 
 void RenderManager::setScaleQuality(ScaleQuality quality) {
@@ -26,6 +26,8 @@
 #include <imgui.h>
 #include <imgui_impl_sdl2.h>
 #include <imgui_impl_sdlrenderer2.h>
+#include "draw_data_hash.h"
+#include "render_batch.h"
 
 // 前向声明
 struct SDL_Window;
@@ -210,10 +212,11 @@ struct RendererConfig {
     bool enable_vsync;
     ScaleQuality scale_quality;
     Color clear_color;
-    bool enable_batching;
-    size_t max_batch_size;
-    bool enable_culling;
+    bool enable_batching;            ///< 基本图元和纹理绘制先进入命令缓冲，按批通过 SDL_RenderGeometry 提交
+    size_t max_batch_size;           ///< 单批最多的四边形数
+    bool enable_culling;             ///< 丢弃完全落在视口和裁剪矩形之外的图元
     bool enable_depth_test;
+    bool skip_unchanged_frames;      ///< ImGui 绘制数据与上一帧相同时跳过提交和 present
     std::string shader_path;
     
     RendererConfig()
@@ -224,7 +227,8 @@ struct RendererConfig {
         , enable_batching(true)
         , max_batch_size(1000)
         , enable_culling(true)
-        , enable_depth_test(false) {
+        , enable_depth_test(false)
+        , skip_unchanged_frames(true) {
     }
 };
 
@@ -257,11 +261,15 @@ struct TextureInfo {
  */
 struct RenderStats {
     uint64_t frame_count;
+    uint64_t frames_skipped;         ///< 因画面未变化而跳过提交的帧数（累计）
     uint64_t draw_calls;
     uint64_t vertices_rendered;
+    uint64_t indices_rendered;
     uint64_t triangles_rendered;
+    uint64_t command_lists;
     uint64_t textures_bound;
     uint64_t state_changes;
+    uint64_t primitives_culled;      ///< 被视口/裁剪矩形裁剪掉的图元数
     double frame_time;
     double cpu_time;
     double gpu_time;
@@ -271,11 +279,15 @@ struct RenderStats {
     
     RenderStats()
         : frame_count(0)
+        , frames_skipped(0)
         , draw_calls(0)
         , vertices_rendered(0)
+        , indices_rendered(0)
         , triangles_rendered(0)
+        , command_lists(0)
         , textures_bound(0)
         , state_changes(0)
+        , primitives_culled(0)
         , frame_time(0.0)
         , cpu_time(0.0)
         , gpu_time(0.0)
@@ -287,13 +299,45 @@ struct RenderStats {
     void reset() {
         draw_calls = 0;
         vertices_rendered = 0;
+        indices_rendered = 0;
         triangles_rendered = 0;
+        command_lists = 0;
         textures_bound = 0;
         state_changes = 0;
+        primitives_culled = 0;
         frame_time = 0.0;
         cpu_time = 0.0;
         gpu_time = 0.0;
     }
+
+    /**
+     * @brief 累加一帧 ImGui 绘制数据的顶点、索引和绘制命令数
+     */
+    void addDrawData(const ImDrawData* draw_data) {
+        if (!draw_data || !draw_data->Valid) {
+            return;
+        }
+        vertices_rendered += static_cast<uint64_t>(draw_data->TotalVtxCount);
+        indices_rendered += static_cast<uint64_t>(draw_data->TotalIdxCount);
+        triangles_rendered += static_cast<uint64_t>(draw_data->TotalIdxCount / 3);
+        command_lists += static_cast<uint64_t>(draw_data->CmdListsCount);
+        for (int i = 0; i < draw_data->CmdListsCount; ++i) {
+            draw_calls += static_cast<uint64_t>(draw_data->CmdLists[i]->CmdBuffer.Size);
+        }
+    }
+
+    /**
+     * @brief 累加两次批处理统计之间的差值
+     */
+    void addBatchStats(const BatchStats& before, const BatchStats& after) {
+        draw_calls += after.draw_calls - before.draw_calls;
+        vertices_rendered += after.vertices - before.vertices;
+        indices_rendered += after.indices - before.indices;
+        triangles_rendered += (after.indices - before.indices) / 3;
+        state_changes += after.state_changes - before.state_changes;
+        textures_bound += after.texture_changes - before.texture_changes;
+        primitives_culled += after.quads_culled - before.quads_culled;
+    }
 };
 
 // ============================================================================
@@ -452,8 +496,9 @@ public:
 
 /**
  * @brief SDL纹理实现
+ * @details 由 SDLRenderer 通过 std::make_shared 创建；命令缓冲借助 shared_from_this 在提交前保持纹理存活
  */
-class SDLTexture : public ITexture {
+class SDLTexture : public ITexture, public std::enable_shared_from_this<SDLTexture> {
 public:
     SDLTexture(SDL_Texture* texture, const TextureInfo& info);
     ~SDLTexture() override;
@@ -549,7 +594,23 @@ public:
     bool initializeImGui(SDL_Window* window, SDL_Renderer* renderer);
     void shutdownImGui();
     void newImGuiFrame();
-    void renderImGui(ImDrawData* draw_data);
+
+    /**
+     * @brief 提交 ImGui 绘制数据（调用方需先调用 ImGui::Render()）
+     * @return 是否已提交；画面与上一帧相同时返回 false，调用方应跳过 present
+     */
+    bool renderImGui(ImDrawData* draw_data);
+
+    /**
+     * @brief 下一帧强制提交（窗口暴露、尺寸变化等）
+     */
+    void invalidateFrame() { frame_filter_.invalidate(); }
+
+    /**
+     * @brief 提交命令缓冲中待处理的图元
+     * @details present、切换渲染目标/视口、直接绘制和 ImGui 提交之前会自动调用
+     */
+    void flushBatches();
     
     // SDL特定方法
     SDL_Renderer* getSDLRenderer() const { return renderer_; }
@@ -563,6 +624,20 @@ private:
     
     // ImGui相关成员变量
     bool imgui_initialized_;
+    UnchangedFrameFilter frame_filter_;     ///< 画面未变化检测
+
+    // 命令缓冲与当前绘制状态
+    RenderBatcher batcher_;
+    std::vector<std::shared_ptr<SDLTexture>> batched_textures_;  ///< 待提交批次引用的纹理，提交或丢弃前保持存活
+    Color draw_color_;
+    BlendMode blend_mode_;
+    bool clip_enabled_;
+    SDL_Rect clip_rect_;
+    bool applied_clip_valid_;               ///< applied_clip_* 是否与 SDL 渲染器的实际裁剪状态一致
+    bool applied_clip_enabled_;
+    SDL_Rect applied_clip_rect_;
+    uint64_t frame_quads_;                  ///< 本帧加入命令缓冲的图元数
+    BatchStats recorded_batch_stats_;       ///< 已计入 stats_ 的批处理统计快照
     
     std::unordered_map<uint32_t, std::shared_ptr<ITexture>> textures_;
     uint32_t next_texture_id_;
@@ -581,6 +656,16 @@ private:
     
     void updateStats();
     uint32_t generateTextureId();
+
+    // 批处理相关方法
+    void beginBatchFrame();
+    void refreshViewportSize();
+    void submitBatch(const BatchState& state, const SDL_Vertex* vertices, int vertex_count,
+                     const int* indices, int index_count);
+    void applyClip(bool enabled, const SDL_Rect& rect);
+    void batchRect(float x, float y, float w, float h);
+    void batchTexture(SDLTexture* texture, const Rect* src_rect, const SDL_FRect& dst,
+                      double angle, const SDL_FPoint* center, FlipMode flip);
     
     // ImGui相关方法
     bool initializeImGuiInternal();
@@ -753,6 +838,22 @@ public:
      * @brief 重置全局渲染统计
      */
     void resetGlobalStats();
+
+    /**
+     * @brief 记录一次 ImGui 绘制（所有窗口的绘制数据都汇总到全局统计）
+     * @param draw_data ImGui 绘制数据
+     */
+    void recordDrawData(const ImDrawData* draw_data);
+
+    /**
+     * @brief 记录一次因画面未变化而跳过的提交
+     */
+    void recordSkippedFrame();
+
+    /**
+     * @brief 记录一次批处理提交（两次统计快照之间的差值）
+     */
+    void recordBatchStats(const BatchStats& before, const BatchStats& after);
     
     /**
      * @brief 设置缩放质量
@@ -778,6 +879,8 @@ private:
     std::vector<std::shared_ptr<RenderContext>> contexts_;
     std::shared_ptr<RenderContext> current_context_;
     RendererConfig global_config_;
+    RenderStats global_stats_;                ///< 累计渲染统计（单调递增，使用方按帧取差值）
+    mutable std::mutex stats_mutex_;
     mutable std::mutex contexts_mutex_;
     bool initialized_ = false;
 };
@@ -8,11 +8,14 @@
 #include "font_resource.h"
 #include "../utils/logger.h"
 #include "../utils/file_utils.h"
+#include "../utils/memory_tracker.h"
+#include "../app/task_scheduler.h"
 
 #include <imgui.h>
 #include <misc/freetype/imgui_freetype.h>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 
 namespace DearTs {
 namespace Core {
@@ -73,6 +76,7 @@ void FontManager::shutdown() {
 }
 
 bool FontManager::loadDefaultFont(float fontSize, float scaleFactor) {
+    DEARTS_MEMORY_TAG(FONTS);
     try {
         ImGuiIO& io = ImGui::GetIO();
         
@@ -254,7 +258,7 @@ std::shared_ptr<FontResource> FontManager::loadLargeFont(float fontSize) {
     }
 
     FontConfig config("large", "", fontSize, 1.0f, getChineseGlyphRanges(), false);
-    return loadFontFromFile("large", "", config);
+    return loadFontAsync("large", config);
 }
 
 std::shared_ptr<FontResource> FontManager::loadTitleFont(float fontSize) {
@@ -264,23 +268,119 @@ std::shared_ptr<FontResource> FontManager::loadTitleFont(float fontSize) {
     }
 
     FontConfig config("title", "", fontSize, 1.0f, getChineseGlyphRanges(), false);
-    return loadFontFromFile("title", "", config);
+    return loadFontAsync("title", config);
+}
+
+std::string FontManager::getDefaultFontPath() {
+    std::string exeDir = Utils::FileUtils::getExecutableDirectory();
+    std::string fontPath = "resources/fonts/OPPOSans-M.ttf";
+    if (!exeDir.empty()) {
+        fontPath = exeDir + "/" + fontPath;
+        fontPath = Utils::FileUtils::normalizePath(fontPath);
+    }
+    return fontPath;
+}
+
+std::shared_ptr<FontResource> FontManager::loadFontAsync(const std::string& name, const FontConfig& config) {
+    auto it = fonts_.find(name);
+    if (it != fonts_.end()) {
+        return it->second;
+    }
+    auto retryIt = asyncRetryAt_.find(name);
+    if (retryIt != asyncRetryAt_.end()) {
+        // 失败后立即重试会让每一帧都重新读文件，失败回调又唤醒主循环，空闲时也停不下来
+        if (std::chrono::steady_clock::now() < retryIt->second) {
+            return nullptr;
+        }
+        asyncRetryAt_.erase(retryIt);
+    }
+    if (!asyncRequests_.insert(name).second) {
+        // 读取中
+        return nullptr;
+    }
+
+    // 字体文件有数 MB，读取放到工作线程，避免首次显示该布局的那一帧卡顿
+    std::string fontPath = getDefaultFontPath();
+    App::TaskScheduler::getInstance()
+        .submit([fontPath]() { return Utils::FileUtils::readBinaryFile(fontPath); }, App::TaskPriority::HIGH)
+        .then(
+            [this, name, fontPath, config](std::vector<uint8_t>& data) {
+                asyncRequests_.erase(name);
+                if (data.empty()) {
+                    DEARTS_LOG_ERROR("Font file not found: " + fontPath);
+                    asyncRetryAt_[name] = std::chrono::steady_clock::now() + ASYNC_RETRY_DELAY;
+                    return;
+                }
+                if (!addFontFromMemory(name, fontPath, config, data)) {
+                    asyncRetryAt_[name] = std::chrono::steady_clock::now() + ASYNC_RETRY_DELAY;
+                }
+            },
+            [this, name](const std::string& error) {
+                DEARTS_LOG_ERROR("读取字体文件失败 (" + name + "): " + error);
+                asyncRequests_.erase(name);
+                asyncRetryAt_[name] = std::chrono::steady_clock::now() + ASYNC_RETRY_DELAY;
+            });
+    return nullptr;
+}
+
+std::shared_ptr<FontResource> FontManager::addFontFromMemory(const std::string& name,
+                                                            const std::string& path,
+                                                            const FontConfig& config,
+                                                            const std::vector<uint8_t>& data) {
+    DEARTS_MEMORY_TAG(FONTS);
+    auto it = fonts_.find(name);
+    if (it != fonts_.end()) {
+        return it->second;
+    }
+
+    ImFontConfig fontConfig;
+    fillFontConfig(fontConfig, name, config);
+
+    // 字体图集接管这块内存并用 IM_FREE 释放
+    void* fontData = IM_ALLOC(data.size());
+    std::memcpy(fontData, data.data(), data.size());
+    ImFont* font = ImGui::GetIO().Fonts->AddFontFromMemoryTTF(
+        fontData,
+        static_cast<int>(data.size()),
+        fontConfig.SizePixels,
+        &fontConfig,
+        config.glyphRanges ? config.glyphRanges : getDefaultGlyphRanges()
+    );
+
+    if (!font) {
+        DEARTS_LOG_ERROR("创建字体失败: " + name);
+        return nullptr;
+    }
+
+    auto fontResource = std::make_shared<FontResource>(path, font, config);
+    fonts_[name] = fontResource;
+    DEARTS_LOG_INFO("字体已加载: " + name);
+    return fontResource;
+}
+
+void FontManager::fillFontConfig(ImFontConfig& fontConfig, const std::string& name, const FontConfig& config) {
+    // 使用优化的FreeType渲染设置
+    fontConfig.SizePixels = config.size * config.scale;
+    fontConfig.MergeMode = config.mergeMode;
+    fontConfig.OversampleH = 2;  // 提高水平采样率以增强清晰度
+    fontConfig.OversampleV = 1;  // 保持垂直采样率为1以避免模糊
+    fontConfig.PixelSnapH = true;
+    fontConfig.RasterizerMultiply = 1.0f;  // 避免过度加粗
+    // 启用FreeType优化
+    fontConfig.FontLoaderFlags = ImGuiFreeTypeLoaderFlags_LightHinting;
+    strcpy_s(fontConfig.Name, sizeof(fontConfig.Name), name.c_str());
 }
 
 std::shared_ptr<FontResource> FontManager::loadFontFromFile(const std::string& name,
                                                            const std::string& path,
                                                            const FontConfig& config) {
+    DEARTS_MEMORY_TAG(FONTS);
     try {
         // 确定字体文件路径
         std::string fontPath = path;
         if (fontPath.empty()) {
             // 如果没有提供路径，使用默认字体路径
-            std::string exeDir = Utils::FileUtils::getExecutableDirectory();
-            fontPath = "resources/fonts/OPPOSans-M.ttf";
-            if (!exeDir.empty()) {
-                fontPath = exeDir + "/" + fontPath;
-                fontPath = Utils::FileUtils::normalizePath(fontPath);
-            }
+            fontPath = getDefaultFontPath();
         }
 
         // 检查文件是否存在
@@ -297,17 +397,9 @@ std::shared_ptr<FontResource> FontManager::loadFontFromFile(const std::string& n
         
         ImGuiIO& io = ImGui::GetIO();
         
-        // 配置字体 - 使用优化的FreeType渲染设置
+        // 配置字体
         ImFontConfig fontConfig;
-        fontConfig.SizePixels = config.size * config.scale;
-        fontConfig.MergeMode = config.mergeMode;
-        fontConfig.OversampleH = 2;  // 提高水平采样率以增强清晰度
-        fontConfig.OversampleV = 1;  // 保持垂直采样率为1以避免模糊
-        fontConfig.PixelSnapH = true;
-        fontConfig.RasterizerMultiply = 1.0f;  // 避免过度加粗
-        // 启用FreeType优化
-        fontConfig.FontLoaderFlags = ImGuiFreeTypeLoaderFlags_LightHinting;
-        strcpy_s(fontConfig.Name, sizeof(fontConfig.Name), name.c_str());
+        fillFontConfig(fontConfig, name, config);
         
         // 加载字体
         ImFont* font = io.Fonts->AddFontFromFileTTF(
@@ -386,6 +478,8 @@ void FontManager::unloadFont(const std::string& name) {
 void FontManager::clearAll() {
     fonts_.clear();
     defaultFont_ = nullptr;
+    asyncRequests_.clear();
+    asyncRetryAt_.clear();
     
     // 清除ImGui字体
     ImGuiIO& io = ImGui::GetIO();
@@ -13,6 +13,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace DearTs {
 namespace Core {
@@ -102,6 +105,8 @@ private:
  */
 class FontManager {
 public:
+    static constexpr std::chrono::seconds ASYNC_RETRY_DELAY{5}; ///< 后台读取字体失败后再次尝试前的间隔
+
     /**
      * @brief 获取单例实例
      * @return FontManager实例指针
@@ -129,15 +134,18 @@ public:
 
     /**
      * @brief 加载大字体
+     * @details 首次调用时在后台读取字体文件并返回空指针，文件读完后在主线程加入字体图集，
+     *          之后的调用返回该字体。读取失败时同样返回空指针，ASYNC_RETRY_DELAY 之后的调用重新读取。
+     *          调用方必须处理空指针（通常是继续使用当前字体），并在之后的帧再次调用，不能只在初始化时调用一次
      * @param fontSize 字体大小
-     * @return 字体资源指针
+     * @return 字体资源指针，尚未加载完成或读取失败时为空
      */
     std::shared_ptr<FontResource> loadLargeFont(float fontSize = 16.0f);
 
     /**
-     * @brief 加载标题字体
+     * @brief 加载标题字体（异步，返回值约定同 loadLargeFont）
      * @param fontSize 字体大小
-     * @return 字体资源指针
+     * @return 字体资源指针，尚未加载完成或读取失败时为空
      */
     std::shared_ptr<FontResource> loadTitleFont(float fontSize = 20.0f);
     
@@ -273,10 +281,37 @@ private:
      * @brief 私有析构函数
      */
     ~FontManager() = default;
+
+    /**
+     * @brief 默认字体文件路径（可执行文件目录下的 resources/fonts/OPPOSans-M.ttf）
+     */
+    static std::string getDefaultFontPath();
+
+    /**
+     * @brief 在后台读取默认字体文件，读完后在主线程以指定名称加入字体图集
+     * @details 同一名称同时只有一次读取；失败后 ASYNC_RETRY_DELAY 内的调用不再发起读取
+     * @return 已加载时返回字体资源，否则返回空指针
+     */
+    std::shared_ptr<FontResource> loadFontAsync(const std::string& name, const FontConfig& config);
+
+    /**
+     * @brief 由内存中的字体文件数据创建字体（主线程调用）
+     */
+    std::shared_ptr<FontResource> addFontFromMemory(const std::string& name,
+                                                    const std::string& path,
+                                                    const FontConfig& config,
+                                                    const std::vector<uint8_t>& data);
+
+    /**
+     * @brief 填充 ImGui 字体配置（loadFontFromFile 与 addFontFromMemory 共用）
+     */
+    static void fillFontConfig(ImFontConfig& fontConfig, const std::string& name, const FontConfig& config);
     
     static FontManager* instance_;                                              ///< 单例实例
     std::unordered_map<std::string, std::shared_ptr<FontResource>> fonts_;     ///< 字体资源映射
     std::shared_ptr<FontResource> defaultFont_;                                 ///< 默认字体
+    std::unordered_set<std::string> asyncRequests_;                             ///< 正在后台读取的字体名称
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> asyncRetryAt_; ///< 读取失败的字体名称 -> 允许重试的时间
     float currentScale_ = 1.0f;                                                ///< 当前缩放因子
     bool initialized_ = false;                                                  ///< 是否已初始化
 };
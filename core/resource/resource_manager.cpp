@@ -18,6 +18,39 @@ namespace Resource {
 // 静态成员初始化
 ResourceManager* ResourceManager::instance_ = nullptr;
 
+/**
+ * @brief 获取图片在纹理中的区域
+ */
+SDL_Rect TextureResource::getRegion() const {
+    if (slot_) {
+        return slot_->rect;
+    }
+    SDL_Rect rect = {0, 0, 0, 0};
+    if (texture_) {
+        SDL_QueryTexture(texture_, nullptr, nullptr, &rect.w, &rect.h);
+    }
+    return rect;
+}
+
+/**
+ * @brief 获取图片区域的纹理坐标
+ */
+void TextureResource::getUV(float& u0, float& v0, float& u1, float& v1) const {
+    if (!slot_ || slot_->page_width <= 0 || slot_->page_height <= 0) {
+        u0 = 0.0f;
+        v0 = 0.0f;
+        u1 = 1.0f;
+        v1 = 1.0f;
+        return;
+    }
+    const float width = static_cast<float>(slot_->page_width);
+    const float height = static_cast<float>(slot_->page_height);
+    u0 = static_cast<float>(slot_->rect.x) / width;
+    v0 = static_cast<float>(slot_->rect.y) / height;
+    u1 = static_cast<float>(slot_->rect.x + slot_->rect.w) / width;
+    v1 = static_cast<float>(slot_->rect.y + slot_->rect.h) / height;
+}
+
 /**
  * @brief 获取单例实例
  * @return ResourceManager实例指针
@@ -51,6 +84,8 @@ bool ResourceManager::initialize(SDL_Renderer* renderer) {
         DEARTS_LOG_ERROR("资源管理器: 初始化SDL_image失败: " + std::string(IMG_GetError()));
         return false;
     }
+
+    atlas_ = std::make_unique<TextureAtlas>(renderer_);
     
     DEARTS_LOG_INFO("资源管理器初始化成功");
     return true;
@@ -62,6 +97,7 @@ bool ResourceManager::initialize(SDL_Renderer* renderer) {
 void ResourceManager::shutdown() {
     DEARTS_LOG_INFO("Shutting down ResourceManager");
     clearAll();
+    atlas_.reset();
     
     IMG_Quit();
     renderer_ = nullptr;
@@ -106,6 +142,18 @@ std::shared_ptr<TextureResource> ResourceManager::loadTexture(const std::string&
     }
     
     DEARTS_LOG_DEBUG("Image loaded successfully: " + path + " (" + std::to_string(surface->w) + "x" + std::to_string(surface->h) + ")");
+
+    // 小图放进共享图集，同一页上的图标绘制时不需要切换纹理
+    if (atlas_enabled_ && atlas_ && atlas_->accepts(surface)) {
+        auto slot = atlas_->add(path, surface);
+        if (slot) {
+            SDL_FreeSurface(surface);
+            auto texture_resource = std::make_shared<TextureResource>(path, std::move(slot));
+            resources_[path] = texture_resource;
+            DEARTS_LOG_INFO("ResourceManager: Loaded texture " + path + " into atlas");
+            return texture_resource;
+        }
+    }
     
     // 创建纹理
     SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
@@ -232,6 +280,9 @@ void ResourceManager::clearAll() {
     DEARTS_LOG_DEBUG("Clearing all resources");
     
     resources_.clear();
+    if (atlas_) {
+        atlas_->clear();
+    }
     DEARTS_LOG_INFO("ResourceManager: Cleared all resources");
 }
 
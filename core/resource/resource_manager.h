@@ -11,6 +11,7 @@
 #include <memory>
 #include <unordered_map>
 #include <SDL.h>
+#include "texture_atlas.h"
 // Logger removed - using simple output instead
 
 namespace DearTs {
@@ -75,6 +76,14 @@ public:
      */
     TextureResource(const std::string& path, SDL_Texture* texture)
         : Resource(path, ResourceType::TEXTURE), texture_(texture) {}
+
+    /**
+     * @brief 构造函数（图集中的子图）
+     * @param path 纹理路径
+     * @param slot 图集位置，纹理由图集持有
+     */
+    TextureResource(const std::string& path, std::shared_ptr<AtlasSlot> slot)
+        : Resource(path, ResourceType::TEXTURE), texture_(nullptr), slot_(std::move(slot)) {}
     
     /**
      * @brief 析构函数
@@ -87,12 +96,28 @@ public:
     
     /**
      * @brief 获取SDL纹理
-     * @return SDL纹理指针
+     * @return SDL纹理指针；图集中的子图返回所在的图集页，需配合 getRegion()/getUV() 使用
+     */
+    SDL_Texture* getTexture() const { return slot_ ? slot_->page : texture_; }
+
+    /**
+     * @brief 是否位于图集中
+     */
+    bool isAtlased() const { return slot_ != nullptr; }
+
+    /**
+     * @brief 获取图片在纹理中的区域（独立纹理为整张纹理）
      */
-    SDL_Texture* getTexture() const { return texture_; }
+    SDL_Rect getRegion() const;
+
+    /**
+     * @brief 获取图片区域的纹理坐标（左上角 u0,v0，右下角 u1,v1）
+     */
+    void getUV(float& u0, float& v0, float& u1, float& v1) const;
     
 private:
     SDL_Texture* texture_;
+    std::shared_ptr<AtlasSlot> slot_;   ///< 图集位置（独立纹理时为空）
 };
 
 /**
@@ -187,6 +212,16 @@ public:
      * @brief 清除所有资源
      */
     void clearAll();
+
+    /**
+     * @brief 设置是否把小图（图标等）放进共享图集，只影响之后加载的纹理
+     */
+    void setAtlasEnabled(bool enabled) { atlas_enabled_ = enabled; }
+
+    /**
+     * @brief 获取纹理图集（未初始化时为 nullptr）
+     */
+    TextureAtlas* getAtlas() const { return atlas_.get(); }
     
 private:
     /**
@@ -202,6 +237,8 @@ private:
     static ResourceManager* instance_;
     SDL_Renderer* renderer_ = nullptr;
     std::unordered_map<std::string, std::shared_ptr<Resource>> resources_;
+    std::unique_ptr<TextureAtlas> atlas_;   ///< 小图共享图集
+    bool atlas_enabled_ = true;
 };
 
 } // namespace Resource
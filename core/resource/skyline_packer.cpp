@@ -0,0 +1,113 @@
+/**
+ * @file skyline_packer.cpp
+ * @brief 天际线矩形装箱实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "skyline_packer.h"
+#include <algorithm>
+#include <limits>
+
+namespace DearTs {
+namespace Core {
+namespace Resource {
+
+void SkylinePacker::reset(int width, int height) {
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    used_area_ = 0;
+    skyline_.clear();
+    skyline_.push_back({0, 0, width_});
+}
+
+float SkylinePacker::getOccupancy() const {
+    const uint64_t total = static_cast<uint64_t>(width_) * static_cast<uint64_t>(height_);
+    return total == 0 ? 0.0f : static_cast<float>(static_cast<double>(used_area_) / static_cast<double>(total));
+}
+
+int SkylinePacker::fit(size_t index, int width, int height) const {
+    const int x = skyline_[index].x;
+    if (x + width > width_) {
+        return -1;
+    }
+    int y = skyline_[index].y;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        if (i >= skyline_.size()) {
+            return -1;
+        }
+        y = std::max(y, skyline_[i].y);
+        if (y + height > height_) {
+            return -1;
+        }
+        remaining -= skyline_[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int width, int height, PackedRect& out) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+
+    size_t bestIndex = skyline_.size();
+    int bestTop = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        const int y = fit(i, width, height);
+        if (y < 0) {
+            continue;
+        }
+        const int top = y + height;
+        if (top < bestTop || (top == bestTop && skyline_[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = skyline_[i].width;
+            bestY = y;
+        }
+    }
+    if (bestIndex == skyline_.size()) {
+        return false;
+    }
+
+    out = {skyline_[bestIndex].x, bestY, width, height};
+    addLevel(bestIndex, out.x, out.y, width, height);
+    used_area_ += static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    return true;
+}
+
+void SkylinePacker::addLevel(size_t index, int x, int y, int width, int height) {
+    skyline_.insert(skyline_.begin() + static_cast<std::ptrdiff_t>(index), {x, y + height, width});
+
+    // 新线段覆盖的后续线段缩短或移除
+    for (size_t i = index + 1; i < skyline_.size();) {
+        const Segment& previous = skyline_[i - 1];
+        Segment& segment = skyline_[i];
+        const int overlap = previous.x + previous.width - segment.x;
+        if (overlap <= 0) {
+            break;
+        }
+        segment.x += overlap;
+        segment.width -= overlap;
+        if (segment.width > 0) {
+            break;
+        }
+        skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    // 合并高度相同的相邻线段
+    for (size_t i = 0; i + 1 < skyline_.size();) {
+        if (skyline_[i].y == skyline_[i + 1].y) {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+    }
+}
+
+} // namespace Resource
+} // namespace Core
+} // namespace DearTs
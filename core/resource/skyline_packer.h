@@ -0,0 +1,87 @@
+/**
+ * @file skyline_packer.h
+ * @brief 天际线（Skyline）矩形装箱
+ * @details 维护一条由水平线段组成的“天际线”，每个矩形放在使其顶边最低的位置（bottom-left 规则），
+ *          高度相同时选择浪费宽度最少的线段。插入为 O(线段数)，适合图标这类尺寸相近的小图。
+ *          不依赖 SDL，只做坐标计算。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Resource {
+
+/**
+ * @brief 装箱结果
+ */
+struct PackedRect {
+    int x = 0;
+    int y = 0;
+    int w = 0;
+    int h = 0;
+};
+
+/**
+ * @brief 天际线装箱器
+ */
+class SkylinePacker {
+public:
+    SkylinePacker() = default;
+    SkylinePacker(int width, int height) { reset(width, height); }
+
+    /**
+     * @brief 清空并设置容器尺寸
+     */
+    void reset(int width, int height);
+
+    /**
+     * @brief 放入一个矩形
+     * @param width 宽度
+     * @param height 高度
+     * @param out 放置位置
+     * @return 放不下时返回 false
+     */
+    bool insert(int width, int height, PackedRect& out);
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+    /**
+     * @brief 已放入矩形的总面积
+     */
+    uint64_t getUsedArea() const { return used_area_; }
+
+    /**
+     * @brief 占用率（已放入面积 / 容器面积）
+     */
+    float getOccupancy() const;
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    /**
+     * @brief 矩形左边对齐到第 index 段时的放置高度，放不下返回 -1
+     */
+    int fit(size_t index, int width, int height) const;
+    void addLevel(size_t index, int x, int y, int width, int height);
+
+    int width_ = 0;
+    int height_ = 0;
+    uint64_t used_area_ = 0;
+    std::vector<Segment> skyline_;
+};
+
+} // namespace Resource
+} // namespace Core
+} // namespace DearTs
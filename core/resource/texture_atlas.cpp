@@ -0,0 +1,238 @@
+/**
+ * @file texture_atlas.cpp
+ * @brief 运行时纹理图集实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "texture_atlas.h"
+#include "../utils/logger.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Core {
+namespace Resource {
+
+TextureAtlas::TextureAtlas(SDL_Renderer* renderer)
+    : renderer_(renderer)
+    , page_size_(PAGE_SIZE) {
+    SDL_RendererInfo info;
+    if (renderer_ && SDL_GetRendererInfo(renderer_, &info) == 0) {
+        if (info.max_texture_width > 0) {
+            page_size_ = std::min(page_size_, info.max_texture_width);
+        }
+        if (info.max_texture_height > 0) {
+            page_size_ = std::min(page_size_, info.max_texture_height);
+        }
+    }
+}
+
+TextureAtlas::~TextureAtlas() {
+    clear();
+}
+
+bool TextureAtlas::accepts(const SDL_Surface* surface) const {
+    return surface && surface->w > 0 && surface->h > 0 &&
+           surface->w <= MAX_IMAGE_SIZE && surface->h <= MAX_IMAGE_SIZE &&
+           surface->w + 2 * PADDING <= page_size_ && surface->h + 2 * PADDING <= page_size_;
+}
+
+std::shared_ptr<AtlasSlot> TextureAtlas::add(const std::string& key, SDL_Surface* surface) {
+    if (!renderer_ || !accepts(surface)) {
+        return nullptr;
+    }
+
+    for (const Entry& entry : entries_) {
+        if (entry.key == key && entry.slot.use_count() > 1) {
+            return entry.slot;
+        }
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.surface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!entry.surface) {
+        DEARTS_LOG_ERROR("纹理图集: 转换图片格式失败 " + key + ": " + SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetSurfaceBlendMode(entry.surface, SDL_BLENDMODE_NONE);
+    entry.slot = std::make_shared<AtlasSlot>();
+
+    // 现有页面 -> 回收后重新打包 -> 新建页面
+    bool placed = place(entry, true);
+    if (!placed && releaseUnused() > 0) {
+        repack();
+        placed = place(entry, true);
+    }
+    if (!placed && pages_.size() < MAX_PAGES && createPage()) {
+        placed = place(entry, true);
+    }
+    if (!placed) {
+        SDL_FreeSurface(entry.surface);
+        return nullptr;
+    }
+
+    std::shared_ptr<AtlasSlot> slot = entry.slot;
+    entries_.push_back(std::move(entry));
+    DEARTS_LOG_DEBUG("纹理图集: 已加入 " + key + "，共 " + std::to_string(entries_.size()) + " 张图片、" +
+                     std::to_string(pages_.size()) + " 页");
+    return slot;
+}
+
+bool TextureAtlas::place(Entry& entry, bool upload_now) {
+    const int width = entry.surface->w + 2 * PADDING;
+    const int height = entry.surface->h + 2 * PADDING;
+    for (Page& page : pages_) {
+        PackedRect rect;
+        if (!page.packer.insert(width, height, rect)) {
+            continue;
+        }
+        blit(page, entry, rect.x, rect.y);
+        if (upload_now) {
+            upload(page, SDL_Rect{rect.x, rect.y, rect.w, rect.h});
+        }
+        entry.slot->page = page.texture;
+        entry.slot->rect = {rect.x + PADDING, rect.y + PADDING, entry.surface->w, entry.surface->h};
+        entry.slot->page_width = page.packer.getWidth();
+        entry.slot->page_height = page.packer.getHeight();
+        return true;
+    }
+    return false;
+}
+
+void TextureAtlas::repack() {
+    releaseUnused();
+
+    // 先放高的图片，天际线更平整
+    std::stable_sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+        return a.surface->h > b.surface->h;
+    });
+    for (Page& page : pages_) {
+        page.packer.reset(page_size_, page_size_);
+        SDL_FillRect(page.pixels, nullptr, 0);
+    }
+
+    size_t usedPages = 0;
+    for (Entry& entry : entries_) {
+        if (!place(entry, false)) {
+            // 图片总数不变且每张都曾放下过，只有页数已满又被碎片化时才会走到这里
+            if (pages_.size() >= MAX_PAGES || !createPage() || !place(entry, false)) {
+                DEARTS_LOG_WARN("纹理图集: 重新打包时无法放下 " + entry.key);
+                entry.slot->page = nullptr;
+                continue;
+            }
+        }
+        for (size_t i = 0; i < pages_.size(); ++i) {
+            if (pages_[i].texture == entry.slot->page) {
+                usedPages = std::max(usedPages, i + 1);
+            }
+        }
+    }
+
+    // 释放末尾的空页，其余页面整体上传
+    while (pages_.size() > usedPages) {
+        destroyPage(pages_.back());
+        pages_.pop_back();
+    }
+    for (Page& page : pages_) {
+        upload(page, SDL_Rect{0, 0, page_size_, page_size_});
+    }
+    DEARTS_LOG_DEBUG("纹理图集: 重新打包完成，" + std::to_string(entries_.size()) + " 张图片、" +
+                     std::to_string(pages_.size()) + " 页");
+}
+
+void TextureAtlas::clear() {
+    for (Entry& entry : entries_) {
+        entry.slot->page = nullptr;
+        SDL_FreeSurface(entry.surface);
+    }
+    entries_.clear();
+    for (Page& page : pages_) {
+        destroyPage(page);
+    }
+    pages_.clear();
+}
+
+float TextureAtlas::getOccupancy() const {
+    if (pages_.empty()) {
+        return 0.0f;
+    }
+    float total = 0.0f;
+    for (const Page& page : pages_) {
+        total += page.packer.getOccupancy();
+    }
+    return total / static_cast<float>(pages_.size());
+}
+
+bool TextureAtlas::createPage() {
+    Page page;
+    page.pixels = SDL_CreateRGBSurfaceWithFormat(0, page_size_, page_size_, 32, SDL_PIXELFORMAT_RGBA32);
+    page.texture = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, page_size_, page_size_);
+    if (!page.pixels || !page.texture) {
+        DEARTS_LOG_ERROR("纹理图集: 创建图集页失败: " + std::string(SDL_GetError()));
+        destroyPage(page);
+        return false;
+    }
+    SDL_FillRect(page.pixels, nullptr, 0);
+    SDL_SetTextureBlendMode(page.texture, SDL_BLENDMODE_BLEND);
+    page.packer.reset(page_size_, page_size_);
+    upload(page, SDL_Rect{0, 0, page_size_, page_size_});
+    pages_.push_back(std::move(page));
+    return true;
+}
+
+void TextureAtlas::destroyPage(Page& page) {
+    if (page.texture) {
+        SDL_DestroyTexture(page.texture);
+        page.texture = nullptr;
+    }
+    if (page.pixels) {
+        SDL_FreeSurface(page.pixels);
+        page.pixels = nullptr;
+    }
+}
+
+void TextureAtlas::blit(Page& page, const Entry& entry, int x, int y) {
+    SDL_Surface* source = entry.surface;
+    const int w = source->w;
+    const int h = source->h;
+
+    // SDL_BlitSurface 会修改目标矩形，每次传入副本
+    auto copy = [&](SDL_Rect from, SDL_Rect to) {
+        SDL_BlitSurface(source, &from, page.pixels, &to);
+    };
+    copy({0, 0, w, h}, {x + PADDING, y + PADDING, w, h});
+
+    // 边缘像素向外复制一圈
+    copy({0, 0, w, 1}, {x + PADDING, y, w, 1});
+    copy({0, h - 1, w, 1}, {x + PADDING, y + PADDING + h, w, 1});
+    copy({0, 0, 1, h}, {x, y + PADDING, 1, h});
+    copy({w - 1, 0, 1, h}, {x + PADDING + w, y + PADDING, 1, h});
+}
+
+void TextureAtlas::upload(Page& page, const SDL_Rect& area) {
+    const auto* pixels = static_cast<const Uint8*>(page.pixels->pixels) +
+                         area.y * page.pixels->pitch + area.x * page.pixels->format->BytesPerPixel;
+    if (SDL_UpdateTexture(page.texture, &area, pixels, page.pixels->pitch) != 0) {
+        DEARTS_LOG_ERROR("纹理图集: 上传图集页失败: " + std::string(SDL_GetError()));
+    }
+}
+
+size_t TextureAtlas::releaseUnused() {
+    // 只剩图集自己持有 slot 时说明对应的纹理资源已经释放
+    const auto unused = std::remove_if(entries_.begin(), entries_.end(), [](Entry& entry) {
+        if (entry.slot.use_count() > 1) {
+            return false;
+        }
+        SDL_FreeSurface(entry.surface);
+        entry.surface = nullptr;
+        return true;
+    });
+    const size_t released = static_cast<size_t>(std::distance(unused, entries_.end()));
+    entries_.erase(unused, entries_.end());
+    return released;
+}
+
+} // namespace Resource
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,117 @@
+/**
+ * @file texture_atlas.h
+ * @brief 运行时纹理图集
+ * @details 把图标等小图打包进少数几张共享的图集页，同一页上的图片绘制时不需要切换纹理，
+ *          可以合并成一次提交。每张图片对应一个 AtlasSlot，记录所在页和子矩形；
+ *          重新打包时只更新 slot 的内容，持有 slot 的 TextureResource 不需要重新获取。
+ *          - 图片四周留 1 像素边距并复制边缘像素，避免线性过滤时采样到相邻图片；
+ *          - 所有页都放不下时，先回收已不再被引用的图片并重新打包，仍放不下再新建一页；
+ *          - 图集保留每张图片的 CPU 副本，重新打包时据此重建页面。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "skyline_packer.h"
+#include <SDL.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Resource {
+
+/**
+ * @brief 图集中一张图片的位置
+ * @details 由图集更新；page 为 nullptr 表示图集已被清空
+ */
+struct AtlasSlot {
+    SDL_Texture* page = nullptr;    ///< 所在图集页
+    SDL_Rect rect = {0, 0, 0, 0};   ///< 在页中的子矩形（不含边距）
+    int page_width = 0;             ///< 页宽度（计算纹理坐标用）
+    int page_height = 0;            ///< 页高度
+};
+
+/**
+ * @brief 运行时纹理图集
+ * @details 非线程安全，与所属的 SDL 渲染器在同一线程使用
+ */
+class TextureAtlas {
+public:
+    static constexpr int MAX_IMAGE_SIZE = 128;  ///< 进入图集的图片最大边长
+    static constexpr int PAGE_SIZE = 1024;      ///< 图集页边长（受渲染器最大纹理尺寸限制）
+    static constexpr int PADDING = 1;           ///< 图片四周的边距
+    static constexpr size_t MAX_PAGES = 8;      ///< 最多的图集页数
+
+    /**
+     * @brief 构造函数
+     * @param renderer 创建图集页所用的 SDL 渲染器
+     */
+    explicit TextureAtlas(SDL_Renderer* renderer);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /**
+     * @brief 图片是否适合放进图集（尺寸不超过 MAX_IMAGE_SIZE）
+     */
+    bool accepts(const SDL_Surface* surface) const;
+
+    /**
+     * @brief 把图片放进图集
+     * @param key 图片标识（通常是文件路径），相同标识且仍被引用时直接返回已有位置
+     * @param surface 图片，图集会复制一份，调用方仍负责释放
+     * @return 图片位置；放不下或创建页面失败时返回 nullptr，调用方应改用独立纹理
+     */
+    std::shared_ptr<AtlasSlot> add(const std::string& key, SDL_Surface* surface);
+
+    /**
+     * @brief 回收不再被引用的图片并重新打包全部页面
+     */
+    void repack();
+
+    /**
+     * @brief 释放全部页面，已发出的 slot 的 page 置为 nullptr
+     */
+    void clear();
+
+    size_t getPageCount() const { return pages_.size(); }
+    size_t getImageCount() const { return entries_.size(); }
+
+    /**
+     * @brief 全部页面的平均占用率
+     */
+    float getOccupancy() const;
+
+private:
+    struct Page {
+        SDL_Texture* texture = nullptr;
+        SDL_Surface* pixels = nullptr;      ///< CPU 侧的页面内容
+        SkylinePacker packer;
+    };
+
+    struct Entry {
+        std::string key;
+        SDL_Surface* surface = nullptr;     ///< 图片副本（RGBA32）
+        std::shared_ptr<AtlasSlot> slot;
+    };
+
+    bool place(Entry& entry, bool upload_now);
+    bool createPage();
+    void destroyPage(Page& page);
+    void blit(Page& page, const Entry& entry, int x, int y);
+    void upload(Page& page, const SDL_Rect& area);
+    size_t releaseUnused();
+
+    SDL_Renderer* renderer_;
+    int page_size_;
+    std::vector<Page> pages_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace Resource
+} // namespace Core
+} // namespace DearTs
@@ -253,7 +253,7 @@ void FileWatcher::stop() {
     }
     
     std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& [path, entry] : watches_) {
+    for ([[maybe_unused]] auto& [path, entry] : watches_) {
 #ifdef _WIN32
         if (entry.platform_handle) {
             CloseHandle(static_cast<HANDLE>(entry.platform_handle));
@@ -293,7 +293,7 @@ void FileWatcher::watchThread() {
         
         // Check for changes (simplified implementation)
         std::lock_guard<std::mutex> lock(mutex_);
-        for (const auto& [path, entry] : watches_) {
+        for ([[maybe_unused]] const auto& [path, entry] : watches_) {
             // This is a placeholder - real implementation would detect actual changes
             // handleFileEvent(path, FileWatchEvent::MODIFIED);
         }
@@ -553,6 +553,7 @@ FileLock::~FileLock() {
  * @return 是否成功
  */
 bool FileLock::lock(int timeout_ms) {
+    (void)timeout_ms;  // 目前只尝试一次，不等待
     if (locked_) {
         return true;
     }
@@ -612,6 +613,7 @@ bool FileLock::tryLock() {
  * @return 是否成功
  */
 bool FileLock::lockShared(int timeout_ms) {
+    (void)timeout_ms;  // 目前只尝试一次，不等待
     if (locked_) {
         return shared_lock_;
     }
@@ -1198,6 +1200,8 @@ std::string FileUtils::changeExtension(const std::string& path, const std::strin
  * @return 哈希值(十六进制字符串)
  */
 std::string FileUtils::calculateFileHash(const std::string& path, const std::string& algorithm) {
+    (void)path;
+    (void)algorithm;
     // This is a placeholder implementation
     // In a real implementation, you would use a proper hash library like OpenSSL
     // FileUtils: Hash calculation not implemented - removed logging
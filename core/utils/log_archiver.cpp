@@ -0,0 +1,402 @@
+/**
+ * DearTs Log Archiver Implementation
+ *
+ * 日志归档器实现 - 轮转文件的后台 gzip 压缩与保留清理
+ *
+ * @author DearTs Team
+ * @version 1.0.0
+ * @date 2025
+ */
+
+#include "log_archiver.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace DearTs {
+namespace Utils {
+
+namespace {
+
+// ============================================================================
+// gzip / deflate（固定哈夫曼编码 + LZ77），无第三方依赖
+// ============================================================================
+
+constexpr size_t SEGMENT_SIZE = 256 * 1024;   // 每个 deflate 块处理的输入长度
+constexpr size_t WINDOW_SIZE = 32768;         // deflate 最大回溯距离
+constexpr size_t HASH_BITS = 15;
+constexpr size_t MIN_MATCH = 3;
+constexpr size_t MAX_MATCH = 258;
+constexpr int MAX_CHAIN = 32;                 // 哈希链最大搜索深度
+
+constexpr std::array<uint16_t, 29> LENGTH_BASE = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<uint8_t, 29> LENGTH_EXTRA = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<uint16_t, 30> DIST_BASE = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<uint8_t, 30> DIST_EXTRA = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+            }
+            result[i] = value;
+        }
+        return result;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief LSB 优先的位输出流
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::ofstream& out) : out_(out) {}
+
+    void writeBits(uint32_t value, int count) {
+        buffer_ |= static_cast<uint64_t>(value) << bitCount_;
+        bitCount_ += count;
+        while (bitCount_ >= 8) {
+            bytes_.push_back(static_cast<uint8_t>(buffer_));
+            buffer_ >>= 8;
+            bitCount_ -= 8;
+        }
+        if (bytes_.size() >= 64 * 1024) {
+            drain();
+        }
+    }
+
+    /**
+     * @brief 写入哈夫曼码（码字按 MSB 优先存放，需要反转）
+     */
+    void writeCode(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        writeBits(reversed, length);
+    }
+
+    void finish() {
+        if (bitCount_ > 0) {
+            bytes_.push_back(static_cast<uint8_t>(buffer_));
+            buffer_ = 0;
+            bitCount_ = 0;
+        }
+        drain();
+    }
+
+private:
+    void drain() {
+        out_.write(reinterpret_cast<const char*>(bytes_.data()), static_cast<std::streamsize>(bytes_.size()));
+        bytes_.clear();
+    }
+
+    std::ofstream& out_;
+    std::vector<uint8_t> bytes_;
+    uint64_t buffer_ = 0;
+    int bitCount_ = 0;
+};
+
+void writeLiteral(BitWriter& writer, uint32_t symbol) {
+    if (symbol < 144) {
+        writer.writeCode(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        writer.writeCode(0x190 + (symbol - 144), 9);
+    } else if (symbol < 280) {
+        writer.writeCode(symbol - 256, 7);
+    } else {
+        writer.writeCode(0xC0 + (symbol - 280), 8);
+    }
+}
+
+void writeMatch(BitWriter& writer, size_t length, size_t distance) {
+    size_t lengthIndex = LENGTH_BASE.size() - 1;
+    while (LENGTH_BASE[lengthIndex] > length) {
+        --lengthIndex;
+    }
+    writeLiteral(writer, static_cast<uint32_t>(257 + lengthIndex));
+    writer.writeBits(static_cast<uint32_t>(length - LENGTH_BASE[lengthIndex]), LENGTH_EXTRA[lengthIndex]);
+
+    size_t distIndex = DIST_BASE.size() - 1;
+    while (DIST_BASE[distIndex] > distance) {
+        --distIndex;
+    }
+    writer.writeCode(static_cast<uint32_t>(distIndex), 5);
+    writer.writeBits(static_cast<uint32_t>(distance - DIST_BASE[distIndex]), DIST_EXTRA[distIndex]);
+}
+
+/**
+ * @brief 把一段输入编码为一个固定哈夫曼块
+ */
+void deflateSegment(BitWriter& writer, const uint8_t* data, size_t size, bool final,
+                    std::vector<int32_t>& head, std::vector<int32_t>& prev) {
+    writer.writeBits(final ? 1 : 0, 1);
+    writer.writeBits(1, 2);  // BTYPE = 01，固定哈夫曼编码
+
+    std::fill(head.begin(), head.end(), -1);
+    auto hashAt = [data](size_t pos) {
+        const uint32_t value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16);
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    };
+    auto insert = [&](size_t pos) {
+        if (pos + MIN_MATCH <= size) {
+            const uint32_t hash = hashAt(pos);
+            prev[pos] = head[hash];
+            head[hash] = static_cast<int32_t>(pos);
+        }
+    };
+
+    size_t pos = 0;
+    while (pos < size) {
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+        if (pos + MIN_MATCH <= size) {
+            const size_t maxLength = std::min(MAX_MATCH, size - pos);
+            int32_t candidate = head[hashAt(pos)];
+            for (int chain = 0; candidate >= 0 && chain < MAX_CHAIN; ++chain) {
+                const size_t distance = pos - static_cast<size_t>(candidate);
+                if (distance > WINDOW_SIZE) {
+                    break;
+                }
+                size_t length = 0;
+                while (length < maxLength && data[candidate + length] == data[pos + length]) {
+                    ++length;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = distance;
+                    if (length == maxLength) {
+                        break;
+                    }
+                }
+                candidate = prev[candidate];
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            writeMatch(writer, bestLength, bestDistance);
+            for (size_t i = 0; i < bestLength; ++i) {
+                insert(pos + i);
+            }
+            pos += bestLength;
+        } else {
+            writeLiteral(writer, data[pos]);
+            insert(pos);
+            ++pos;
+        }
+    }
+
+    writeLiteral(writer, 256);  // 块结束
+}
+
+void writeLittleEndian32(std::ofstream& out, uint32_t value) {
+    const char bytes[4] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                           static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)};
+    out.write(bytes, sizeof(bytes));
+}
+
+void lowerCurrentThreadPriority() {
+#ifdef _WIN32
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+    // Linux 上 nice 值按线程生效
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
+/**
+ * @brief 判断文件是否为 activeFile 轮转出的文件（name.<时间戳>.ext 或 name.<时间戳>.ext.gz）
+ */
+bool isRotatedSibling(const std::filesystem::path& candidate, const std::filesystem::path& activeFile) {
+    const std::string name = candidate.filename().string();
+    const std::string prefix = activeFile.stem().string() + ".";
+    const std::string extension = activeFile.extension().string();
+    if (name == activeFile.filename().string() || name.rfind(prefix, 0) != 0) {
+        return false;
+    }
+    auto endsWith = [&name](const std::string& suffix) {
+        return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    return endsWith(extension) || endsWith(extension + ".gz") || endsWith(extension + ".gz.tmp");
+}
+
+} // namespace
+
+// ============================================================================
+// LogArchiver
+// ============================================================================
+
+LogArchiver::~LogArchiver() {
+    stop();
+}
+
+void LogArchiver::submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+        if (!worker_.joinable()) {
+            stopping_ = false;
+            worker_ = std::thread(&LogArchiver::workerThread, this);
+        }
+    }
+    cv_.notify_one();
+}
+
+void LogArchiver::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!worker_.joinable()) {
+            return;
+        }
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();
+}
+
+void LogArchiver::workerThread() {
+    lowerCurrentThreadPriority();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+            break;
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+
+        lock.unlock();
+        process(job);
+        lock.lock();
+    }
+}
+
+void LogArchiver::process(const Job& job) {
+    std::error_code ec;
+    if (job.compress) {
+        std::filesystem::path destination = job.rotatedFile;
+        destination += ".gz";
+        std::filesystem::path temporary = destination;
+        temporary += ".tmp";
+
+        if (compressFile(job.rotatedFile, temporary)) {
+            std::filesystem::rename(temporary, destination, ec);
+            if (!ec) {
+                std::filesystem::remove(job.rotatedFile, ec);
+            }
+        } else {
+            std::filesystem::remove(temporary, ec);
+        }
+    }
+    applyRetention(job.activeFile, job.maxFiles);
+}
+
+bool LogArchiver::compressFile(const std::filesystem::path& source, const std::filesystem::path& destination) {
+    std::ifstream input(source, std::ios::binary);
+    std::ofstream output(destination, std::ios::binary | std::ios::trunc);
+    if (!input.is_open() || !output.is_open()) {
+        return false;
+    }
+
+    // gzip 文件头：ID1 ID2 CM=deflate FLG=0 MTIME=0 XFL=0 OS=unknown
+    const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff'};
+    output.write(header, sizeof(header));
+
+    BitWriter writer(output);
+    std::vector<uint8_t> current(SEGMENT_SIZE);
+    std::vector<uint8_t> next(SEGMENT_SIZE);
+    std::vector<int32_t> head(size_t{1} << HASH_BITS);
+    std::vector<int32_t> prev(SEGMENT_SIZE);
+    uint32_t crc = 0;
+    uint64_t totalSize = 0;
+
+    auto readSegment = [&input](std::vector<uint8_t>& buffer) {
+        input.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return static_cast<size_t>(input.gcount());
+    };
+
+    // 预读下一段以确定当前段是否为最后一个块
+    size_t currentSize = readSegment(current);
+    while (true) {
+        const size_t nextSize = currentSize == SEGMENT_SIZE ? readSegment(next) : 0;
+        const bool final = nextSize == 0;
+
+        crc = crc32Update(crc, current.data(), currentSize);
+        totalSize += currentSize;
+        deflateSegment(writer, current.data(), currentSize, final, head, prev);
+
+        if (final) {
+            break;
+        }
+        current.swap(next);
+        currentSize = nextSize;
+    }
+
+    writer.finish();
+    writeLittleEndian32(output, crc);
+    writeLittleEndian32(output, static_cast<uint32_t>(totalSize));
+    output.flush();
+    return !input.bad() && output.good();
+}
+
+void LogArchiver::applyRetention(const std::filesystem::path& activeFile, int maxFiles) {
+    if (maxFiles <= 0) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::path directory = activeFile.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> rotated;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && isRotatedSibling(entry.path(), activeFile)) {
+            rotated.emplace_back(entry.last_write_time(ec), entry.path());
+        }
+    }
+    if (rotated.size() <= static_cast<size_t>(maxFiles)) {
+        return;
+    }
+
+    // 保留最新的 maxFiles 个
+    std::sort(rotated.begin(), rotated.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    for (size_t i = static_cast<size_t>(maxFiles); i < rotated.size(); ++i) {
+        std::filesystem::remove(rotated[i].second, ec);
+    }
+}
+
+} // namespace Utils
+} // namespace DearTs
@@ -0,0 +1,81 @@
+/**
+ * @file log_archiver.h
+ * @brief 轮转后日志文件的后台压缩与保留清理
+ * @details 日志写入线程完成文件切换后把旧文件交给归档线程，
+ *          归档线程以低优先级把文件压缩为 .gz 并删除超出保留数量的旧文件，
+ *          全程不占用日志写入线程和业务线程
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace DearTs {
+    namespace Utils {
+
+        /**
+         * @brief 日志归档器
+         */
+        class LogArchiver {
+        public:
+            /**
+             * @brief 归档任务
+             */
+            struct Job {
+                std::filesystem::path rotatedFile;  ///< 已轮转的日志文件
+                std::filesystem::path activeFile;   ///< 当前正在写入的日志文件（用于匹配同组文件）
+                bool compress = false;              ///< 是否压缩为 .gz
+                int maxFiles = 0;                   ///< 保留的轮转文件数量，0 表示不限制
+            };
+
+            LogArchiver() = default;
+            ~LogArchiver();
+            LogArchiver(const LogArchiver&) = delete;
+            LogArchiver& operator=(const LogArchiver&) = delete;
+
+            /**
+             * @brief 提交归档任务（不阻塞，首次调用时启动归档线程）
+             * @param job 归档任务
+             */
+            void submit(Job job);
+
+            /**
+             * @brief 处理完所有已提交的任务后停止归档线程
+             */
+            void stop();
+
+            /**
+             * @brief 将文件压缩为 gzip 格式（deflate 固定哈夫曼编码）
+             * @param source 源文件
+             * @param destination 目标文件
+             * @return 是否成功
+             */
+            static bool compressFile(const std::filesystem::path& source, const std::filesystem::path& destination);
+
+            /**
+             * @brief 删除超出保留数量的轮转文件（按修改时间保留最新的 maxFiles 个）
+             * @param activeFile 当前正在写入的日志文件
+             * @param maxFiles 保留数量，0 表示不限制
+             */
+            static void applyRetention(const std::filesystem::path& activeFile, int maxFiles);
+
+        private:
+            void workerThread();
+            void process(const Job& job);
+
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::deque<Job> jobs_;
+            std::thread worker_;
+            bool stopping_ = false;
+        };
+
+    } // namespace Utils
+} // namespace DearTs
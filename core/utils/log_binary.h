@@ -0,0 +1,286 @@
+/**
+ * @file log_binary.h
+ * @brief 紧凑的二进制日志文件格式（编码与解码）
+ * @details 文件由若干条目组成，每个条目以 1 字节标签开头：
+ *          - HEADER：魔数、版本以及单调时钟/系统时钟锚点，每次打开文件时写入，
+ *            解码器遇到新的 HEADER 时重置字符串表（因此多次会话追加到同一文件也能解码）
+ *          - STRING：定义被引用的字符串（源文件名、格式字符串），varint 编号 + 长度 + 字节
+ *          - RECORD：varint 时间差（zigzag）、级别、文件编号、行号、格式编号、参数长度和参数；
+ *            参数使用 log_record.h 中的编码，格式编号为 0 表示参数是一条完整的消息文本
+ *          日志器写入时不做任何字符串格式化，格式化留给解码工具。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "log_record.h"
+
+namespace DearTs {
+    namespace Utils {
+        namespace LogBinary {
+
+            inline constexpr char MAGIC[4] = {'D', 'T', 'L', 'B'};
+            inline constexpr uint16_t VERSION = 1;
+
+            /**
+             * @brief 条目标签
+             */
+            enum class Tag : uint8_t {
+                HEADER = 0xB0,
+                STRING = 0xB1,
+                RECORD = 0xB2
+            };
+
+            /**
+             * @brief 二进制日志编码器
+             * @details 按指针驻留源文件名和格式字符串（二者都具有静态存储期），
+             *          每个字符串在一个文件中只写入一次
+             */
+            class Encoder {
+            public:
+                /**
+                 * @brief 开始一个新文件（或新会话）：清空字符串表并写入文件头
+                 * @param out 输出缓冲
+                 * @param steadyAnchorNs 单调时钟锚点（纳秒）
+                 * @param systemAnchorNs 与锚点对应的系统时间（纳秒，Unix 纪元）
+                 */
+                void begin(std::string& out, int64_t steadyAnchorNs, int64_t systemAnchorNs) {
+                    ids_.clear();
+                    nextId_ = 1;
+                    lastTimestamp_ = steadyAnchorNs;
+
+                    out += static_cast<char>(Tag::HEADER);
+                    out.append(MAGIC, sizeof(MAGIC));
+                    appendFixed(out, VERSION);
+                    appendFixed(out, steadyAnchorNs);
+                    appendFixed(out, systemAnchorNs);
+                }
+
+                /**
+                 * @brief 编码一条延迟格式化的记录（参数已按 log_record.h 编码）
+                 */
+                void appendRecord(std::string& out, int64_t timestamp, uint8_t level, const char* file, int line,
+                                  const char* format, const uint8_t* args, size_t argsSize) {
+                    const uint64_t fileId = intern(out, file);
+                    const uint64_t formatId = format ? intern(out, format) : 0;
+                    appendRecordHeader(out, timestamp, level, fileId, line, formatId);
+                    appendVarint(out, argsSize);
+                    out.append(reinterpret_cast<const char*>(args), argsSize);
+                }
+
+                /**
+                 * @brief 编码一条已构造好的消息
+                 */
+                void appendText(std::string& out, int64_t timestamp, uint8_t level, const char* file, int line,
+                                std::string_view text) {
+                    const uint64_t fileId = intern(out, file);
+                    appendRecordHeader(out, timestamp, level, fileId, line, 0);
+                    appendVarint(out, LogRecord::argSize(text));
+                    const size_t start = out.size();
+                    out.resize(start + LogRecord::argSize(text));
+                    LogRecord::writeArg(reinterpret_cast<uint8_t*>(out.data() + start), text);
+                }
+
+            private:
+                template<typename T>
+                static void appendFixed(std::string& out, T value) {
+                    char bytes[sizeof(T)];
+                    std::memcpy(bytes, &value, sizeof(T));
+                    out.append(bytes, sizeof(T));
+                }
+
+                static void appendVarint(std::string& out, uint64_t value) {
+                    uint8_t bytes[10];
+                    const uint8_t* end = LogRecord::writeVarint(bytes, value);
+                    out.append(reinterpret_cast<const char*>(bytes), static_cast<size_t>(end - bytes));
+                }
+
+                void appendRecordHeader(std::string& out, int64_t timestamp, uint8_t level, uint64_t fileId,
+                                        int line, uint64_t formatId) {
+                    out += static_cast<char>(Tag::RECORD);
+                    appendVarint(out, LogRecord::zigzagEncode(timestamp - lastTimestamp_));
+                    lastTimestamp_ = timestamp;
+                    out += static_cast<char>(level);
+                    appendVarint(out, fileId);
+                    appendVarint(out, static_cast<uint32_t>(line));
+                    appendVarint(out, formatId);
+                }
+
+                uint64_t intern(std::string& out, const char* text) {
+                    if (!text) {
+                        text = "";
+                    }
+                    auto [it, inserted] = ids_.try_emplace(text, nextId_);
+                    if (inserted) {
+                        ++nextId_;
+                        const size_t length = std::strlen(text);
+                        out += static_cast<char>(Tag::STRING);
+                        appendVarint(out, it->second);
+                        appendVarint(out, length);
+                        out.append(text, length);
+                    }
+                    return it->second;
+                }
+
+                std::unordered_map<const char*, uint64_t> ids_;
+                uint64_t nextId_ = 1;
+                int64_t lastTimestamp_ = 0;
+            };
+
+            /**
+             * @brief 解码后的一条记录
+             */
+            struct Entry {
+                int64_t steadyNs = 0;       ///< 单调时间戳（纳秒）
+                int64_t systemNs = 0;       ///< 换算后的系统时间（纳秒，Unix 纪元）
+                uint8_t level = 0;          ///< 日志级别
+                std::string_view file;      ///< 源文件名
+                int line = 0;               ///< 行号
+                std::string message;        ///< 格式化后的消息
+            };
+
+            /**
+             * @brief 二进制日志解码器
+             */
+            class Decoder {
+            public:
+                /**
+                 * @brief 构造函数
+                 * @param data 文件内容（需在解码期间保持有效）
+                 * @param size 字节数
+                 */
+                Decoder(const uint8_t* data, size_t size) : cursor_(data), end_(data + size) {}
+
+                /**
+                 * @brief 读取下一条记录
+                 * @param entry 输出
+                 * @return 读取成功返回 true；到达末尾或数据损坏时返回 false（见 isCorrupted()）
+                 */
+                bool next(Entry& entry) {
+                    while (cursor_ < end_) {
+                        const auto tag = static_cast<Tag>(*cursor_++);
+                        switch (tag) {
+                            case Tag::HEADER:
+                                if (!readHeader()) return fail();
+                                break;
+                            case Tag::STRING:
+                                if (!readString()) return fail();
+                                break;
+                            case Tag::RECORD:
+                                return readRecord(entry) || fail();
+                            default:
+                                return fail();
+                        }
+                    }
+                    return false;
+                }
+
+                /**
+                 * @brief 是否因数据损坏或截断而停止
+                 */
+                bool isCorrupted() const noexcept { return corrupted_; }
+
+            private:
+                bool fail() noexcept {
+                    corrupted_ = true;
+                    cursor_ = end_;
+                    return false;
+                }
+
+                template<typename T>
+                bool readFixed(T& value) noexcept {
+                    if (end_ - cursor_ < static_cast<std::ptrdiff_t>(sizeof(T))) {
+                        return false;
+                    }
+                    std::memcpy(&value, cursor_, sizeof(T));
+                    cursor_ += sizeof(T);
+                    return true;
+                }
+
+                bool readHeader() {
+                    char magic[sizeof(MAGIC)];
+                    uint16_t version = 0;
+                    if (!readFixed(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+                        !readFixed(version) || version != VERSION ||
+                        !readFixed(steadyAnchorNs_) || !readFixed(systemAnchorNs_)) {
+                        return false;
+                    }
+                    strings_.clear();
+                    lastTimestamp_ = steadyAnchorNs_;
+                    hasHeader_ = true;
+                    return true;
+                }
+
+                bool readString() {
+                    uint64_t id = 0;
+                    uint64_t length = 0;
+                    if (!LogRecord::readVarint(cursor_, end_, id) || !LogRecord::readVarint(cursor_, end_, length) ||
+                        length > static_cast<uint64_t>(end_ - cursor_) || id > strings_.size() + 1) {
+                        // 编号按顺序分配，跳跃的编号视为数据损坏
+                        return false;
+                    }
+                    if (strings_.size() <= id) {
+                        strings_.resize(static_cast<size_t>(id) + 1);
+                    }
+                    strings_[static_cast<size_t>(id)] =
+                        std::string_view(reinterpret_cast<const char*>(cursor_), static_cast<size_t>(length));
+                    cursor_ += length;
+                    return true;
+                }
+
+                bool lookup(uint64_t id, std::string_view& text) const noexcept {
+                    if (id >= strings_.size()) {
+                        return false;
+                    }
+                    text = strings_[static_cast<size_t>(id)];
+                    return true;
+                }
+
+                bool readRecord(Entry& entry) {
+                    uint64_t delta = 0, fileId = 0, line = 0, formatId = 0, argsSize = 0;
+                    if (!hasHeader_ || !LogRecord::readVarint(cursor_, end_, delta) || cursor_ >= end_) {
+                        return false;
+                    }
+                    entry.level = *cursor_++;
+                    if (!LogRecord::readVarint(cursor_, end_, fileId) || !LogRecord::readVarint(cursor_, end_, line) ||
+                        !LogRecord::readVarint(cursor_, end_, formatId) || !LogRecord::readVarint(cursor_, end_, argsSize) ||
+                        argsSize > static_cast<uint64_t>(end_ - cursor_) || !lookup(fileId, entry.file)) {
+                        return false;
+                    }
+
+                    std::string_view format("{}");
+                    if (formatId != 0 && !lookup(formatId, format)) {
+                        return false;
+                    }
+
+                    lastTimestamp_ += LogRecord::zigzagDecode(delta);
+                    entry.steadyNs = lastTimestamp_;
+                    entry.systemNs = systemAnchorNs_ + (lastTimestamp_ - steadyAnchorNs_);
+                    entry.line = static_cast<int>(line);
+                    entry.message.clear();
+                    LogRecord::formatArgs(entry.message, format, cursor_, static_cast<size_t>(argsSize));
+                    cursor_ += argsSize;
+                    return true;
+                }
+
+                const uint8_t* cursor_;
+                const uint8_t* end_;
+                std::vector<std::string_view> strings_;
+                int64_t steadyAnchorNs_ = 0;
+                int64_t systemAnchorNs_ = 0;
+                int64_t lastTimestamp_ = 0;
+                bool hasHeader_ = false;
+                bool corrupted_ = false;
+            };
+
+        } // namespace LogBinary
+    } // namespace Utils
+} // namespace DearTs
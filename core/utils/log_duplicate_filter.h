@@ -0,0 +1,168 @@
+/**
+ * @file log_duplicate_filter.h
+ * @brief 固定大小的重复日志抑制表
+ * @details 以（调用点, 消息哈希）为键，在时间窗口内抑制重复日志并计数，
+ *          窗口结束时给出“已抑制 N 条重复日志”的汇总。内存占用固定，检查过程不分配内存。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace DearTs {
+    namespace Utils {
+
+        /**
+         * @brief 重复日志抑制表
+         * @details 表分为若干分片，每个分片一把锁和固定数量的槽位（开放寻址，限长探测）。
+         *          check() 只尝试加锁，分片被占用时不阻塞，直接把消息当作非重复输出。
+         *          每个槽位记录一个窗口：窗口内首次出现的消息正常输出，之后的重复只计数；
+         *          窗口结束后再次出现、槽位被回收或被 collectExpired() 扫描到时输出汇总。
+         *          探测范围内没有空闲或过期槽位时淘汰窗口最早开始的槽位。
+         */
+        class LogDuplicateFilter {
+        public:
+            static constexpr size_t SHARD_COUNT = 16;
+            static constexpr size_t SLOTS_PER_SHARD = 64;
+            static constexpr size_t MAX_PROBE = 8;
+
+            /**
+             * @brief 被抑制消息的汇总
+             */
+            struct Summary {
+                const char* file = nullptr;  ///< 原始调用点文件
+                int line = 0;                ///< 原始调用点行号
+                int level = 0;               ///< 原始日志级别
+                uint32_t count = 0;          ///< 被抑制的条数，0 表示无汇总
+            };
+
+            /**
+             * @brief 单次检查的结果
+             */
+            struct Decision {
+                bool suppress = false;  ///< 当前消息是否应被抑制
+                Summary summary;        ///< 需要先于当前消息输出的汇总（count 为 0 时无）
+            };
+
+            /**
+             * @brief 检查一条消息
+             * @param file 调用点文件（静态存储期）
+             * @param line 调用点行号
+             * @param level 日志级别
+             * @param messageHash 消息内容哈希
+             * @param nowMs 当前单调时间（毫秒）
+             * @param windowMs 时间窗口（毫秒），不大于 0 时不做抑制
+             * @return 检查结果
+             */
+            Decision check(const char* file, int line, int level, uint64_t messageHash,
+                           int64_t nowMs, int64_t windowMs) noexcept {
+                Decision decision;
+                if (windowMs <= 0) {
+                    return decision;
+                }
+
+                const uint64_t key = makeKey(file, line, messageHash);
+                Shard& shard = shards_[(key >> 56) % SHARD_COUNT];
+                const size_t start = static_cast<size_t>(key) % SLOTS_PER_SHARD;
+
+                // 日志调用点不等锁：分片正被其他线程使用时按非重复放行，最多少抑制几条重复
+                std::unique_lock<std::mutex> lock(shard.mutex, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    return decision;
+                }
+
+                Slot* reusable = nullptr;
+                Slot* oldest = nullptr;
+                for (size_t i = 0; i < MAX_PROBE; ++i) {
+                    Slot& slot = shard.slots[(start + i) % SLOTS_PER_SHARD];
+                    if (slot.key == key) {
+                        if (nowMs - slot.windowStart < windowMs) {
+                            ++slot.suppressed;
+                            decision.suppress = true;
+                            return decision;
+                        }
+                        // 窗口已结束：汇总上个窗口并开始新窗口
+                        decision.summary = takeSummary(slot);
+                        slot.windowStart = nowMs;
+                        return decision;
+                    }
+                    const bool free = slot.key == 0 || nowMs - slot.windowStart >= windowMs;
+                    if (free && !reusable) {
+                        reusable = &slot;
+                    }
+                    if (!oldest || slot.windowStart < oldest->windowStart) {
+                        oldest = &slot;
+                    }
+                }
+
+                Slot& target = reusable ? *reusable : *oldest;
+                if (target.key != 0) {
+                    decision.summary = takeSummary(target);
+                }
+                target.key = key;
+                target.file = file;
+                target.line = line;
+                target.level = level;
+                target.windowStart = nowMs;
+                target.suppressed = 0;
+                return decision;
+            }
+
+            /**
+             * @brief 收集窗口已结束且有抑制计数的汇总，并清空这些槽位
+             * @param nowMs 当前单调时间（毫秒）
+             * @param windowMs 时间窗口（毫秒）
+             * @param out 输出（追加）
+             */
+            void collectExpired(int64_t nowMs, int64_t windowMs, std::vector<Summary>& out) {
+                for (Shard& shard : shards_) {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    for (Slot& slot : shard.slots) {
+                        if (slot.key != 0 && slot.suppressed > 0 && nowMs - slot.windowStart >= windowMs) {
+                            out.push_back(takeSummary(slot));
+                            slot.key = 0;
+                        }
+                    }
+                }
+            }
+
+        private:
+            struct Slot {
+                uint64_t key = 0;            ///< 0 表示空槽位
+                const char* file = nullptr;
+                int64_t windowStart = 0;
+                int32_t line = 0;
+                int32_t level = 0;
+                uint32_t suppressed = 0;
+            };
+
+            struct Shard {
+                std::mutex mutex;
+                std::array<Slot, SLOTS_PER_SHARD> slots{};
+            };
+
+            static uint64_t makeKey(const char* file, int line, uint64_t messageHash) noexcept {
+                // __FILE__ 指针与行号唯一确定调用点
+                uint64_t key = reinterpret_cast<std::uintptr_t>(file) * 0x9E3779B97F4A7C15ull;
+                key ^= static_cast<uint64_t>(static_cast<uint32_t>(line)) + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2);
+                key ^= messageHash + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2);
+                return key | 1;
+            }
+
+            static Summary takeSummary(Slot& slot) noexcept {
+                Summary summary{slot.file, slot.line, slot.level, slot.suppressed};
+                slot.suppressed = 0;
+                return summary;
+            }
+
+            std::array<Shard, SHARD_COUNT> shards_;
+        };
+
+    } // namespace Utils
+} // namespace DearTs
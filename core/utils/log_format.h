@@ -0,0 +1,215 @@
+/**
+ * @file log_format.h
+ * @brief 日志消息的延迟格式化工具
+ * @details 提供 std::format 风格的 "{}" 占位符格式化，仅在日志级别通过检查后才执行，
+ *          不依赖 <format>（部分编译器的标准库尚未提供）
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace DearTs {
+    namespace Utils {
+        namespace LogFormat {
+
+            /**
+             * @brief 可以通过 operator<< 输出的类型
+             */
+            template<typename T>
+            concept Streamable = requires(std::ostream& os, const T& value) {
+                { os << value };
+            };
+
+            /**
+             * @brief 追加整数
+             */
+            template<std::integral T>
+            inline void appendValue(std::string& out, T value) {
+                if constexpr (std::is_same_v<T, bool>) {
+                    out += value ? "true" : "false";
+                } else if constexpr (std::is_same_v<T, char>) {
+                    out += value;
+                } else {
+                    char buffer[24];
+                    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                    out.append(buffer, result.ptr);
+                }
+            }
+
+            /**
+             * @brief 追加浮点数
+             */
+            template<std::floating_point T>
+            inline void appendValue(std::string& out, T value) {
+                char buffer[64];
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                out.append(buffer, result.ptr);
+            }
+
+            /**
+             * @brief 追加枚举（按底层整数值输出）
+             */
+            template<typename T>
+                requires std::is_enum_v<T>
+            inline void appendValue(std::string& out, T value) {
+                appendValue(out, static_cast<std::underlying_type_t<T>>(value));
+            }
+
+            inline void appendValue(std::string& out, std::string_view value) {
+                out.append(value.data(), value.size());
+            }
+
+            inline void appendValue(std::string& out, const std::string& value) {
+                out += value;
+            }
+
+            inline void appendValue(std::string& out, const char* value) {
+                out += value ? value : "(null)";
+            }
+
+            inline void appendValue(std::string& out, char* value) {
+                appendValue(out, static_cast<const char*>(value));
+            }
+
+            /**
+             * @brief 追加指针（十六进制地址）
+             */
+            template<typename T>
+            inline void appendValue(std::string& out, T* value) {
+                char buffer[2 + sizeof(std::uintptr_t) * 2];
+                buffer[0] = '0';
+                buffer[1] = 'x';
+                auto result = std::to_chars(buffer + 2, buffer + sizeof(buffer),
+                                            reinterpret_cast<std::uintptr_t>(value), 16);
+                out.append(buffer, result.ptr);
+            }
+
+            /**
+             * @brief 其他类型回退到 operator<<
+             */
+            template<typename T>
+                requires (!std::is_arithmetic_v<T> && !std::is_enum_v<T> && !std::is_pointer_v<T> &&
+                          !std::is_convertible_v<const T&, std::string_view> && Streamable<T>)
+            inline void appendValue(std::string& out, const T& value) {
+                std::ostringstream oss;
+                oss << value;
+                out += oss.str();
+            }
+
+            /**
+             * @brief 类型擦除的参数引用，用于在格式化时按位置取值
+             */
+            struct ArgRef {
+                const void* value;
+                void (*append)(std::string&, const void*);
+            };
+
+            template<typename T>
+            inline ArgRef makeArg(const T& value) {
+                return ArgRef{&value, [](std::string& out, const void* ptr) {
+                    appendValue(out, *static_cast<const T*>(ptr));
+                }};
+            }
+
+            /**
+             * @brief 字符串字面量格式字符串
+             * @details 构造函数是 consteval 的，只接受常量表达式：字符串字面量或静态存储期的字符数组。
+             *          后台线程在调用返回后才按这个指针格式化，栈上的 char buf[N] 在这里会编译失败，
+             *          需要显式转成 std::string_view 或 std::string 走立即格式化的重载
+             */
+            struct Literal {
+                template<size_t N>
+                consteval Literal(const char (&literal)[N]) : text(literal) {}
+
+                const char* text;
+            };
+
+            /**
+             * @brief 按 "{}" 占位符格式化的通用驱动
+             * @details 支持 "{{" / "}}" 转义；"{:...}" 中的格式说明会被忽略；
+             *          参数不足时保留占位符原文，多余参数被忽略（与 std::format 相同）
+             * @param appendNext 追加下一个参数的回调，签名 bool(std::string&)，没有更多参数时返回 false
+             */
+            template<typename AppendNext>
+            inline void formatWith(std::string& out, std::string_view fmt, AppendNext&& appendNext) {
+                size_t i = 0;
+                while (i < fmt.size()) {
+                    const char c = fmt[i];
+                    if (c == '{') {
+                        if (i + 1 < fmt.size() && fmt[i + 1] == '{') {
+                            out += '{';
+                            i += 2;
+                            continue;
+                        }
+                        const size_t close = fmt.find('}', i + 1);
+                        if (close == std::string_view::npos) {
+                            out.append(fmt.data() + i, fmt.size() - i);
+                            return;
+                        }
+                        if (!appendNext(out)) {
+                            out.append(fmt.data() + i, close - i + 1);
+                        }
+                        i = close + 1;
+                    } else if (c == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}') {
+                        out += '}';
+                        i += 2;
+                    } else {
+                        out += c;
+                        ++i;
+                    }
+                }
+            }
+
+            /**
+             * @brief 按 "{}" 占位符格式化类型擦除的参数列表
+             */
+            inline void formatArgs(std::string& out, std::string_view fmt, const ArgRef* args, size_t argCount) {
+                size_t nextArg = 0;
+                formatWith(out, fmt, [&](std::string& target) {
+                    if (nextArg >= argCount) {
+                        return false;
+                    }
+                    args[nextArg].append(target, args[nextArg].value);
+                    ++nextArg;
+                    return true;
+                });
+            }
+
+            /**
+             * @brief 将格式化结果追加到 out
+             */
+            template<typename... Args>
+            inline void formatTo(std::string& out, std::string_view fmt, const Args&... args) {
+                if constexpr (sizeof...(Args) == 0) {
+                    formatArgs(out, fmt, nullptr, 0);
+                } else {
+                    const std::array<ArgRef, sizeof...(Args)> refs{makeArg(args)...};
+                    formatArgs(out, fmt, refs.data(), refs.size());
+                }
+            }
+
+            /**
+             * @brief 格式化为新字符串
+             */
+            template<typename... Args>
+            inline std::string format(std::string_view fmt, const Args&... args) {
+                std::string out;
+                out.reserve(fmt.size() + sizeof...(Args) * 8);
+                formatTo(out, fmt, args...);
+                return out;
+            }
+
+        } // namespace LogFormat
+    } // namespace Utils
+} // namespace DearTs
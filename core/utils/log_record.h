@@ -0,0 +1,330 @@
+/**
+ * @file log_record.h
+ * @brief 日志二进制记录与参数编解码
+ * @details 生产者线程只把时间戳、级别、源码位置和参数按二进制写入环形缓冲区，
+ *          格式化工作由消费者线程完成。参数使用 varint 编码。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "log_format.h"
+
+namespace DearTs {
+    namespace Utils {
+
+        /**
+         * @brief 记录类型
+         */
+        enum class LogRecordKind : uint8_t {
+            TEXT = 0,   ///< 负载为已构造好的消息文本
+            FORMAT = 1  ///< 负载为编码后的参数，配合静态格式字符串在消费者端格式化
+        };
+
+        /**
+         * @brief 参数类型标签
+         */
+        enum class LogArgType : uint8_t {
+            INT = 1,     ///< 有符号整数（zigzag varint）
+            UINT = 2,    ///< 无符号整数（varint）
+            DOUBLE = 3,  ///< 浮点数（8 字节）
+            BOOL = 4,    ///< 布尔（1 字节）
+            CHAR = 5,    ///< 字符（1 字节）
+            STRING = 6,  ///< 字符串（varint 长度 + 字节）
+            POINTER = 7  ///< 指针（varint）
+        };
+
+        /**
+         * @brief 环形缓冲区中每条日志记录的头部
+         */
+        struct LogRecordHeader {
+            int64_t timestamp;    ///< steady_clock 时间戳（纳秒）
+            const char* file;     ///< 源文件名（__FILE__，静态存储期）
+            const char* format;   ///< FORMAT 记录的格式字符串（静态存储期）
+            int32_t line;         ///< 行号
+            uint8_t level;        ///< 日志级别
+            LogRecordKind kind;   ///< 记录类型
+            uint16_t argCount;    ///< 参数个数
+        };
+
+        namespace LogRecord {
+
+            // ===== varint =====
+
+            inline size_t varintSize(uint64_t value) noexcept {
+                size_t size = 1;
+                while (value >= 0x80) {
+                    value >>= 7;
+                    ++size;
+                }
+                return size;
+            }
+
+            inline uint8_t* writeVarint(uint8_t* dst, uint64_t value) noexcept {
+                while (value >= 0x80) {
+                    *dst++ = static_cast<uint8_t>(value | 0x80);
+                    value >>= 7;
+                }
+                *dst++ = static_cast<uint8_t>(value);
+                return dst;
+            }
+
+            inline bool readVarint(const uint8_t*& src, const uint8_t* end, uint64_t& value) noexcept {
+                value = 0;
+                for (int shift = 0; src < end && shift < 64; shift += 7) {
+                    const uint8_t byte = *src++;
+                    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                    if ((byte & 0x80) == 0) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            inline uint64_t zigzagEncode(int64_t value) noexcept {
+                return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+            }
+
+            inline int64_t zigzagDecode(uint64_t value) noexcept {
+                return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+            }
+
+            // ===== 参数预处理 =====
+
+            /**
+             * @brief 把参数转换为可直接编码的形式
+             * @details 基本类型和字符串原样传递；其他类型在生产者端转换为字符串
+             */
+            template<typename T>
+            inline decltype(auto) toEncodable(const T& value) {
+                using U = std::remove_cvref_t<T>;
+                if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U> || std::is_pointer_v<U> ||
+                              std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+                    return (value);
+                } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                    return std::string_view(value);
+                } else {
+                    std::string text;
+                    LogFormat::appendValue(text, value);
+                    return text;
+                }
+            }
+
+            // ===== 编码 =====
+
+            template<typename T>
+            inline std::string_view asStringView(const T& value) noexcept {
+                using U = std::decay_t<T>;
+                if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+                    return value ? std::string_view(value) : std::string_view("(null)");
+                } else {
+                    return std::string_view(value);
+                }
+            }
+
+            template<typename T>
+            inline constexpr bool isStringArg() {
+                using U = std::decay_t<T>;
+                return std::is_same_v<U, const char*> || std::is_same_v<U, char*> ||
+                       std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>;
+            }
+
+            /**
+             * @brief 单个参数编码后的字节数
+             */
+            template<typename T>
+            inline size_t argSize(const T& value) noexcept {
+                using U = std::decay_t<T>;
+                if constexpr (isStringArg<T>()) {
+                    const size_t length = asStringView(value).size();
+                    return 1 + varintSize(length) + length;
+                } else if constexpr (std::is_same_v<U, bool> || std::is_same_v<U, char>) {
+                    return 2;
+                } else if constexpr (std::is_enum_v<U>) {
+                    return argSize(static_cast<std::underlying_type_t<U>>(value));
+                } else if constexpr (std::is_floating_point_v<U>) {
+                    return 1 + sizeof(double);
+                } else if constexpr (std::is_pointer_v<U>) {
+                    return 1 + varintSize(reinterpret_cast<std::uintptr_t>(value));
+                } else if constexpr (std::is_signed_v<U>) {
+                    return 1 + varintSize(zigzagEncode(static_cast<int64_t>(value)));
+                } else {
+                    return 1 + varintSize(static_cast<uint64_t>(value));
+                }
+            }
+
+            /**
+             * @brief 编码单个参数
+             * @return 写入结束位置
+             */
+            template<typename T>
+            inline uint8_t* writeArg(uint8_t* dst, const T& value) noexcept {
+                using U = std::decay_t<T>;
+                if constexpr (isStringArg<T>()) {
+                    const std::string_view text = asStringView(value);
+                    *dst++ = static_cast<uint8_t>(LogArgType::STRING);
+                    dst = writeVarint(dst, text.size());
+                    if (!text.empty()) {
+                        std::memcpy(dst, text.data(), text.size());
+                    }
+                    return dst + text.size();
+                } else if constexpr (std::is_same_v<U, bool>) {
+                    *dst++ = static_cast<uint8_t>(LogArgType::BOOL);
+                    *dst++ = value ? 1 : 0;
+                    return dst;
+                } else if constexpr (std::is_same_v<U, char>) {
+                    *dst++ = static_cast<uint8_t>(LogArgType::CHAR);
+                    *dst++ = static_cast<uint8_t>(value);
+                    return dst;
+                } else if constexpr (std::is_enum_v<U>) {
+                    return writeArg(dst, static_cast<std::underlying_type_t<U>>(value));
+                } else if constexpr (std::is_floating_point_v<U>) {
+                    const double number = static_cast<double>(value);
+                    *dst++ = static_cast<uint8_t>(LogArgType::DOUBLE);
+                    std::memcpy(dst, &number, sizeof(number));
+                    return dst + sizeof(number);
+                } else if constexpr (std::is_pointer_v<U>) {
+                    *dst++ = static_cast<uint8_t>(LogArgType::POINTER);
+                    return writeVarint(dst, reinterpret_cast<std::uintptr_t>(value));
+                } else if constexpr (std::is_signed_v<U>) {
+                    *dst++ = static_cast<uint8_t>(LogArgType::INT);
+                    return writeVarint(dst, zigzagEncode(static_cast<int64_t>(value)));
+                } else {
+                    *dst++ = static_cast<uint8_t>(LogArgType::UINT);
+                    return writeVarint(dst, static_cast<uint64_t>(value));
+                }
+            }
+
+            /**
+             * @brief 所有参数编码后的总字节数
+             */
+            template<typename... Args>
+            inline size_t argsSize(const Args&... args) noexcept {
+                return (size_t{0} + ... + argSize(args));
+            }
+
+            /**
+             * @brief 依次编码所有参数
+             */
+            template<typename... Args>
+            inline uint8_t* writeArgs(uint8_t* dst, const Args&... args) noexcept {
+                ((dst = writeArg(dst, args)), ...);
+                return dst;
+            }
+
+            // ===== 哈希 =====
+
+            /**
+             * @brief FNV-1a 64 位哈希
+             */
+            inline uint64_t hashBytes(const void* data, size_t size,
+                                      uint64_t seed = 0xcbf29ce484222325ull) noexcept {
+                const auto* bytes = static_cast<const uint8_t*>(data);
+                uint64_t hash = seed;
+                for (size_t i = 0; i < size; ++i) {
+                    hash ^= bytes[i];
+                    hash *= 0x100000001b3ull;
+                }
+                return hash;
+            }
+
+            /**
+             * @brief 按编码后的字节计算参数哈希（无需实际写入缓冲区）
+             */
+            template<typename T>
+            inline uint64_t hashArg(uint64_t seed, const T& value) noexcept {
+                if constexpr (isStringArg<T>()) {
+                    const std::string_view text = asStringView(value);
+                    const uint64_t length = text.size();
+                    return hashBytes(text.data(), text.size(), hashBytes(&length, sizeof(length), seed));
+                } else {
+                    uint8_t buffer[16];
+                    const uint8_t* end = writeArg(buffer, value);
+                    return hashBytes(buffer, static_cast<size_t>(end - buffer), seed);
+                }
+            }
+
+            /**
+             * @brief 所有参数的哈希
+             */
+            template<typename... Args>
+            inline uint64_t hashArgs(const Args&... args) noexcept {
+                uint64_t hash = 0xcbf29ce484222325ull;
+                ((hash = hashArg(hash, args)), ...);
+                return hash;
+            }
+
+            // ===== 解码 =====
+
+            /**
+             * @brief 解码一个参数并以文本形式追加到 out
+             * @return 解码是否成功（数据耗尽或损坏时返回 false）
+             */
+            inline bool appendNextArg(std::string& out, const uint8_t*& src, const uint8_t* end) {
+                if (src >= end) {
+                    return false;
+                }
+                const auto type = static_cast<LogArgType>(*src++);
+                uint64_t raw = 0;
+                switch (type) {
+                    case LogArgType::INT:
+                        if (!readVarint(src, end, raw)) return false;
+                        LogFormat::appendValue(out, zigzagDecode(raw));
+                        return true;
+                    case LogArgType::UINT:
+                        if (!readVarint(src, end, raw)) return false;
+                        LogFormat::appendValue(out, raw);
+                        return true;
+                    case LogArgType::POINTER:
+                        if (!readVarint(src, end, raw)) return false;
+                        LogFormat::appendValue(out, reinterpret_cast<const void*>(static_cast<std::uintptr_t>(raw)));
+                        return true;
+                    case LogArgType::DOUBLE: {
+                        if (end - src < static_cast<std::ptrdiff_t>(sizeof(double))) return false;
+                        double number = 0.0;
+                        std::memcpy(&number, src, sizeof(number));
+                        src += sizeof(number);
+                        LogFormat::appendValue(out, number);
+                        return true;
+                    }
+                    case LogArgType::BOOL:
+                        if (src >= end) return false;
+                        LogFormat::appendValue(out, *src++ != 0);
+                        return true;
+                    case LogArgType::CHAR:
+                        if (src >= end) return false;
+                        out += static_cast<char>(*src++);
+                        return true;
+                    case LogArgType::STRING: {
+                        if (!readVarint(src, end, raw) || raw > static_cast<uint64_t>(end - src)) return false;
+                        out.append(reinterpret_cast<const char*>(src), static_cast<size_t>(raw));
+                        src += raw;
+                        return true;
+                    }
+                    default:
+                        src = end;
+                        return false;
+                }
+            }
+
+            /**
+             * @brief 按格式字符串和编码后的参数生成消息文本
+             */
+            inline void formatArgs(std::string& out, std::string_view fmt, const uint8_t* args, size_t size) {
+                const uint8_t* cursor = args;
+                const uint8_t* end = args + size;
+                LogFormat::formatWith(out, fmt, [&](std::string& target) {
+                    return appendNextArg(target, cursor, end);
+                });
+            }
+
+        } // namespace LogRecord
+    } // namespace Utils
+} // namespace DearTs
@@ -0,0 +1,176 @@
+/**
+ * @file log_ring_buffer.h
+ * @brief 日志后端使用的单生产者/单消费者（SPSC）无锁环形缓冲区
+ * @details 每个写日志的线程拥有一个缓冲区，写入变长的二进制记录；
+ *          唯一的消费者线程（文件写入线程）负责读取和释放
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace DearTs {
+    namespace Utils {
+
+        /**
+         * @brief SPSC 变长记录环形缓冲区
+         * @details 每条记录前有 8 字节帧头（负载长度 + 标志），整体按 8 字节对齐；
+         *          当缓冲区尾部剩余空间不足以放下连续记录时写入填充帧并回绕到开头。
+         *          head_/tail_ 是单调递增的字节位置，取模容量得到实际下标。
+         */
+        class LogRingBuffer {
+        public:
+            static constexpr size_t FRAME_HEADER_SIZE = 8;
+            static constexpr size_t ALIGNMENT = 8;
+
+            /**
+             * @brief 构造函数
+             * @param capacity 容量（字节），向上取整为 2 的幂，最小 4KB
+             */
+            explicit LogRingBuffer(size_t capacity) {
+                size_t actual = 4096;
+                while (actual < capacity) {
+                    actual <<= 1;
+                }
+                capacity_ = actual;
+                mask_ = actual - 1;
+                data_ = std::make_unique<uint8_t[]>(actual);
+            }
+
+            LogRingBuffer(const LogRingBuffer&) = delete;
+            LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+            /**
+             * @brief 获取容量
+             */
+            size_t capacity() const noexcept { return capacity_; }
+
+            /**
+             * @brief 单条记录允许的最大负载长度
+             */
+            size_t maxPayloadSize() const noexcept { return capacity_ / 2 - FRAME_HEADER_SIZE; }
+
+            // ===== 生产者接口（仅限拥有者线程调用）=====
+
+            /**
+             * @brief 预留一段连续的写入空间
+             * @param payloadSize 负载长度
+             * @return 写入位置；空间不足时返回 nullptr
+             */
+            uint8_t* reserve(size_t payloadSize) noexcept {
+                if (payloadSize > maxPayloadSize()) {
+                    return nullptr;
+                }
+
+                const size_t frameSize = alignUp(FRAME_HEADER_SIZE + payloadSize);
+                const size_t tail = tail_.load(std::memory_order_relaxed);
+                const size_t index = tail & mask_;
+                const size_t contiguous = capacity_ - index;
+                const size_t padding = (frameSize > contiguous) ? contiguous : 0;
+                const size_t required = padding + frameSize;
+
+                if (required > capacity_ - (tail - cachedHead_)) {
+                    cachedHead_ = head_.load(std::memory_order_acquire);
+                    if (required > capacity_ - (tail - cachedHead_)) {
+                        return nullptr;
+                    }
+                }
+
+                if (padding > 0) {
+                    writeFrameHeader(index, static_cast<uint32_t>(padding - FRAME_HEADER_SIZE), FLAG_PADDING);
+                }
+
+                const size_t frameIndex = (tail + padding) & mask_;
+                writeFrameHeader(frameIndex, static_cast<uint32_t>(payloadSize), 0);
+                pendingSize_ = required;
+                return data_.get() + frameIndex + FRAME_HEADER_SIZE;
+            }
+
+            /**
+             * @brief 提交最近一次 reserve 的记录，使其对消费者可见
+             */
+            void commit() noexcept {
+                tail_.store(tail_.load(std::memory_order_relaxed) + pendingSize_, std::memory_order_release);
+                pendingSize_ = 0;
+            }
+
+            /**
+             * @brief 放弃最近一次 reserve 的记录
+             */
+            void abandon() noexcept {
+                pendingSize_ = 0;
+            }
+
+            // ===== 消费者接口（仅限唯一的消费者线程调用）=====
+
+            /**
+             * @brief 遍历当前所有已提交的记录（不释放）
+             * @param fn 回调，签名 void(const uint8_t* payload, size_t size)
+             * @return 遍历结束时的位置，传给 release() 以释放这些记录
+             */
+            template<typename Fn>
+            size_t forEach(Fn&& fn) const {
+                size_t head = head_.load(std::memory_order_relaxed);
+                const size_t tail = tail_.load(std::memory_order_acquire);
+                while (head != tail) {
+                    const size_t index = head & mask_;
+                    uint32_t size = 0;
+                    uint32_t flags = 0;
+                    std::memcpy(&size, data_.get() + index, sizeof(size));
+                    std::memcpy(&flags, data_.get() + index + sizeof(size), sizeof(flags));
+                    if ((flags & FLAG_PADDING) == 0) {
+                        fn(data_.get() + index + FRAME_HEADER_SIZE, static_cast<size_t>(size));
+                    }
+                    head += alignUp(FRAME_HEADER_SIZE + size);
+                }
+                return head;
+            }
+
+            /**
+             * @brief 释放到指定位置为止的记录
+             * @param position forEach() 返回的位置
+             */
+            void release(size_t position) noexcept {
+                head_.store(position, std::memory_order_release);
+            }
+
+            /**
+             * @brief 是否没有待消费的记录
+             */
+            bool empty() const noexcept {
+                return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+            }
+
+        private:
+            static constexpr uint32_t FLAG_PADDING = 1u;
+
+            static constexpr size_t alignUp(size_t value) noexcept {
+                return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+            }
+
+            void writeFrameHeader(size_t index, uint32_t size, uint32_t flags) noexcept {
+                std::memcpy(data_.get() + index, &size, sizeof(size));
+                std::memcpy(data_.get() + index + sizeof(size), &flags, sizeof(flags));
+            }
+
+            std::unique_ptr<uint8_t[]> data_;
+            size_t capacity_ = 0;
+            size_t mask_ = 0;
+
+            // 消费者写、生产者读
+            alignas(64) std::atomic<size_t> head_{0};
+
+            // 生产者写、消费者读
+            alignas(64) std::atomic<size_t> tail_{0};
+            size_t cachedHead_ = 0;  // 生产者缓存的 head_，减少跨核读取
+            size_t pendingSize_ = 0; // 生产者尚未提交的字节数（含填充）
+        };
+
+    } // namespace Utils
+} // namespace DearTs
@@ -1,7 +1,8 @@
 /**
  * @file logger.h
  * @brief 现代C++20日志系统
- * @details 使用模板、constexpr和source_location实现高性能日志记录
+ * @details 使用模板、constexpr和source_location实现高性能日志记录；
+ *          文件后端为每线程无锁环形缓冲区 + 单个后台格式化线程
  * @author DearTs Team
  * @date 2024
  */
@@ -23,6 +24,21 @@
 #include <filesystem>
 #include <unordered_map>
 #include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+
+#include "log_archiver.h"
+#include "log_binary.h"
+#include "log_duplicate_filter.h"
+#include "log_format.h"
+#include "log_record.h"
+#include "log_ring_buffer.h"
 
 // 确保定义了 NOMINMAX 宏以避免 Windows.h 中的 min/max 宏冲突
 #ifndef NOMINMAX
@@ -34,6 +50,12 @@
 #define WIN32_LEAN_AND_MEAN
 #endif
 
+// 编译期日志级别阈值（由 CMake 的 DEARTS_LOG_COMPILE_LEVEL 设置）
+// 低于该级别的 DEARTS_LOG_* 调用在编译期被整体剔除，0 = TRACE ... 6 = 全部关闭
+#ifndef DEARTS_LOG_ACTIVE_LEVEL
+#define DEARTS_LOG_ACTIVE_LEVEL 0
+#endif
+
 namespace DearTs {
     namespace Utils {
         
@@ -49,9 +71,46 @@ namespace DearTs {
             LOG_FATAL = 5
         };
         
+        /**
+         * @brief 日志文件刷新策略
+         */
+        enum class LogFlushPolicy : int {
+            EVERY_BATCH = 0,  ///< 每处理完一批记录就刷新（默认，与旧行为一致）
+            INTERVAL = 1,     ///< 按固定时间间隔刷新
+            MANUAL = 2        ///< 仅在调用 flush()、关闭文件或输出 ERROR 以上级别时刷新
+        };
+        
+        /**
+         * @brief 线程缓冲区写满时的处理策略
+         */
+        enum class LogOverflowPolicy : int {
+            BLOCK = 0,  ///< 等待后台线程腾出空间（默认，不丢日志）
+            DROP = 1    ///< 直接丢弃并计数，由后台线程汇总报告
+        };
+        
+        /**
+         * @brief 日志文件格式
+         */
+        enum class LogFileFormat : int {
+            TEXT = 0,   ///< 可读文本（默认）
+            BINARY = 1  ///< 紧凑二进制格式，见 log_binary.h，使用 dearts_logdump 解码
+        };
+        
+        /**
+         * @brief 日志文件轮转策略
+         */
+        struct LogRotationPolicy {
+            size_t maxFileSize = 0;   ///< 单个文件的最大字节数，0 表示不按大小轮转
+            bool daily = false;       ///< 本地时间跨天时轮转
+            int maxFiles = 0;         ///< 保留的轮转文件数量，0 表示不限制
+            bool compress = false;    ///< 在后台把轮转出的文件压缩为 .gz
+        };
+        
         /**
          * @brief 现代C++20日志器类
-         * @details 线程安全的单例日志器，使用原子操作和互斥锁保证并发安全
+         * @details 线程安全的单例日志器。启用文件输出后，各线程把二进制记录写入自己的
+         *          SPSC 环形缓冲区（无锁），由唯一的后台线程合并、格式化并输出到控制台和文件；
+         *          未启用文件输出时在调用线程同步格式化并输出到控制台。
          */
         class Logger {
         public:
@@ -80,15 +139,26 @@ namespace DearTs {
                 return static_cast<LogLevel>(current_level_.load(std::memory_order_relaxed));
             }
             
+            /**
+             * @brief 检查指定级别是否会被输出（线程安全，无分配）
+             * @param level 日志级别
+             * @return 是否会被输出
+             */
+            bool shouldLog(LogLevel level) const noexcept {
+                return static_cast<int>(level) >= current_level_.load(std::memory_order_relaxed);
+            }
+            
             /**
              * @brief 启用文件输出
              * @param filename 日志文件名
              * @param enable 是否启用文件输出
              */
             void enableFileOutput(const std::string& filename, bool enable = true) {
-                std::lock_guard<std::mutex> lock(file_mutex_);
+                std::lock_guard<std::mutex> controlLock(control_mutex_);
                 
                 if (enable && !file_output_enabled_.load(std::memory_order_relaxed)) {
+                    std::lock_guard<std::mutex> lock(file_mutex_);
+                    
                     // 关闭当前文件流（如果已打开）
                     if (file_stream_.is_open()) {
                         file_stream_.close();
@@ -100,44 +170,92 @@ namespace DearTs {
                         std::filesystem::create_directories(logPath.parent_path());
                     }
                     
+                    // 上次运行留下的文件已超过大小限制或属于前一天时先轮转
+                    if (shouldRotateExisting(logPath)) {
+                        rotateExisting(logPath);
+                    }
+                    
                     // 打开新的日志文件
-                    file_stream_.open(filename, std::ios::app);
+                    active_file_format_ = static_cast<LogFileFormat>(file_format_.load(std::memory_order_relaxed));
+                    const bool binary = active_file_format_ == LogFileFormat::BINARY;
+                    file_stream_.open(filename, binary ? (std::ios::app | std::ios::binary) : std::ios::app);
                     if (file_stream_.is_open()) {
                         log_filename_ = filename;
+                        std::error_code ec;
+                        const auto existingSize = std::filesystem::file_size(logPath, ec);
+                        current_file_size_ = ec ? 0 : static_cast<uint64_t>(existingSize);
+                        next_day_boundary_ns_ = nextLocalMidnight(currentWallTime());
+                        if (binary) {
+                            // 每次打开都写入文件头，追加的多次会话可以独立解码
+                            std::string header;
+                            binary_encoder_.begin(header, steady_anchor_ns_, system_anchor_ns_);
+                            file_stream_.write(header.data(), static_cast<std::streamsize>(header.size()));
+                        }
                         file_output_enabled_.store(true, std::memory_order_relaxed);
                         
-                        // 启动文件写入线程（如果尚未运行）
+                        // 启动后台写入线程（如果尚未运行）
                         if (!writer_running_.load(std::memory_order_relaxed)) {
-                            writer_running_.store(true, std::memory_order_relaxed);
+                            writer_running_.store(true, std::memory_order_release);
                             file_writer_thread_ = std::thread(&Logger::fileWriterThread, this);
                         }
                     }
                 } else if (!enable && file_output_enabled_.load(std::memory_order_relaxed)) {
-                    // 停止文件输出
+                    // 停止文件输出，后台线程退出前会处理完所有缓冲区中的记录
                     file_output_enabled_.store(false, std::memory_order_relaxed);
+                    writer_running_.store(false, std::memory_order_release);
+                    wakeWriter(true);
                     
-                    // 通知写入线程退出
-                    {
-                        std::lock_guard<std::mutex> queueLock(queue_mutex_);
-                        queue_cv_.notify_all();
-                    }
-                    
-                    // 等待写入线程结束
                     if (file_writer_thread_.joinable()) {
-                        // 确保线程知道需要退出
-                        writer_running_.store(false, std::memory_order_relaxed);
-                        queue_cv_.notify_all(); // 再次通知以确保线程能退出等待
                         file_writer_thread_.join();
                     }
                     
-                    // 关闭文件流
-                    if (file_stream_.is_open()) {
-                        file_stream_.close();
+                    // 唤醒可能仍在等待 flush() 的线程
+                    flush_cv_.notify_all();
+                    
+                    {
+                        std::lock_guard<std::mutex> lock(file_mutex_);
+                        if (file_stream_.is_open()) {
+                            file_stream_.flush();
+                            file_stream_.close();
+                        }
+                        log_filename_.clear();
                     }
-                    log_filename_.clear();
+                    
+                    // 等待已提交的压缩和清理任务完成
+                    archiver_.stop();
                 }
             }
             
+            /**
+             * @brief 设置日志文件格式（在下一次 enableFileOutput 打开文件时生效）
+             * @param format 文件格式
+             */
+            void setFileFormat(LogFileFormat format) noexcept {
+                file_format_.store(static_cast<int>(format), std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief 设置日志文件轮转策略
+             * @details 文件切换在后台写入线程中完成，不阻塞写日志的线程；
+             *          压缩和旧文件清理在低优先级的归档线程中进行
+             * @param policy 轮转策略
+             */
+            void setRotationPolicy(const LogRotationPolicy& policy) noexcept {
+                max_file_size_.store(policy.maxFileSize, std::memory_order_relaxed);
+                rotate_daily_.store(policy.daily, std::memory_order_relaxed);
+                max_rotated_files_.store(policy.maxFiles, std::memory_order_relaxed);
+                compress_rotated_.store(policy.compress, std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief 设置启用文件输出时是否同时输出到控制台
+             * @details 关闭后，二进制文件格式下后台线程完全不做字符串格式化
+             * @param enable 是否输出到控制台
+             */
+            void setConsoleOutput(bool enable) noexcept {
+                console_output_enabled_.store(enable, std::memory_order_relaxed);
+            }
+            
             /**
              * @brief 检查是否启用了文件输出
              * @return 是否启用了文件输出
@@ -148,6 +266,7 @@ namespace DearTs {
             
             /**
              * @brief 设置缓冲区大小
+             * @details 后台线程累计的格式化文本超过该大小时写入文件一次
              * @param size 缓冲区大小（字节）
              */
             void setBufferSize(size_t size) noexcept {
@@ -162,8 +281,65 @@ namespace DearTs {
                 return buffer_size_.load(std::memory_order_relaxed);
             }
             
+            /**
+             * @brief 设置每个线程的环形缓冲区容量（对之后首次写日志的线程生效）
+             * @param bytes 容量（字节）
+             */
+            void setThreadBufferCapacity(size_t bytes) noexcept {
+                thread_buffer_capacity_.store(bytes, std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief 设置文件刷新策略
+             * @param policy 刷新策略
+             * @param interval INTERVAL 策略下的刷新间隔
+             */
+            void setFlushPolicy(LogFlushPolicy policy,
+                                std::chrono::milliseconds interval = std::chrono::milliseconds(200)) noexcept {
+                flush_interval_ms_.store(interval.count(), std::memory_order_relaxed);
+                flush_policy_.store(static_cast<int>(policy), std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief 设置线程缓冲区写满时的处理策略
+             * @param policy 处理策略
+             */
+            void setOverflowPolicy(LogOverflowPolicy policy) noexcept {
+                overflow_policy_.store(static_cast<int>(policy), std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief 获取因缓冲区写满而丢弃的记录总数
+             * @return 丢弃数量
+             */
+            uint64_t getDroppedCount() const noexcept {
+                return dropped_count_.load(std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief 等待调用线程此前写入的日志全部落盘
+             */
+            void flush() {
+                if (!writer_running_.load(std::memory_order_acquire)) {
+                    std::lock_guard<std::mutex> lock(file_mutex_);
+                    if (file_stream_.is_open()) {
+                        file_stream_.flush();
+                    }
+                    return;
+                }
+                
+                const uint64_t ticket = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+                wakeWriter(true);
+                
+                std::unique_lock<std::mutex> lock(flush_mutex_);
+                flush_cv_.wait(lock, [this, ticket] {
+                    return flush_completed_ >= ticket || !writer_running_.load(std::memory_order_acquire);
+                });
+            }
+            
             /**
              * @brief 设置重复日志过滤时间窗口（毫秒）
+             * @details 同一调用点的相同消息在窗口内只输出一次，窗口结束时输出被抑制的条数；不大于 0 时关闭过滤
              * @param windowMs 时间窗口（毫秒）
              */
             void setDuplicateFilterWindow(int windowMs) noexcept {
@@ -179,29 +355,102 @@ namespace DearTs {
              */
             void log(LogLevel level, const std::string& message, 
                     const char* file = __FILE__, int line = __LINE__) {
-                if (static_cast<int>(level) < current_level_.load(std::memory_order_relaxed)) {
+                if (!shouldLog(level)) {
                     return;
                 }
                 
-                // 检查是否为重复日志
-                if (isDuplicateMessage(message, file, line)) {
+                if (writer_running_.load(std::memory_order_acquire)) {
+                    enqueueText(level, message, file, line);
                     return;
                 }
                 
-                // 格式化日志消息
-                std::string formattedMessage = formatLogMessage(level, message, file, line);
-                
-                // 输出到控制台
-                {
-                    std::lock_guard<std::mutex> lock(output_mutex_);
-                    auto& stream = (static_cast<int>(level) >= static_cast<int>(LogLevel::LOG_ERROR)) ? std::cerr : std::cout;
-                    stream << formattedMessage << std::endl;
+                // 检查是否为重复日志
+                const int64_t timestamp = nowTimestamp();
+                const auto decision = checkDuplicate(level, file, line,
+                                                     LogRecord::hashBytes(message.data(), message.size()), timestamp);
+                if (decision.suppress) {
+                    return;
                 }
                 
-                // 输出到文件（如果启用）
-                if (file_output_enabled_.load(std::memory_order_relaxed)) {
-                    writeToFile(formattedMessage);
+                // 后台线程未运行：同步格式化并输出到控制台
+                std::lock_guard<std::mutex> lock(output_mutex_);
+                auto writeLine = [this](LogLevel lineLevel) {
+                    auto& stream = (static_cast<int>(lineLevel) >= static_cast<int>(LogLevel::LOG_ERROR)) ? std::cerr : std::cout;
+                    stream << sync_line_ << std::flush;
+                    sync_line_.clear();
+                };
+                sync_line_.clear();
+                sweepDuplicates(timestamp, false, sync_summaries_, [&](const LogDuplicateFilter::Summary& summary) {
+                    appendSummaryLine(sync_line_, sync_message_, sync_clock_, timestamp, summary);
+                    writeLine(static_cast<LogLevel>(summary.level));
+                });
+                if (decision.summary.count > 0) {
+                    appendSummaryLine(sync_line_, sync_message_, sync_clock_, timestamp, decision.summary);
+                    writeLine(static_cast<LogLevel>(decision.summary.level));
+                }
+                appendFormattedLine(sync_line_, sync_clock_, timestamp, level, file, line, message);
+                writeLine(level);
+            }
+            
+            /**
+             * @brief 写入一条已构造好的日志消息（供 DEARTS_LOG_* 宏使用）
+             * @param level 日志级别
+             * @param file 源文件名
+             * @param line 行号
+             * @param message 日志消息
+             */
+            template<typename Message>
+            void write(LogLevel level, const char* file, int line, Message&& message) {
+                if constexpr (std::is_convertible_v<Message&&, const std::string&>) {
+                    log(level, std::forward<Message>(message), file, line);
+                } else {
+                    log(level, std::string(std::forward<Message>(message)), file, line);
+                }
+            }
+            
+            /**
+             * @brief 使用 "{}" 占位符的格式字符串字面量写入日志（供 DEARTS_LOG_* 宏使用）
+             * @details 后台线程运行时只编码参数，格式化在后台线程完成；
+             *          LogFormat::Literal 保证格式字符串具有静态存储期，栈上的字符数组无法编译
+             * @param level 日志级别
+             * @param file 源文件名
+             * @param line 行号
+             * @param fmt 格式字符串字面量
+             * @param arg 第一个参数
+             * @param args 其余参数
+             */
+            template<typename Arg, typename... Args>
+            void write(LogLevel level, const char* file, int line, LogFormat::Literal fmt,
+                       const Arg& arg, const Args&... args) {
+                if (!shouldLog(level)) {
+                    return;
+                }
+                if (writer_running_.load(std::memory_order_acquire)) {
+                    enqueueFormat(level, file, line, fmt.text, LogRecord::toEncodable(arg), LogRecord::toEncodable(args)...);
+                    return;
                 }
+                log(level, LogFormat::format(fmt.text, arg, args...), file, line);
+            }
+            
+            /**
+             * @brief 使用 "{}" 占位符延迟格式化并写入日志（格式字符串不是字面量时）
+             * @details 仅在级别检查通过后才进行格式化，参见 LogFormat::formatTo；
+             *          在调用线程格式化，不保留格式字符串。字符数组一律走字面量重载
+             * @param level 日志级别
+             * @param file 源文件名
+             * @param line 行号
+             * @param fmt 格式字符串
+             * @param arg 第一个参数
+             * @param args 其余参数
+             */
+            template<typename Format, typename Arg, typename... Args>
+                requires (!std::is_array_v<Format> && std::is_convertible_v<const Format&, std::string_view>)
+            void write(LogLevel level, const char* file, int line, const Format& fmt,
+                       const Arg& arg, const Args&... args) {
+                if (!shouldLog(level)) {
+                    return;
+                }
+                log(level, LogFormat::format(fmt, arg, args...), file, line);
             }
             
             /**
@@ -253,18 +502,65 @@ namespace DearTs {
             }
             
         private:
+            /**
+             * @brief 单个线程的日志缓冲区
+             */
+            struct ThreadBuffer {
+                explicit ThreadBuffer(size_t capacity) : ring(capacity) {}
+                
+                LogRingBuffer ring;
+                std::atomic<bool> retired{false};  ///< 所属线程已退出，处理完后可回收
+            };
+            
+            /**
+             * @brief 线程局部的缓冲区句柄，线程退出时标记缓冲区可回收
+             */
+            struct ThreadBufferHandle {
+                std::shared_ptr<ThreadBuffer> buffer;
+                
+                ~ThreadBufferHandle() {
+                    if (buffer) {
+                        buffer->retired.store(true, std::memory_order_release);
+                    }
+                }
+            };
+            
+            /**
+             * @brief 批处理中的一条记录
+             */
+            struct PendingRecord {
+                LogRecordHeader header;
+                const uint8_t* payload;
+                size_t payloadSize;
+            };
+            
+            /**
+             * @brief 秒级时间前缀缓存，避免每条日志都调用 localtime
+             */
+            struct TimestampCache {
+                int64_t second = -1;
+                char text[32] = {};
+                size_t length = 0;
+            };
+            
             Logger() : writer_running_(false), duplicate_filter_window_ms_(1000) {
                 // 不在构造函数中启动线程，而是在enableFileOutput中启动
+                const auto steadyNow = std::chrono::steady_clock::now();
+                const auto systemNow = std::chrono::system_clock::now();
+                steady_anchor_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    steadyNow.time_since_epoch()).count();
+                system_anchor_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    systemNow.time_since_epoch()).count();
             }
             
             ~Logger() {
-                // 停止文件输出
+                // 停止文件输出（会等待后台线程处理完剩余记录）
                 enableFileOutput("", false);
                 
                 // 确保线程已终止
                 if (file_writer_thread_.joinable()) {
-                    writer_running_.store(false, std::memory_order_relaxed);
-                    queue_cv_.notify_all();
+                    writer_running_.store(false, std::memory_order_release);
+                    wakeWriter(true);
                     file_writer_thread_.join();
                 }
             }
@@ -273,127 +569,719 @@ namespace DearTs {
             Logger(Logger&&) = delete;
             Logger& operator=(Logger&&) = delete;
             
+            /**
+             * @brief 获取单调时间戳（纳秒）
+             */
+            static int64_t nowTimestamp() noexcept {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+            
+            /**
+             * @brief 获取调用线程的缓冲区，首次调用时创建并注册
+             */
+            ThreadBuffer& threadBuffer() {
+                thread_local ThreadBufferHandle handle;
+                if (!handle.buffer) {
+                    handle.buffer = std::make_shared<ThreadBuffer>(
+                        thread_buffer_capacity_.load(std::memory_order_relaxed));
+                    std::lock_guard<std::mutex> lock(buffers_mutex_);
+                    thread_buffers_.push_back(handle.buffer);
+                }
+                return *handle.buffer;
+            }
+            
+            /**
+             * @brief 在调用线程的缓冲区中预留一条记录的空间，按溢出策略处理写满的情况
+             * @return 负载写入位置；丢弃时返回 nullptr
+             */
+            uint8_t* reserveRecord(ThreadBuffer& buffer, size_t payloadSize) {
+                uint8_t* dst = buffer.ring.reserve(payloadSize);
+                if (dst) {
+                    return dst;
+                }
+                if (overflow_policy_.load(std::memory_order_relaxed) == static_cast<int>(LogOverflowPolicy::BLOCK)) {
+                    while (writer_running_.load(std::memory_order_acquire)) {
+                        wakeWriter(true);
+                        std::this_thread::yield();
+                        if ((dst = buffer.ring.reserve(payloadSize)) != nullptr) {
+                            return dst;
+                        }
+                    }
+                }
+                dropped_count_.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            
+            /**
+             * @brief 提交记录并在后台线程休眠时唤醒它
+             */
+            void commitRecord(ThreadBuffer& buffer) {
+                buffer.ring.commit();
+                wakeWriter(false);
+            }
+            
+            /**
+             * @brief 过滤重复消息后把已构造好的消息写入调用线程的缓冲区
+             */
+            void enqueueText(LogLevel level, const std::string& message, const char* file, int line) {
+                const auto decision = checkDuplicate(level, file, line,
+                                                     LogRecord::hashBytes(message.data(), message.size()), nowTimestamp());
+                if (decision.suppress) {
+                    return;
+                }
+                pushSummary(decision.summary);
+                pushText(level, message, file, line);
+            }
+            
+            /**
+             * @brief 过滤重复消息后把格式字符串指针和编码后的参数写入调用线程的缓冲区
+             */
+            template<typename... Args>
+            void enqueueFormat(LogLevel level, const char* file, int line, const char* fmt, const Args&... args) {
+                // 同一调用点的格式字符串相同，参数即可区分消息内容
+                const auto decision = checkDuplicate(level, file, line, LogRecord::hashArgs(args...), nowTimestamp());
+                if (decision.suppress) {
+                    return;
+                }
+                pushSummary(decision.summary);
+                pushFormat(level, file, line, fmt, args...);
+            }
+            
+            /**
+             * @brief 把已构造好的消息写入调用线程的缓冲区
+             */
+            void pushText(LogLevel level, std::string_view message, const char* file, int line) {
+                ThreadBuffer& buffer = threadBuffer();
+                const size_t maxText = buffer.ring.maxPayloadSize() - sizeof(LogRecordHeader);
+                const size_t textSize = std::min(message.size(), maxText);
+                
+                uint8_t* dst = reserveRecord(buffer, sizeof(LogRecordHeader) + textSize);
+                if (!dst) {
+                    return;
+                }
+                
+                const LogRecordHeader header{nowTimestamp(), file, nullptr, line,
+                                             static_cast<uint8_t>(level), LogRecordKind::TEXT, 0};
+                std::memcpy(dst, &header, sizeof(header));
+                std::memcpy(dst + sizeof(header), message.data(), textSize);
+                commitRecord(buffer);
+            }
+            
+            /**
+             * @brief 把格式字符串指针和编码后的参数写入调用线程的缓冲区
+             */
+            template<typename... Args>
+            void pushFormat(LogLevel level, const char* file, int line, const char* fmt, const Args&... args) {
+                ThreadBuffer& buffer = threadBuffer();
+                const size_t argsSize = LogRecord::argsSize(args...);
+                if (sizeof(LogRecordHeader) + argsSize > buffer.ring.maxPayloadSize()) {
+                    // 参数过大（超长字符串），退化为在当前线程格式化并截断
+                    std::string message;
+                    LogFormat::formatTo(message, fmt, args...);
+                    pushText(level, message, file, line);
+                    return;
+                }
+                
+                uint8_t* dst = reserveRecord(buffer, sizeof(LogRecordHeader) + argsSize);
+                if (!dst) {
+                    return;
+                }
+                
+                const LogRecordHeader header{nowTimestamp(), file, fmt, line, static_cast<uint8_t>(level),
+                                             LogRecordKind::FORMAT, static_cast<uint16_t>(sizeof...(Args))};
+                std::memcpy(dst, &header, sizeof(header));
+                LogRecord::writeArgs(dst + sizeof(header), args...);
+                commitRecord(buffer);
+            }
+            
+            /**
+             * @brief 唤醒后台线程
+             * @param force 为 true 时无论后台线程是否休眠都发出通知
+             */
+            void wakeWriter(bool force) {
+                // 与后台线程的“标记休眠 -> 检查缓冲区”配对，保证不会丢失唤醒
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!force && !writer_sleeping_.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                if (force || writer_sleeping_.exchange(false, std::memory_order_acq_rel)) {
+                    {
+                        std::lock_guard<std::mutex> lock(wake_mutex_);
+                        wake_pending_ = true;
+                    }
+                    wake_cv_.notify_one();
+                }
+            }
+            
             /**
              * @brief 检查是否为重复消息
-             * @param message 日志消息
+             * @param level 日志级别
              * @param file 源文件名
              * @param line 行号
-             * @return 是否为重复消息
+             * @param messageHash 消息内容哈希
+             * @param timestamp 单调时间戳（纳秒）
+             * @return 检查结果，可能附带需要先输出的汇总
+             */
+            LogDuplicateFilter::Decision checkDuplicate(LogLevel level, const char* file, int line,
+                                                        uint64_t messageHash, int64_t timestamp) noexcept {
+                return duplicate_filter_.check(file, line, static_cast<int>(level), messageHash, timestamp / 1000000,
+                                               duplicate_filter_window_ms_.load(std::memory_order_relaxed));
+            }
+            
+            /**
+             * @brief 把重复日志汇总写入调用线程的缓冲区
+             */
+            void pushSummary(const LogDuplicateFilter::Summary& summary) {
+                if (summary.count == 0) {
+                    return;
+                }
+                // 先复制到局部变量：pushFormat 按引用接收参数，summary 通常引用调用方栈上的 Decision
+                const LogLevel level = static_cast<LogLevel>(summary.level);
+                const char* const file = summary.file;
+                const int line = summary.line;
+                const uint32_t count = summary.count;
+                pushFormat(level, file, line, DUPLICATE_SUMMARY_FORMAT, count);
+            }
+            
+            /**
+             * @brief 定期收集窗口已结束的重复日志汇总（不再出现的消息也能得到汇总）
+             * @param timestamp 单调时间戳（纳秒）
+             * @param force 为 true 时忽略时间窗口，收集所有尚未汇总的计数（关闭文件输出时使用）
+             * @param scratch 复用的临时容器
+             * @param emit 输出回调，签名 void(const LogDuplicateFilter::Summary&)
+             */
+            template<typename Emit>
+            void sweepDuplicates(int64_t timestamp, bool force, std::vector<LogDuplicateFilter::Summary>& scratch,
+                                 Emit&& emit) {
+                const int64_t windowMs = duplicate_filter_window_ms_.load(std::memory_order_relaxed);
+                const int64_t nowMs = timestamp / 1000000;
+                if (windowMs <= 0 ||
+                    (!force && nowMs - last_duplicate_sweep_ms_.load(std::memory_order_relaxed) < windowMs)) {
+                    return;
+                }
+                last_duplicate_sweep_ms_.store(nowMs, std::memory_order_relaxed);
+                
+                scratch.clear();
+                duplicate_filter_.collectExpired(nowMs, force ? 0 : windowMs, scratch);
+                for (const auto& summary : scratch) {
+                    emit(summary);
+                }
+            }
+            
+            /**
+             * @brief 追加一行重复日志汇总
+             */
+            void appendSummaryLine(std::string& out, std::string& scratch, TimestampCache& cache, int64_t timestamp,
+                                   const LogDuplicateFilter::Summary& summary) const {
+                scratch.clear();
+                LogFormat::formatTo(scratch, DUPLICATE_SUMMARY_FORMAT, summary.count);
+                appendFormattedLine(out, cache, timestamp, static_cast<LogLevel>(summary.level), summary.file,
+                                    summary.line, scratch);
+            }
+            
+            /**
+             * @brief 把单调时间戳转换为本地时间文本 "YYYY-mm-dd HH:MM:SS.mmm"
+             * @details 同一秒内复用缓存的前缀；使用线程安全的 localtime_r / localtime_s
              */
-            bool isDuplicateMessage(const std::string& message, const char* file, int line) {
-                // 构造唯一键
-                std::string key = std::string(file) + ":" + std::to_string(line) + ":" + message;
+            void appendTimestamp(std::string& out, TimestampCache& cache, int64_t timestamp) const {
+                const int64_t wallNs = system_anchor_ns_ + (timestamp - steady_anchor_ns_);
+                int64_t second = wallNs / 1000000000;
+                int64_t millis = (wallNs / 1000000) % 1000;
+                if (millis < 0) {
+                    millis += 1000;
+                    --second;
+                }
                 
-                // 获取当前时间
-                auto now = std::chrono::steady_clock::now();
-                auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+                if (second != cache.second) {
+                    const std::time_t time = static_cast<std::time_t>(second);
+                    std::tm localTime{};
+#ifdef _WIN32
+                    localtime_s(&localTime, &time);
+#else
+                    localtime_r(&time, &localTime);
+#endif
+                    cache.length = std::strftime(cache.text, sizeof(cache.text), "%Y-%m-%d %H:%M:%S", &localTime);
+                    cache.second = second;
+                }
                 
-                std::lock_guard<std::mutex> lock(duplicate_mutex_);
+                out.append(cache.text, cache.length);
+                out += '.';
+                out += static_cast<char>('0' + millis / 100);
+                out += static_cast<char>('0' + (millis / 10) % 10);
+                out += static_cast<char>('0' + millis % 10);
+            }
+            
+            /**
+             * @brief 追加一行格式化后的日志（含换行符）
+             */
+            void appendFormattedLine(std::string& out, TimestampCache& cache, int64_t timestamp, LogLevel level,
+                                     const char* file, int line, std::string_view message) const {
+                out += '[';
+                appendTimestamp(out, cache, timestamp);
+                out += "] [";
+                out += getLevelString(level);
+                out += "] [";
+                out += extractFilename(file);
+                out += ':';
+                LogFormat::appendValue(out, line);
+                out += "] ";
+                out.append(message.data(), message.size());
+                out += '\n';
+            }
+            
+            /**
+             * @brief 把一条二进制记录格式化为文本行
+             */
+            void appendRecord(std::string& out, const PendingRecord& record) {
+                const LogRecordHeader& header = record.header;
+                const uint8_t* body = record.payload + sizeof(LogRecordHeader);
+                const size_t bodySize = record.payloadSize - sizeof(LogRecordHeader);
+                
+                std::string_view message;
+                if (header.kind == LogRecordKind::FORMAT) {
+                    message_scratch_.clear();
+                    LogRecord::formatArgs(message_scratch_, header.format, body, bodySize);
+                    message = message_scratch_;
+                } else {
+                    message = std::string_view(reinterpret_cast<const char*>(body), bodySize);
+                }
+                appendFormattedLine(out, writer_clock_, header.timestamp, static_cast<LogLevel>(header.level),
+                                    header.file, header.line, message);
+            }
+            
+            /**
+             * @brief 输出一条记录：按需格式化到控制台，并按文件格式追加到 file_text_
+             */
+            void emitRecord(const PendingRecord& record) {
+                const LogRecordHeader& header = record.header;
+                maybeRotate(header.timestamp);
+                const bool binary = active_file_format_ == LogFileFormat::BINARY;
                 
-                // 查找是否已存在该消息
-                auto it = last_message_times_.find(key);
-                if (it != last_message_times_.end()) {
-                    // 检查是否在过滤时间窗口内
-                    if (now_ms - it->second < duplicate_filter_window_ms_.load(std::memory_order_relaxed)) {
-                        // 更新最后记录时间
-                        it->second = now_ms;
-                        return true; // 过滤掉重复消息
+                if (console_output_enabled_.load(std::memory_order_relaxed) || !binary) {
+                    line_text_.clear();
+                    appendRecord(line_text_, record);
+                    if (console_output_enabled_.load(std::memory_order_relaxed)) {
+                        writeConsole(line_text_, header.level >= static_cast<uint8_t>(LogLevel::LOG_ERROR));
+                    }
+                    if (!binary) {
+                        file_text_ += line_text_;
+                        return;
                     }
                 }
                 
-                // 更新最后记录时间
-                last_message_times_[key] = now_ms;
+                const uint8_t* body = record.payload + sizeof(LogRecordHeader);
+                const size_t bodySize = record.payloadSize - sizeof(LogRecordHeader);
+                if (header.kind == LogRecordKind::FORMAT) {
+                    binary_encoder_.appendRecord(file_text_, header.timestamp, header.level, header.file, header.line,
+                                                 header.format, body, bodySize);
+                } else {
+                    binary_encoder_.appendText(file_text_, header.timestamp, header.level, header.file, header.line,
+                                               std::string_view(reinterpret_cast<const char*>(body), bodySize));
+                }
+            }
+            
+            /**
+             * @brief 输出一条由后台线程自身产生的消息（丢弃统计、重复汇总）
+             */
+            void emitLine(int64_t timestamp, LogLevel level, const char* file, int line, std::string_view message) {
+                maybeRotate(timestamp);
+                const bool binary = active_file_format_ == LogFileFormat::BINARY;
+                line_text_.clear();
+                appendFormattedLine(line_text_, writer_clock_, timestamp, level, file, line, message);
+                if (console_output_enabled_.load(std::memory_order_relaxed)) {
+                    writeConsole(line_text_, static_cast<int>(level) >= static_cast<int>(LogLevel::LOG_ERROR));
+                }
+                if (binary) {
+                    binary_encoder_.appendText(file_text_, timestamp, static_cast<uint8_t>(level), file, line, message);
+                } else {
+                    file_text_ += line_text_;
+                }
+            }
+            
+            /**
+             * @brief 检查是否还有未处理的记录
+             */
+            bool hasPendingRecords() {
+                std::lock_guard<std::mutex> lock(buffers_mutex_);
+                for (const auto& buffer : thread_buffers_) {
+                    if (!buffer->ring.empty()) {
+                        return true;
+                    }
+                }
                 return false;
             }
             
             /**
-             * @brief 格式化日志消息
-             * @param level 日志级别
-             * @param message 日志消息
-             * @param file 源文件名
-             * @param line 行号
-             * @return 格式化后的日志消息
-             */
-            std::string formatLogMessage(LogLevel level, const std::string& message, 
-                                       const char* file, int line) const noexcept {
-                // 获取当前时间
-                const auto now = std::chrono::system_clock::now();
-                const auto time_t = std::chrono::system_clock::to_time_t(now);
-                const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now.time_since_epoch()) % 1000;
+             * @brief 处理所有线程缓冲区中当前可见的记录
+             * @param final 是否为后台线程退出前的最后一次处理
+             * @return 本批次处理的记录数
+             */
+            size_t drainBuffers(bool final = false) {
+                {
+                    std::lock_guard<std::mutex> lock(buffers_mutex_);
+                    buffer_snapshot_.assign(thread_buffers_.begin(), thread_buffers_.end());
+                }
+                
+                batch_.clear();
+                release_positions_.resize(buffer_snapshot_.size());
+                for (size_t i = 0; i < buffer_snapshot_.size(); ++i) {
+                    release_positions_[i] = buffer_snapshot_[i]->ring.forEach([this](const uint8_t* payload, size_t size) {
+                        PendingRecord record{};
+                        std::memcpy(&record.header, payload, sizeof(LogRecordHeader));
+                        record.payload = payload;
+                        record.payloadSize = size;
+                        batch_.push_back(record);
+                    });
+                }
+                
+                // 多个线程的记录按时间戳合并，保持全局时间顺序
+                std::stable_sort(batch_.begin(), batch_.end(), [](const PendingRecord& a, const PendingRecord& b) {
+                    return a.header.timestamp < b.header.timestamp;
+                });
                 
-                // 格式化时间
-                std::stringstream ss;
-                ss << "[" << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S")
-                   << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
+                const size_t writeThreshold = buffer_size_.load(std::memory_order_relaxed);
+                bool hasError = false;
+                for (const PendingRecord& record : batch_) {
+                    hasError = hasError || record.header.level >= static_cast<uint8_t>(LogLevel::LOG_ERROR);
+                    emitRecord(record);
+                    
+                    if (file_text_.size() >= writeThreshold) {
+                        writeFileText();
+                    }
+                }
                 
-                // 输出日志级别
-                ss << "[" << getLevelString(level) << "] ";
+                for (size_t i = 0; i < buffer_snapshot_.size(); ++i) {
+                    buffer_snapshot_[i]->ring.release(release_positions_[i]);
+                }
                 
-                // 输出源码位置信息（仅显示文件名，不显示完整路径）
-                const std::string filename = extractFilename(file);
-                ss << "[" << filename << ":" << line << "] ";
+                reportDroppedRecords();
+                sweepDuplicates(nowTimestamp(), final, writer_summaries_, [this](const LogDuplicateFilter::Summary& summary) {
+                    summary_scratch_.clear();
+                    LogFormat::formatTo(summary_scratch_, DUPLICATE_SUMMARY_FORMAT, summary.count);
+                    emitLine(nowTimestamp(), static_cast<LogLevel>(summary.level), summary.file, summary.line,
+                             summary_scratch_);
+                });
+                writeFileText();
+                if (!batch_.empty() || unflushed_) {
+                    applyFlushPolicy(hasError);
+                }
                 
-                // 输出消息
-                ss << message;
+                // 回收已退出线程的空缓冲区
+                {
+                    std::lock_guard<std::mutex> lock(buffers_mutex_);
+                    thread_buffers_.erase(std::remove_if(thread_buffers_.begin(), thread_buffers_.end(),
+                        [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                            return buffer->retired.load(std::memory_order_acquire) && buffer->ring.empty();
+                        }), thread_buffers_.end());
+                }
+                buffer_snapshot_.clear();
                 
-                return ss.str();
+                return batch_.size();
             }
             
             /**
-             * @brief 写入日志到文件
-             * @param message 格式化后的日志消息
+             * @brief 输出一行到控制台
              */
-            void writeToFile(const std::string& message) {
-                // 将消息添加到队列中
+            void writeConsole(std::string_view text, bool isError) {
+                std::lock_guard<std::mutex> lock(output_mutex_);
+                auto& stream = isError ? std::cerr : std::cout;
+                stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+            }
+            
+            /**
+             * @brief 把累计的文本写入文件
+             */
+            void writeFileText() {
+                if (file_text_.empty()) {
+                    return;
+                }
                 {
-                    std::lock_guard<std::mutex> lock(queue_mutex_);
-                    log_queue_.push(message);
+                    std::lock_guard<std::mutex> lock(file_mutex_);
+                    if (file_stream_.is_open()) {
+                        file_stream_.write(file_text_.data(), static_cast<std::streamsize>(file_text_.size()));
+                        unflushed_ = true;
+                    }
                 }
-                // 通知写入线程
-                queue_cv_.notify_one();
+                current_file_size_ += file_text_.size();
+                file_text_.clear();
             }
             
             /**
-             * @brief 文件写入线程函数
+             * @brief 获取当前系统时间（纳秒，Unix 纪元）
+             */
+            static int64_t currentWallTime() noexcept {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+            
+            /**
+             * @brief 计算给定时间之后的下一个本地午夜（纳秒，Unix 纪元）
+             */
+            static int64_t nextLocalMidnight(int64_t wallNs) noexcept {
+                const std::time_t time = static_cast<std::time_t>(wallNs / 1000000000);
+                std::tm localTime{};
+#ifdef _WIN32
+                localtime_s(&localTime, &time);
+#else
+                localtime_r(&time, &localTime);
+#endif
+                localTime.tm_hour = 0;
+                localTime.tm_min = 0;
+                localTime.tm_sec = 0;
+                localTime.tm_mday += 1;
+                localTime.tm_isdst = -1;
+                return static_cast<int64_t>(std::mktime(&localTime)) * 1000000000;
+            }
+            
+            /**
+             * @brief 生成轮转后的文件名：name.YYYYmmdd-HHMMSS.ext（重名时追加序号）
+             */
+            static std::filesystem::path rotatedPath(const std::filesystem::path& path, int64_t wallNs) {
+                const std::time_t time = static_cast<std::time_t>(wallNs / 1000000000);
+                std::tm localTime{};
+#ifdef _WIN32
+                localtime_s(&localTime, &time);
+#else
+                localtime_r(&time, &localTime);
+#endif
+                char stamp[32];
+                std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &localTime);
+                
+                const std::string base = path.stem().string() + "." + stamp;
+                const std::string extension = path.extension().string();
+                std::filesystem::path candidate = path.parent_path() / (base + extension);
+                std::error_code ec;
+                for (int index = 1; std::filesystem::exists(candidate, ec) ||
+                                    std::filesystem::exists(std::filesystem::path(candidate) += ".gz", ec); ++index) {
+                    candidate = path.parent_path() / (base + "-" + std::to_string(index) + extension);
+                }
+                return candidate;
+            }
+            
+            /**
+             * @brief 打开文件前检查已有文件是否需要轮转
+             */
+            bool shouldRotateExisting(const std::filesystem::path& path) const {
+                std::error_code ec;
+                const auto size = std::filesystem::file_size(path, ec);
+                if (ec || size == 0) {
+                    return false;
+                }
+                const size_t maxSize = max_file_size_.load(std::memory_order_relaxed);
+                if (maxSize > 0 && size >= maxSize) {
+                    return true;
+                }
+                if (rotate_daily_.load(std::memory_order_relaxed)) {
+                    const auto modified = std::filesystem::last_write_time(path, ec);
+                    if (!ec) {
+                        const int64_t modifiedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::file_clock::to_sys(modified).time_since_epoch()).count();
+                        return nextLocalMidnight(modifiedNs) <= currentWallTime();
+                    }
+                }
+                return false;
+            }
+            
+            /**
+             * @brief 重命名已有文件并提交归档任务（仅在后台线程未运行时调用）
+             */
+            void rotateExisting(const std::filesystem::path& path) {
+                const std::filesystem::path rotated = rotatedPath(path, currentWallTime());
+                std::error_code ec;
+                std::filesystem::rename(path, rotated, ec);
+                if (!ec) {
+                    submitArchive(rotated, path);
+                }
+            }
+            
+            /**
+             * @brief 把轮转出的文件交给归档线程
+             */
+            void submitArchive(const std::filesystem::path& rotated, const std::filesystem::path& active) {
+                const bool compress = compress_rotated_.load(std::memory_order_relaxed);
+                const int maxFiles = max_rotated_files_.load(std::memory_order_relaxed);
+                if (compress || maxFiles > 0) {
+                    archiver_.submit({rotated, active, compress, maxFiles});
+                }
+            }
+            
+            /**
+             * @brief 在写入下一条记录前检查是否需要轮转（仅后台线程调用）
+             * @param timestamp 记录的单调时间戳（纳秒）
+             */
+            void maybeRotate(int64_t timestamp) {
+                const size_t maxSize = max_file_size_.load(std::memory_order_relaxed);
+                const uint64_t size = current_file_size_ + file_text_.size();
+                const bool sizeExceeded = maxSize > 0 && size > 0 && size >= maxSize;
+                const bool dayChanged = rotate_daily_.load(std::memory_order_relaxed) &&
+                                        system_anchor_ns_ + (timestamp - steady_anchor_ns_) >= next_day_boundary_ns_;
+                if (sizeExceeded || dayChanged) {
+                    rotateFile();
+                }
+            }
+            
+            /**
+             * @brief 在后台线程中切换到新文件
+             * @details 先把已累计的数据写入旧文件，再重命名旧文件并重新打开，
+             *          期间写日志的线程继续写入各自的缓冲区，不会丢失记录
+             */
+            void rotateFile() {
+                writeFileText();
+                
+                const int64_t now = currentWallTime();
+                std::filesystem::path active;
+                std::filesystem::path rotated;
+                std::error_code ec;
+                {
+                    std::lock_guard<std::mutex> lock(file_mutex_);
+                    if (!file_stream_.is_open()) {
+                        return;
+                    }
+                    file_stream_.flush();
+                    file_stream_.close();
+                    
+                    active = log_filename_;
+                    rotated = rotatedPath(active, now);
+                    std::filesystem::rename(active, rotated, ec);
+                    
+                    const bool binary = active_file_format_ == LogFileFormat::BINARY;
+                    file_stream_.open(active, binary ? (std::ios::app | std::ios::binary) : std::ios::app);
+                    unflushed_ = false;
+                }
+                
+                // 重命名失败时继续写入原文件，下一个周期再尝试
+                current_file_size_ = 0;
+                next_day_boundary_ns_ = nextLocalMidnight(now);
+                if (active_file_format_ == LogFileFormat::BINARY) {
+                    binary_encoder_.begin(file_text_, steady_anchor_ns_, system_anchor_ns_);
+                }
+                
+                if (ec) {
+                    emitLine(nowTimestamp(), LogLevel::LOG_WARN, __FILE__, __LINE__,
+                             LogFormat::format("日志文件轮转失败: {}", ec.message()));
+                } else {
+                    submitArchive(rotated, active);
+                }
+            }
+            
+            /**
+             * @brief 按刷新策略刷新文件和控制台
+             */
+            void applyFlushPolicy(bool force) {
+                const auto policy = static_cast<LogFlushPolicy>(flush_policy_.load(std::memory_order_relaxed));
+                const auto now = std::chrono::steady_clock::now();
+                bool shouldFlush = force || policy == LogFlushPolicy::EVERY_BATCH;
+                if (!shouldFlush && policy == LogFlushPolicy::INTERVAL) {
+                    shouldFlush = now - last_flush_time_ >=
+                                  std::chrono::milliseconds(flush_interval_ms_.load(std::memory_order_relaxed));
+                }
+                if (shouldFlush) {
+                    flushOutputs();
+                    last_flush_time_ = now;
+                }
+            }
+            
+            /**
+             * @brief 刷新控制台和文件流
+             */
+            void flushOutputs() {
+                {
+                    std::lock_guard<std::mutex> lock(output_mutex_);
+                    std::cout.flush();
+                }
+                std::lock_guard<std::mutex> lock(file_mutex_);
+                if (file_stream_.is_open() && unflushed_) {
+                    file_stream_.flush();
+                }
+                unflushed_ = false;
+            }
+            
+            /**
+             * @brief 报告自上次报告以来被丢弃的记录数
+             */
+            void reportDroppedRecords() {
+                const uint64_t dropped = dropped_count_.load(std::memory_order_relaxed);
+                if (dropped == reported_dropped_) {
+                    return;
+                }
+                const std::string message = LogFormat::format("日志缓冲区已满，丢弃了 {} 条记录", dropped - reported_dropped_);
+                reported_dropped_ = dropped;
+                emitLine(nowTimestamp(), LogLevel::LOG_WARN, __FILE__, __LINE__, message);
+            }
+            
+            /**
+             * @brief 完成所有已到期的 flush() 请求
+             */
+            void completeFlushRequests(uint64_t requested) {
+                if (requested == 0) {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(flush_mutex_);
+                    if (requested <= flush_completed_) {
+                        return;
+                    }
+                }
+                flushOutputs();
+                last_flush_time_ = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard<std::mutex> lock(flush_mutex_);
+                    flush_completed_ = requested;
+                }
+                flush_cv_.notify_all();
+            }
+            
+            /**
+             * @brief 后台写入线程函数
+             * @details 唯一的消费者：合并各线程缓冲区的记录、格式化并输出，空闲时休眠等待唤醒
              */
             void fileWriterThread() {
-                // 线程运行标志
-                while (writer_running_.load(std::memory_order_relaxed)) {
-                    std::unique_lock<std::mutex> lock(queue_mutex_);
+                last_flush_time_ = std::chrono::steady_clock::now();
+                
+                while (true) {
+                    const uint64_t requested = flush_requested_.load(std::memory_order_acquire);
+                    const bool running = writer_running_.load(std::memory_order_acquire);
                     
-                    // 等待条件变量或超时
-                    queue_cv_.wait_for(lock, std::chrono::milliseconds(100), [this] {
-                        return !log_queue_.empty() || !writer_running_.load(std::memory_order_relaxed);
-                    });
+                    const size_t processed = drainBuffers();
+                    completeFlushRequests(requested);
                     
-                    // 检查是否需要退出
-                    if (!writer_running_.load(std::memory_order_relaxed)) {
+                    if (!running) {
+                        // 退出前再处理一遍，确保停止前提交的记录全部输出
+                        drainBuffers(true);
+                        flushOutputs();
                         break;
                     }
+                    if (processed > 0) {
+                        continue;
+                    }
                     
-                    // 处理队列中的所有消息
-                    std::string buffer;
-                    size_t bufferSize = 0;
-                    const size_t maxBufferSize = buffer_size_.load(std::memory_order_relaxed);
-                    
-                    while (!log_queue_.empty() && bufferSize < maxBufferSize) {
-                        const std::string& msg = log_queue_.front();
-                        buffer += msg + "\n";
-                        bufferSize += msg.length() + 1;
-                        log_queue_.pop();
+                    // 没有待处理记录：标记休眠并等待生产者唤醒
+                    std::unique_lock<std::mutex> lock(wake_mutex_);
+                    writer_sleeping_.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (wake_pending_ || hasPendingRecords() ||
+                        flush_requested_.load(std::memory_order_acquire) != requested ||
+                        !writer_running_.load(std::memory_order_acquire)) {
+                        writer_sleeping_.store(false, std::memory_order_relaxed);
+                        wake_pending_ = false;
+                        continue;
                     }
                     
-                    // 释放锁以便其他线程可以继续添加消息
+                    // INTERVAL 策略下有未刷新的数据时按间隔醒来，否则长时间休眠
+                    const bool intervalPending = unflushed_ &&
+                        flush_policy_.load(std::memory_order_relaxed) == static_cast<int>(LogFlushPolicy::INTERVAL);
+                    const auto timeout = intervalPending
+                        ? std::chrono::milliseconds(flush_interval_ms_.load(std::memory_order_relaxed))
+                        : std::chrono::milliseconds(1000);
+                    wake_cv_.wait_for(lock, timeout, [this] { return wake_pending_; });
+                    wake_pending_ = false;
+                    writer_sleeping_.store(false, std::memory_order_relaxed);
                     lock.unlock();
                     
-                    // 如果有数据要写入
-                    if (!buffer.empty()) {
-                        std::lock_guard<std::mutex> fileLock(file_mutex_);
-                        if (file_stream_.is_open()) {
-                            file_stream_ << buffer;
-                            file_stream_.flush();  // 实时保存
-                        }
+                    if (intervalPending) {
+                        flushOutputs();
+                        last_flush_time_ = std::chrono::steady_clock::now();
                     }
                 }
             }
@@ -403,7 +1291,7 @@ namespace DearTs {
              * @param level 日志级别
              * @return 日志级别字符串
              */
-            constexpr const char* getLevelString(LogLevel level) const noexcept {
+            static constexpr const char* getLevelString(LogLevel level) noexcept {
                 switch (level) {
                     case LogLevel::LOG_TRACE: return "TRACE";
                     case LogLevel::LOG_DEBUG: return "DEBUG";
@@ -420,33 +1308,86 @@ namespace DearTs {
              * @param path 完整文件路径
              * @return 文件名
              */
-            std::string extractFilename(const char* path) const noexcept {
-                std::string pathStr(path);
+            static std::string_view extractFilename(const char* path) noexcept {
+                std::string_view pathStr(path ? path : "");
                 size_t pos = pathStr.find_last_of("/\\");
-                return (pos != std::string::npos) ? pathStr.substr(pos + 1) : pathStr;
+                return (pos != std::string_view::npos) ? pathStr.substr(pos + 1) : pathStr;
             }
             
             std::atomic<int> current_level_{2};  // LOG_INFO = 2
             mutable std::mutex output_mutex_;
+            std::string sync_line_;              // 同步输出路径的行缓冲（受 output_mutex_ 保护）
+            std::string sync_message_;           // 同步输出路径的消息缓冲（受 output_mutex_ 保护）
+            TimestampCache sync_clock_;          // 同步输出路径的时间缓存（受 output_mutex_ 保护）
+            
+            // 单调时钟与系统时钟的对应关系，用于把记录时间戳转换为本地时间
+            int64_t steady_anchor_ns_ = 0;
+            int64_t system_anchor_ns_ = 0;
             
             // 文件输出相关
+            std::mutex control_mutex_;           // 串行化 enableFileOutput
             std::atomic<bool> file_output_enabled_{false};
             std::string log_filename_;
             mutable std::mutex file_mutex_;
             std::ofstream file_stream_;
+            std::atomic<int> file_format_{static_cast<int>(LogFileFormat::TEXT)};
+            std::atomic<bool> console_output_enabled_{true};
+            
+            // 文件轮转相关
+            std::atomic<size_t> max_file_size_{0};
+            std::atomic<bool> rotate_daily_{false};
+            std::atomic<int> max_rotated_files_{0};
+            std::atomic<bool> compress_rotated_{false};
+            uint64_t current_file_size_ = 0;     // 当前文件大小（打开文件时初始化，之后仅由后台线程访问）
+            int64_t next_day_boundary_ns_ = 0;   // 下一次按天轮转的时间点（同上）
+            LogArchiver archiver_;
+            
+            // 线程缓冲区（生产者首次写日志时注册）
+            std::vector<std::shared_ptr<ThreadBuffer>> thread_buffers_;
+            std::mutex buffers_mutex_;
+            std::atomic<size_t> thread_buffer_capacity_{64 * 1024};
+            std::atomic<int> overflow_policy_{static_cast<int>(LogOverflowPolicy::BLOCK)};
+            std::atomic<uint64_t> dropped_count_{0};
             
-            // 异步写入相关
-            std::queue<std::string> log_queue_;
-            mutable std::mutex queue_mutex_;
-            std::condition_variable queue_cv_;
+            // 后台线程相关
             std::thread file_writer_thread_;
             std::atomic<bool> writer_running_{false};
+            std::atomic<bool> writer_sleeping_{false};
+            std::mutex wake_mutex_;
+            std::condition_variable wake_cv_;
+            bool wake_pending_ = false;          // 受 wake_mutex_ 保护
             std::atomic<size_t> buffer_size_{1024};  // 默认缓冲区大小1KB
+            std::atomic<int> flush_policy_{static_cast<int>(LogFlushPolicy::EVERY_BATCH)};
+            std::atomic<long long> flush_interval_ms_{200};
+            
+            // flush() 请求
+            std::atomic<uint64_t> flush_requested_{0};
+            uint64_t flush_completed_ = 0;       // 受 flush_mutex_ 保护
+            std::mutex flush_mutex_;
+            std::condition_variable flush_cv_;
+            
+            // 仅由后台线程访问的状态
+            std::vector<std::shared_ptr<ThreadBuffer>> buffer_snapshot_;
+            std::vector<size_t> release_positions_;
+            std::vector<PendingRecord> batch_;
+            std::string file_text_;              // 待写入文件的数据（文本行或二进制条目）
+            std::string line_text_;              // 当前记录的文本行
+            std::string message_scratch_;
+            std::string summary_scratch_;
+            LogFileFormat active_file_format_ = LogFileFormat::TEXT;  // 打开文件时确定
+            LogBinary::Encoder binary_encoder_;
+            TimestampCache writer_clock_;
+            std::chrono::steady_clock::time_point last_flush_time_;
+            uint64_t reported_dropped_ = 0;
+            bool unflushed_ = false;
             
             // 重复日志过滤相关
+            static constexpr const char* DUPLICATE_SUMMARY_FORMAT = "已抑制 {} 条重复日志";
             std::atomic<int> duplicate_filter_window_ms_; // 重复日志过滤时间窗口（毫秒）
-            std::unordered_map<std::string, long long> last_message_times_; // 记录每个消息最后出现的时间
-            mutable std::mutex duplicate_mutex_;
+            LogDuplicateFilter duplicate_filter_;         // 固定大小的重复日志抑制表
+            std::atomic<int64_t> last_duplicate_sweep_ms_{0};
+            std::vector<LogDuplicateFilter::Summary> sync_summaries_;   // 受 output_mutex_ 保护
+            std::vector<LogDuplicateFilter::Summary> writer_summaries_; // 仅由后台线程访问
         };
 
         
@@ -595,10 +1536,23 @@ namespace DearTs {
 } // namespace DearTs::Log
 
 // 为了向后兼容，保留少量必要的宏定义
+// 级别检查在宏内完成：低于编译期阈值的调用被剔除，低于运行期级别的调用不会构造消息。
+// 既可传入单个消息表达式，也可使用 "{}" 占位符延迟格式化：
+//   DEARTS_LOG_DEBUG("帧计数: " + std::to_string(n));   // 仅在 DEBUG 启用时才拼接
+//   DEARTS_LOG_DEBUG("帧计数: {}", n);                   // 仅在 DEBUG 启用时才格式化
 #define DEARTS_LOGGER() ::DearTs::Utils::getLogger()
-#define DEARTS_LOG_TRACE(msg) ::DearTs::Utils::getLogger().trace(msg, __FILE__, __LINE__)
-#define DEARTS_LOG_DEBUG(msg) ::DearTs::Utils::getLogger().debug(msg, __FILE__, __LINE__)
-#define DEARTS_LOG_INFO(msg)  ::DearTs::Utils::getLogger().info(msg, __FILE__, __LINE__)
-#define DEARTS_LOG_WARN(msg)  ::DearTs::Utils::getLogger().warn(msg, __FILE__, __LINE__)
-#define DEARTS_LOG_ERROR(msg) ::DearTs::Utils::getLogger().error(msg, __FILE__, __LINE__)
-#define DEARTS_LOG_FATAL(msg) ::DearTs::Utils::getLogger().fatal(msg, __FILE__, __LINE__)
\ No newline at end of file
+#define DEARTS_LOG_AT(level, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= DEARTS_LOG_ACTIVE_LEVEL) { \
+            auto& dearts_logger_ = ::DearTs::Utils::getLogger(); \
+            if (dearts_logger_.shouldLog(level)) { \
+                dearts_logger_.write(level, __FILE__, __LINE__, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+#define DEARTS_LOG_TRACE(...) DEARTS_LOG_AT(::DearTs::Utils::LogLevel::LOG_TRACE, __VA_ARGS__)
+#define DEARTS_LOG_DEBUG(...) DEARTS_LOG_AT(::DearTs::Utils::LogLevel::LOG_DEBUG, __VA_ARGS__)
+#define DEARTS_LOG_INFO(...)  DEARTS_LOG_AT(::DearTs::Utils::LogLevel::LOG_INFO, __VA_ARGS__)
+#define DEARTS_LOG_WARN(...)  DEARTS_LOG_AT(::DearTs::Utils::LogLevel::LOG_WARN, __VA_ARGS__)
+#define DEARTS_LOG_ERROR(...) DEARTS_LOG_AT(::DearTs::Utils::LogLevel::LOG_ERROR, __VA_ARGS__)
+#define DEARTS_LOG_FATAL(...) DEARTS_LOG_AT(::DearTs::Utils::LogLevel::LOG_FATAL, __VA_ARGS__)
@@ -0,0 +1,487 @@
+/**
+ * @file memory_tracker.cpp
+ * @brief 全局堆分配跟踪实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "memory_tracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <new>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <dbghelp.h>
+    #pragma comment(lib, "dbghelp.lib")
+    #define DEARTS_MEMORY_TRACKER_BACKTRACE 1
+#elif defined(__linux__) || defined(__APPLE__)
+    #include <execinfo.h>
+    #include <cxxabi.h>
+    #define DEARTS_MEMORY_TRACKER_BACKTRACE 1
+#else
+    #define DEARTS_MEMORY_TRACKER_BACKTRACE 0
+#endif
+
+namespace DearTs {
+namespace Core {
+namespace Utils {
+
+namespace {
+
+constexpr size_t SITE_SLOTS = 2048;        ///< 调用点表大小（2 的幂）
+constexpr size_t SITE_MAX_PROBE = 32;      ///< 调用点表最大探测次数
+constexpr int SITE_SKIP_FRAMES = 2;        ///< 跳过的栈帧（采样函数和 operator new 本身）
+
+/**
+ * @brief 单个子系统的计数（独占缓存行，避免不同子系统互相干扰）
+ */
+struct alignas(64) TagCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytesAllocated{0};
+    std::atomic<uint64_t> bytesFreed{0};
+};
+
+/**
+ * @brief 调用点表槽位
+ * @details hash 为 0 表示空槽；抢占到槽位的线程写完栈帧后置 ready
+ */
+struct SiteSlot {
+    std::atomic<uint64_t> hash{0};
+    std::atomic<uint32_t> ready{0};
+    uint32_t frameCount = 0;
+    void* frames[MemoryTracker::MAX_SITE_FRAMES] = {};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<int64_t> liveBytes{0};
+};
+
+// 以下均为常量初始化，静态构造之前的分配也能安全计数
+TagCounters g_tagCounters[MEMORY_TAG_COUNT];
+SiteSlot g_sites[SITE_SLOTS];
+std::atomic<uint32_t> g_sampleEvery{0};
+
+thread_local uint8_t t_tag = 0;
+// 仅在替换全局 operator new 时使用
+[[maybe_unused]] thread_local bool t_inHook = false;
+[[maybe_unused]] thread_local uint32_t t_sampleCountdown = 0;
+
+const char* const TAG_NAMES[MEMORY_TAG_COUNT] = {
+    "General",
+    "Clipboard",
+    "Fonts",
+    "TextSegmentation",
+    "Render",
+    "Logging",
+};
+
+uint64_t hashFrames(void* const* frames, uint32_t count) {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t i = 0; i < count; ++i) {
+        hash ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i]));
+        hash *= 1099511628211ull;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * @brief 记录一次采样到的调用点
+ * @return 槽位序号 + 1，表满时返回 0
+ */
+uint32_t recordSite(void* const* frames, uint32_t count, uint64_t size) {
+    const uint64_t hash = hashFrames(frames, count);
+    size_t index = static_cast<size_t>(hash) & (SITE_SLOTS - 1);
+    for (size_t probe = 0; probe < SITE_MAX_PROBE; ++probe) {
+        SiteSlot& slot = g_sites[index];
+        uint64_t current = slot.hash.load(std::memory_order_acquire);
+        if (current == 0 && slot.hash.compare_exchange_strong(current, hash, std::memory_order_acq_rel)) {
+            std::copy(frames, frames + count, slot.frames);
+            slot.frameCount = count;
+            slot.ready.store(1, std::memory_order_release);
+            current = hash;
+        }
+        if (current == hash) {
+            slot.allocations.fetch_add(1, std::memory_order_relaxed);
+            slot.bytes.fetch_add(size, std::memory_order_relaxed);
+            slot.liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+            return static_cast<uint32_t>(index + 1);
+        }
+        index = (index + 1) & (SITE_SLOTS - 1);
+    }
+    return 0;
+}
+
+#if DEARTS_MEMORY_TRACKER_BACKTRACE
+#if defined(_MSC_VER)
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+[[maybe_unused]] uint32_t captureSite(uint64_t size) {
+    void* frames[MemoryTracker::MAX_SITE_FRAMES + SITE_SKIP_FRAMES];
+#if defined(_WIN32)
+    const int captured = static_cast<int>(CaptureStackBackTrace(0, static_cast<DWORD>(std::size(frames)), frames, nullptr));
+#else
+    const int captured = backtrace(frames, static_cast<int>(std::size(frames)));
+#endif
+    if (captured <= SITE_SKIP_FRAMES) {
+        return 0;
+    }
+    return recordSite(frames + SITE_SKIP_FRAMES, static_cast<uint32_t>(captured - SITE_SKIP_FRAMES), size);
+}
+#else
+[[maybe_unused]] uint32_t captureSite(uint64_t) {
+    return 0;
+}
+#endif
+
+/**
+ * @brief 把栈帧地址转换为可读的符号名称
+ */
+std::vector<std::string> symbolize(void* const* frames, uint32_t count) {
+    std::vector<std::string> result;
+    result.reserve(count);
+#if defined(_WIN32)
+    static bool symbolsInitialized = false;
+    HANDLE process = GetCurrentProcess();
+    if (!symbolsInitialized) {
+        SymInitialize(process, nullptr, TRUE);
+        symbolsInitialized = true;
+    }
+    alignas(SYMBOL_INFO) char buffer[sizeof(SYMBOL_INFO) + 256];
+    for (uint32_t i = 0; i < count; ++i) {
+        auto* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+        symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        symbol->MaxNameLen = 255;
+        DWORD64 displacement = 0;
+        char line[320];
+        if (SymFromAddr(process, reinterpret_cast<DWORD64>(frames[i]), &displacement, symbol)) {
+            std::snprintf(line, sizeof(line), "%s+0x%llx", symbol->Name, static_cast<unsigned long long>(displacement));
+        } else {
+            std::snprintf(line, sizeof(line), "%p", frames[i]);
+        }
+        result.emplace_back(line);
+    }
+#elif DEARTS_MEMORY_TRACKER_BACKTRACE
+    char** symbols = backtrace_symbols(frames, static_cast<int>(count));
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string text = symbols ? symbols[i] : "";
+        // glibc 格式：module(mangled+offset) [address]
+        const size_t open = text.find('(');
+        const size_t plus = text.find('+', open == std::string::npos ? 0 : open);
+        if (open != std::string::npos && plus != std::string::npos && plus > open + 1) {
+            const std::string mangled = text.substr(open + 1, plus - open - 1);
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+            if (status == 0 && demangled) {
+                text = demangled + text.substr(plus);
+            }
+            std::free(demangled);
+        }
+        if (text.empty()) {
+            char address[32];
+            std::snprintf(address, sizeof(address), "%p", frames[i]);
+            text = address;
+        }
+        result.push_back(std::move(text));
+    }
+    std::free(symbols);
+#else
+    (void)frames;
+    (void)count;
+#endif
+    return result;
+}
+
+void appendCounters(std::string& out, const char* label, const AllocationCounters& counters) {
+    char line[256];
+    std::snprintf(line, sizeof(line), "  %-18s 存活 %12llu 字节  分配 %10llu 次  释放 %10llu 次  累计 %14llu 字节\n",
+                  label,
+                  static_cast<unsigned long long>(counters.liveBytes()),
+                  static_cast<unsigned long long>(counters.allocations),
+                  static_cast<unsigned long long>(counters.deallocations),
+                  static_cast<unsigned long long>(counters.bytesAllocated));
+    out += line;
+}
+
+} // namespace
+
+const char* memoryTagName(MemoryTag tag) {
+    const size_t index = static_cast<size_t>(tag);
+    return index < MEMORY_TAG_COUNT ? TAG_NAMES[index] : "Unknown";
+}
+
+AllocationCounters MemoryTracker::counters() noexcept {
+    AllocationCounters total;
+    for (size_t i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        const AllocationCounters tag = tagCounters(static_cast<MemoryTag>(i));
+        total.allocations += tag.allocations;
+        total.deallocations += tag.deallocations;
+        total.bytesAllocated += tag.bytesAllocated;
+        total.bytesFreed += tag.bytesFreed;
+    }
+    return total;
+}
+
+AllocationCounters MemoryTracker::tagCounters(MemoryTag tag) noexcept {
+    AllocationCounters result;
+    const size_t index = static_cast<size_t>(tag);
+    if (index >= MEMORY_TAG_COUNT) {
+        return result;
+    }
+    const TagCounters& counters = g_tagCounters[index];
+    result.allocations = counters.allocations.load(std::memory_order_relaxed);
+    result.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+    result.bytesAllocated = counters.bytesAllocated.load(std::memory_order_relaxed);
+    result.bytesFreed = counters.bytesFreed.load(std::memory_order_relaxed);
+    return result;
+}
+
+MemoryTag MemoryTracker::currentTag() noexcept {
+    return static_cast<MemoryTag>(t_tag);
+}
+
+MemoryTag MemoryTracker::exchangeTag(MemoryTag tag) noexcept {
+    const uint8_t previous = t_tag;
+    t_tag = static_cast<uint8_t>(tag);
+    return static_cast<MemoryTag>(previous);
+}
+
+void MemoryTracker::setCallSiteSampling(uint32_t everyN) noexcept {
+    g_sampleEvery.store(everyN, std::memory_order_relaxed);
+}
+
+uint32_t MemoryTracker::callSiteSampling() noexcept {
+    return g_sampleEvery.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::initializeFromEnvironment() {
+    const char* value = std::getenv("DEARTS_ALLOC_CALLSITES");
+    if (value && *value) {
+        const unsigned long everyN = std::strtoul(value, nullptr, 10);
+        setCallSiteSampling(static_cast<uint32_t>(everyN));
+    }
+}
+
+std::vector<AllocationSiteInfo> MemoryTracker::topCallSites(size_t limit, bool byLiveBytes) {
+    struct Candidate {
+        const SiteSlot* slot;
+        uint64_t bytes;
+        int64_t liveBytes;
+    };
+    std::vector<Candidate> candidates;
+    for (const SiteSlot& slot : g_sites) {
+        if (slot.ready.load(std::memory_order_acquire) == 0) {
+            continue;
+        }
+        candidates.push_back({&slot, slot.bytes.load(std::memory_order_relaxed),
+                              slot.liveBytes.load(std::memory_order_relaxed)});
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [byLiveBytes](const Candidate& a, const Candidate& b) {
+        return byLiveBytes ? a.liveBytes > b.liveBytes : a.bytes > b.bytes;
+    });
+    if (candidates.size() > limit) {
+        candidates.resize(limit);
+    }
+
+    std::vector<AllocationSiteInfo> result;
+    result.reserve(candidates.size());
+    for (const Candidate& candidate : candidates) {
+        AllocationSiteInfo info;
+        info.frames = symbolize(candidate.slot->frames, candidate.slot->frameCount);
+        info.allocations = candidate.slot->allocations.load(std::memory_order_relaxed);
+        info.bytes = candidate.bytes;
+        info.liveBytes = candidate.liveBytes;
+        result.push_back(std::move(info));
+    }
+    return result;
+}
+
+std::string MemoryTracker::report(size_t topSites) {
+    std::string out;
+    out += "=== DearTs 内存报告 ===\n";
+    if (!isEnabled()) {
+        out += "分配跟踪未编译（使用 -DDEARTS_TRACK_ALLOCATIONS=ON 重新构建）\n";
+        return out;
+    }
+
+    out += "总计:\n";
+    appendCounters(out, "All", counters());
+    out += "按子系统:\n";
+    for (size_t i = 0; i < MEMORY_TAG_COUNT; ++i) {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        appendCounters(out, memoryTagName(tag), tagCounters(tag));
+    }
+
+    const uint32_t sampling = callSiteSampling();
+    if (sampling == 0) {
+        out += "调用点采样未开启（设置环境变量 DEARTS_ALLOC_CALLSITES=N 每 N 次分配采样一次）\n";
+        return out;
+    }
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "调用点（每 %u 次分配采样一次，按存活字节排序）:\n", sampling);
+    out += line;
+    const auto sites = topCallSites(topSites, true);
+    for (size_t i = 0; i < sites.size(); ++i) {
+        const AllocationSiteInfo& site = sites[i];
+        std::snprintf(line, sizeof(line), "  #%zu 存活 %lld 字节  采样 %llu 次 / %llu 字节\n", i + 1,
+                      static_cast<long long>(site.liveBytes),
+                      static_cast<unsigned long long>(site.allocations),
+                      static_cast<unsigned long long>(site.bytes));
+        out += line;
+        for (const std::string& frame : site.frames) {
+            out += "      ";
+            out += frame;
+            out += '\n';
+        }
+    }
+    return out;
+}
+
+bool MemoryTracker::writeReport(const std::string& path, size_t topSites) {
+    std::error_code ec;
+    const std::filesystem::path outputPath(path);
+    if (outputPath.has_parent_path()) {
+        std::filesystem::create_directories(outputPath.parent_path(), ec);
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        return false;
+    }
+    const std::string text = report(topSites);
+    output.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return output.good();
+}
+
+} // namespace Utils
+} // namespace Core
+} // namespace DearTs
+
+#ifdef DEARTS_TRACK_ALLOCATIONS
+
+namespace {
+
+using DearTs::Core::Utils::MEMORY_TAG_COUNT;
+
+/**
+ * @brief 每块内存前的头部，保持 16 字节以维持 malloc 的对齐
+ */
+struct alignas(16) AllocationHeader {
+    uint64_t size;       ///< 请求大小
+    uint32_t site;       ///< 调用点槽位序号 + 1，0 表示未采样
+    uint8_t tag;         ///< 分配时的子系统标签
+    uint8_t reserved[3];
+};
+static_assert(sizeof(AllocationHeader) == 16, "AllocationHeader must keep malloc alignment");
+
+void* trackedAllocate(std::size_t size) noexcept {
+    using namespace DearTs::Core::Utils;
+
+    for (;;) {
+        if (void* block = std::malloc(sizeof(AllocationHeader) + size)) {
+            auto* header = static_cast<AllocationHeader*>(block);
+            header->size = size;
+            header->tag = t_tag < MEMORY_TAG_COUNT ? t_tag : 0;
+            header->site = 0;
+
+            TagCounters& counters = g_tagCounters[header->tag];
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            counters.bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+            // 调用点采样：每个线程每 N 次分配回溯一次调用栈，回溯期间的分配不再采样
+            const uint32_t every = g_sampleEvery.load(std::memory_order_relaxed);
+            if (every != 0 && !t_inHook) {
+                if (t_sampleCountdown == 0 || t_sampleCountdown > every) {
+                    t_sampleCountdown = every;
+                }
+                if (--t_sampleCountdown == 0) {
+                    t_inHook = true;
+                    header->site = captureSite(size);
+                    t_inHook = false;
+                }
+            }
+            return header + 1;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            return nullptr;
+        }
+        handler();
+    }
+}
+
+void trackedFree(void* ptr) noexcept {
+    using namespace DearTs::Core::Utils;
+
+    if (!ptr) {
+        return;
+    }
+    auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+    TagCounters& counters = g_tagCounters[header->tag];
+    counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytesFreed.fetch_add(header->size, std::memory_order_relaxed);
+    if (header->site != 0) {
+        g_sites[header->site - 1].liveBytes.fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+    }
+    std::free(header);
+}
+
+} // namespace
+
+// 对齐版本（align_val_t）保持标准库实现，不计入统计
+void* operator new(std::size_t size) {
+    if (void* ptr = trackedAllocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = trackedAllocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    trackedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    trackedFree(ptr);
+}
+
+#endif // DEARTS_TRACK_ALLOCATIONS
@@ -0,0 +1,188 @@
+/**
+ * @file memory_tracker.h
+ * @brief 全局堆分配跟踪与分子系统内存统计
+ * @details 定义 DEARTS_TRACK_ALLOCATIONS（CMake 选项，默认关闭）时替换全局 operator new/delete：
+ *          每块内存前附加 16 字节头部记录大小、子系统标签和调用点，
+ *          以 relaxed 原子计数统计总量和各子系统的分配次数、存活字节数。
+ *          调用点采样在运行时按需开启（栈回溯开销较大）。
+ *          未定义时所有计数恒为 0，DEARTS_MEMORY_TAG 宏展开为空。
+ *          本模块只依赖标准库和平台 API，可在无窗口环境下单独编译测试。
+ *          头部要求同一模块分配和释放，跨动态库（如插件 DLL）释放内存时不安全，仅建议在诊断构建中开启。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#ifndef DEARTS_MEMORY_TRACKER_H
+#define DEARTS_MEMORY_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Utils {
+
+/**
+ * @brief 内存子系统标签
+ */
+enum class MemoryTag : uint8_t {
+    GENERAL = 0,         ///< 未归类
+    CLIPBOARD,           ///< 剪切板管理器（历史记录、条目处理）
+    FONTS,               ///< 字体管理器
+    TEXT_SEGMENTATION,   ///< 分词与分词结果布局
+    RENDER,              ///< 渲染
+    LOGGING,             ///< 日志
+    COUNT
+};
+
+constexpr size_t MEMORY_TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+
+/**
+ * @brief 获取标签名称
+ */
+const char* memoryTagName(MemoryTag tag);
+
+/**
+ * @brief 分配计数快照
+ */
+struct AllocationCounters {
+    uint64_t allocations = 0;     ///< 累计分配次数
+    uint64_t deallocations = 0;   ///< 累计释放次数
+    uint64_t bytesAllocated = 0;  ///< 累计分配字节数（请求大小）
+    uint64_t bytesFreed = 0;      ///< 累计释放字节数
+
+    /**
+     * @brief 当前存活的字节数
+     */
+    uint64_t liveBytes() const {
+        return bytesAllocated >= bytesFreed ? bytesAllocated - bytesFreed : 0;
+    }
+};
+
+/**
+ * @brief 调用点统计
+ */
+struct AllocationSiteInfo {
+    std::vector<std::string> frames;  ///< 符号化后的调用栈（由内向外）
+    uint64_t allocations = 0;         ///< 采样到的分配次数
+    uint64_t bytes = 0;               ///< 采样到的分配字节数
+    int64_t liveBytes = 0;            ///< 采样到且尚未释放的字节数
+};
+
+/**
+ * @brief 堆分配跟踪器
+ */
+class MemoryTracker {
+public:
+    static constexpr size_t MAX_SITE_FRAMES = 8;   ///< 每个调用点记录的栈帧数
+
+    /**
+     * @brief 是否编译了分配钩子
+     */
+    static constexpr bool isEnabled() {
+#ifdef DEARTS_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 读取全局计数快照
+     */
+    static AllocationCounters counters() noexcept;
+
+    /**
+     * @brief 读取指定子系统的计数快照
+     */
+    static AllocationCounters tagCounters(MemoryTag tag) noexcept;
+
+    /**
+     * @brief 调用线程当前的子系统标签
+     */
+    static MemoryTag currentTag() noexcept;
+
+    /**
+     * @brief 设置调用线程的子系统标签
+     * @return 之前的标签
+     */
+    static MemoryTag exchangeTag(MemoryTag tag) noexcept;
+
+    /**
+     * @brief 设置调用点采样间隔
+     * @param everyN 每个线程每 N 次分配采样一次调用栈，0 表示关闭
+     */
+    static void setCallSiteSampling(uint32_t everyN) noexcept;
+
+    /**
+     * @brief 当前调用点采样间隔，0 表示关闭
+     */
+    static uint32_t callSiteSampling() noexcept;
+
+    /**
+     * @brief 读取环境变量 DEARTS_ALLOC_CALLSITES（采样间隔）开启调用点采样
+     */
+    static void initializeFromEnvironment();
+
+    /**
+     * @brief 获取排名靠前的调用点
+     * @param limit 最多返回的数量
+     * @param byLiveBytes 为 true 时按存活字节排序，否则按累计分配字节排序
+     */
+    static std::vector<AllocationSiteInfo> topCallSites(size_t limit, bool byLiveBytes = true);
+
+    /**
+     * @brief 生成文本格式的内存报告（总量、各子系统、调用点）
+     * @param topSites 报告中列出的调用点数量
+     */
+    static std::string report(size_t topSites = 20);
+
+    /**
+     * @brief 把内存报告写入文件
+     * @param path 输出路径（父目录不存在时自动创建）
+     * @return 是否成功
+     */
+    static bool writeReport(const std::string& path, size_t topSites = 20);
+};
+
+/**
+ * @brief RAII 子系统标签作用域
+ * @details 作用域内调用线程的分配计入指定子系统，释放时按分配时的标签扣减
+ */
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) noexcept
+        : m_previous(MemoryTracker::exchangeTag(tag)) {}
+
+    ~MemoryTagScope() {
+        MemoryTracker::exchangeTag(m_previous);
+    }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+    MemoryTag m_previous;
+};
+
+} // namespace Utils
+} // namespace Core
+} // namespace DearTs
+
+// 便利宏定义
+#define DEARTS_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define DEARTS_MEMORY_TAG_CONCAT(a, b) DEARTS_MEMORY_TAG_CONCAT_INNER(a, b)
+
+#ifdef DEARTS_TRACK_ALLOCATIONS
+    #define DEARTS_MEMORY_TAG(tag) \
+        ::DearTs::Core::Utils::MemoryTagScope DEARTS_MEMORY_TAG_CONCAT(dearts_memory_tag_, __LINE__)( \
+            ::DearTs::Core::Utils::MemoryTag::tag)
+#else
+    #define DEARTS_MEMORY_TAG(tag) ((void)0)
+#endif
+
+#endif // DEARTS_MEMORY_TRACKER_H
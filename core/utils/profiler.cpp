@@ -1,42 +1,300 @@
 /**
  * @file profiler.cpp
- * @brief 简化的性能分析器实现
+ * @brief 分层作用域性能分析器实现
  * @author DearTs Team
  * @date 2024
  */
 
 #include "profiler.h"
-#include <iostream>
+#include "logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 
 namespace DearTs {
 namespace Core {
 namespace Utils {
 
+namespace {
+
+/**
+ * @brief 线程局部的缓冲区句柄，线程退出时标记缓冲区可回收
+ */
+struct ThreadBufferHandle {
+    std::shared_ptr<ProfileThreadBuffer> buffer;
+
+    ~ThreadBufferHandle() {
+        if (buffer) {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadBufferHandle t_bufferHandle;
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text ? text : ""; *p; ++p) {
+        const char c = *p;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
 Profiler& Profiler::getInstance() {
     static Profiler instance;
     return instance;
 }
 
+Profiler::~Profiler() = default;
+
 void Profiler::initialize() {
-    // 初始化性能分析器
+    const char* output = std::getenv("DEARTS_PROFILE_OUTPUT");
+    if (output && *output && !isRecording()) {
+        beginSession("DearTs", output);
+        m_autoSession = true;
+    }
+    setThreadName("Main");
 }
 
 void Profiler::shutdown() {
-    // 清理性能分析器资源
+    endSession();
+    m_autoSession = false;
 }
 
-void Profiler::beginSession(const std::string& name) {
-    // 开始性能分析会话
+void Profiler::beginSession(const std::string& name, const std::string& filepath) {
+    if (isRecording()) {
+        endSession();
+    }
+
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+    m_sessionName = name;
+    m_outputPath = filepath.empty() ? "profiles/" + name + ".json" : filepath;
+    m_startTime = std::chrono::steady_clock::now();
+    m_startTicks = now();
+
+    // 先切换会话编号，线程在新会话中第一次记录时清空自己的缓冲区
+    m_session.fetch_add(1, std::memory_order_acq_rel);
+    m_flags.fetch_or(FLAG_RECORDING, std::memory_order_release);
+
+    DEARTS_LOG_INFO("性能分析会话开始: {} -> {}", m_sessionName, m_outputPath);
 }
 
 void Profiler::endSession() {
-    // 结束性能分析会话
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+    if ((m_flags.fetch_and(~FLAG_RECORDING, std::memory_order_acq_rel) & FLAG_RECORDING) == 0) {
+        return;
+    }
+
+    // 用 steady_clock 校准时间戳频率
+    const uint64_t endTicks = now();
+    const double elapsedUs = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - m_startTime).count();
+#if DEARTS_PROFILER_USE_RDTSC
+    const double ticksPerMicrosecond = elapsedUs > 0.0 ? static_cast<double>(endTicks - m_startTicks) / elapsedUs : 1.0;
+#else
+    (void)endTicks;
+    (void)elapsedUs;
+    const double ticksPerMicrosecond = 1000.0;
+#endif
+
+    writeTrace(ticksPerMicrosecond > 0.0 ? ticksPerMicrosecond : 1.0);
+
+    // 回收已退出线程的缓冲区
+    std::lock_guard<std::mutex> registryLock(m_registryMutex);
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+        [](const std::shared_ptr<ProfileThreadBuffer>& buffer) {
+            return buffer->retired.load(std::memory_order_acquire);
+        }), m_buffers.end());
 }
 
 void Profiler::writeProfile(const char* name) {
-    // 写入性能分析数据
+    if (!isRecording()) {
+        return;
+    }
+    const uint64_t timestamp = now();
+    ProfileThreadBuffer& buffer = threadBuffer();
+    if (buffer.session == currentSession()) {
+        buffer.push({name, timestamp, timestamp, ProfileEvent::INSTANT});
+    }
+}
+
+void Profiler::setLiveStatsEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(m_sessionMutex);
+    if (enabled) {
+        if ((m_flags.load(std::memory_order_relaxed) & FLAG_LIVE_STATS) == 0) {
+            m_liveStartTime = std::chrono::steady_clock::now();
+            m_liveStartTicks = now();
+            // 丢弃上次开启时残留的汇总
+            ProfileThreadBuffer& buffer = threadBuffer();
+            std::fill(std::begin(buffer.zoneTotals), std::end(buffer.zoneTotals), ProfileZoneTotal{});
+        }
+        m_flags.fetch_or(FLAG_LIVE_STATS, std::memory_order_release);
+    } else {
+        m_flags.fetch_and(~FLAG_LIVE_STATS, std::memory_order_release);
+    }
+}
+
+void Profiler::collectLiveStats(std::vector<ProfileZoneTotal>& out, std::vector<double>& outMilliseconds) {
+    out.clear();
+    outMilliseconds.clear();
+
+    ProfileThreadBuffer& buffer = threadBuffer();
+    for (ProfileZoneTotal& total : buffer.zoneTotals) {
+        if (total.name && total.calls > 0) {
+            out.push_back(total);
+        }
+        total = ProfileZoneTotal{};
+    }
+
+    std::sort(out.begin(), out.end(), [](const ProfileZoneTotal& a, const ProfileZoneTotal& b) {
+        return a.ticks > b.ticks;
+    });
+
+    const double ticksPerMs = liveTicksPerMillisecond();
+    outMilliseconds.reserve(out.size());
+    for (const ProfileZoneTotal& total : out) {
+        outMilliseconds.push_back(static_cast<double>(total.ticks) / ticksPerMs);
+    }
+}
+
+double Profiler::liveTicksPerMillisecond() const {
+#if DEARTS_PROFILER_USE_RDTSC
+    // 以开启实时统计以来的 steady_clock 时长校准 rdtsc 频率，开启初期误差较大但很快收敛
+    const double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - m_liveStartTime).count();
+    const uint64_t ticks = now() - m_liveStartTicks;
+    if (elapsedMs > 1.0 && ticks > 0) {
+        return static_cast<double>(ticks) / elapsedMs;
+    }
+    return 1.0e6;
+#else
+    return 1.0e6;
+#endif
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ProfileThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    buffer.threadName = name;
+}
+
+ProfileThreadBuffer& Profiler::threadBuffer() {
+    if (!t_bufferHandle.buffer) {
+        auto buffer = std::make_shared<ProfileThreadBuffer>();
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        buffer->threadId = m_nextThreadId++;
+        m_buffers.push_back(buffer);
+        t_bufferHandle.buffer = std::move(buffer);
+    }
+
+    ProfileThreadBuffer& buffer = *t_bufferHandle.buffer;
+    const uint64_t session = m_session.load(std::memory_order_acquire);
+    if (buffer.session != session && isRecording()) {
+        // 事件数组在线程第一次参与记录时分配
+        if (!buffer.events) {
+            buffer.events = std::make_unique<ProfileEvent[]>(ProfileThreadBuffer::CAPACITY);
+        }
+        buffer.count.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+        buffer.session = session;
+    }
+    return buffer;
+}
+
+void Profiler::writeTrace(double ticksPerMicrosecond) {
+    std::error_code ec;
+    const std::filesystem::path outputPath(m_outputPath);
+    if (outputPath.has_parent_path()) {
+        std::filesystem::create_directories(outputPath.parent_path(), ec);
+    }
+
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        DEARTS_LOG_ERROR("无法写入性能分析文件: {}", m_outputPath);
+        return;
+    }
+
+    const uint64_t session = m_session.load(std::memory_order_acquire);
+    std::string text;
+    text.reserve(1 << 20);
+    text += "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"session\":";
+    appendJsonString(text, m_sessionName.c_str());
+    text += "},\"traceEvents\":[";
+
+    bool first = true;
+    auto beginEvent = [&text, &first]() {
+        text += first ? "\n" : ",\n";
+        first = false;
+    };
+    auto toMicroseconds = [this, ticksPerMicrosecond](uint64_t ticks) {
+        return static_cast<double>(static_cast<int64_t>(ticks - m_startTicks)) / ticksPerMicrosecond;
+    };
+
+    size_t eventCount = 0;
+    uint64_t droppedCount = 0;
+    char number[128];
+
+    std::lock_guard<std::mutex> lock(m_registryMutex);
+    for (const auto& buffer : m_buffers) {
+        if (buffer->session != session) {
+            continue;
+        }
+
+        if (!buffer->threadName.empty()) {
+            beginEvent();
+            std::snprintf(number, sizeof(number), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                          buffer->threadId);
+            text += number;
+            appendJsonString(text, buffer->threadName.c_str());
+            text += "}}";
+        }
+
+        const size_t count = buffer->count.load(std::memory_order_acquire);
+        droppedCount += buffer->dropped.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            const ProfileEvent& event = buffer->events[i];
+            beginEvent();
+            text += "{\"name\":";
+            appendJsonString(text, event.name);
+            if (event.depth == ProfileEvent::INSTANT) {
+                std::snprintf(number, sizeof(number), ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                              toMicroseconds(event.start), buffer->threadId);
+            } else {
+                std::snprintf(number, sizeof(number),
+                              ",\"cat\":\"dearts\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"depth\":%u}}",
+                              toMicroseconds(event.start),
+                              static_cast<double>(event.end - event.start) / ticksPerMicrosecond,
+                              buffer->threadId, event.depth);
+            }
+            text += number;
+            ++eventCount;
+
+            if (text.size() >= (1 << 20)) {
+                output.write(text.data(), static_cast<std::streamsize>(text.size()));
+                text.clear();
+            }
+        }
+    }
+    text += "\n]}\n";
+    output.write(text.data(), static_cast<std::streamsize>(text.size()));
+
+    DEARTS_LOG_INFO("性能分析会话结束: {} 个事件已写入 {}（丢弃 {} 个）", eventCount, m_outputPath, droppedCount);
 }
 
 } // namespace Utils
 } // namespace Core
-} // namespace DearTs
\ No newline at end of file
+} // namespace DearTs
@@ -1,6 +1,10 @@
 /**
  * @file profiler.h
- * @brief 简化的性能分析器
+ * @brief 分层作用域性能分析器
+ * @details 通过 RAII 作用域区间（zone）记录耗时，每个线程写入自己的缓冲区，
+ *          支持嵌套和多线程；会话结束时导出 Chrome trace-event JSON，
+ *          可直接在 chrome://tracing 或 Perfetto 中打开。
+ *          未定义 DEARTS_ENABLE_PROFILING 时所有 DEARTS_PROFILE_* 宏展开为空。
  * @author DearTs Team
  * @date 2024
  */
@@ -11,11 +15,23 @@
 #define DEARTS_PROFILER_H
 
 // 直接包含必要的标准库头文件以避免预编译头文件问题
+#include <atomic>
 #include <chrono>
-#include <string>
-#include <unordered_map>
+#include <cstdint>
 #include <memory>
-#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define DEARTS_PROFILER_USE_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define DEARTS_PROFILER_USE_RDTSC 1
+#else
+    #define DEARTS_PROFILER_USE_RDTSC 0
+#endif
 
 namespace DearTs {
 namespace Core {
@@ -30,7 +46,7 @@ public:
      * @brief 构造函数，开始计时
      */
     SimpleTimer() : start_time_(std::chrono::high_resolution_clock::now()) {}
-    
+
     /**
      * @brief 获取经过的时间（毫秒）
      * @return 经过的时间
@@ -40,41 +56,260 @@ public:
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time_);
         return duration.count() / 1000.0;
     }
-    
+
     /**
      * @brief 重置计时器
      */
     void reset() {
         start_time_ = std::chrono::high_resolution_clock::now();
     }
-    
+
 private:
     std::chrono::high_resolution_clock::time_point start_time_;
 };
 
 /**
- * @brief 简化的性能分析器
+ * @brief 一条性能事件
+ */
+struct ProfileEvent {
+    static constexpr uint32_t INSTANT = UINT32_MAX;  ///< depth 取该值表示瞬时标记
+
+    const char* name;   ///< 区间名称（静态存储期）
+    uint64_t start;     ///< 开始时间（时钟周期）
+    uint64_t end;       ///< 结束时间（时钟周期）
+    uint32_t depth;     ///< 嵌套深度
+};
+
+/**
+ * @brief 区间耗时汇总（实时统计用）
+ */
+struct ProfileZoneTotal {
+    const char* name = nullptr;  ///< 区间名称
+    uint64_t ticks = 0;          ///< 累计耗时（时钟周期）
+    uint32_t calls = 0;          ///< 调用次数
+    uint32_t depth = 0;          ///< 最近一次调用的嵌套深度
+};
+
+/**
+ * @brief 单个线程的事件缓冲区
+ * @details 只有所属线程追加事件；导出线程在会话停止后读取 count 之前的事件
+ */
+struct ProfileThreadBuffer {
+    static constexpr size_t CAPACITY = size_t{1} << 16;
+    static constexpr size_t ZONE_TOTAL_SLOTS = 64;  ///< 实时统计表大小（2 的幂）
+
+    uint32_t threadId = 0;                       ///< 导出时使用的线程编号
+    std::string threadName;                      ///< 线程名称（受 Profiler 注册表锁保护）
+    std::unique_ptr<ProfileEvent[]> events;      ///< 固定容量的事件数组
+    std::atomic<size_t> count{0};                ///< 已提交的事件数
+    std::atomic<uint64_t> dropped{0};            ///< 缓冲区写满后丢弃的事件数
+    std::atomic<bool> retired{false};            ///< 所属线程已退出
+    uint64_t session = 0;                        ///< 事件所属的会话编号
+    uint32_t depth = 0;                          ///< 当前嵌套深度
+    ProfileZoneTotal zoneTotals[ZONE_TOTAL_SLOTS]; ///< 实时统计表（仅所属线程读写）
+
+    /**
+     * @brief 追加一条事件（仅所属线程调用）
+     */
+    void push(const ProfileEvent& event) noexcept {
+        const size_t index = count.load(std::memory_order_relaxed);
+        if (index >= CAPACITY || !events) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[index] = event;
+        count.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 累加一次区间耗时到实时统计表（按名称指针开放寻址，表满时忽略）
+     */
+    void accumulate(const char* name, uint64_t ticks, uint32_t zoneDepth) noexcept {
+        size_t slot = (reinterpret_cast<uintptr_t>(name) >> 3) & (ZONE_TOTAL_SLOTS - 1);
+        for (size_t probe = 0; probe < ZONE_TOTAL_SLOTS; ++probe) {
+            ProfileZoneTotal& total = zoneTotals[slot];
+            if (total.name == name || total.name == nullptr) {
+                total.name = name;
+                total.ticks += ticks;
+                total.calls += 1;
+                total.depth = zoneDepth;
+                return;
+            }
+            slot = (slot + 1) & (ZONE_TOTAL_SLOTS - 1);
+        }
+    }
+};
+
+/**
+ * @brief 性能分析器
+ * @details 会话期间记录所有线程的作用域区间，endSession() 时写出 Chrome trace JSON。
+ *          未在会话中且未开启实时统计时 ProfileZone 只做一次原子读取。
  */
 class Profiler {
 public:
     static Profiler& getInstance();
 
+    /**
+     * @brief 初始化性能分析器
+     * @details 设置了环境变量 DEARTS_PROFILE_OUTPUT 时立即开始会话并在 shutdown() 时写入该文件
+     */
     void initialize();
+
+    /**
+     * @brief 关闭性能分析器，结束进行中的会话
+     */
     void shutdown();
 
-    // 性能分析相关方法
-    void beginSession(const std::string& name);
+    /**
+     * @brief 开始性能分析会话
+     * @param name 会话名称
+     * @param filepath 输出文件路径，为空时使用 profiles/<name>.json
+     */
+    void beginSession(const std::string& name, const std::string& filepath = "");
+
+    /**
+     * @brief 结束会话并写出 Chrome trace JSON
+     */
     void endSession();
+
+    /**
+     * @brief 写入一个瞬时标记（如帧边界）
+     * @param name 标记名称（静态存储期）
+     */
     void writeProfile(const char* name);
 
+    /**
+     * @brief 设置调用线程在 trace 中显示的名称
+     * @param name 线程名称
+     */
+    void setThreadName(const std::string& name);
+
+    static constexpr uint32_t FLAG_RECORDING = 1u;   ///< 会话记录中
+    static constexpr uint32_t FLAG_LIVE_STATS = 2u;  ///< 实时区间统计开启
+
+    /**
+     * @brief 是否正在记录
+     */
+    bool isRecording() const noexcept {
+        return (m_flags.load(std::memory_order_relaxed) & FLAG_RECORDING) != 0;
+    }
+
+    /**
+     * @brief 当前启用的功能标志（FLAG_RECORDING / FLAG_LIVE_STATS），为 0 时区间不做任何记录
+     */
+    uint32_t activeFlags() const noexcept {
+        return m_flags.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 开启或关闭实时区间统计（供性能浮层使用）
+     * @details 开启后每个区间结束时把耗时累加到所属线程的统计表，与会话记录相互独立
+     */
+    void setLiveStatsEnabled(bool enabled);
+
+    /**
+     * @brief 取出调用线程自上次调用以来的区间耗时汇总并清空统计表
+     * @param out 输出：按耗时降序排列的汇总
+     * @param outMilliseconds 输出：与 out 一一对应的累计耗时（毫秒）
+     */
+    void collectLiveStats(std::vector<ProfileZoneTotal>& out, std::vector<double>& outMilliseconds);
+
+    /**
+     * @brief 当前会话编号
+     */
+    uint64_t currentSession() const noexcept {
+        return m_session.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取调用线程的事件缓冲区（首次调用时注册，新会话时清空）
+     */
+    ProfileThreadBuffer& threadBuffer();
+
+    /**
+     * @brief 读取时间戳
+     * @details x86 上使用 rdtsc（会话结束时按 steady_clock 校准），其他平台使用 steady_clock 纳秒
+     */
+    static uint64_t now() noexcept {
+#if DEARTS_PROFILER_USE_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
 private:
     Profiler() = default;
-    ~Profiler() = default;
+    ~Profiler();
     Profiler(const Profiler&) = delete;
     Profiler& operator=(const Profiler&) = delete;
 
-    std::ofstream m_outputStream;
-    int m_profileCount = 0;
+    void writeTrace(double ticksPerMicrosecond);
+    double liveTicksPerMillisecond() const;
+
+    std::atomic<uint32_t> m_flags{0};
+    std::atomic<uint64_t> m_session{0};
+
+    std::mutex m_sessionMutex;                   ///< 串行化 begin/endSession
+    std::string m_sessionName;
+    std::string m_outputPath;
+    bool m_autoSession = false;                  ///< 会话由环境变量开启
+    uint64_t m_startTicks = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+    uint64_t m_liveStartTicks = 0;               ///< 实时统计开启时的时间戳（用于换算毫秒）
+    std::chrono::steady_clock::time_point m_liveStartTime;
+
+    std::mutex m_registryMutex;                  ///< 保护线程缓冲区列表和线程名称
+    std::vector<std::shared_ptr<ProfileThreadBuffer>> m_buffers;
+    uint32_t m_nextThreadId = 1;
+};
+
+/**
+ * @brief RAII 作用域区间
+ * @details 构造时记录开始时间，析构时把完整区间写入当前线程的缓冲区
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) noexcept {
+        Profiler& profiler = Profiler::getInstance();
+        m_flags = profiler.activeFlags();
+        if (m_flags == 0) {
+            return;
+        }
+        m_buffer = &profiler.threadBuffer();
+        m_session = m_buffer->session;
+        m_name = name;
+        m_depth = m_buffer->depth++;
+        m_start = Profiler::now();
+    }
+
+    ~ProfileZone() {
+        if (!m_buffer) {
+            return;
+        }
+        const uint64_t end = Profiler::now();
+        --m_buffer->depth;
+        // 跨越会话边界的区间不记录
+        if ((m_flags & Profiler::FLAG_RECORDING) && m_buffer->session == m_session &&
+            Profiler::getInstance().isRecording()) {
+            m_buffer->push({m_name, m_start, end, m_depth});
+        }
+        if (m_flags & Profiler::FLAG_LIVE_STATS) {
+            m_buffer->accumulate(m_name, end - m_start, m_depth);
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    ProfileThreadBuffer* m_buffer = nullptr;
+    const char* m_name = nullptr;
+    uint64_t m_start = 0;
+    uint64_t m_session = 0;
+    uint32_t m_depth = 0;
+    uint32_t m_flags = 0;
 };
 
 } // namespace Utils
@@ -82,16 +317,28 @@ private:
 } // namespace DearTs
 
 // 便利宏定义
-#ifdef DEARTS_DEBUG
+#define DEARTS_PROFILE_CONCAT_INNER(a, b) a##b
+#define DEARTS_PROFILE_CONCAT(a, b) DEARTS_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef DEARTS_ENABLE_PROFILING
+    #define DEARTS_PROFILE_ZONE(name) \
+        ::DearTs::Core::Utils::ProfileZone DEARTS_PROFILE_CONCAT(dearts_profile_zone_, __LINE__)(name)
+    #define DEARTS_PROFILE_SCOPE(name) DEARTS_PROFILE_ZONE(name)
+    #define DEARTS_PROFILE_FUNCTION() DEARTS_PROFILE_ZONE(__FUNCTION__)
+    #define DEARTS_PROFILE_THREAD(name) DearTs::Core::Utils::Profiler::getInstance().setThreadName(name)
     #define DEARTS_PROFILE_TIMER(name) DearTs::Core::Utils::SimpleTimer timer_##name
     #define DEARTS_PROFILE_START(name) DearTs::Core::Utils::Profiler::getInstance().beginSession(name)
     #define DEARTS_PROFILE_END(name) DearTs::Core::Utils::Profiler::getInstance().endSession()
     #define DEARTS_PROFILE_FRAME(time) DearTs::Core::Utils::Profiler::getInstance().writeProfile(#time)
 #else
+    #define DEARTS_PROFILE_ZONE(name) ((void)0)
+    #define DEARTS_PROFILE_SCOPE(name) ((void)0)
+    #define DEARTS_PROFILE_FUNCTION() ((void)0)
+    #define DEARTS_PROFILE_THREAD(name) ((void)0)
     #define DEARTS_PROFILE_TIMER(name)
     #define DEARTS_PROFILE_START(name)
     #define DEARTS_PROFILE_END(name)
     #define DEARTS_PROFILE_FRAME(time)
 #endif
 
-#endif // DEARTS_PROFILER_H
\ No newline at end of file
+#endif // DEARTS_PROFILER_H
@@ -1120,12 +1120,12 @@ uint64_t StringUtils::murmur3Hash(const std::string& str) {
     uint64_t k1 = 0;
     
     switch (len & 7) {
-        case 7: k1 ^= static_cast<uint64_t>(tail[6]) << 48;
-        case 6: k1 ^= static_cast<uint64_t>(tail[5]) << 40;
-        case 5: k1 ^= static_cast<uint64_t>(tail[4]) << 32;
-        case 4: k1 ^= static_cast<uint64_t>(tail[3]) << 24;
-        case 3: k1 ^= static_cast<uint64_t>(tail[2]) << 16;
-        case 2: k1 ^= static_cast<uint64_t>(tail[1]) << 8;
+        case 7: k1 ^= static_cast<uint64_t>(tail[6]) << 48; [[fallthrough]];
+        case 6: k1 ^= static_cast<uint64_t>(tail[5]) << 40; [[fallthrough]];
+        case 5: k1 ^= static_cast<uint64_t>(tail[4]) << 32; [[fallthrough]];
+        case 4: k1 ^= static_cast<uint64_t>(tail[3]) << 24; [[fallthrough]];
+        case 3: k1 ^= static_cast<uint64_t>(tail[2]) << 16; [[fallthrough]];
+        case 2: k1 ^= static_cast<uint64_t>(tail[1]) << 8; [[fallthrough]];
         case 1: k1 ^= static_cast<uint64_t>(tail[0]);
                 k1 *= c1;
                 k1 = (k1 << 31) | (k1 >> 33);
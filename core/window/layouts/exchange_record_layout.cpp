@@ -13,6 +13,8 @@
 #include "../utils/logger.h"
 #include "../utils/file_utils.h"
 #include "../window_manager.h"
+#include "../../app/frame_scheduler.h"
+#include "../../events/event_queue.h"
 
 namespace DearTs {
 namespace Core {
@@ -29,28 +31,34 @@ ExchangeRecordLayout::ExchangeRecordLayout()
     , manualGamePath_()
     , searchResults_()
     , autoSearchCompleted_(false)
-    , showManualInput_(false)
-    , isSearching_(false)
-    , currentProgress_(0) {
+    , showManualInput_(false) {
 
     DEARTS_LOG_INFO("ExchangeRecordLayout构造函数");
 
     // 加载保存的配置
     loadConfiguration();
+
+    // 工作线程投递的进度只在搜索期间写入界面
+    searchProgressSubscription_ = Events::EventSystem::getInstance()->getDispatcher().subscribeScoped(
+        Events::EventType::EVT_SEARCH_PROGRESS, [this](const Events::Event& event) {
+            const auto& progress = static_cast<const SearchProgressEvent&>(event);
+            if (progress.getSource() == this && isSearching_) {
+                updateSearchProgress(progress.getPhase(), progress.getProgress());
+            }
+            return false;
+        });
 }
 
 /**
  * @brief 析构函数
  */
 ExchangeRecordLayout::~ExchangeRecordLayout() {
-    // 确保异步搜索任务被正确停止
-    if (isSearching_.load()) {
+    // 后台工作捕获了 this：销毁搜索协程时取消其正在等待的后台工作并等待结束，协程不再恢复
+    if (searchTask_.isRunning()) {
         DEARTS_LOG_INFO("等待异步搜索任务完成...");
-        if (searchFuture_.valid()) {
-            searchFuture_.wait();
-        }
-        isSearching_.store(false);
     }
+    searchTask_.reset();
+    isSearching_ = false;
 }
 
 /**
@@ -151,8 +159,11 @@ void ExchangeRecordLayout::renderInFixedArea(float contentX, float contentY, flo
 void ExchangeRecordLayout::updateLayout(float width, float height) {
     setSize(width, height);
 
-    // 检查异步搜索是否完成
-    checkSearchCompletion();
+    // 搜索期间定时重绘以刷新进度动画，搜索协程在主线程恢复并处理结果
+    if (isSearching_) {
+        App::FrameScheduler::getInstance().requestRedrawIn(std::chrono::milliseconds(SEARCH_PROGRESS_REDRAW_MS));
+        invalidateLayout();
+    }
 }
 
 /**
@@ -798,11 +809,10 @@ void ExchangeRecordLayout::renderStatusArea() {
     ImGui::PopStyleColor();
 
     // 如果正在搜索，显示进度条
-    if (isSearching_.load()) {
+    if (isSearching_) {
         ImGui::Separator();
-        std::lock_guard<std::mutex> lock(searchMutex_);
         ImGui::Text("搜索进度: %s", currentSearchPhase_.c_str());
-        ImGui::ProgressBar(currentProgress_ / 100.0f, ImVec2(0, 0));
+        ImGui::ProgressBar(static_cast<float>(currentProgress_) / 100.0f, ImVec2(0, 0));
     }
 
     // 如果找到URL，显示URL
@@ -1198,7 +1208,7 @@ void ExchangeRecordLayout::refreshUrlFromSavedPath() {
         return;
     }
 
-    if (isSearching_.load()) {
+    if (isSearching_) {
         DEARTS_LOG_WARN("搜索已在进行中，跳过重复请求");
         return;
     }
@@ -1212,35 +1222,11 @@ void ExchangeRecordLayout::refreshUrlFromSavedPath() {
     // 更新状态为搜索中
     updateStatus("正在从保存路径重新搜索最新URL: " + manualGamePath_, ExchangeRecordState::SEARCHING);
 
-    // 异步执行路径验证和URL搜索
-    isSearching_.store(true);
-    updateSearchProgress("验证保存的游戏路径...", 10);
-
-    // 启动异步搜索任务
-    searchFuture_ = std::async(std::launch::async, [this, savedPath = manualGamePath_]() -> SearchResult {
-        try {
-            updateSearchProgress("验证游戏路径...", 20);
-            SearchResult result = checkGamePath(std::filesystem::path(savedPath));
-
-            if (result.found && !result.url.empty()) {
-                updateSearchProgress("成功找到URL!", 100);
-                DEARTS_LOG_INFO("异步路径验证成功找到URL: " + result.url);
-            } else if (result.found) {
-                updateSearchProgress("路径验证成功，但未找到URL", 90);
-                DEARTS_LOG_INFO("异步路径验证成功但未找到URL: " + result.message);
-            } else {
-                updateSearchProgress("路径验证失败", 50);
-                DEARTS_LOG_WARN("异步路径验证失败: " + result.message);
-            }
-
-            return result;
-        } catch (const std::exception& e) {
-            DEARTS_LOG_ERROR("异步路径验证过程中发生异常: " + std::string(e.what()));
-            SearchResult errorResult;
-            errorResult.message = "路径验证过程中发生错误: " + std::string(e.what());
-            return errorResult;
-        }
-    });
+    // 启动搜索协程：路径验证在工作线程执行，失败时在同一协程内转为自动搜索
+    isSearching_ = true;
+    invalidateLayout();
+    searchTask_ = runSearch(manualGamePath_);
+    searchTask_.start();
 
     DEARTS_LOG_INFO("异步路径验证任务已启动");
 }
@@ -1249,214 +1235,202 @@ void ExchangeRecordLayout::refreshUrlFromSavedPath() {
  * @brief 异步执行自动搜索
  */
 void ExchangeRecordLayout::performAutoSearchAsync() {
-    if (isSearching_.load()) {
+    if (isSearching_) {
         DEARTS_LOG_WARN("搜索已在进行中，跳过重复请求");
         return;
     }
 
-    isSearching_.store(true);
-    updateSearchProgress("启动搜索...", 0);
-
-    // 启动异步搜索任务
-    searchFuture_ = std::async(std::launch::async, [this]() -> SearchResult {
-        return autoSearchGamePathAsync();
-    });
+    isSearching_ = true;
+    invalidateLayout();
+    searchTask_ = runSearch(std::string());
+    searchTask_.start();
 
     DEARTS_LOG_INFO("异步搜索任务已启动");
 }
 
 /**
- * @brief 异步搜索主函数（在后台线程执行）
+ * @brief 搜索协程
  */
-SearchResult ExchangeRecordLayout::autoSearchGamePathAsync() {
-    SearchResult result;
-    DEARTS_LOG_INFO("开始异步自动搜索鸣潮游戏路径");
-
+App::Task<void> ExchangeRecordLayout::runSearch(std::string savedPath) {
     try {
-        // 1. 首先尝试MUI Cache搜索（最有效的方法）
-        updateSearchProgress("搜索MUI Cache...", 20);
-        auto muiCachePaths = searchGamePathFromMuiCache();
-        DEARTS_LOG_INFO("MUI Cache搜索找到 " + std::to_string(muiCachePaths.size()) + " 个路径");
-
-        for (size_t i = 0; i < muiCachePaths.size(); ++i) {
-            updateSearchProgress("检查MUI Cache路径 " + std::to_string(i + 1) + "/" + std::to_string(muiCachePaths.size()), 25);
-            DEARTS_LOG_INFO("检查MUI Cache路径 " + std::to_string(i + 1) + "/" + std::to_string(muiCachePaths.size()) + ": " + muiCachePaths[i]);
-            result = checkGamePath(std::filesystem::path(muiCachePaths[i]));
-            if (result.found && !result.url.empty()) {
-                DEARTS_LOG_INFO("MUI Cache路径成功找到URL: " + result.url);
-                return result;
-            }
-            if (result.found) {
-                std::lock_guard<std::mutex> lock(searchMutex_);
-                searchResults_.push_back(result);
-            }
-        }
-
-        // 2. 然后尝试Firewall规则搜索
-        updateSearchProgress("搜索防火墙规则...", 50);
-        auto firewallPaths = searchGamePathFromFirewall();
-        DEARTS_LOG_INFO("防火墙规则搜索找到 " + std::to_string(firewallPaths.size()) + " 个路径");
-
-        for (size_t i = 0; i < firewallPaths.size(); ++i) {
-            updateSearchProgress("检查防火墙路径 " + std::to_string(i + 1) + "/" + std::to_string(firewallPaths.size()), 55);
-            DEARTS_LOG_INFO("检查防火墙路径 " + std::to_string(i + 1) + "/" + std::to_string(firewallPaths.size()) + ": " + firewallPaths[i]);
-            result = checkGamePath(std::filesystem::path(firewallPaths[i]));
-            if (result.found && !result.url.empty()) {
-                DEARTS_LOG_INFO("防火墙路径成功找到URL: " + result.url);
-                return result;
-            }
-            if (result.found) {
-                std::lock_guard<std::mutex> lock(searchMutex_);
-                searchResults_.push_back(result);
-            }
-        }
+        SearchResult result;
 
-        // 3. 然后通过注册表搜索
-        updateSearchProgress("搜索注册表...", 75);
-        auto registryPaths = searchGamePathFromRegistry();
-        DEARTS_LOG_INFO("注册表搜索找到 " + std::to_string(registryPaths.size()) + " 个路径");
-
-        for (size_t i = 0; i < registryPaths.size(); ++i) {
-            updateSearchProgress("检查注册表路径 " + std::to_string(i + 1) + "/" + std::to_string(registryPaths.size()), 80);
-            DEARTS_LOG_INFO("检查注册表路径 " + std::to_string(i + 1) + "/" + std::to_string(registryPaths.size()) + ": " + registryPaths[i]);
-            result = checkGamePath(std::filesystem::path(registryPaths[i]));
-            if (result.found && !result.url.empty()) {
-                DEARTS_LOG_INFO("注册表路径成功找到URL: " + result.url);
-                return result;
-            }
-            if (result.found) {
-                std::lock_guard<std::mutex> lock(searchMutex_);
-                searchResults_.push_back(result);
-            }
-        }
-
-        // 4. 最后检查常见安装位置
-        updateSearchProgress("检查常见安装位置...", 90);
-        auto commonPaths = checkCommonInstallPaths();
-        DEARTS_LOG_INFO("常见安装位置找到 " + std::to_string(commonPaths.size()) + " 个路径");
+        if (!savedPath.empty()) {
+            updateSearchProgress("验证游戏路径...", 20);
+            result = co_await App::runInBackground([this, savedPath]() {
+                return checkGamePath(std::filesystem::path(savedPath));
+            });
 
-        for (size_t i = 0; i < commonPaths.size(); ++i) {
-            updateSearchProgress("检查常见路径 " + std::to_string(i + 1) + "/" + std::to_string(commonPaths.size()), 95);
-            DEARTS_LOG_INFO("检查常见路径 " + std::to_string(i + 1) + "/" + std::to_string(commonPaths.size()) + ": " + commonPaths[i]);
-            result = checkGamePath(std::filesystem::path(commonPaths[i]));
             if (result.found && !result.url.empty()) {
-                DEARTS_LOG_INFO("常见路径成功找到URL: " + result.url);
-                return result;
-            }
-            if (result.found) {
-                std::lock_guard<std::mutex> lock(searchMutex_);
-                searchResults_.push_back(result);
+                updateSearchProgress("成功找到URL!", 100);
+                DEARTS_LOG_INFO("异步路径验证成功找到URL: " + result.url);
+            } else if (result.found) {
+                updateSearchProgress("路径验证成功，但未找到URL", 90);
+                DEARTS_LOG_INFO("异步路径验证成功但未找到URL: " + result.message);
+            } else {
+                updateSearchProgress("路径验证失败", 50);
+                DEARTS_LOG_WARN("异步路径验证失败: " + result.message);
+                DEARTS_LOG_INFO("保存的路径验证失败，启动自动搜索");
             }
         }
 
-        // 返回最后一个结果（如果有的话）
-        {
-            std::lock_guard<std::mutex> lock(searchMutex_);
-            if (!searchResults_.empty()) {
-                DEARTS_LOG_INFO("所有搜索完成，返回最后一个搜索结果: " + searchResults_.back().message);
-                return searchResults_.back();
-            }
+        if (!result.found) {
+            result = co_await runAutoSearch();
         }
 
-        DEARTS_LOG_ERROR("所有搜索方法都未找到鸣潮游戏安装目录");
-        result.message = "无法找到鸣潮游戏安装目录";
-        return result;
-
+        onSearchCompleted(result);
     } catch (const std::exception& e) {
-        DEARTS_LOG_ERROR("异步搜索过程中发生异常: " + std::string(e.what()));
-        result.message = "搜索过程中发生错误: " + std::string(e.what());
-        return result;
+        onSearchFailed(e.what());
     }
 }
 
 /**
- * @brief 检查异步搜索是否完成并更新结果
+ * @brief 自动搜索协程
  */
-void ExchangeRecordLayout::checkSearchCompletion() {
-    if (!isSearching_.load()) {
-        return;
-    }
+App::Task<SearchResult> ExchangeRecordLayout::runAutoSearch() {
+    /**
+     * @brief 候选路径来源，按查找效果排序
+     */
+    struct PathSource {
+        const char* name;                                        ///< 来源名称（日志）
+        const char* searchingPhase;                              ///< 枚举阶段描述
+        const char* checkingPhase;                               ///< 验证阶段描述前缀
+        int searchingProgress;                                   ///< 枚举阶段进度
+        int checkingProgress;                                    ///< 验证阶段进度
+        std::vector<std::string> (ExchangeRecordLayout::*find)(); ///< 枚举候选路径
+    };
+    static const PathSource sources[] = {
+        {"MUI Cache", "搜索MUI Cache...", "检查MUI Cache路径 ", 20, 25, &ExchangeRecordLayout::searchGamePathFromMuiCache},
+        {"防火墙规则", "搜索防火墙规则...", "检查防火墙路径 ", 50, 55, &ExchangeRecordLayout::searchGamePathFromFirewall},
+        {"注册表", "搜索注册表...", "检查注册表路径 ", 75, 80, &ExchangeRecordLayout::searchGamePathFromRegistry},
+        {"常见安装位置", "检查常见安装位置...", "检查常见路径 ", 90, 95, &ExchangeRecordLayout::checkCommonInstallPaths},
+    };
 
-    // 检查异步任务是否完成
-    if (searchFuture_.valid() && searchFuture_.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
-        try {
-            SearchResult result = searchFuture_.get();
+    DEARTS_LOG_INFO("开始异步自动搜索鸣潮游戏路径");
 
-            // 处理搜索结果
-            if (result.found && !result.url.empty()) {
-                foundUrl_ = result.url;
-                // 如果路径验证成功且是自动搜索，保存路径
-                if (result.path.empty() && !manualGamePath_.empty()) {
-                    result.path = manualGamePath_;
-                }
-                if (!result.path.empty()) {
-                    manualGamePath_ = result.path; // 保存找到的路径
-                }
-                showManualInput_ = true;
-                updateStatus("成功找到抽卡记录URL！", ExchangeRecordState::FOUND_URL);
-                copyUrlToClipboard();
-                DEARTS_LOG_INFO("异步搜索成功找到URL: " + result.url);
-            } else if (result.found) {
-                // 如果路径验证成功且是自动搜索，保存路径
-                if (result.path.empty() && !manualGamePath_.empty()) {
-                    result.path = manualGamePath_;
-                }
-                if (!result.path.empty()) {
-                    manualGamePath_ = result.path; // 保存找到的路径
-                }
-                showManualInput_ = true;
-                updateStatus("游戏路径有效，但未找到抽卡记录URL。请确保已打开游戏内的抽卡记录页面。", ExchangeRecordState::FOUND_LOG);
-                DEARTS_LOG_INFO("异步搜索找到路径但未找到URL: " + result.message);
-            } else {
-                // 路径验证失败，如果是路径验证，启动自动搜索
-                if (statusMessage_.find("正在从保存路径重新搜索") != std::string::npos) {
-                    DEARTS_LOG_INFO("保存的路径验证失败，启动自动搜索");
-                    performAutoSearchAsync();
-                    // 不重置搜索状态，让自动搜索继续
-                    return;
-                } else {
-                    updateStatus("未能自动找到游戏安装路径，请手动选择游戏安装目录。", ExchangeRecordState::SEARCH_ERROR);
-                    showManualInput_ = true;
-                    DEARTS_LOG_WARN("异步搜索未找到有效路径: " + result.message);
+    for (const PathSource& source : sources) {
+        updateSearchProgress(source.searchingPhase, source.searchingProgress);
+        // 枚举和逐个验证都在工作线程进行，找到 URL 即停止；每个路径的进度投递为延迟事件，
+        // 协程只在整个来源处理完后回到主线程一次
+        std::vector<SearchResult> found = co_await App::runInBackground([this, &source](App::TaskContext& context) {
+            std::vector<SearchResult> results;
+            std::vector<std::string> paths = (this->*source.find)();
+            DEARTS_LOG_INFO(std::string(source.name) + "搜索找到 " + std::to_string(paths.size()) + " 个路径");
+
+            for (size_t i = 0; i < paths.size() && !context.isCancelled(); ++i) {
+                const std::string counter = std::to_string(i + 1) + "/" + std::to_string(paths.size());
+                postSearchProgress(source.checkingPhase + counter, source.checkingProgress);
+                DEARTS_LOG_INFO(source.checkingPhase + counter + ": " + paths[i]);
+
+                SearchResult result = checkGamePath(std::filesystem::path(paths[i]));
+                if (result.found) {
+                    results.push_back(std::move(result));
+                    if (!results.back().url.empty()) {
+                        break;
+                    }
                 }
             }
+            return results;
+        });
 
-            // 添加最终搜索结果
-            {
-                std::lock_guard<std::mutex> lock(searchMutex_);
-                searchResults_.push_back(result);
+        for (SearchResult& result : found) {
+            if (!result.url.empty()) {
+                DEARTS_LOG_INFO(std::string(source.name) + "路径成功找到URL: " + result.url);
+                co_return result;
             }
-            autoSearchCompleted_ = true;
+            searchResults_.push_back(result);
+        }
+    }
 
-            // 保存配置
-            saveConfiguration();
+    // 返回最后一个结果（如果有的话）
+    if (!searchResults_.empty()) {
+        DEARTS_LOG_INFO("所有搜索完成，返回最后一个搜索结果: " + searchResults_.back().message);
+        co_return searchResults_.back();
+    }
 
-        } catch (const std::exception& e) {
-            DEARTS_LOG_ERROR("获取异步搜索结果时发生异常: " + std::string(e.what()));
-            updateStatus("搜索过程中发生错误，请手动选择游戏路径。", ExchangeRecordState::SEARCH_ERROR);
-            showManualInput_ = true;
-        }
+    DEARTS_LOG_ERROR("所有搜索方法都未找到鸣潮游戏安装目录");
+    SearchResult result;
+    result.message = "无法找到鸣潮游戏安装目录";
+    co_return result;
+}
 
-        // 重置搜索状态
-        isSearching_.store(false);
-        currentSearchPhase_.clear();
-        currentProgress_ = 0;
+/**
+ * @brief 处理搜索结果（搜索协程结束时在主线程执行）
+ */
+void ExchangeRecordLayout::onSearchCompleted(SearchResult& result) {
+    // 处理搜索结果
+    if (result.found && !result.url.empty()) {
+        foundUrl_ = result.url;
+        // 如果路径验证成功且是自动搜索，保存路径
+        if (result.path.empty() && !manualGamePath_.empty()) {
+            result.path = manualGamePath_;
+        }
+        if (!result.path.empty()) {
+            manualGamePath_ = result.path; // 保存找到的路径
+        }
+        showManualInput_ = true;
+        updateStatus("成功找到抽卡记录URL！", ExchangeRecordState::FOUND_URL);
+        copyUrlToClipboard();
+        DEARTS_LOG_INFO("异步搜索成功找到URL: " + result.url);
+    } else if (result.found) {
+        // 如果路径验证成功且是自动搜索，保存路径
+        if (result.path.empty() && !manualGamePath_.empty()) {
+            result.path = manualGamePath_;
+        }
+        if (!result.path.empty()) {
+            manualGamePath_ = result.path; // 保存找到的路径
+        }
+        showManualInput_ = true;
+        updateStatus("游戏路径有效，但未找到抽卡记录URL。请确保已打开游戏内的抽卡记录页面。", ExchangeRecordState::FOUND_LOG);
+        DEARTS_LOG_INFO("异步搜索找到路径但未找到URL: " + result.message);
+    } else {
+        updateStatus("未能自动找到游戏安装路径，请手动选择游戏安装目录。", ExchangeRecordState::SEARCH_ERROR);
+        showManualInput_ = true;
+        DEARTS_LOG_WARN("异步搜索未找到有效路径: " + result.message);
     }
+
+    // 添加最终搜索结果
+    searchResults_.push_back(result);
+    autoSearchCompleted_ = true;
+
+    // 保存配置
+    saveConfiguration();
+
+    // 重置搜索状态
+    isSearching_ = false;
+}
+
+/**
+ * @brief 搜索过程抛出异常（在主线程执行）
+ */
+void ExchangeRecordLayout::onSearchFailed(const std::string& error) {
+    DEARTS_LOG_ERROR("异步搜索过程中发生异常: " + error);
+    updateStatus("搜索过程中发生错误，请手动选择游戏路径。", ExchangeRecordState::SEARCH_ERROR);
+    showManualInput_ = true;
+    isSearching_ = false;
 }
 
 /**
  * @brief 更新搜索进度
  */
 void ExchangeRecordLayout::updateSearchProgress(const std::string& phase, int progress) {
-    std::lock_guard<std::mutex> lock(searchMutex_);
+    // 搜索协程在主线程恢复，直接写入界面读取的进度
     currentSearchPhase_ = phase;
     currentProgress_ = progress;
 
     // 更新状态消息以显示进度
-    std::string progressMsg = "正在搜索: " + phase + " (" + std::to_string(progress) + "%)";
-    statusMessage_ = progressMsg;
+    statusMessage_ = "正在搜索: " + phase + " (" + std::to_string(progress) + "%)";
+
+    DEARTS_LOG_DEBUG("搜索进度更新: {}", statusMessage_);
+}
 
-    DEARTS_LOG_DEBUG("搜索进度更新: " + progressMsg);
+/**
+ * @brief 从工作线程投递搜索进度
+ */
+void ExchangeRecordLayout::postSearchProgress(const std::string& phase, int progress) const {
+    // 以布局地址为合并键，同一帧内的多条进度只分发最后一条
+    Events::EventSystem::getInstance()->getQueue().emplaceWithKey<SearchProgressEvent>(
+        reinterpret_cast<uintptr_t>(this), this, phase, progress);
 }
 
 } // namespace Window
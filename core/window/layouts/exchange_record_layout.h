@@ -10,9 +10,9 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
-#include <future>
 #include <imgui.h>
 #include "../../utils/config_manager.h"
+#include "../../app/coroutine_task.h"
 
 namespace DearTs {
 namespace Core {
@@ -40,6 +40,29 @@ struct SearchResult {
     SearchResult() : found(false) {}
 };
 
+/**
+ * @brief 搜索进度事件
+ * 工作线程验证候选路径时投递到 EventSystem 的延迟队列，同一布局的进度在一帧内只分发最新的一条
+ */
+class SearchProgressEvent : public Events::Event {
+public:
+    SearchProgressEvent(const void* source, std::string phase, int progress)
+        : Event(Events::EventType::EVT_SEARCH_PROGRESS)
+        , source_(source)
+        , phase_(std::move(phase))
+        , progress_(progress) {}
+
+    const char* getName() const override { return "SearchProgress"; }
+    const void* getSource() const { return source_; }
+    const std::string& getPhase() const { return phase_; }
+    int getProgress() const { return progress_; }
+
+private:
+    const void* source_;    ///< 投递进度的布局（只用于比较）
+    std::string phase_;     ///< 搜索阶段描述
+    int progress_;          ///< 进度百分比
+};
+
 /**
  * @brief 鸣潮换取记录布局类
  * 用于提取鸣潮游戏的抽卡记录URL
@@ -156,12 +179,13 @@ private:
     bool autoSearchCompleted_;               ///< 自动搜索是否完成
     bool showManualInput_;                   ///< 是否显示手动输入框
 
-    // 异步搜索相关
-    std::atomic<bool> isSearching_{false};   ///< 是否正在搜索
-    std::future<SearchResult> searchFuture_; ///< 异步搜索结果
-    std::mutex searchMutex_;                 ///< 搜索结果保护锁
+    // 异步搜索相关（搜索协程在主线程恢复，以下状态只在主线程读写）
+    static constexpr int SEARCH_PROGRESS_REDRAW_MS = 100; ///< 搜索期间刷新进度的重绘间隔（毫秒）
+    bool isSearching_ = false;               ///< 是否正在搜索
     std::string currentSearchPhase_;         ///< 当前搜索阶段描述
-    int currentProgress_ = 0;                ///< 当前搜索进度
+    int currentProgress_ = 0;                ///< 当前搜索进度百分比
+    App::Task<void> searchTask_;             ///< 搜索协程（析构时销毁，等待中的后台工作随之取消并等待结束）
+    Events::ScopedSubscription searchProgressSubscription_; ///< 工作线程投递的搜索进度事件
 
     /**
      * @brief 自动搜索游戏路径
@@ -261,22 +285,43 @@ private:
     void performAutoSearchAsync();
 
     /**
-     * @brief 异步搜索主函数（在后台线程执行）
+     * @brief 搜索协程：先验证保存的路径，失败时转为自动搜索，最后在主线程处理结果
+     * @param savedPath 保存的游戏路径，为空时直接自动搜索
+     */
+    App::Task<void> runSearch(std::string savedPath);
+
+    /**
+     * @brief 自动搜索协程：依次枚举各来源的候选路径并逐个验证
+     * 每个来源的枚举和验证在一次工作线程任务中完成，逐个路径的进度经延迟事件队列投递
      * @return 搜索结果
      */
-    SearchResult autoSearchGamePathAsync();
+    App::Task<SearchResult> runAutoSearch();
 
     /**
-     * @brief 检查异步搜索是否完成并更新结果
+     * @brief 处理搜索结果（在主线程执行）
+     * @param result 搜索结果
      */
-    void checkSearchCompletion();
+    void onSearchCompleted(SearchResult& result);
 
     /**
-     * @brief 更新搜索进度
+     * @brief 搜索过程抛出异常（在主线程执行）
+     * @param error 异常描述
+     */
+    void onSearchFailed(const std::string& error);
+
+    /**
+     * @brief 更新搜索进度（在主线程调用）
      * @param phase 搜索阶段描述
      * @param progress 进度百分比
      */
     void updateSearchProgress(const std::string& phase, int progress);
+
+    /**
+     * @brief 从工作线程投递搜索进度，主循环下一次分发延迟事件时写入界面
+     * @param phase 搜索阶段描述
+     * @param progress 进度百分比
+     */
+    void postSearchProgress(const std::string& phase, int progress) const;
 };
 
 } // namespace Window
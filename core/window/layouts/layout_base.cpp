@@ -1,4 +1,5 @@
 #include "layout_base.h"
+#include "layout_registry.h"
 #include "../window_base.h"
 
 namespace DearTs {
@@ -15,7 +16,133 @@ LayoutBase::LayoutBase(const std::string& name)
     , x_(0.0f)
     , y_(0.0f)
     , width_(0.0f)
-    , height_(0.0f) {
+    , height_(0.0f)
+    , renderCacheEnabled_(false)
+    , visibleEventsSubscribed_(false)
+    , layoutInvalid_(true)
+    , updatingLayout_(false)
+    , registry_(nullptr)
+    , registrySlot_(0) {
+}
+
+/**
+ * 设置父窗口
+ */
+void LayoutBase::setParentWindow(WindowBase* window) {
+    if (parentWindow_ == window) {
+        return;
+    }
+    // 旧窗口上的订阅先取消
+    visibleSubscriptions_.clear();
+    visibleEventsSubscribed_ = false;
+    parentWindow_ = window;
+    updateVisibleSubscriptions();
+}
+
+/**
+ * 设置是否可见
+ */
+void LayoutBase::setVisible(bool visible) {
+    // 隐藏期间不更新，重新显示时需要按当前尺寸重新计算
+    if (visible && !visible_) {
+        invalidateLayout();
+    }
+    visible_ = visible;
+    if (registry_) {
+        registry_->syncFlag(registrySlot_, LayoutRegistry::FLAG_VISIBLE, visible);
+    }
+    updateVisibleSubscriptions();
+}
+
+/**
+ * 设置布局位置
+ */
+void LayoutBase::setPosition(float x, float y) {
+    if (x_ != x || y_ != y) {
+        x_ = x;
+        y_ = y;
+        if (registry_) {
+            registry_->touchBounds();
+        }
+        if (!updatingLayout_) {
+            invalidateLayout();
+        }
+    }
+}
+
+/**
+ * 设置布局大小
+ */
+void LayoutBase::setSize(float width, float height) {
+    if (width_ != width || height_ != height) {
+        width_ = width;
+        height_ = height;
+        if (registry_) {
+            registry_->touchBounds();
+        }
+        if (!updatingLayout_) {
+            invalidateLayout();
+        }
+    }
+}
+
+/**
+ * 使布局失效
+ */
+void LayoutBase::invalidateLayout() {
+    if (layoutInvalid_) {
+        return;
+    }
+    layoutInvalid_ = true;
+    if (registry_) {
+        registry_->syncFlag(registrySlot_, LayoutRegistry::FLAG_NEEDS_UPDATE, true);
+    }
+}
+
+/**
+ * 清除失效标记并更新布局
+ */
+void LayoutBase::refreshLayout(float width, float height) {
+    // 先清除再调用，updateLayout() 中再次调用 invalidateLayout() 会保留到下一帧
+    layoutInvalid_ = false;
+    if (registry_) {
+        registry_->syncFlag(registrySlot_, LayoutRegistry::FLAG_NEEDS_UPDATE, false);
+    }
+    // 子类可能在 updateLayout() 中直接写入位置和大小，比较前后的值通知注册表
+    const float oldX = x_;
+    const float oldY = y_;
+    const float oldWidth = width_;
+    const float oldHeight = height_;
+    updatingLayout_ = true;
+    updateLayout(width, height);
+    updatingLayout_ = false;
+    if (registry_ && (x_ != oldX || y_ != oldY || width_ != oldWidth || height_ != oldHeight)) {
+        registry_->touchBounds();
+    }
+}
+
+/**
+ * 订阅显示期间的事件
+ */
+void LayoutBase::subscribeWhileVisible(Events::EventType type, Events::EventHandler handler) {
+    if (!parentWindow_) {
+        return;
+    }
+    visibleSubscriptions_.push_back(parentWindow_->getEventDispatcher().subscribeScoped(type, std::move(handler)));
+}
+
+/**
+ * 按可见性更新订阅
+ */
+void LayoutBase::updateVisibleSubscriptions() {
+    const bool wanted = visible_ && parentWindow_;
+    if (wanted && !visibleEventsSubscribed_) {
+        visibleEventsSubscribed_ = true;
+        subscribeVisibleEvents();
+    } else if (!wanted && visibleEventsSubscribed_) {
+        visibleEventsSubscribed_ = false;
+        visibleSubscriptions_.clear();
+    }
 }
 
 } // namespace Window
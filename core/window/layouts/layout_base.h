@@ -1,8 +1,11 @@
 #pragma once
 
+#include "../../events/event_system.h"
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <SDL.h>
 
 // Forward declarations
@@ -10,6 +13,7 @@ namespace DearTs {
 namespace Core {
 namespace Window {
     class WindowBase;
+    class LayoutRegistry;
 }
 }
 }
@@ -62,6 +66,10 @@ public:
      * @param contentHeight 内容区域高度
      */
     virtual void renderInFixedArea(float contentX, float contentY, float contentWidth, float contentHeight) {
+        (void)contentX;
+        (void)contentY;
+        (void)contentWidth;
+        (void)contentHeight;
         // 默认行为：调用原始render方法
         render();
     }
@@ -74,7 +82,7 @@ public:
     /**
      * @brief 设置父窗口
      */
-    void setParentWindow(WindowBase* window) { parentWindow_ = window; }
+    void setParentWindow(WindowBase* window);
     
     /**
      * @brief 获取父窗口
@@ -83,8 +91,9 @@ public:
     
     /**
      * @brief 设置是否可见
+     * 显示时调用 subscribeVisibleEvents()，隐藏时取消其中的订阅
      */
-    void setVisible(bool visible) { visible_ = visible; }
+    void setVisible(bool visible);
     
     /**
      * @brief 检查是否可见
@@ -92,14 +101,31 @@ public:
     bool isVisible() const { return visible_; }
     
     /**
-     * @brief 设置布局位置
+     * @brief 设置布局位置，位置变化时使布局失效
      */
-    void setPosition(float x, float y) { x_ = x; y_ = y; }
+    void setPosition(float x, float y);
     
     /**
-     * @brief 设置布局大小
+     * @brief 设置布局大小，大小变化时使布局失效
      */
-    void setSize(float width, float height) { width_ = width; height_ = height; }
+    void setSize(float width, float height);
+
+    /**
+     * @brief 使布局失效，LayoutManager 在下一次 updateAll() 时调用 updateLayout()
+     * 内容变化时调用；在 updateLayout() 中调用表示下一帧仍需更新（动画、计时等）
+     */
+    void invalidateLayout();
+
+    /**
+     * @brief 布局是否已失效
+     */
+    bool isLayoutInvalid() const { return layoutInvalid_; }
+
+    /**
+     * @brief 清除失效标记并调用 updateLayout()
+     * 期间布局自己设置的位置和大小是计算结果，不再使布局失效
+     */
+    void refreshLayout(float width, float height);
     
     /**
      * @brief 获取布局X坐标
@@ -121,7 +147,53 @@ public:
      */
     float getHeight() const { return height_; }
 
+    /**
+     * @brief 检查窗口坐标是否落在布局内，LayoutManager 只把鼠标事件分发给命中的布局
+     * 尚未设置大小的布局视为覆盖整个窗口
+     */
+    virtual bool hitTest(float x, float y) const {
+        if (width_ <= 0.0f || height_ <= 0.0f) {
+            return true;
+        }
+        return x >= x_ && x < x_ + width_ && y >= y_ && y < y_ + height_;
+    }
+
+    /**
+     * @brief 设置是否使用离屏渲染缓存
+     * 只对系统布局生效，且布局需要通过 getRenderCacheWindowName() 提供绘制所用的 ImGui 窗口名称
+     */
+    void setRenderCacheEnabled(bool enabled) { renderCacheEnabled_ = enabled; }
+
+    /**
+     * @brief 检查是否使用离屏渲染缓存
+     */
+    bool isRenderCacheEnabled() const { return renderCacheEnabled_; }
+
+    /**
+     * @brief 获取布局绘制所用的 ImGui 窗口名称（缓存捕获该窗口及其子窗口），默认不支持缓存
+     */
+    virtual const char* getRenderCacheWindowName() const { return nullptr; }
+
+    /**
+     * @brief 当前内容是否可以缓存
+     * 动画、弹出窗口等每帧变化或需要额外窗口的状态下应返回false
+     */
+    virtual bool isRenderCacheable() const { return true; }
+
 protected:
+    /**
+     * @brief 布局可见且有父窗口时调用，在这里用 subscribeWhileVisible() 订阅只在显示期间需要的事件
+     * 布局隐藏、更换父窗口或销毁时这些订阅自动取消，再次显示时重新调用
+     */
+    virtual void subscribeVisibleEvents() {}
+
+    /**
+     * @brief 在父窗口的事件调度器上订阅事件，订阅随布局隐藏自动取消
+     * @param type 事件类型
+     * @param handler 事件处理器
+     */
+    void subscribeWhileVisible(Events::EventType type, Events::EventHandler handler);
+
     std::string name_;              ///< 布局名称
     WindowBase* parentWindow_;      ///< 父窗口
     bool visible_;                  ///< 是否可见
@@ -129,6 +201,22 @@ protected:
     float y_;                       ///< Y坐标
     float width_;                   ///< 宽度
     float height_;                  ///< 高度
+    bool renderCacheEnabled_;       ///< 是否使用离屏渲染缓存
+
+private:
+    /**
+     * @brief 按可见性和父窗口订阅或取消显示期间的事件
+     */
+    void updateVisibleSubscriptions();
+
+    friend class LayoutRegistry;
+
+    std::vector<Events::ScopedSubscription> visibleSubscriptions_;  ///< 显示期间的订阅
+    bool visibleEventsSubscribed_;  ///< 是否已调用 subscribeVisibleEvents()
+    bool layoutInvalid_;            ///< 是否需要调用 updateLayout()
+    bool updatingLayout_;           ///< 是否正在 refreshLayout() 中
+    LayoutRegistry* registry_;      ///< 所在的布局注册表（未注册时为空），可见性和失效标记变化时同步到注册表
+    uint32_t registrySlot_;         ///< 在注册表中的槽位
 };
 
 } // namespace Window
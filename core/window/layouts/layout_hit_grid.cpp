@@ -0,0 +1,126 @@
+#include "layout_hit_grid.h"
+#include "layout_base.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+void LayoutHitGrid::clear() {
+    cellOffsets_.assign(GRID_SIZE * GRID_SIZE + 1, 0);
+    cellEntries_.clear();
+    unbounded_.clear();
+    originX_ = originY_ = endX_ = endY_ = 0.0f;
+    inverseCellWidth_ = inverseCellHeight_ = 0.0f;
+    boundedCount_ = 0;
+}
+
+void LayoutHitGrid::rebuild(const LayoutRegistry& registry, const std::vector<LayoutHandle>& order) {
+    clear();
+    scratchBounds_.clear();
+    scratchOrder_.clear();
+
+    // 收集可见布局的矩形，同时求出网格覆盖的范围
+    float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        const LayoutHandle handle = order[i];
+        if (!registry.hasFlags(handle, LayoutRegistry::FLAG_VISIBLE)) {
+            continue;
+        }
+        const LayoutBase* layout = registry.get(handle);
+        const float width = layout->getWidth();
+        const float height = layout->getHeight();
+        if (width <= 0.0f || height <= 0.0f) {
+            unbounded_.push_back(i);
+            continue;
+        }
+        const float x0 = layout->getX();
+        const float y0 = layout->getY();
+        const float x1 = x0 + width;
+        const float y1 = y0 + height;
+        if (scratchOrder_.empty()) {
+            minX = x0; minY = y0; maxX = x1; maxY = y1;
+        } else {
+            minX = std::min(minX, x0); minY = std::min(minY, y0);
+            maxX = std::max(maxX, x1); maxY = std::max(maxY, y1);
+        }
+        scratchOrder_.push_back(i);
+        scratchBounds_.insert(scratchBounds_.end(), {x0, y0, x1, y1});
+    }
+    boundedCount_ = scratchOrder_.size();
+    if (scratchOrder_.empty()) {
+        return;
+    }
+
+    originX_ = minX;
+    originY_ = minY;
+    endX_ = maxX;
+    endY_ = maxY;
+    inverseCellWidth_ = static_cast<float>(GRID_SIZE) / (maxX - minX);
+    inverseCellHeight_ = static_cast<float>(GRID_SIZE) / (maxY - minY);
+
+    // 两遍填充：先统计每个单元的数量，再按分发顺序写入，单元内的下标保持升序
+    auto forEachCell = [&](size_t bounded, auto&& visit) {
+        const float* bounds = &scratchBounds_[bounded * 4];
+        const uint32_t column0 = cellColumn(bounds[0]);
+        const uint32_t row0 = cellRow(bounds[1]);
+        const uint32_t column1 = cellColumn(bounds[2]);
+        const uint32_t row1 = cellRow(bounds[3]);
+        for (uint32_t row = row0; row <= row1; ++row) {
+            for (uint32_t column = column0; column <= column1; ++column) {
+                visit(row * GRID_SIZE + column);
+            }
+        }
+    };
+
+    std::vector<uint32_t>& counts = cellOffsets_;
+    for (size_t b = 0; b < scratchOrder_.size(); ++b) {
+        forEachCell(b, [&](uint32_t cell) { ++counts[cell + 1]; });
+    }
+    // 未设置大小的布局出现在每个单元中
+    for (uint32_t cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell) {
+        counts[cell + 1] += static_cast<uint32_t>(unbounded_.size());
+    }
+    for (uint32_t cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell) {
+        cellOffsets_[cell + 1] += cellOffsets_[cell];
+    }
+
+    cellEntries_.resize(cellOffsets_.back());
+    std::vector<uint32_t> cursor(cellOffsets_.begin(), cellOffsets_.end() - 1);
+    size_t nextUnbounded = 0;
+    for (size_t b = 0; b <= scratchOrder_.size(); ++b) {
+        // 按分发顺序合并有界布局和未设置大小的布局
+        const uint32_t index = b < scratchOrder_.size() ? scratchOrder_[b] : UINT32_MAX;
+        for (; nextUnbounded < unbounded_.size() && unbounded_[nextUnbounded] < index; ++nextUnbounded) {
+            for (uint32_t cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell) {
+                cellEntries_[cursor[cell]++] = unbounded_[nextUnbounded];
+            }
+        }
+        if (b < scratchOrder_.size()) {
+            forEachCell(b, [&](uint32_t cell) { cellEntries_[cursor[cell]++] = index; });
+        }
+    }
+}
+
+LayoutHitGrid::Candidates LayoutHitGrid::query(float x, float y) const {
+    if (boundedCount_ == 0 || x < originX_ || y < originY_ || x >= endX_ || y >= endY_) {
+        return {unbounded_.data(), unbounded_.data() + unbounded_.size()};
+    }
+    const uint32_t cell = cellRow(y) * GRID_SIZE + cellColumn(x);
+    const uint32_t* entries = cellEntries_.data();
+    return {entries + cellOffsets_[cell], entries + cellOffsets_[cell + 1]};
+}
+
+uint32_t LayoutHitGrid::cellColumn(float x) const {
+    const float column = (x - originX_) * inverseCellWidth_;
+    return column <= 0.0f ? 0 : std::min(static_cast<uint32_t>(column), GRID_SIZE - 1);
+}
+
+uint32_t LayoutHitGrid::cellRow(float y) const {
+    const float row = (y - originY_) * inverseCellHeight_;
+    return row <= 0.0f ? 0 : std::min(static_cast<uint32_t>(row), GRID_SIZE - 1);
+}
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
@@ -0,0 +1,87 @@
+/**
+ * @file layout_hit_grid.h
+ * @brief 布局命中网格：按指针位置找出可能命中的布局
+ * @details 把可见布局的矩形按分发顺序登记到覆盖所有布局的均匀网格中，鼠标事件只对指针所在单元中的布局
+ *          调用 hitTest()，开销与指针下重叠的布局数量有关，与窗口中的布局总数无关。
+ *          网格在注册表结构版本或命中范围版本变化后重建（见 LayoutRegistry::getBoundsVersion()）。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include "layout_registry.h"
+#include <cstdint>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+/**
+ * @brief 布局命中网格
+ * 单元中保存布局在分发顺序中的下标（升序），查询结果直接按分发顺序遍历
+ */
+class LayoutHitGrid {
+public:
+    static constexpr uint32_t GRID_SIZE = 16;   ///< 每个方向的单元数
+
+    /**
+     * @brief 查询结果：分发顺序下标的区间
+     */
+    struct Candidates {
+        const uint32_t* first = nullptr;
+        const uint32_t* last = nullptr;
+
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+    /**
+     * @brief 按分发顺序重建网格
+     * @param registry 布局注册表
+     * @param order 按分发顺序排列的布局
+     * @details 不可见的布局不登记；尚未设置大小的布局视为覆盖整个窗口，出现在所有查询结果中
+     */
+    void rebuild(const LayoutRegistry& registry, const std::vector<LayoutHandle>& order);
+
+    /**
+     * @brief 取矩形覆盖窗口坐标 (x, y) 的候选布局，仍需逐个调用 hitTest() 确认
+     */
+    Candidates query(float x, float y) const;
+
+    /**
+     * @brief 清空网格
+     */
+    void clear();
+
+    /**
+     * @brief 登记的布局数量（不含未设置大小的布局）
+     */
+    size_t getBoundedCount() const { return boundedCount_; }
+
+private:
+    /**
+     * @brief 坐标所在的单元格范围，clamp 到网格内
+     */
+    uint32_t cellColumn(float x) const;
+    uint32_t cellRow(float y) const;
+
+    std::vector<uint32_t> cellOffsets_;     ///< 每个单元在 cellEntries_ 中的起点（GRID_SIZE * GRID_SIZE + 1 个）
+    std::vector<uint32_t> cellEntries_;     ///< 各单元的分发顺序下标，单元内升序
+    std::vector<uint32_t> unbounded_;       ///< 未设置大小的布局，落在网格之外的指针只查询这些布局
+    std::vector<float> scratchBounds_;      ///< 重建时暂存的矩形（minX, minY, maxX, maxY）
+    std::vector<uint32_t> scratchOrder_;    ///< 重建时暂存的有界布局下标
+    float originX_ = 0.0f;                  ///< 网格左上角
+    float originY_ = 0.0f;
+    float endX_ = 0.0f;                     ///< 网格右下角（不含）
+    float endY_ = 0.0f;
+    float inverseCellWidth_ = 0.0f;         ///< 单元宽度的倒数
+    float inverseCellHeight_ = 0.0f;        ///< 单元高度的倒数
+    size_t boundedCount_ = 0;
+};
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
@@ -2,6 +2,7 @@
 #include "../window_base.h"
 #include "../../events/layout_events.h"
 #include "../../utils/logger.h"
+#include "../../utils/profiler.h"
 #include <algorithm>
 #include <chrono>
 #include <numeric>
@@ -10,6 +11,33 @@ namespace DearTs {
 namespace Core {
 namespace Window {
 
+namespace {
+
+/**
+ * 取鼠标事件的窗口坐标，非鼠标事件返回false
+ */
+bool getPointerPosition(const SDL_Event& event, float& x, float& y) {
+    switch (event.type) {
+        case SDL_MOUSEMOTION:
+            x = static_cast<float>(event.motion.x);
+            y = static_cast<float>(event.motion.y);
+            return true;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            x = static_cast<float>(event.button.x);
+            y = static_cast<float>(event.button.y);
+            return true;
+        case SDL_MOUSEWHEEL:
+            x = static_cast<float>(event.wheel.mouseX);
+            y = static_cast<float>(event.wheel.mouseY);
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
 /**
  * LayoutManager构造函数
  */
@@ -42,27 +70,28 @@ LayoutManager& LayoutManager::getInstance() {
 void LayoutManager::addLayout(const std::string& name, std::unique_ptr<LayoutBase> layout, const std::string& windowId) {
     if (!layout) return;
 
-    // 确定目标窗口ID
+    // 确定目标窗口ID，目标窗口不存在时创建一个默认的
     std::string targetWindowId = windowId.empty() ? getCurrentWindowId() : windowId;
-
-    // 如果目标窗口不存在，创建一个默认的
-    if (windowLayouts_.find(targetWindowId) == windowLayouts_.end()) {
-        windowLayouts_.emplace(targetWindowId, std::unordered_map<std::string, std::unique_ptr<LayoutBase>>{});
-        systemLayoutNames_[targetWindowId] = {"TitleBar", "Sidebar"}; // 默认系统布局
-        currentContentLayouts_[targetWindowId] = "";
-        lastActiveLayouts_[targetWindowId] = "";
-    }
+    const LayoutRegistry::WindowIndex window = ensureWindow(targetWindowId);
+    WindowEntry& entry = windows_[window];
 
     // 设置父窗口
-    auto windowIt = windowContexts_.find(targetWindowId);
-    if (windowIt != windowContexts_.end()) {
-        layout->setParentWindow(windowIt->second);
+    if (entry.hasContext) {
+        layout->setParentWindow(entry.context);
     }
 
-    // 添加布局到指定窗口
-    windowLayouts_[targetWindowId][name] = std::move(layout);
+    const LayoutRegistry::NameId nameId = registry_.internName(name);
+    auto registrationIt = registeredLayouts_.find(name);
+    const LayoutPriority priority =
+        registrationIt != registeredLayouts_.end() ? registrationIt->second.priority : LayoutPriority::NORMAL;
+    const bool isSystemLayout =
+        std::find(entry.systemLayouts.begin(), entry.systemLayouts.end(), nameId) != entry.systemLayouts.end();
+
+    // 添加布局到指定窗口，同名布局被替换
+    eraseLayout(registry_.find(window, nameId));
+    registry_.insert(window, nameId, std::move(layout), priority, isSystemLayout);
 
-    DEARTS_LOG_DEBUG("添加布局 " + name + " 到窗口 " + targetWindowId);
+    DEARTS_LOG_DEBUG("添加布局 {} 到窗口 {}", name, targetWindowId);
 }
 
 /**
@@ -70,8 +99,15 @@ void LayoutManager::addLayout(const std::string& name, std::unique_ptr<LayoutBas
  */
 void LayoutManager::removeLayout(const std::string& name) {
     // 在所有窗口中查找并移除布局
-    for (auto& [windowId, layouts] : windowLayouts_) {
-        layouts.erase(name);
+    const LayoutRegistry::NameId nameId = registry_.findName(name);
+    std::vector<LayoutHandle> handles;
+    registry_.forEach(LayoutRegistry::INVALID_ID, 0, [&](LayoutHandle handle, LayoutBase&) {
+        if (registry_.getNameId(handle) == nameId) {
+            handles.push_back(handle);
+        }
+    });
+    for (LayoutHandle handle : handles) {
+        eraseLayout(handle);
     }
 }
 
@@ -79,22 +115,22 @@ void LayoutManager::removeLayout(const std::string& name) {
  * 获取布局
  */
 LayoutBase* LayoutManager::getLayout(const std::string& name, const std::string& windowId) const {
-    // 确定目标窗口ID
-    std::string targetWindowId = windowId.empty() ? getCurrentWindowId() : windowId;
+    // 确定目标窗口ID（引用，不复制字符串）
+    const std::string& targetWindowId =
+        !windowId.empty() ? windowId : (currentWindowId_.empty() ? defaultWindowId_ : currentWindowId_);
 
-    auto windowIt = windowLayouts_.find(targetWindowId);
-    if (windowIt == windowLayouts_.end()) {
-        DEARTS_LOG_WARN("窗口不存在: " + targetWindowId + " (查找布局: " + name + ")");
-        return nullptr;
+    // 布局只存在于已创建的窗口中，找到布局即说明窗口存在
+    if (LayoutBase* layout = registry_.get(registry_.find(targetWindowId, name))) {
+        return layout;
     }
 
-    auto layoutIt = windowIt->second.find(name);
-    if (layoutIt != windowIt->second.end()) {
-        return layoutIt->second.get();
+    if (findExistingWindow(targetWindowId) == LayoutRegistry::INVALID_ID) {
+        DEARTS_LOG_WARN("窗口不存在: {} (查找布局: {})", targetWindowId, name);
+        return nullptr;
     }
 
     // 记录调试信息
-    DEARTS_LOG_DEBUG("布局不存在: " + name + " (窗口: " + targetWindowId + ")");
+    DEARTS_LOG_DEBUG("布局不存在: {} (窗口: {})", name, targetWindowId);
     return nullptr;
 }
 
@@ -102,113 +138,263 @@ LayoutBase* LayoutManager::getLayout(const std::string& name, const std::string&
  * 渲染所有布局
  */
 void LayoutManager::renderAll(const std::string& windowId) {
+    DEARTS_PROFILE_SCOPE("LayoutManager::renderAll");
     std::string targetWindowId = windowId.empty() ? getCurrentWindowId() : windowId;
 
-    //std::cout << "[RENDER] LayoutManager::renderAll - 渲染窗口 " << targetWindowId << " 的所有布局 (参数windowId: " << (windowId.empty() ? "空" : windowId) << ")" << std::endl;
+    const LayoutRegistry::WindowIndex window = findExistingWindow(targetWindowId);
+    if (window == LayoutRegistry::INVALID_ID) {
+        DEARTS_LOG_WARN("窗口不存在: {}", targetWindowId);
+        return;
+    }
+
+    // 这里只渲染可见的系统布局，内容布局由窗口在固定区域内渲染
+    registry_.forEach(window, LayoutRegistry::FLAG_VISIBLE | LayoutRegistry::FLAG_SYSTEM,
+                      [this](LayoutHandle handle, LayoutBase& layout) {
+                          DEARTS_PROFILE_SCOPE("Layout::render");
+                          renderSystemLayout(handle, layout);
+                      });
+}
 
-    auto windowIt = windowLayouts_.find(targetWindowId);
-    if (windowIt == windowLayouts_.end()) {
-        DEARTS_LOG_WARN("窗口不存在: " + targetWindowId);
+/**
+ * 渲染系统布局
+ */
+void LayoutManager::renderSystemLayout(LayoutHandle handle, LayoutBase& layout) {
+    const char* cacheWindowName = layout.getRenderCacheWindowName();
+    if (!layout.isRenderCacheEnabled() || !cacheWindowName) {
+        layout.render();
         return;
     }
 
-    const auto& layouts = windowIt->second;
-    const auto& systemLayouts = systemLayoutNames_[targetWindowId];
+    auto& cache = renderCaches_[handle.value];
+    if (!cache) {
+        cache = std::make_unique<LayoutRenderCache>(registry_.getName(handle), cacheWindowName);
+    }
+    cache->render(layout);
+}
 
-    for (const auto& [name, layout] : layouts) {
-        if (layout && layout->isVisible()) {
-            // 检查是否为系统布局
-            bool isSystemLayout = std::find(systemLayouts.begin(),
-                                           systemLayouts.end(),
-                                           name) != systemLayouts.end();
+void LayoutManager::captureRenderCaches(SDL_Renderer* renderer, const ImDrawData* drawData) {
+    DEARTS_PROFILE_SCOPE("LayoutManager::captureRenderCaches");
+    for (auto& [handle, cache] : renderCaches_) {
+        cache->capture(renderer, drawData);
+    }
+}
 
+void LayoutManager::invalidateRenderCaches() {
+    for (auto& [handle, cache] : renderCaches_) {
+        cache->invalidate();
+    }
+}
 
-            if (isSystemLayout) {
-                layout->render();
-            }
-        } else if (layout && !layout->isVisible()) {
-            //std::cout << "[RENDER] LayoutManager::renderAll - 跳过隐藏布局: " << name << " (不可见)" << std::endl;
-        } else if (!layout) {
-            //std::cout << "[RENDER] LayoutManager::renderAll - 跳过空布局: " << name << std::endl;
+void LayoutManager::resetRenderCaches(bool releaseTextures) {
+    for (auto& [handle, cache] : renderCaches_) {
+        if (releaseTextures) {
+            cache->releaseTexture();
+        } else {
+            cache->invalidate();
         }
     }
 }
 
+void LayoutManager::releaseRenderCaches() {
+    for (const LayoutRenderCacheStats& stats : getRenderCacheStats()) {
+        DEARTS_LOG_INFO("布局缓存 {}: 命中率 {}% ({} / {} 帧)，捕获 {} 次，节省 {} 个顶点", stats.layoutName,
+                        static_cast<unsigned>(stats.hitRate() * 100.0 + 0.5), stats.hits, stats.hits + stats.misses, stats.captures,
+                        stats.savedVertices);
+    }
+    renderCaches_.clear();
+}
+
+std::vector<LayoutRenderCacheStats> LayoutManager::getRenderCacheStats() const {
+    std::vector<LayoutRenderCacheStats> stats;
+    stats.reserve(renderCaches_.size());
+    for (const auto& [handle, cache] : renderCaches_) {
+        stats.push_back(cache->getStats());
+    }
+    std::sort(stats.begin(), stats.end(), [](const LayoutRenderCacheStats& a, const LayoutRenderCacheStats& b) {
+        return a.layoutName < b.layoutName;
+    });
+    return stats;
+}
+
 /**
  * 更新所有布局
  */
 void LayoutManager::updateAll(float width, float height, const std::string& windowId) {
     std::string targetWindowId = windowId.empty() ? getCurrentWindowId() : windowId;
 
-    auto windowIt = windowLayouts_.find(targetWindowId);
-    if (windowIt == windowLayouts_.end()) {
+    const LayoutRegistry::WindowIndex window = findExistingWindow(targetWindowId);
+    if (window == LayoutRegistry::INVALID_ID) {
         return;
     }
 
-    for (auto& [name, layout] : windowIt->second) {
-        if (layout && layout->isVisible()) {
-            layout->updateLayout(width, height);
-        }
+    // 窗口尺寸变化时所有可见布局都要重新计算，否则只扫描失效标记
+    WindowEntry& entry = windows_[window];
+    const bool resized = width != entry.lastWidth || height != entry.lastHeight;
+    entry.lastWidth = width;
+    entry.lastHeight = height;
+
+    const uint8_t required = resized ? LayoutRegistry::FLAG_VISIBLE
+                                     : LayoutRegistry::FLAG_VISIBLE | LayoutRegistry::FLAG_NEEDS_UPDATE;
+    uint32_t updated = 0;
+    registry_.forEach(window, required, [width, height, &updated](LayoutHandle, LayoutBase& layout) {
+        layout.refreshLayout(width, height);
+        ++updated;
+    });
+    entry.updatedLayouts = updated;
+}
+
+uint32_t LayoutManager::getUpdatedLayoutCount() const {
+    uint32_t total = 0;
+    for (const WindowEntry& entry : windows_) {
+        total += entry.updatedLayouts;
     }
+    return total;
 }
 
 /**
  * 处理事件
  */
 void LayoutManager::handleEvent(const SDL_Event& event, const std::string& windowId) {
+    // 渲染目标被清空（D3D 丢失设备等）后缓存纹理里是黑的或旧的内容；设备重置时纹理本身也已失效，
+    // 销毁后在下一次捕获时重建。这两个事件不属于任何窗口，布局不需要处理
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+        resetRenderCaches(event.type == SDL_RENDER_DEVICE_RESET);
+        return;
+    }
+
     // 确定目标窗口ID
     std::string targetWindowId = windowId.empty() ? getCurrentWindowId() : windowId;
 
-    // 记录事件类型用于调试
-    if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP || event.type == SDL_MOUSEMOTION) {
-        DEARTS_LOG_INFO("LayoutManager::handleEvent - 处理鼠标事件，类型: " + std::to_string(event.type) + " (窗口: " + targetWindowId + ")");
+    // 窗口尺寸、最大化、焦点等变化会改变系统布局的内容
+    if (event.type == SDL_WINDOWEVENT) {
+        invalidateRenderCaches();
     }
 
-    auto windowIt = windowLayouts_.find(targetWindowId);
-    if (windowIt == windowLayouts_.end()) {
-        DEARTS_LOG_WARN("窗口不存在: " + targetWindowId + " (事件处理)");
+    const LayoutRegistry::WindowIndex window = findExistingWindow(targetWindowId);
+    if (window == LayoutRegistry::INVALID_ID) {
+        DEARTS_LOG_WARN("窗口不存在: {} (事件处理)", targetWindowId);
         return;
     }
 
-    // 按优先级顺序处理事件（系统布局优先）
-    std::vector<std::string> layoutOrder = getLayoutsByPriority();
+    // 按优先级顺序处理事件（系统布局优先），顺序在布局增删或优先级变化后才重建
+    EventRoute& route = windows_[window].route;
+    if (route.version != registry_.getVersion()) {
+        rebuildEventRoute(window, route);
+    }
 
-    for (const std::string& layoutName : layoutOrder) {
-        auto it = windowIt->second.find(layoutName);
-        if (it != windowIt->second.end() && it->second) {
-            bool isVisible = it->second->isVisible();
-            if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP || event.type == SDL_MOUSEMOTION) {
-                DEARTS_LOG_INFO("LayoutManager::handleEvent - 布局: " + layoutName + " (窗口: " + targetWindowId + ") 可见: " + std::string(isVisible ? "是" : "否"));
-            }
+    float pointerX = 0.0f;
+    float pointerY = 0.0f;
+    const bool pointerEvent = getPointerPosition(event, pointerX, pointerY);
 
-            if (isVisible) {
-                it->second->handleEvent(event);
+    // 布局在处理事件时增删布局会使路由过期，此时停止分发本事件，避免访问已移除的布局
+    if (!pointerEvent) {
+        for (size_t i = 0; i < route.order.size() && route.version == registry_.getVersion(); ++i) {
+            const LayoutHandle handle = route.order[i];
+            if (registry_.hasFlags(handle, LayoutRegistry::FLAG_VISIBLE)) {
+                registry_.get(handle)->handleEvent(event);
             }
         }
+    } else {
+        // 鼠标事件只分发给指针下的布局，以及按下鼠标后捕获指针的布局（拖拽移出区域时仍需收到移动和松开）
+        if (route.boundsVersion != registry_.getBoundsVersion()) {
+            route.hitGrid.rebuild(registry_, route.order);
+            route.boundsVersion = registry_.getBoundsVersion();
+        }
+        auto dispatch = [&](uint32_t index, bool captured) {
+            const LayoutHandle handle = route.order[index];
+            if (!registry_.hasFlags(handle, LayoutRegistry::FLAG_VISIBLE)) {
+                return;
+            }
+            LayoutBase* layout = registry_.get(handle);
+            if (!captured && !layout->hitTest(pointerX, pointerY)) {
+                return;
+            }
+            if (event.type == SDL_MOUSEBUTTONDOWN && !route.pointerCapture.isValid()) {
+                route.pointerCapture = handle;
+                route.pointerCaptureIndex = index;
+            }
+            layout->handleEvent(event);
+        };
+
+        // 候选下标按分发顺序升序，捕获指针的布局不在候选中时按它的顺序插入
+        uint32_t capture = route.pointerCapture.isValid() ? route.pointerCaptureIndex : UINT32_MAX;
+        const LayoutHitGrid::Candidates candidates = route.hitGrid.query(pointerX, pointerY);
+        for (const uint32_t* it = candidates.begin(); it != candidates.end(); ++it) {
+            if (route.version != registry_.getVersion()) {
+                break;
+            }
+            if (capture < *it) {
+                dispatch(capture, true);
+                capture = UINT32_MAX;
+                if (route.version != registry_.getVersion()) {
+                    break;
+                }
+            }
+            const bool captured = *it == capture;
+            if (captured) {
+                capture = UINT32_MAX;
+            }
+            dispatch(*it, captured);
+        }
+        if (capture != UINT32_MAX && route.version == registry_.getVersion()) {
+            dispatch(capture, true);
+        }
+    }
+
+    if (event.type == SDL_MOUSEBUTTONDOWN) {
+        route.pressedButtons |= SDL_BUTTON(event.button.button);
+    } else if (event.type == SDL_MOUSEBUTTONUP) {
+        route.pressedButtons &= ~SDL_BUTTON(event.button.button);
+        if (route.pressedButtons == 0) {
+            route.pointerCapture = LayoutHandle{};
+        }
+    }
+}
+
+/**
+ * 重建事件分发顺序
+ */
+void LayoutManager::rebuildEventRoute(LayoutRegistry::WindowIndex window, EventRoute& route) const {
+    // 优先级从高到低，同优先级按名称，保证顺序稳定
+    registry_.collectByPriority(window, route.order);
+
+    // 捕获指针的布局已被移除时放弃捕获（槽位代数变化，旧句柄不再有效）
+    if (route.pointerCapture.isValid() && !registry_.isAlive(route.pointerCapture)) {
+        route.pointerCapture = LayoutHandle{};
+        route.pressedButtons = 0;
+    }
+    route.pointerCaptureIndex = UINT32_MAX;
+    if (route.pointerCapture.isValid()) {
+        const auto it = std::find(route.order.begin(), route.order.end(), route.pointerCapture);
+        if (it != route.order.end()) {
+            route.pointerCaptureIndex = static_cast<uint32_t>(it - route.order.begin());
+        } else {
+            route.pointerCapture = LayoutHandle{};
+            route.pressedButtons = 0;
+        }
     }
+    route.version = registry_.getVersion();
+    // 顺序变化后网格中的下标失效
+    route.boundsVersion = UINT64_MAX;
 }
 
 /**
  * 获取布局数量
  */
 size_t LayoutManager::getLayoutCount() const {
-    size_t totalCount = 0;
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        totalCount += layouts.size();
-    }
-    return totalCount;
+    return registry_.size();
 }
 
 /**
  * 清除所有布局
  */
 void LayoutManager::clear() {
-    windowLayouts_.clear();
-    windowContexts_.clear();
-    currentContentLayouts_.clear();
-    lastActiveLayouts_.clear();
-    systemLayoutNames_.clear();
-    messageHandlers_.clear();
+    renderCaches_.clear();
+    registry_.clear();
+    for (WindowEntry& entry : windows_) {
+        entry = WindowEntry{};
+    }
+    messageBus_.discardQueued();
 }
 
 
@@ -217,12 +403,11 @@ void LayoutManager::clear() {
  */
 std::vector<std::string> LayoutManager::getLayoutNames() const {
     std::vector<std::string> names;
+    names.reserve(registry_.size());
 
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        for (const auto& [name, layout] : layouts) {
-            names.push_back(name);
-        }
-    }
+    registry_.forEach(LayoutRegistry::INVALID_ID, 0, [&](LayoutHandle handle, LayoutBase&) {
+        names.push_back(registry_.getName(handle));
+    });
 
     return names;
 }
@@ -231,24 +416,15 @@ std::vector<std::string> LayoutManager::getLayoutNames() const {
  * 检查是否存在指定名称的布局
  */
 bool LayoutManager::hasLayout(const std::string& name) const {
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        if (layouts.find(name) != layouts.end()) {
-            return true;
-        }
-    }
-    return false;
+    return findLayout(name).isValid();
 }
 
 /**
  * 设置布局可见性
  */
 void LayoutManager::setLayoutVisible(const std::string& name, bool visible) {
-    for (auto& [windowId, layouts] : windowLayouts_) {
-        auto it = layouts.find(name);
-        if (it != layouts.end() && it->second) {
-            it->second->setVisible(visible);
-            return; // 找到并设置后退出
-        }
+    if (LayoutBase* layout = registry_.get(findLayout(name))) {
+        layout->setVisible(visible);
     }
 }
 
@@ -256,13 +432,8 @@ void LayoutManager::setLayoutVisible(const std::string& name, bool visible) {
  * 获取布局可见性
  */
 bool LayoutManager::isLayoutVisible(const std::string& name) const {
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        auto it = layouts.find(name);
-        if (it != layouts.end() && it->second) {
-            return it->second->isVisible();
-        }
-    }
-    return false;
+    const LayoutHandle handle = findLayout(name);
+    return handle.isValid() && registry_.hasFlags(handle, LayoutRegistry::FLAG_VISIBLE);
 }
 
 /**
@@ -270,27 +441,23 @@ bool LayoutManager::isLayoutVisible(const std::string& name) const {
  */
 bool LayoutManager::switchToLayout(const std::string& layoutName, bool animated) {
     // 检查目标布局是否存在
-    if (!hasLayout(layoutName)) {
-        DEARTS_LOG_ERROR("切换布局失败，布局不存在: " + layoutName);
+    const LayoutHandle handle = findLayout(layoutName);
+    if (!handle.isValid()) {
+        DEARTS_LOG_ERROR("切换布局失败，布局不存在: {}", layoutName);
         return false;
     }
 
-    // 找到布局所属的窗口
-    std::string layoutWindowId = getLayoutWindowId(layoutName);
-    if (layoutWindowId.empty()) {
-        DEARTS_LOG_ERROR("无法确定布局所属窗口: " + layoutName);
-        return false;
-    }
-
-    std::string previousLayout = currentContentLayouts_[layoutWindowId];
+    // 布局所属的窗口
+    WindowEntry& entry = windows_[registry_.getWindow(handle)];
+    std::string previousLayout = nameOf(entry.currentContent);
 
     // 隐藏所有内容布局（保留系统布局）
     hideAllContentLayouts();
 
     // 显示目标布局
     if (showLayout(layoutName, "切换布局")) {
-        currentContentLayouts_[layoutWindowId] = layoutName;
-        DEARTS_LOG_INFO("布局切换成功: " + previousLayout + " -> " + layoutName);
+        entry.currentContent = registry_.getNameId(handle);
+        DEARTS_LOG_INFO("布局切换成功: {} -> {}", previousLayout, layoutName);
         return true;
     }
 
@@ -301,16 +468,13 @@ bool LayoutManager::switchToLayout(const std::string& layoutName, bool animated)
  * 显示布局（保持其他布局状态）
  */
 bool LayoutManager::showLayout(const std::string& layoutName, const std::string& reason) {
-    for (auto& [windowId, layouts] : windowLayouts_) {
-        auto it = layouts.find(layoutName);
-        if (it != layouts.end() && it->second) {
-            it->second->setVisible(true);
-            DEARTS_LOG_INFO("显示布局: " + layoutName + (reason.empty() ? "" : " 原因: " + reason));
-            return true;
-        }
+    if (LayoutBase* layout = registry_.get(findLayout(layoutName))) {
+        layout->setVisible(true);
+        DEARTS_LOG_INFO("显示布局: {}{}{}", layoutName, reason.empty() ? "" : " 原因: ", reason);
+        return true;
     }
 
-    DEARTS_LOG_ERROR("显示布局失败，布局不存在: " + layoutName);
+    DEARTS_LOG_ERROR("显示布局失败，布局不存在: {}", layoutName);
     return false;
 }
 
@@ -318,22 +482,21 @@ bool LayoutManager::showLayout(const std::string& layoutName, const std::string&
  * 隐藏布局
  */
 bool LayoutManager::hideLayout(const std::string& layoutName, const std::string& reason) {
-    for (auto& [windowId, layouts] : windowLayouts_) {
-        auto it = layouts.find(layoutName);
-        if (it != layouts.end() && it->second) {
-            it->second->setVisible(false);
-
-            // 如果隐藏的是当前内容布局，清空记录
-            if (currentContentLayouts_[windowId] == layoutName) {
-                currentContentLayouts_[windowId].clear();
-            }
-
-            DEARTS_LOG_INFO("隐藏布局: " + layoutName + (reason.empty() ? "" : " 原因: " + reason));
-            return true;
+    const LayoutHandle handle = findLayout(layoutName);
+    if (LayoutBase* layout = registry_.get(handle)) {
+        layout->setVisible(false);
+
+        // 如果隐藏的是当前内容布局，清空记录
+        WindowEntry& entry = windows_[registry_.getWindow(handle)];
+        if (entry.currentContent == registry_.getNameId(handle)) {
+            entry.currentContent = LayoutRegistry::INVALID_ID;
         }
+
+        DEARTS_LOG_INFO("隐藏布局: {}{}{}", layoutName, reason.empty() ? "" : " 原因: ", reason);
+        return true;
     }
 
-    DEARTS_LOG_ERROR("隐藏布局失败，布局不存在: " + layoutName);
+    DEARTS_LOG_ERROR("隐藏布局失败，布局不存在: {}", layoutName);
     return false;
 }
 
@@ -343,24 +506,15 @@ bool LayoutManager::hideLayout(const std::string& layoutName, const std::string&
 void LayoutManager::hideAllContentLayouts() {
     DEARTS_LOG_DEBUG("隐藏所有内容布局");
 
-    for (auto& [windowId, layouts] : windowLayouts_) {
-        const auto& systemLayouts = systemLayoutNames_[windowId];
-
-        for (auto& [name, layout] : layouts) {
-            if (layout) {
-                // 检查是否为系统布局（标题栏、侧边栏等）
-                bool isSystemLayout = std::find(systemLayouts.begin(),
-                                               systemLayouts.end(),
-                                               name) != systemLayouts.end();
-
-                if (!isSystemLayout && layout->isVisible()) {
-                    layout->setVisible(false);
-                    DEARTS_LOG_DEBUG("隐藏内容布局: " + name);
-                }
-            }
+    registry_.forEach(LayoutRegistry::INVALID_ID, LayoutRegistry::FLAG_VISIBLE, [this](LayoutHandle handle, LayoutBase& layout) {
+        if (!registry_.hasFlags(handle, LayoutRegistry::FLAG_SYSTEM)) {
+            layout.setVisible(false);
+            DEARTS_LOG_DEBUG("隐藏内容布局: {}", registry_.getName(handle));
         }
+    });
 
-        currentContentLayouts_[windowId].clear();
+    for (WindowEntry& entry : windows_) {
+        entry.currentContent = LayoutRegistry::INVALID_ID;
     }
 }
 
@@ -375,7 +529,8 @@ void LayoutManager::initializeEventSystem() {
     }
 
     // 初始化系统布局名称
-    systemLayoutNames_[defaultWindowId_] = {"TitleBar", "Sidebar"};
+    windowEntry(registry_.internWindow(defaultWindowId_)).systemLayouts = {
+        registry_.internName("TitleBar"), registry_.internName("Sidebar")};
 
     // 创建事件调度器
     eventDispatcher_ = new Events::LayoutEventDispatcher();
@@ -446,35 +601,39 @@ bool LayoutManager::registerLayout(const LayoutRegistration& registration) {
     }
 
     if (registeredLayouts_.find(registration.name) != registeredLayouts_.end()) {
-        DEARTS_LOG_WARN("布局已注册，将被覆盖: " + registration.name);
+        DEARTS_LOG_WARN("布局已注册，将被覆盖: {}", registration.name);
     }
 
     registeredLayouts_[registration.name] = registration;
 
+    // 已存在的实例使用新的优先级
+    const LayoutRegistry::NameId nameId = registry_.findName(registration.name);
+    registry_.forEach(LayoutRegistry::INVALID_ID, 0, [&](LayoutHandle handle, LayoutBase&) {
+        if (registry_.getNameId(handle) == nameId) {
+            registry_.setPriority(handle, registration.priority);
+        }
+    });
+
     // 如果设置了自动创建且布局不存在，则立即创建
     if (registration.autoCreate && !hasLayout(registration.name)) {
         createRegisteredLayout(registration.name);
     }
 
-    DEARTS_LOG_INFO("布局注册成功: " + registration.name + " (类型: " +
-                    std::to_string(static_cast<int>(registration.type)) +
-                    ", 优先级: " + std::to_string(static_cast<int>(registration.priority)) + ")");
+    DEARTS_LOG_INFO("布局注册成功: {} (类型: {}, 优先级: {})", registration.name,
+                    static_cast<int>(registration.type), static_cast<int>(registration.priority));
     return true;
 }
 
 void LayoutManager::unregisterLayout(const std::string& layoutName) {
     auto it = registeredLayouts_.find(layoutName);
     if (it != registeredLayouts_.end()) {
-        // 移除布局实例
+        // 移除布局实例（元数据随之移除）
         removeLayout(layoutName);
 
-        // 移除元数据
-        layoutMetadata_.erase(layoutName);
-
         // 移除注册信息
         registeredLayouts_.erase(it);
 
-        DEARTS_LOG_INFO("布局取消注册: " + layoutName);
+        DEARTS_LOG_INFO("布局取消注册: {}", layoutName);
     }
 }
 
@@ -485,33 +644,30 @@ bool LayoutManager::isLayoutRegistered(const std::string& layoutName) const {
 bool LayoutManager::createRegisteredLayout(const std::string& layoutName) {
     auto it = registeredLayouts_.find(layoutName);
     if (it == registeredLayouts_.end()) {
-        DEARTS_LOG_ERROR("布局未注册: " + layoutName);
+        DEARTS_LOG_ERROR("布局未注册: {}", layoutName);
         return false;
     }
 
     if (hasLayout(layoutName)) {
-        DEARTS_LOG_WARN("布局实例已存在: " + layoutName);
+        DEARTS_LOG_WARN("布局实例已存在: {}", layoutName);
         return true;
     }
 
     try {
         auto layout = it->second.factory();
         if (!layout) {
-            DEARTS_LOG_ERROR("布局工厂函数返回空指针: " + layoutName);
+            DEARTS_LOG_ERROR("布局工厂函数返回空指针: {}", layoutName);
             return false;
         }
 
         std::string currentWindowId = getCurrentWindowId();
-        DEARTS_LOG_DEBUG("创建布局 " + layoutName + " 并添加到窗口: " + currentWindowId);
+        DEARTS_LOG_DEBUG("创建布局 {} 并添加到窗口: {}", layoutName, currentWindowId);
         addLayout(layoutName, std::move(layout), currentWindowId);
 
-        // 初始化元数据
-        layoutMetadata_[layoutName] = LayoutMetadata{};
-
-        DEARTS_LOG_INFO("布局实例创建成功: " + layoutName + " (窗口: " + currentWindowId + ")");
+        DEARTS_LOG_INFO("布局实例创建成功: {} (窗口: {})", layoutName, currentWindowId);
         return true;
     } catch (const std::exception& e) {
-        DEARTS_LOG_ERROR("创建布局实例失败: " + layoutName + " 错误: " + e.what());
+        DEARTS_LOG_ERROR("创建布局实例失败: {} 错误: {}", layoutName, e.what());
         return false;
     }
 }
@@ -532,16 +688,22 @@ std::vector<std::string> LayoutManager::getRegisteredLayoutNames() const {
 bool LayoutManager::setLayoutPriority(const std::string& layoutName, LayoutPriority priority) {
     auto it = registeredLayouts_.find(layoutName);
     if (it == registeredLayouts_.end()) {
-        DEARTS_LOG_ERROR("布局未注册，无法设置优先级: " + layoutName);
+        DEARTS_LOG_ERROR("布局未注册，无法设置优先级: {}", layoutName);
         return false;
     }
 
     LayoutPriority oldPriority = it->second.priority;
     it->second.priority = priority;
 
-    DEARTS_LOG_INFO("布局优先级更新: " + layoutName + " " +
-                    std::to_string(static_cast<int>(oldPriority)) + " -> " +
-                    std::to_string(static_cast<int>(priority)));
+    const LayoutRegistry::NameId nameId = registry_.findName(layoutName);
+    registry_.forEach(LayoutRegistry::INVALID_ID, 0, [&](LayoutHandle handle, LayoutBase&) {
+        if (registry_.getNameId(handle) == nameId) {
+            registry_.setPriority(handle, priority);
+        }
+    });
+
+    DEARTS_LOG_INFO("布局优先级更新: {} {} -> {}", layoutName, static_cast<int>(oldPriority),
+                    static_cast<int>(priority));
     return true;
 }
 
@@ -554,27 +716,14 @@ LayoutPriority LayoutManager::getLayoutPriority(const std::string& layoutName) c
 }
 
 std::vector<std::string> LayoutManager::getLayoutsByPriority() const {
-    std::vector<std::pair<std::string, LayoutPriority>> layoutPriorities;
-
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        for (const auto& [name, layout] : layouts) {
-            if (layout) {
-                LayoutPriority priority = getLayoutPriority(name);
-                layoutPriorities.emplace_back(name, priority);
-            }
-        }
-    }
-
     // 按优先级从高到低排序
-    std::sort(layoutPriorities.begin(), layoutPriorities.end(),
-              [](const auto& a, const auto& b) {
-                  return static_cast<int>(a.second) > static_cast<int>(b.second);
-              });
+    std::vector<LayoutHandle> handles;
+    registry_.collectByPriority(LayoutRegistry::INVALID_ID, handles);
 
     std::vector<std::string> result;
-    result.reserve(layoutPriorities.size());
-    for (const auto& [name, priority] : layoutPriorities) {
-        result.push_back(name);
+    result.reserve(handles.size());
+    for (LayoutHandle handle : handles) {
+        result.push_back(registry_.getName(handle));
     }
 
     return result;
@@ -610,25 +759,25 @@ std::vector<std::string> LayoutManager::getLayoutDependencies(const std::string&
 bool LayoutManager::addLayoutDependency(const std::string& layoutName, const std::string& dependency) {
     auto it = registeredLayouts_.find(layoutName);
     if (it == registeredLayouts_.end()) {
-        DEARTS_LOG_ERROR("布局未注册，无法添加依赖: " + layoutName);
+        DEARTS_LOG_ERROR("布局未注册，无法添加依赖: {}", layoutName);
         return false;
     }
 
     it->second.dependencies.insert(dependency);
-    DEARTS_LOG_INFO("添加布局依赖: " + layoutName + " -> " + dependency);
+    DEARTS_LOG_INFO("添加布局依赖: {} -> {}", layoutName, dependency);
     return true;
 }
 
 bool LayoutManager::removeLayoutDependency(const std::string& layoutName, const std::string& dependency) {
     auto it = registeredLayouts_.find(layoutName);
     if (it == registeredLayouts_.end()) {
-        DEARTS_LOG_ERROR("布局未注册，无法移除依赖: " + layoutName);
+        DEARTS_LOG_ERROR("布局未注册，无法移除依赖: {}", layoutName);
         return false;
     }
 
     size_t removed = it->second.dependencies.erase(dependency);
     if (removed > 0) {
-        DEARTS_LOG_INFO("移除布局依赖: " + layoutName + " -> " + dependency);
+        DEARTS_LOG_INFO("移除布局依赖: {} -> {}", layoutName, dependency);
         return true;
     }
     return false;
@@ -637,47 +786,40 @@ bool LayoutManager::removeLayoutDependency(const std::string& layoutName, const
 // === 布局状态管理实现 ===
 
 bool LayoutManager::setLayoutState(const std::string& layoutName, LayoutState state) {
-    auto it = layoutMetadata_.find(layoutName);
-    if (it == layoutMetadata_.end()) {
-        DEARTS_LOG_ERROR("布局元数据不存在: " + layoutName);
+    const LayoutHandle handle = findLayout(layoutName);
+    if (!handle.isValid()) {
+        DEARTS_LOG_ERROR("布局不存在: {}", layoutName);
         return false;
     }
 
-    LayoutState oldState = it->second.state;
-    it->second.state = state;
-    it->second.lastActive = std::chrono::steady_clock::now();
-    it->second.isDirty = true;
+    LayoutState oldState = registry_.getState(handle);
+    registry_.setState(handle, state);
+    registry_.getMetadata(handle).lastActive = std::chrono::steady_clock::now();
+    registry_.setFlag(handle, LayoutRegistry::FLAG_DIRTY, true);
 
     if (state == LayoutState::ACTIVE || state == LayoutState::VISIBLE || state == LayoutState::FOCUSED) {
-        // 找到布局所属的窗口并更新最后激活布局
-        std::string layoutWindowId = getLayoutWindowId(layoutName);
-        if (!layoutWindowId.empty()) {
-            lastActiveLayouts_[layoutWindowId] = layoutName;
-        }
+        // 更新布局所属窗口的最后激活布局
+        windows_[registry_.getWindow(handle)].lastActive = registry_.getNameId(handle);
     }
 
-    DEARTS_LOG_DEBUG("布局状态更新: " + layoutName + " " +
-                     std::to_string(static_cast<int>(oldState)) + " -> " +
-                     std::to_string(static_cast<int>(state)));
+    DEARTS_LOG_DEBUG("布局状态更新: {} {} -> {}", layoutName, static_cast<int>(oldState),
+                     static_cast<int>(state));
     return true;
 }
 
 LayoutState LayoutManager::getLayoutState(const std::string& layoutName) const {
-    auto it = layoutMetadata_.find(layoutName);
-    if (it != layoutMetadata_.end()) {
-        return it->second.state;
-    }
-    return LayoutState::INACTIVE;
+    const LayoutHandle handle = findLayout(layoutName);
+    return handle.isValid() ? registry_.getState(handle) : LayoutState::INACTIVE;
 }
 
 std::vector<std::string> LayoutManager::getLayoutsByState(LayoutState state) const {
     std::vector<std::string> result;
 
-    for (const auto& [name, metadata] : layoutMetadata_) {
-        if (metadata.state == state) {
-            result.push_back(name);
+    registry_.forEach(LayoutRegistry::INVALID_ID, 0, [&](LayoutHandle handle, LayoutBase&) {
+        if (registry_.getState(handle) == state) {
+            result.push_back(registry_.getName(handle));
         }
-    }
+    });
 
     return result;
 }
@@ -685,22 +827,23 @@ std::vector<std::string> LayoutManager::getLayoutsByState(LayoutState state) con
 // === 布局元数据管理实现 ===
 
 bool LayoutManager::setLayoutMetadata(const std::string& layoutName, const std::string& key, const std::string& value) {
-    auto it = layoutMetadata_.find(layoutName);
-    if (it == layoutMetadata_.end()) {
-        DEARTS_LOG_ERROR("布局元数据不存在: " + layoutName);
+    const LayoutHandle handle = findLayout(layoutName);
+    if (!handle.isValid()) {
+        DEARTS_LOG_ERROR("布局不存在: {}", layoutName);
         return false;
     }
 
-    it->second.customData[key] = value;
-    it->second.isDirty = true;
+    registry_.getMetadata(handle).customData[key] = value;
+    registry_.setFlag(handle, LayoutRegistry::FLAG_DIRTY, true);
     return true;
 }
 
 std::string LayoutManager::getLayoutMetadata(const std::string& layoutName, const std::string& key) const {
-    auto it = layoutMetadata_.find(layoutName);
-    if (it != layoutMetadata_.end()) {
-        auto keyIt = it->second.customData.find(key);
-        if (keyIt != it->second.customData.end()) {
+    const LayoutHandle handle = findLayout(layoutName);
+    if (handle.isValid()) {
+        const auto& customData = registry_.getMetadata(handle).customData;
+        auto keyIt = customData.find(key);
+        if (keyIt != customData.end()) {
             return keyIt->second;
         }
     }
@@ -708,15 +851,24 @@ std::string LayoutManager::getLayoutMetadata(const std::string& layoutName, cons
 }
 
 void LayoutManager::markLayoutDirty(const std::string& layoutName, bool dirty) {
-    auto it = layoutMetadata_.find(layoutName);
-    if (it != layoutMetadata_.end()) {
-        it->second.isDirty = dirty;
+    const LayoutHandle handle = findLayout(layoutName);
+    if (!handle.isValid()) {
+        return;
+    }
+    registry_.setFlag(handle, LayoutRegistry::FLAG_DIRTY, dirty);
+
+    // 内容已变化，缓存的纹理不能再用
+    if (dirty) {
+        auto cacheIt = renderCaches_.find(handle.value);
+        if (cacheIt != renderCaches_.end()) {
+            cacheIt->second->invalidate();
+        }
     }
 }
 
 bool LayoutManager::isLayoutDirty(const std::string& layoutName) const {
-    auto it = layoutMetadata_.find(layoutName);
-    return it != layoutMetadata_.end() && it->second.isDirty;
+    const LayoutHandle handle = findLayout(layoutName);
+    return handle.isValid() && registry_.hasFlags(handle, LayoutRegistry::FLAG_DIRTY);
 }
 
 // === 布局生命周期管理实现 ===
@@ -728,21 +880,21 @@ bool LayoutManager::activateLayout(const std::string& layoutName) {
                 return false;
             }
         } else {
-            DEARTS_LOG_ERROR("布局不存在且未注册: " + layoutName);
+            DEARTS_LOG_ERROR("布局不存在且未注册: {}", layoutName);
             return false;
         }
     }
 
     // 检查依赖
     if (!checkLayoutDependencies(layoutName)) {
-        DEARTS_LOG_ERROR("布局依赖不满足: " + layoutName);
+        DEARTS_LOG_ERROR("布局依赖不满足: {}", layoutName);
         return false;
     }
 
     // 解决冲突
     std::string layoutWindowId = getLayoutWindowId(layoutName);
     if (!resolveLayoutConflicts(layoutName, layoutWindowId)) {
-        DEARTS_LOG_ERROR("无法解决布局冲突: " + layoutName);
+        DEARTS_LOG_ERROR("无法解决布局冲突: {}", layoutName);
         return false;
     }
 
@@ -751,29 +903,31 @@ bool LayoutManager::activateLayout(const std::string& layoutName) {
     showLayout(layoutName, "激活布局");
 
     // 更新最后激活布局
-    if (!layoutWindowId.empty()) {
-        lastActiveLayouts_[layoutWindowId] = layoutName;
+    const LayoutHandle handle = findLayout(layoutName);
+    if (handle.isValid()) {
+        windows_[registry_.getWindow(handle)].lastActive = registry_.getNameId(handle);
     }
-    DEARTS_LOG_INFO("布局激活成功: " + layoutName);
+    DEARTS_LOG_INFO("布局激活成功: {}", layoutName);
     return true;
 }
 
 bool LayoutManager::deactivateLayout(const std::string& layoutName) {
     if (!hasLayout(layoutName)) {
-        DEARTS_LOG_WARN("尝试停用不存在的布局: " + layoutName);
+        DEARTS_LOG_WARN("尝试停用不存在的布局: {}", layoutName);
         return false;
     }
 
     setLayoutState(layoutName, LayoutState::INACTIVE);
     hideLayout(layoutName, "停用布局");
 
-    DEARTS_LOG_INFO("布局停用成功: " + layoutName);
+    DEARTS_LOG_INFO("布局停用成功: {}", layoutName);
     return true;
 }
 
 std::string LayoutManager::getLastActiveLayout() const {
     // 返回默认窗口的最后激活布局
-    return lastActiveLayouts_.empty() ? "" : lastActiveLayouts_.at(defaultWindowId_);
+    const LayoutRegistry::WindowIndex window = findExistingWindow(defaultWindowId_);
+    return window == LayoutRegistry::INVALID_ID ? "" : nameOf(windows_[window].lastActive);
 }
 
 bool LayoutManager::resolveLayoutConflicts(const std::string& layoutName, const std::string& windowId) {
@@ -785,7 +939,7 @@ bool LayoutManager::resolveLayoutConflicts(const std::string& layoutName, const
     // 隐藏冲突的布局
     for (const std::string& conflict : it->second.conflicts) {
         if (hasLayout(conflict) && isLayoutVisible(conflict)) {
-            DEARTS_LOG_INFO("解决布局冲突: 隐藏 " + conflict + " 以激活 " + layoutName);
+            DEARTS_LOG_INFO("解决布局冲突: 隐藏 {} 以激活 {}", conflict, layoutName);
             hideLayout(conflict, "布局冲突解决");
         }
     }
@@ -796,49 +950,51 @@ bool LayoutManager::resolveLayoutConflicts(const std::string& layoutName, const
 // === 窗口上下文管理实现 ===
 
 void LayoutManager::registerWindowContext(const std::string& windowId, WindowBase* window) {
-    windowContexts_[windowId] = window;
-
     // 初始化窗口的布局数据
-    if (windowLayouts_.find(windowId) == windowLayouts_.end()) {
-        windowLayouts_.emplace(windowId, std::unordered_map<std::string, std::unique_ptr<LayoutBase>>{});
-        systemLayoutNames_[windowId] = {"TitleBar", "Sidebar"};
-        currentContentLayouts_[windowId] = "";
-        lastActiveLayouts_[windowId] = "";
-    }
+    WindowEntry& entry = windows_[ensureWindow(windowId)];
+    entry.hasContext = true;
+    entry.context = window;
 
-    DEARTS_LOG_DEBUG("注册窗口上下文: " + windowId);
+    DEARTS_LOG_DEBUG("注册窗口上下文: {}", windowId);
 }
 
 void LayoutManager::unregisterWindowContext(const std::string& windowId) {
-    windowContexts_.erase(windowId);
-    windowLayouts_.erase(windowId);
-    systemLayoutNames_.erase(windowId);
-    currentContentLayouts_.erase(windowId);
-    lastActiveLayouts_.erase(windowId);
+    const LayoutRegistry::WindowIndex window = registry_.findWindow(windowId);
+    if (window != LayoutRegistry::INVALID_ID && window < windows_.size()) {
+        std::vector<LayoutHandle> handles;
+        registry_.forEach(window, 0, [&](LayoutHandle handle, LayoutBase&) {
+            handles.push_back(handle);
+        });
+        for (LayoutHandle handle : handles) {
+            eraseLayout(handle);
+        }
+        windows_[window] = WindowEntry{};
+    }
 
-    DEARTS_LOG_DEBUG("注销窗口上下文: " + windowId);
+    DEARTS_LOG_DEBUG("注销窗口上下文: {}", windowId);
 }
 
 LayoutBase* LayoutManager::getWindowLayout(const std::string& windowId, const std::string& layoutName) const {
-    auto windowIt = windowLayouts_.find(windowId);
-    if (windowIt == windowLayouts_.end()) {
-        return nullptr;
-    }
+    return registry_.get(registry_.find(windowId, layoutName));
+}
 
-    auto layoutIt = windowIt->second.find(layoutName);
-    if (layoutIt != windowIt->second.end()) {
-        return layoutIt->second.get();
+LayoutBase* LayoutManager::getWindowLayout(LayoutHandle& cached, const std::string& windowId,
+                                          const std::string& layoutName) const {
+    if (registry_.matches(cached, windowId, layoutName)) {
+        return registry_.get(cached);
     }
 
-    return nullptr;
+    cached = registry_.find(windowId, layoutName);
+    return registry_.get(cached);
 }
 
 std::vector<std::string> LayoutManager::getRegisteredWindowIds() const {
     std::vector<std::string> windowIds;
-    windowIds.reserve(windowContexts_.size());
 
-    for (const auto& [windowId, window] : windowContexts_) {
-        windowIds.push_back(windowId);
+    for (LayoutRegistry::WindowIndex window = 0; window < windows_.size(); ++window) {
+        if (windows_[window].hasContext) {
+            windowIds.push_back(registry_.getWindowId(window));
+        }
     }
 
     return windowIds;
@@ -846,9 +1002,8 @@ std::vector<std::string> LayoutManager::getRegisteredWindowIds() const {
 
 std::string LayoutManager::getCurrentContentLayout() const {
     // 获取当前活跃窗口的当前内容布局
-    std::string currentWindowId = getCurrentWindowId();
-    auto it = currentContentLayouts_.find(currentWindowId);
-    return (it == currentContentLayouts_.end()) ? "" : it->second;
+    const LayoutRegistry::WindowIndex window = findExistingWindow(getCurrentWindowId());
+    return window == LayoutRegistry::INVALID_ID ? "" : nameOf(windows_[window].currentContent);
 }
 
 // === 辅助方法实现 ===
@@ -863,72 +1018,57 @@ void LayoutManager::setActiveWindow(const std::string& windowId) {
         std::string previousWindow = currentWindowId_;
         currentWindowId_ = windowId.empty() ? defaultWindowId_ : windowId;
 
-        DEARTS_LOG_DEBUG("活跃窗口切换: " + previousWindow + " -> " + currentWindowId_);
+        DEARTS_LOG_DEBUG("活跃窗口切换: {} -> {}", previousWindow, currentWindowId_);
     }
 }
 
 std::string LayoutManager::getLayoutWindowId(const std::string& layoutName) const {
     // 在所有窗口中查找布局
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        if (layouts.find(layoutName) != layouts.end()) {
-            return windowId;
-        }
-    }
-    return "";
+    const LayoutHandle handle = findLayout(layoutName);
+    return handle.isValid() ? registry_.getWindowId(registry_.getWindow(handle)) : "";
 }
 
-// === 布局间通信机制实现 ===
+LayoutManager::WindowEntry& LayoutManager::windowEntry(LayoutRegistry::WindowIndex window) {
+    if (window >= windows_.size()) {
+        windows_.resize(window + 1);
+    }
+    return windows_[window];
+}
 
-bool LayoutManager::sendLayoutMessage(const std::string& fromWindowId, const std::string& fromLayoutName,
-                                     const std::string& toWindowId, const std::string& toLayoutName,
-                                     const std::string& message) {
-    // 如果指定了目标布局，只发送给该布局
-    if (!toLayoutName.empty()) {
-        LayoutBase* targetLayout = getWindowLayout(toWindowId, toLayoutName);
-        if (targetLayout) {
-            // 这里可以调用布局的消息处理方法
-            DEARTS_LOG_DEBUG("发送布局消息: " + fromWindowId + ":" + fromLayoutName +
-                            " -> " + toWindowId + ":" + toLayoutName + " : " + message);
-            return true;
-        }
-    } else {
-        // 发送给目标窗口的所有布局
-        auto windowIt = windowLayouts_.find(toWindowId);
-        if (windowIt != windowLayouts_.end()) {
-            for (const auto& [layoutName, layout] : windowIt->second) {
-                if (layout) {
-                    DEARTS_LOG_DEBUG("广播布局消息到: " + toWindowId + ":" + layoutName +
-                                    " : " + message);
-                }
-            }
-            return true;
-        }
+LayoutRegistry::WindowIndex LayoutManager::ensureWindow(const std::string& windowId) {
+    const LayoutRegistry::WindowIndex window = registry_.internWindow(windowId);
+    WindowEntry& entry = windowEntry(window);
+    if (!entry.exists) {
+        entry.exists = true;
+        entry.systemLayouts = {registry_.internName("TitleBar"), registry_.internName("Sidebar")}; // 默认系统布局
+        entry.currentContent = LayoutRegistry::INVALID_ID;
+        entry.lastActive = LayoutRegistry::INVALID_ID;
     }
+    return window;
+}
 
-    return false;
+LayoutRegistry::WindowIndex LayoutManager::findExistingWindow(const std::string& windowId) const {
+    const LayoutRegistry::WindowIndex window = registry_.findWindow(windowId);
+    if (window == LayoutRegistry::INVALID_ID || window >= windows_.size() || !windows_[window].exists) {
+        return LayoutRegistry::INVALID_ID;
+    }
+    return window;
 }
 
-void LayoutManager::registerLayoutMessageHandler(const std::string& windowId, const std::string& layoutName,
-                                                 std::function<void(const std::string&, const std::string&, const std::string&)> handler) {
-    messageHandlers_[windowId][layoutName] = handler;
-    DEARTS_LOG_DEBUG("注册布局消息处理器: " + windowId + ":" + layoutName);
+LayoutHandle LayoutManager::findLayout(const std::string& name) const {
+    return registry_.findAny(registry_.findName(name));
 }
 
-void LayoutManager::broadcastMessage(const std::string& fromWindowId, const std::string& fromLayoutName,
-                                    const std::string& message) {
-    // 广播给所有窗口的所有布局
-    for (const auto& [windowId, layouts] : windowLayouts_) {
-        for (const auto& [layoutName, layout] : layouts) {
-            if (layout) {
-                auto handlerIt = messageHandlers_[windowId].find(layoutName);
-                if (handlerIt != messageHandlers_[windowId].end()) {
-                    handlerIt->second(fromWindowId, fromLayoutName, message);
-                }
-            }
-        }
+void LayoutManager::eraseLayout(LayoutHandle handle) {
+    if (!registry_.isAlive(handle)) {
+        return;
     }
+    renderCaches_.erase(handle.value);
+    registry_.erase(handle);
+}
 
-    DEARTS_LOG_DEBUG("广播布局消息: " + fromWindowId + ":" + fromLayoutName + " -> all : " + message);
+std::string LayoutManager::nameOf(LayoutRegistry::NameId name) const {
+    return name == LayoutRegistry::INVALID_ID ? "" : registry_.getName(name);
 }
 
 // === 父窗口管理实现 ===
@@ -943,16 +1083,11 @@ void LayoutManager::setParentWindow(WindowBase* window, const std::string& windo
     setActiveWindow(targetWindowId);
 
     // 为该窗口的所有现有布局设置父窗口
-    auto windowIt = windowLayouts_.find(targetWindowId);
-    if (windowIt != windowLayouts_.end()) {
-        for (auto& [name, layout] : windowIt->second) {
-            if (layout) {
-                layout->setParentWindow(window);
-            }
-        }
-    }
+    registry_.forEach(registry_.findWindow(targetWindowId), 0, [window](LayoutHandle, LayoutBase& layout) {
+        layout.setParentWindow(window);
+    });
 
-    DEARTS_LOG_DEBUG("设置父窗口: " + targetWindowId + " (已设为活跃窗口)");
+    DEARTS_LOG_DEBUG("设置父窗口: {} (已设为活跃窗口)", targetWindowId);
 }
 
 } // namespace Window
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "layout_base.h"
+#include "layout_hit_grid.h"
+#include "layout_render_cache.h"
+#include "layout_message_bus.h"
+#include "layout_registry.h"
+#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -40,28 +45,6 @@ enum class LayoutType {
     OVERLAY         ///< 覆盖层布局（通知、提示等）
 };
 
-/**
- * @brief 布局优先级
- */
-enum class LayoutPriority {
-    LOWEST = 0,     ///< 最低优先级
-    LOW = 25,       ///< 低优先级
-    NORMAL = 50,    ///< 普通优先级
-    HIGH = 75,      ///< 高优先级
-    HIGHEST = 100   ///< 最高优先级
-};
-
-/**
- * @brief 布局状态枚举
- */
-enum class LayoutState {
-    INACTIVE,       ///< 未激活
-    ACTIVE,         ///< 已激活
-    VISIBLE,        ///< 可见
-    FOCUSED,        ///< 获得焦点
-    MODAL           ///< 模态状态
-};
-
 /**
  * @brief 布局注册信息
  */
@@ -81,20 +64,10 @@ struct LayoutRegistration {
         : name(n), type(t), priority(p) {}
 };
 
-/**
- * @brief 布局元数据
- */
-struct LayoutMetadata {
-    LayoutState state = LayoutState::INACTIVE;  ///< 当前状态
-    std::string lastFocused;                     ///< 最后获得焦点的布局
-    std::chrono::steady_clock::time_point lastActive; ///< 最后激活时间
-    std::unordered_map<std::string, std::string> customData; ///< 自定义数据
-    bool isDirty = false;                        ///< 是否需要保存
-};
-
 /**
  * @brief 布局管理器
  * 统一管理所有布局对象，提供布局的创建、销毁、查找等操作
+ * 布局存放在 LayoutRegistry 中，按名称的接口在入口处把名称解析为句柄，每帧的渲染、更新和事件分发按句柄线性遍历
  */
 class LayoutManager {
 public:
@@ -144,11 +117,18 @@ public:
 
     /**
      * @brief 更新所有布局
+     * 窗口尺寸变化时更新所有可见布局，否则只更新已失效的可见布局（见 LayoutBase::invalidateLayout()）
      * @param width 可用宽度
      * @param height 可用高度
      * @param windowId 窗口ID（可选，指定窗口则只更新该窗口的布局）
      */
     void updateAll(float width, float height, const std::string& windowId = "");
+
+    /**
+     * @brief 获取各窗口最近一次 updateAll() 实际调用 updateLayout() 的布局数量之和
+     * 每个窗口每帧更新一次时即为本帧做了更新工作的布局数
+     */
+    uint32_t getUpdatedLayoutCount() const;
     
     /**
      * @brief 处理事件
@@ -202,6 +182,15 @@ public:
      * @return 布局对象指针
      */
     LayoutBase* getWindowLayout(const std::string& windowId, const std::string& layoutName) const;
+
+    /**
+     * @brief 通过调用方缓存的句柄获取窗口的布局，每帧都要取布局的地方使用
+     * @param cached 缓存的句柄，失效或不再指向该窗口中的同名布局时按名称重新查找并更新
+     * @param windowId 窗口ID
+     * @param layoutName 布局名称
+     * @return 布局对象指针
+     */
+    LayoutBase* getWindowLayout(LayoutHandle& cached, const std::string& windowId, const std::string& layoutName) const;
     
     /**
      * @brief 获取所有布局名称
@@ -412,11 +401,41 @@ public:
 
     /**
      * @brief 标记布局为需要保存
+     * 标记为 true 时同时使该布局的渲染缓存失效
      * @param layoutName 布局名称
      * @param dirty 是否需要保存
      */
     void markLayoutDirty(const std::string& layoutName, bool dirty = true);
 
+    /**
+     * @brief 捕获本帧需要更新的布局渲染缓存
+     * 在 ImGui::Render() 之后调用
+     * @param renderer 主窗口的 SDL 渲染器
+     * @param drawData 本帧的绘制数据
+     */
+    void captureRenderCaches(SDL_Renderer* renderer, const ImDrawData* drawData);
+
+    /**
+     * @brief 使所有布局渲染缓存失效
+     */
+    void invalidateRenderCaches();
+
+    /**
+     * @brief 渲染目标或渲染设备重置后重置所有布局渲染缓存
+     * @param releaseTextures 设备重置时为 true：纹理已失效，销毁后在下一次捕获时重建
+     */
+    void resetRenderCaches(bool releaseTextures);
+
+    /**
+     * @brief 释放所有布局渲染缓存的纹理（须在销毁渲染器之前调用）
+     */
+    void releaseRenderCaches();
+
+    /**
+     * @brief 获取各布局渲染缓存的统计
+     */
+    std::vector<LayoutRenderCacheStats> getRenderCacheStats() const;
+
     /**
      * @brief 检查布局是否需要保存
      * @param layoutName 布局名称
@@ -457,37 +476,10 @@ public:
     // === 布局间通信机制 ===
 
     /**
-     * @brief 发送布局消息
-     * @param fromWindowId 源窗口ID
-     * @param fromLayoutName 源布局名称
-     * @param toWindowId 目标窗口ID（为空则广播到所有窗口）
-     * @param toLayoutName 目标布局名称（为空则发送到指定窗口的所有布局）
-     * @param message 消息内容
-     * @return 是否发送成功
-     */
-    bool sendLayoutMessage(const std::string& fromWindowId, const std::string& fromLayoutName,
-                          const std::string& toWindowId, const std::string& toLayoutName,
-                          const std::string& message);
-
-    /**
-     * @brief 注册布局消息处理器
-     * @param windowId 窗口ID
-     * @param layoutName 布局名称
-     * @param handler 消息处理函数
-     */
-    void registerLayoutMessageHandler(const std::string& windowId, const std::string& layoutName,
-                                     std::function<void(const std::string& fromWindowId,
-                                                       const std::string& fromLayoutName,
-                                                       const std::string& message)> handler);
-
-    /**
-     * @brief 广播消息到所有窗口
-     * @param fromWindowId 源窗口ID
-     * @param fromLayoutName 源布局名称
-     * @param message 消息内容
+     * @brief 获取布局消息总线
+     * 布局在初始化时解析所需的通道和端点并保存，之后发送消息不再按名称查找
      */
-    void broadcastMessage(const std::string& fromWindowId, const std::string& fromLayoutName,
-                         const std::string& message);
+    LayoutMessageBus& getMessageBus() { return messageBus_; }
 
     /**
      * @brief 获取所有已注册的窗口ID
@@ -511,29 +503,91 @@ private:
      * @brief 禁止赋值操作
      */
     LayoutManager& operator=(const LayoutManager&) = delete;
-  
-    // 多窗口布局存储：windowId -> (layoutName -> layout)
-    std::unordered_map<std::string, std::unordered_map<std::string, std::unique_ptr<LayoutBase>>> windowLayouts_; ///< 窗口布局映射
 
-    // 窗口上下文管理
-    std::unordered_map<std::string, WindowBase*> windowContexts_; ///< 窗口上下文映射
-    std::string defaultWindowId_;                                  ///< 默认窗口ID
+    /**
+     * @brief 窗口的事件分发路由
+     * 按优先级排好的布局列表只在注册表结构版本变化（布局增删、优先级变化）后重建，处理事件时不再排序和按名称查找；
+     * 命中网格另外在布局位置、大小或可见性变化后重建，鼠标事件只测试指针下的布局
+     */
+    struct EventRoute {
+        std::vector<LayoutHandle> order;        ///< 按优先级从高到低的布局
+        uint64_t version = UINT64_MAX;          ///< 构建时的注册表结构版本
+        LayoutHitGrid hitGrid;                  ///< 可见布局的命中网格
+        uint64_t boundsVersion = UINT64_MAX;    ///< 构建命中网格时的注册表命中范围版本
+        LayoutHandle pointerCapture;            ///< 按下鼠标时命中的布局，松开所有按键前持续接收鼠标事件
+        uint32_t pointerCaptureIndex = UINT32_MAX; ///< 捕获指针的布局在 order 中的下标
+        uint32_t pressedButtons = 0;            ///< 当前按下的鼠标按键掩码
+    };
+
+    /**
+     * @brief 窗口条目，以注册表中驻留的窗口索引寻址
+     */
+    struct WindowEntry {
+        bool exists = false;                    ///< 是否已创建（添加布局或注册窗口上下文时）
+        bool hasContext = false;                ///< 是否已注册窗口上下文
+        WindowBase* context = nullptr;          ///< 窗口上下文
+        LayoutRegistry::NameId currentContent = LayoutRegistry::INVALID_ID; ///< 当前可见的内容布局
+        LayoutRegistry::NameId lastActive = LayoutRegistry::INVALID_ID;     ///< 最后激活的布局
+        std::vector<LayoutRegistry::NameId> systemLayouts;                  ///< 系统布局名称
+        EventRoute route;                       ///< 事件分发路由
+        float lastWidth = -1.0f;                ///< 上一次 updateAll() 的可用宽度
+        float lastHeight = -1.0f;               ///< 上一次 updateAll() 的可用高度
+        uint32_t updatedLayouts = 0;            ///< 上一次 updateAll() 更新的布局数量
+    };
+
+    /**
+     * @brief 渲染系统布局，开启缓存的布局经由渲染缓存
+     */
+    void renderSystemLayout(LayoutHandle handle, LayoutBase& layout);
+
+    /**
+     * @brief 按优先级重建窗口的事件分发顺序
+     */
+    void rebuildEventRoute(LayoutRegistry::WindowIndex window, EventRoute& route) const;
+
+    /**
+     * @brief 取窗口条目，不存在时创建
+     */
+    WindowEntry& windowEntry(LayoutRegistry::WindowIndex window);
+
+    /**
+     * @brief 确保窗口已创建（带默认系统布局），返回窗口索引
+     */
+    LayoutRegistry::WindowIndex ensureWindow(const std::string& windowId);
+
+    /**
+     * @brief 查找已创建的窗口，不存在时返回 INVALID_ID
+     */
+    LayoutRegistry::WindowIndex findExistingWindow(const std::string& windowId) const;
+
+    /**
+     * @brief 在所有窗口中按名称查找布局
+     */
+    LayoutHandle findLayout(const std::string& name) const;
+
+    /**
+     * @brief 移除布局及其渲染缓存
+     */
+    void eraseLayout(LayoutHandle handle);
+
+    /**
+     * @brief 名称ID转为名称，INVALID_ID 转为空字符串
+     */
+    std::string nameOf(LayoutRegistry::NameId name) const;
+
+    LayoutRegistry registry_;                                              ///< 布局存储
+    std::deque<WindowEntry> windows_;                                      ///< 窗口索引 -> 窗口条目（deque 保证扩展时已有条目地址不变）
+    std::string defaultWindowId_;                                          ///< 默认窗口ID
 
-    // 布局消息处理器
-    std::unordered_map<std::string, std::unordered_map<std::string,
-        std::function<void(const std::string&, const std::string&, const std::string&)>>> messageHandlers_; ///< 布局消息处理器映射
+    LayoutMessageBus messageBus_;                                          ///< 布局消息总线
 
     // 事件系统相关（全局共享）
     Events::LayoutEventDispatcher* eventDispatcher_;                        ///< 布局事件调度器
 
     // 布局注册机制相关（全局共享）
     std::unordered_map<std::string, LayoutRegistration> registeredLayouts_; ///< 已注册的布局类型
-    std::unordered_map<std::string, LayoutMetadata> layoutMetadata_;        ///< 布局元数据
 
-    // 布局管理相关（按窗口存储）
-    std::unordered_map<std::string, std::string> lastActiveLayouts_;        ///< 每个窗口最后激活的布局名称
-    std::unordered_map<std::string, std::string> currentContentLayouts_;    ///< 每个窗口当前可见的内容布局名称
-    std::unordered_map<std::string, std::vector<std::string>> systemLayoutNames_; ///< 每个窗口的系统布局名称列表
+    std::unordered_map<uint32_t, std::unique_ptr<LayoutRenderCache>> renderCaches_; ///< 布局句柄 -> 渲染缓存
     std::chrono::steady_clock::time_point lastUpdateTime_;                  ///< 最后更新时间
     std::string currentWindowId_;                                          ///< 当前活跃窗口ID
 
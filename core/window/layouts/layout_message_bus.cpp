@@ -0,0 +1,141 @@
+/**
+ * @file layout_message_bus.cpp
+ * @brief 布局间消息总线实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "layout_message_bus.h"
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+// === LayoutChannelBase ===
+
+LayoutChannelBase::LayoutChannelBase(LayoutMessageBus& bus, std::string name, std::type_index type)
+    : activeCount_(0)
+    , dispatchDepth_(0)
+    , bus_(bus)
+    , name_(std::move(name))
+    , type_(type)
+    , self_(std::make_shared<LayoutChannelBase*>(this)) {
+}
+
+uint32_t LayoutChannelBase::acquireSlot() {
+    uint32_t index;
+    if (dispatchDepth_ == 0 && !freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(active_.size());
+        active_.push_back(0);
+        generations_.push_back(1);
+        owners_.emplace_back();
+    }
+    active_[index] = 1;
+    ++activeCount_;
+    return index;
+}
+
+bool LayoutChannelBase::unsubscribe(MessageSubscriptionId id) {
+    const uint32_t index = findActiveSlot(id);
+    if (index == INVALID_SLOT) {
+        return false;
+    }
+
+    active_[index] = 0;
+    ++generations_[index];
+    --activeCount_;
+    if (dispatchDepth_ > 0) {
+        // 处理器可能正在执行（例如在处理器中取消自己），分发结束后再销毁
+        pendingRelease_.push_back(index);
+    } else {
+        releaseHandler(index);
+        freeSlots_.push_back(index);
+    }
+    return true;
+}
+
+void LayoutChannelBase::releasePending() {
+    std::vector<uint32_t> pending;
+    pending.swap(pendingRelease_);
+    for (uint32_t index : pending) {
+        releaseHandler(index);
+        freeSlots_.push_back(index);
+    }
+}
+
+void LayoutChannelBase::notifyQueued() {
+    bus_.pendingChannels_.push_back(this);
+}
+
+// === MessageSubscription ===
+
+MessageSubscription::MessageSubscription(LayoutChannelBase& channel, MessageSubscriptionId id)
+    : channel_(channel.self_)
+    , id_(id) {
+}
+
+MessageSubscription::MessageSubscription(MessageSubscription&& other) noexcept
+    : channel_(std::move(other.channel_))
+    , id_(other.id_) {
+    other.id_ = INVALID_MESSAGE_SUBSCRIPTION;
+}
+
+MessageSubscription& MessageSubscription::operator=(MessageSubscription&& other) noexcept {
+    if (this != &other) {
+        reset();
+        channel_ = std::move(other.channel_);
+        id_ = other.id_;
+        other.id_ = INVALID_MESSAGE_SUBSCRIPTION;
+    }
+    return *this;
+}
+
+void MessageSubscription::reset() {
+    if (id_ != INVALID_MESSAGE_SUBSCRIPTION) {
+        if (auto channel = channel_.lock()) {
+            (*channel)->unsubscribe(id_);
+        }
+        id_ = INVALID_MESSAGE_SUBSCRIPTION;
+    }
+    channel_.reset();
+}
+
+bool MessageSubscription::isConnected() const {
+    auto channel = channel_.lock();
+    return channel && (*channel)->isSubscribed(id_);
+}
+
+// === LayoutMessageBus ===
+
+size_t LayoutMessageBus::deliverQueued() {
+    if (pendingChannels_.empty()) {
+        return 0;
+    }
+
+    // 投递期间再排队的通道重新登记到 pendingChannels_，留到下一次
+    std::vector<LayoutChannelBase*> channels;
+    channels.swap(pendingChannels_);
+    size_t delivered = 0;
+    for (LayoutChannelBase* channel : channels) {
+        delivered += channel->deliverQueued();
+    }
+    if (pendingChannels_.empty()) {
+        channels.clear();
+        pendingChannels_.swap(channels);
+    }
+    return delivered;
+}
+
+void LayoutMessageBus::discardQueued() {
+    for (LayoutChannelBase* channel : pendingChannels_) {
+        channel->discardQueued();
+    }
+    pendingChannels_.clear();
+}
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
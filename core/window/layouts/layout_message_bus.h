@@ -0,0 +1,417 @@
+/**
+ * @file layout_message_bus.h
+ * @brief 布局间消息总线：按类型划分的消息通道
+ * @details 通道按名称和消息类型在初始化时解析一次（LayoutMessageBus::channel<T>()），之后的发送不再做任何查找：
+ *          - publish() 同步地把消息以 const T& 依次交给所有订阅者，广播只是对订阅者数组的线性遍历；
+ *          - post() 把消息移动进通道的队列，由主循环在下一帧开始时（Application::pumpFrameWork()）调用 LayoutMessageBus::deliverQueued() 投递；
+ *          - 点对点发送先用 endpoint() 把目标订阅者解析为端点，之后 LayoutEndpoint::send() 直接调用其处理器；
+ *          - 较大或需要跨帧保留的负载以 SharedPayload<T> 作为消息类型，所有订阅者共享同一份不可变数据。
+ *          总线只在主线程使用，工作线程的结果先经 TaskScheduler 回到主线程再发送。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+class LayoutMessageBus;
+template <typename T> class LayoutChannel;
+
+/**
+ * @brief 共享的不可变负载，投递时只复制引用
+ */
+template <typename T>
+using SharedPayload = std::shared_ptr<const T>;
+
+/**
+ * @brief 创建共享负载
+ */
+template <typename T, typename... Args>
+SharedPayload<T> makeSharedPayload(Args&&... args) {
+    return std::make_shared<const T>(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief 消息订阅标识：高 32 位为槽位代数，低 32 位为槽位索引 + 1，0 表示无效
+ */
+using MessageSubscriptionId = uint64_t;
+constexpr MessageSubscriptionId INVALID_MESSAGE_SUBSCRIPTION = 0;
+
+/**
+ * @brief 与消息类型无关的通道部分：订阅槽位管理和分发期间的延迟释放
+ * @details 分发期间（包括处理器中再次发送）订阅的处理器从下一次分发开始生效；
+ *          取消订阅的处理器立即不再调用，等最外层分发结束后才销毁。
+ */
+class LayoutChannelBase {
+public:
+    LayoutChannelBase(LayoutMessageBus& bus, std::string name, std::type_index type);
+    virtual ~LayoutChannelBase() = default;
+
+    LayoutChannelBase(const LayoutChannelBase&) = delete;
+    LayoutChannelBase& operator=(const LayoutChannelBase&) = delete;
+
+    const std::string& getName() const { return name_; }
+    std::type_index getType() const { return type_; }
+
+    /**
+     * @brief 取消订阅，标识无效时忽略
+     * @return 是否取消成功
+     */
+    bool unsubscribe(MessageSubscriptionId id);
+
+    /**
+     * @brief 订阅是否仍然有效
+     */
+    bool isSubscribed(MessageSubscriptionId id) const { return findActiveSlot(id) != INVALID_SLOT; }
+
+    /**
+     * @brief 当前订阅者数量
+     */
+    size_t getSubscriberCount() const { return activeCount_; }
+
+    /**
+     * @brief 排队等待投递的消息数量
+     */
+    virtual size_t getQueuedCount() const = 0;
+
+protected:
+    friend class LayoutMessageBus;
+    friend class MessageSubscription;
+
+    static constexpr uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    /**
+     * @brief 最外层分发结束（包括处理器抛出异常）时销毁已取消的处理器
+     */
+    class DispatchGuard {
+    public:
+        explicit DispatchGuard(LayoutChannelBase& channel) : channel_(channel) { ++channel_.dispatchDepth_; }
+        ~DispatchGuard() {
+            if (--channel_.dispatchDepth_ == 0 && !channel_.pendingRelease_.empty()) {
+                channel_.releasePending();
+            }
+        }
+
+    private:
+        LayoutChannelBase& channel_;
+    };
+
+    /**
+     * @brief 分配订阅槽位；分发期间只追加新槽位，保证本次分发不会调用新订阅者
+     * @return 槽位索引，等于处理器数组长度时由派生类追加处理器
+     */
+    uint32_t acquireSlot();
+
+    /**
+     * @brief 标识对应的有效槽位，无效时返回 INVALID_SLOT
+     */
+    uint32_t findActiveSlot(MessageSubscriptionId id) const {
+        const uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFFu) - 1;
+        if (id == INVALID_MESSAGE_SUBSCRIPTION || index >= active_.size() || !active_[index] ||
+            generations_[index] != static_cast<uint32_t>(id >> 32)) {
+            return INVALID_SLOT;
+        }
+        return index;
+    }
+
+    MessageSubscriptionId makeId(uint32_t index) const {
+        return (static_cast<uint64_t>(generations_[index]) << 32) | (index + 1);
+    }
+
+    /**
+     * @brief 消息入队后调用，通道首次有排队消息时登记到总线
+     */
+    void notifyQueued();
+
+    /**
+     * @brief 销毁槽位中的处理器
+     */
+    virtual void releaseHandler(uint32_t index) = 0;
+
+    /**
+     * @brief 投递排队的消息，投递期间新排队的消息留到下一次
+     * @return 投递的消息数量
+     */
+    virtual size_t deliverQueued() = 0;
+
+    /**
+     * @brief 丢弃排队的消息
+     */
+    virtual void discardQueued() = 0;
+
+    std::vector<uint8_t> active_;           ///< 槽位是否有订阅者（分发时按此跳过已取消的处理器）
+    std::vector<uint32_t> generations_;     ///< 槽位代数
+    std::vector<std::string> owners_;       ///< 订阅者名称，用于解析端点
+    size_t activeCount_;                    ///< 订阅者数量
+    uint32_t dispatchDepth_;                ///< 分发嵌套深度
+
+private:
+    void releasePending();
+
+    LayoutMessageBus& bus_;
+    std::string name_;
+    std::type_index type_;
+    std::vector<uint32_t> freeSlots_;       ///< 空闲槽位
+    std::vector<uint32_t> pendingRelease_;  ///< 分发期间取消、等待销毁处理器的槽位
+    std::shared_ptr<LayoutChannelBase*> self_; ///< 供 MessageSubscription 判断通道是否仍然存在
+};
+
+/**
+ * @brief 作用域消息订阅，析构时自动取消
+ */
+class MessageSubscription {
+public:
+    MessageSubscription() = default;
+    MessageSubscription(LayoutChannelBase& channel, MessageSubscriptionId id);
+    ~MessageSubscription() { reset(); }
+
+    MessageSubscription(MessageSubscription&& other) noexcept;
+    MessageSubscription& operator=(MessageSubscription&& other) noexcept;
+    MessageSubscription(const MessageSubscription&) = delete;
+    MessageSubscription& operator=(const MessageSubscription&) = delete;
+
+    /**
+     * @brief 立即取消订阅
+     */
+    void reset();
+
+    MessageSubscriptionId getId() const { return id_; }
+
+    /**
+     * @brief 订阅是否仍然有效
+     */
+    bool isConnected() const;
+
+private:
+    std::weak_ptr<LayoutChannelBase*> channel_;
+    MessageSubscriptionId id_ = INVALID_MESSAGE_SUBSCRIPTION;
+};
+
+/**
+ * @brief 解析到单个订阅者的端点，发送时直接调用其处理器
+ * 端点不持有通道，通道随总线存在；订阅取消后 send() 返回false
+ */
+template <typename T>
+class LayoutEndpoint {
+public:
+    LayoutEndpoint() = default;
+    LayoutEndpoint(LayoutChannel<T>* channel, MessageSubscriptionId id) : channel_(channel), id_(id) {}
+
+    /**
+     * @brief 同步发送消息
+     * @return 目标订阅者是否仍然有效
+     */
+    bool send(const T& message) const { return channel_ && channel_->sendTo(id_, message); }
+
+    bool isConnected() const { return channel_ && channel_->isSubscribed(id_); }
+
+private:
+    LayoutChannel<T>* channel_ = nullptr;
+    MessageSubscriptionId id_ = INVALID_MESSAGE_SUBSCRIPTION;
+};
+
+/**
+ * @brief 一类消息的通道
+ * @details 处理器放在 std::deque 中，分发期间订阅不会移动正在调用的处理器；
+ *          同一通道排队的消息按 post() 的顺序投递。
+ */
+template <typename T>
+class LayoutChannel final : public LayoutChannelBase {
+public:
+    using Handler = std::function<void(const T&)>;
+
+    LayoutChannel(LayoutMessageBus& bus, std::string name)
+        : LayoutChannelBase(bus, std::move(name), std::type_index(typeid(T))) {}
+
+    /**
+     * @brief 订阅消息
+     * @param handler 消息处理器
+     * @param owner 订阅者名称（通常为布局名称），供 endpoint() 解析
+     * @return 作用域订阅，处理器为空时返回无效订阅
+     */
+    MessageSubscription subscribe(Handler handler, std::string owner = {}) {
+        if (!handler) {
+            return {};
+        }
+        const uint32_t index = acquireSlot();
+        if (index == handlers_.size()) {
+            handlers_.push_back(std::move(handler));
+        } else {
+            handlers_[index] = std::move(handler);
+        }
+        owners_[index] = std::move(owner);
+        return MessageSubscription(*this, makeId(index));
+    }
+
+    /**
+     * @brief 把订阅者解析为端点
+     */
+    LayoutEndpoint<T> endpoint(const MessageSubscription& subscription) {
+        return LayoutEndpoint<T>(this, subscription.getId());
+    }
+
+    /**
+     * @brief 按订阅者名称解析端点（初始化时调用一次），找不到时返回无效端点
+     */
+    LayoutEndpoint<T> endpoint(const std::string& owner) {
+        for (uint32_t i = 0; i < active_.size(); ++i) {
+            if (active_[i] && owners_[i] == owner) {
+                return LayoutEndpoint<T>(this, makeId(i));
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief 同步广播消息
+     * @return 调用的订阅者数量
+     */
+    size_t publish(const T& message) {
+        DispatchGuard guard(*this);
+        // 本次分发开始后追加的订阅者不参与
+        const size_t count = handlers_.size();
+        size_t delivered = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (active_[i]) {
+                handlers_[i](message);
+                ++delivered;
+            }
+        }
+        return delivered;
+    }
+
+    /**
+     * @brief 同步发送给单个订阅者
+     * @return 订阅是否有效
+     */
+    bool sendTo(MessageSubscriptionId id, const T& message) {
+        const uint32_t index = findActiveSlot(id);
+        if (index == INVALID_SLOT) {
+            return false;
+        }
+        DispatchGuard guard(*this);
+        handlers_[index](message);
+        return true;
+    }
+
+    /**
+     * @brief 把消息移入队列，下一帧开始时广播
+     */
+    void post(T message) {
+        queue_.push_back(std::move(message));
+        if (queue_.size() == 1) {
+            notifyQueued();
+        }
+    }
+
+    size_t getQueuedCount() const override { return queue_.size(); }
+
+private:
+    void releaseHandler(uint32_t index) override {
+        handlers_[index] = nullptr;
+        owners_[index].clear();
+    }
+
+    size_t deliverQueued() override {
+        std::vector<T> batch;
+        batch.swap(queue_);
+        for (const T& message : batch) {
+            publish(message);
+        }
+        const size_t delivered = batch.size();
+        // 投递期间没有新消息时复用队列的容量
+        if (queue_.empty()) {
+            batch.clear();
+            queue_.swap(batch);
+        }
+        return delivered;
+    }
+
+    void discardQueued() override { queue_.clear(); }
+
+    std::deque<Handler> handlers_;  ///< 槽位 -> 处理器
+    std::vector<T> queue_;          ///< 等待投递的消息
+};
+
+/**
+ * @brief 布局消息总线，由 LayoutManager 持有
+ */
+class LayoutMessageBus {
+public:
+    LayoutMessageBus() = default;
+    ~LayoutMessageBus() = default;
+
+    LayoutMessageBus(const LayoutMessageBus&) = delete;
+    LayoutMessageBus& operator=(const LayoutMessageBus&) = delete;
+
+    /**
+     * @brief 取得通道，不存在时创建；返回的引用在总线生存期内有效，应在初始化时保存
+     * @throws std::logic_error 同名通道已用其他消息类型创建
+     */
+    template <typename T>
+    LayoutChannel<T>& channel(const std::string& name) {
+        auto it = channels_.find(name);
+        if (it == channels_.end()) {
+            it = channels_.emplace(name, std::make_unique<LayoutChannel<T>>(*this, name)).first;
+        } else if (it->second->getType() != std::type_index(typeid(T))) {
+            throw std::logic_error("布局消息通道类型不匹配: " + name);
+        }
+        return static_cast<LayoutChannel<T>&>(*it->second);
+    }
+
+    /**
+     * @brief 查找通道，不存在或类型不匹配时返回 nullptr
+     */
+    template <typename T>
+    LayoutChannel<T>* findChannel(const std::string& name) const {
+        auto it = channels_.find(name);
+        if (it == channels_.end() || it->second->getType() != std::type_index(typeid(T))) {
+            return nullptr;
+        }
+        return static_cast<LayoutChannel<T>*>(it->second.get());
+    }
+
+    /**
+     * @brief 投递所有通道中排队的消息，由主循环每帧调用一次
+     * 投递期间新排队的消息留到下一次调用
+     * @return 投递的消息数量
+     */
+    size_t deliverQueued();
+
+    /**
+     * @brief 是否有等待投递的消息
+     */
+    bool hasQueuedMessages() const { return !pendingChannels_.empty(); }
+
+    /**
+     * @brief 丢弃所有排队的消息（通道和订阅保留）
+     */
+    void discardQueued();
+
+    size_t getChannelCount() const { return channels_.size(); }
+
+private:
+    friend class LayoutChannelBase;
+
+    std::unordered_map<std::string, std::unique_ptr<LayoutChannelBase>> channels_; ///< 名称 -> 通道
+    std::vector<LayoutChannelBase*> pendingChannels_;   ///< 有排队消息的通道，按首次排队顺序
+};
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
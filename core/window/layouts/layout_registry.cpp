@@ -0,0 +1,277 @@
+/**
+ * @file layout_registry.cpp
+ * @brief 布局注册表实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "layout_registry.h"
+#include "layout_base.h"
+#include <algorithm>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+LayoutRegistry::LayoutRegistry()
+    : aliveCount_(0)
+    , version_(0)
+    , boundsVersion_(0)
+    , iterationDepth_(0) {
+}
+
+LayoutRegistry::~LayoutRegistry() {
+    clear();
+}
+
+LayoutRegistry::NameId LayoutRegistry::internName(const std::string& name) {
+    const size_t hash = std::hash<std::string>{}(name);
+    const NameId existing = findName(name, hash);
+    if (existing != INVALID_ID) {
+        return existing;
+    }
+    const NameId id = static_cast<NameId>(names_.size());
+    names_.push_back(name);
+    nameHashes_.push_back(hash);
+    nameHeads_.push_back(INVALID_ID);
+
+    // 装载率不超过一半，探测链保持很短
+    if (names_.size() * 2 > nameTable_.size()) {
+        rehashNames(std::max<size_t>(16, nameTable_.size() * 2));
+    } else {
+        insertNameSlot(id);
+    }
+    return id;
+}
+
+LayoutRegistry::NameId LayoutRegistry::findName(const std::string& name) const {
+    return findName(name, std::hash<std::string>{}(name));
+}
+
+LayoutRegistry::NameId LayoutRegistry::findName(const std::string& name, size_t hash) const {
+    if (nameTable_.empty()) {
+        return INVALID_ID;
+    }
+    const size_t mask = nameTable_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const NameId id = nameTable_[i];
+        if (id == INVALID_ID) {
+            return INVALID_ID;
+        }
+        if (nameHashes_[id] == hash && names_[id] == name) {
+            return id;
+        }
+    }
+}
+
+void LayoutRegistry::insertNameSlot(NameId id) {
+    const size_t mask = nameTable_.size() - 1;
+    size_t i = nameHashes_[id] & mask;
+    while (nameTable_[i] != INVALID_ID) {
+        i = (i + 1) & mask;
+    }
+    nameTable_[i] = id;
+}
+
+void LayoutRegistry::rehashNames(size_t slotCount) {
+    nameTable_.assign(slotCount, INVALID_ID);
+    for (NameId id = 0; id < names_.size(); ++id) {
+        insertNameSlot(id);
+    }
+}
+
+LayoutRegistry::WindowIndex LayoutRegistry::internWindow(const std::string& windowId) {
+    auto it = windowLookup_.find(windowId);
+    if (it != windowLookup_.end()) {
+        return it->second;
+    }
+    const WindowIndex index = static_cast<WindowIndex>(windowIds_.size());
+    windowIds_.push_back(windowId);
+    windowLookup_.emplace(windowId, index);
+    return index;
+}
+
+LayoutRegistry::WindowIndex LayoutRegistry::findWindowHashed(const std::string& windowId) const {
+    auto it = windowLookup_.find(windowId);
+    return it == windowLookup_.end() ? INVALID_ID : it->second;
+}
+
+LayoutHandle LayoutRegistry::insert(WindowIndex window, NameId name, std::unique_ptr<LayoutBase> layout,
+                                    LayoutPriority priority, bool system) {
+    if (!layout) {
+        return {};
+    }
+
+    // 同一窗口的同名布局被替换
+    erase(find(window, name));
+
+    uint32_t index;
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(flags_.size());
+        layouts_.emplace_back();
+        generations_.push_back(0);
+        flags_.push_back(0);
+        windows_.push_back(INVALID_ID);
+        nameIds_.push_back(INVALID_ID);
+        nextWithName_.push_back(INVALID_ID);
+        priorities_.push_back(LayoutPriority::NORMAL);
+        states_.push_back(LayoutState::INACTIVE);
+        metadata_.emplace_back();
+    }
+
+    layout->registry_ = this;
+    layout->registrySlot_ = index;
+
+    uint8_t flags = FLAG_ALIVE;
+    if (layout->isVisible()) {
+        flags |= FLAG_VISIBLE;
+    }
+    if (system) {
+        flags |= FLAG_SYSTEM;
+    }
+    if (layout->isLayoutInvalid()) {
+        flags |= FLAG_NEEDS_UPDATE;
+    }
+
+    layouts_[index] = std::move(layout);
+    flags_[index] = flags;
+    windows_[index] = window;
+    nameIds_[index] = name;
+    priorities_[index] = priority;
+    states_[index] = LayoutState::INACTIVE;
+    metadata_[index] = LayoutMetadata{};
+
+    nextWithName_[index] = nameHeads_[name];
+    nameHeads_[name] = index;
+    ++aliveCount_;
+    ++version_;
+    return handleAt(index);
+}
+
+void LayoutRegistry::erase(LayoutHandle handle) {
+    if (!isAlive(handle)) {
+        return;
+    }
+    releaseSlot(handle.index());
+}
+
+void LayoutRegistry::clear() {
+    for (uint32_t i = 0; i < flags_.size(); ++i) {
+        if (flags_[i] & FLAG_ALIVE) {
+            releaseSlot(i);
+        }
+    }
+}
+
+void LayoutRegistry::releaseSlot(uint32_t index) {
+    // 先从列中摘下再销毁，布局析构中访问注册表时看到的已是移除后的状态
+    std::unique_ptr<LayoutBase> layout = std::move(layouts_[index]);
+    layout->registry_ = nullptr;
+    unlinkName(index);
+    flags_[index] = 0;
+    generations_[index] = static_cast<uint8_t>(generations_[index] + 1);
+    metadata_[index] = LayoutMetadata{};
+    freeSlots_.push_back(index);
+    --aliveCount_;
+    ++version_;
+    if (iterationDepth_ > 0) {
+        // 遍历中的回调可能正在使用这个布局
+        pendingDestroy_.push_back(std::move(layout));
+        return;
+    }
+    layout.reset();
+}
+
+void LayoutRegistry::unlinkName(uint32_t index) {
+    uint32_t* link = &nameHeads_[nameIds_[index]];
+    while (*link != index) {
+        link = &nextWithName_[*link];
+    }
+    *link = nextWithName_[index];
+    nextWithName_[index] = INVALID_ID;
+}
+
+void LayoutRegistry::destroyPending() const {
+    // 析构中可能再移除其他布局（此时不在遍历中，立即销毁）
+    std::vector<std::unique_ptr<LayoutBase>> pending;
+    pending.swap(pendingDestroy_);
+    pending.clear();
+}
+
+LayoutHandle LayoutRegistry::find(WindowIndex window, NameId name) const {
+    if (window == INVALID_ID || name >= nameHeads_.size()) {
+        return {};
+    }
+    for (uint32_t i = nameHeads_[name]; i != INVALID_ID; i = nextWithName_[i]) {
+        if (windows_[i] == window) {
+            return handleAt(i);
+        }
+    }
+    return {};
+}
+
+LayoutHandle LayoutRegistry::find(const std::string& windowId, const std::string& name) const {
+    const WindowIndex window = findWindow(windowId);
+    if (window == INVALID_ID) {
+        return {};
+    }
+    return find(window, findName(name));
+}
+
+LayoutHandle LayoutRegistry::findAny(NameId name) const {
+    if (name >= nameHeads_.size()) {
+        return {};
+    }
+    uint32_t first = INVALID_ID;
+    for (uint32_t i = nameHeads_[name]; i != INVALID_ID; i = nextWithName_[i]) {
+        first = std::min(first, i);
+    }
+    return first == INVALID_ID ? LayoutHandle{} : handleAt(first);
+}
+
+void LayoutRegistry::setFlag(LayoutHandle handle, Flags flag, bool enabled) {
+    uint8_t& flags = flags_[handle.index()];
+    const uint8_t updated = enabled ? static_cast<uint8_t>(flags | flag) : static_cast<uint8_t>(flags & ~flag);
+    if ((flag & FLAG_VISIBLE) && updated != flags) {
+        ++boundsVersion_;
+    }
+    flags = updated;
+}
+
+void LayoutRegistry::setPriority(LayoutHandle handle, LayoutPriority priority) {
+    if (priorities_[handle.index()] != priority) {
+        priorities_[handle.index()] = priority;
+        ++version_;
+    }
+}
+
+void LayoutRegistry::syncFlag(uint32_t index, Flags flag, bool enabled) {
+    if (index < flags_.size() && (flags_[index] & FLAG_ALIVE)) {
+        setFlag(handleAt(index), flag, enabled);
+    }
+}
+
+void LayoutRegistry::collectByPriority(WindowIndex window, std::vector<LayoutHandle>& out) const {
+    out.clear();
+    for (uint32_t i = 0; i < flags_.size(); ++i) {
+        if ((flags_[i] & FLAG_ALIVE) && (window == INVALID_ID || windows_[i] == window)) {
+            out.push_back(handleAt(i));
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [this](LayoutHandle a, LayoutHandle b) {
+        const int priorityA = static_cast<int>(priorities_[a.index()]);
+        const int priorityB = static_cast<int>(priorities_[b.index()]);
+        if (priorityA != priorityB) {
+            return priorityA > priorityB;
+        }
+        return names_[nameIds_[a.index()]] < names_[nameIds_[b.index()]];
+    });
+}
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
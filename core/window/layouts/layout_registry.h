@@ -0,0 +1,353 @@
+/**
+ * @file layout_registry.h
+ * @brief 布局注册表：以 32 位句柄寻址的布局存储
+ * @details 布局实例按槽位存放，状态、可见性、优先级、脏标记等每帧访问的数据按列（结构数组）连续存储，
+ *          每帧的渲染、更新、事件分发只是对这些列的线性扫描。布局名称和窗口ID只在 API 边界驻留为整数，
+ *          内部不再按字符串查找。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <chrono>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+class LayoutBase;
+
+/**
+ * @brief 布局优先级
+ */
+enum class LayoutPriority {
+    LOWEST = 0,     ///< 最低优先级
+    LOW = 25,       ///< 低优先级
+    NORMAL = 50,    ///< 普通优先级
+    HIGH = 75,      ///< 高优先级
+    HIGHEST = 100   ///< 最高优先级
+};
+
+/**
+ * @brief 布局状态枚举
+ */
+enum class LayoutState {
+    INACTIVE,       ///< 未激活
+    ACTIVE,         ///< 已激活
+    VISIBLE,        ///< 可见
+    FOCUSED,        ///< 获得焦点
+    MODAL           ///< 模态状态
+};
+
+/**
+ * @brief 布局元数据（不在每帧路径上访问的部分）
+ */
+struct LayoutMetadata {
+    std::string lastFocused;                     ///< 最后获得焦点的布局
+    std::chrono::steady_clock::time_point lastActive; ///< 最后激活时间
+    std::unordered_map<std::string, std::string> customData; ///< 自定义数据
+};
+
+/**
+ * @brief 布局句柄：低 24 位为槽位索引，高 8 位为槽位代数
+ * 布局移除后槽位可被复用，代数随之递增，旧句柄不再解析到新布局
+ */
+struct LayoutHandle {
+    static constexpr uint32_t INDEX_BITS = 24;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t INVALID_VALUE = 0xFFFFFFFFu;
+
+    uint32_t value = INVALID_VALUE;
+
+    static LayoutHandle make(uint32_t index, uint32_t generation) {
+        return LayoutHandle{((generation & 0xFFu) << INDEX_BITS) | (index & INDEX_MASK)};
+    }
+
+    uint32_t index() const { return value & INDEX_MASK; }
+    uint32_t generation() const { return value >> INDEX_BITS; }
+    bool isValid() const { return value != INVALID_VALUE; }
+
+    bool operator==(const LayoutHandle& other) const { return value == other.value; }
+    bool operator!=(const LayoutHandle& other) const { return value != other.value; }
+};
+
+/**
+ * @brief 布局注册表
+ * 只在主线程使用。插入、移除和优先级变化使结构版本递增，缓存的遍历顺序据此失效。
+ * 同名布局按槽位串成链表，(窗口, 名称) 的查找只是沿名称链比较窗口索引。
+ */
+class LayoutRegistry {
+public:
+    using NameId = uint32_t;        ///< 驻留后的布局名称
+    using WindowIndex = uint32_t;   ///< 驻留后的窗口ID
+
+    static constexpr uint32_t INVALID_ID = 0xFFFFFFFFu;
+    static constexpr size_t LINEAR_WINDOW_LOOKUP = 8;  ///< 窗口数不超过该值时 findWindow() 线性比较
+
+    /**
+     * @brief 每个槽位的标记位
+     */
+    enum Flags : uint8_t {
+        FLAG_ALIVE = 1 << 0,        ///< 槽位中有布局
+        FLAG_VISIBLE = 1 << 1,      ///< 布局可见（与 LayoutBase::isVisible() 同步）
+        FLAG_SYSTEM = 1 << 2,       ///< 系统布局（标题栏、侧边栏等）
+        FLAG_DIRTY = 1 << 3,        ///< 布局状态需要保存
+        FLAG_NEEDS_UPDATE = 1 << 4  ///< 布局已失效，需要调用 updateLayout()（与 LayoutBase::isLayoutInvalid() 同步）
+    };
+
+    LayoutRegistry();
+    ~LayoutRegistry();
+
+    LayoutRegistry(const LayoutRegistry&) = delete;
+    LayoutRegistry& operator=(const LayoutRegistry&) = delete;
+
+    // === 名称驻留（API 边界） ===
+
+    /**
+     * @brief 驻留布局名称，已存在则返回原有ID
+     */
+    NameId internName(const std::string& name);
+
+    /**
+     * @brief 查找布局名称的ID，未驻留则返回 INVALID_ID
+     */
+    NameId findName(const std::string& name) const;
+
+    const std::string& getName(NameId name) const { return names_[name]; }
+
+    /**
+     * @brief 驻留窗口ID，已存在则返回原有索引
+     */
+    WindowIndex internWindow(const std::string& windowId);
+
+    /**
+     * @brief 查找窗口ID的索引，未驻留则返回 INVALID_ID
+     */
+    WindowIndex findWindow(const std::string& windowId) const {
+        // 窗口通常只有几个，逐个比较字符串比计算哈希快
+        if (windowIds_.size() > LINEAR_WINDOW_LOOKUP) {
+            return findWindowHashed(windowId);
+        }
+        for (WindowIndex index = 0; index < windowIds_.size(); ++index) {
+            if (windowIds_[index] == windowId) {
+                return index;
+            }
+        }
+        return INVALID_ID;
+    }
+
+    const std::string& getWindowId(WindowIndex window) const { return windowIds_[window]; }
+
+    /**
+     * @brief 已驻留的窗口数量，窗口索引小于该值
+     */
+    uint32_t getWindowCount() const { return static_cast<uint32_t>(windowIds_.size()); }
+
+    // === 布局存储 ===
+
+    /**
+     * @brief 插入布局，同一窗口中的同名布局被替换（旧布局销毁）
+     * @return 新布局的句柄
+     */
+    LayoutHandle insert(WindowIndex window, NameId name, std::unique_ptr<LayoutBase> layout,
+                        LayoutPriority priority, bool system);
+
+    /**
+     * @brief 移除并销毁布局，句柄无效时忽略
+     * @details forEach() 遍历期间移除的布局立即从注册表中摘下（句柄失效、不再被遍历），
+     *          实例延迟到最外层遍历结束后销毁，正在执行的回调仍可安全使用它
+     */
+    void erase(LayoutHandle handle);
+
+    /**
+     * @brief 移除所有布局（驻留的名称保留），遍历期间同样延迟销毁
+     */
+    void clear();
+
+    /**
+     * @brief 在指定窗口中查找布局
+     */
+    LayoutHandle find(WindowIndex window, NameId name) const;
+
+    /**
+     * @brief 按窗口ID和名称字符串查找布局（API 边界）
+     * @details 名称和窗口ID各查找一次，再沿同名链表比较整数窗口索引
+     */
+    LayoutHandle find(const std::string& windowId, const std::string& name) const;
+
+    /**
+     * @brief 在所有窗口中查找布局，返回槽位最小的一个
+     */
+    LayoutHandle findAny(NameId name) const;
+
+    /**
+     * @brief 句柄是否仍指向指定窗口中的同名布局（用于校验调用方缓存的句柄，只比较字符串，不做哈希查找）
+     */
+    bool matches(LayoutHandle handle, const std::string& windowId, const std::string& name) const {
+        return isAlive(handle) && names_[nameIds_[handle.index()]] == name &&
+               windowIds_[windows_[handle.index()]] == windowId;
+    }
+
+    /**
+     * @brief 句柄是否指向现存的布局
+     */
+    bool isAlive(LayoutHandle handle) const {
+        const uint32_t index = handle.index();
+        return handle.isValid() && index < flags_.size() && (flags_[index] & FLAG_ALIVE) &&
+               generations_[index] == handle.generation();
+    }
+
+    /**
+     * @brief 解析句柄，无效时返回 nullptr
+     */
+    LayoutBase* get(LayoutHandle handle) const { return isAlive(handle) ? layouts_[handle.index()].get() : nullptr; }
+
+    /**
+     * @brief 槽位对应的句柄（槽位须有布局）
+     */
+    LayoutHandle handleAt(uint32_t index) const { return LayoutHandle::make(index, generations_[index]); }
+
+    /**
+     * @brief 现存布局数量
+     */
+    size_t size() const { return aliveCount_; }
+
+    /**
+     * @brief 槽位总数，遍历时索引小于该值
+     */
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(flags_.size()); }
+
+    /**
+     * @brief 结构版本：插入、移除和优先级变化时递增
+     */
+    uint64_t getVersion() const { return version_; }
+
+    /**
+     * @brief 命中范围版本：布局位置、大小或可见性变化时递增，事件分发据此重建命中网格
+     */
+    uint64_t getBoundsVersion() const { return boundsVersion_; }
+
+    /**
+     * @brief 由 LayoutBase 在位置或大小变化时调用
+     */
+    void touchBounds() { ++boundsVersion_; }
+
+    // === 按列访问（参数为有效句柄） ===
+
+    WindowIndex getWindow(LayoutHandle handle) const { return windows_[handle.index()]; }
+    NameId getNameId(LayoutHandle handle) const { return nameIds_[handle.index()]; }
+    const std::string& getName(LayoutHandle handle) const { return names_[nameIds_[handle.index()]]; }
+
+    bool hasFlags(LayoutHandle handle, uint8_t flags) const { return (flags_[handle.index()] & flags) == flags; }
+    void setFlag(LayoutHandle handle, Flags flag, bool enabled);
+
+    LayoutPriority getPriority(LayoutHandle handle) const { return priorities_[handle.index()]; }
+    void setPriority(LayoutHandle handle, LayoutPriority priority);
+
+    LayoutState getState(LayoutHandle handle) const { return states_[handle.index()]; }
+    void setState(LayoutHandle handle, LayoutState state) { states_[handle.index()] = state; }
+
+    LayoutMetadata& getMetadata(LayoutHandle handle) { return metadata_[handle.index()]; }
+    const LayoutMetadata& getMetadata(LayoutHandle handle) const { return metadata_[handle.index()]; }
+
+    /**
+     * @brief 由 LayoutBase 调用，使可见性、失效标记与布局一致
+     */
+    void syncFlag(uint32_t index, Flags flag, bool enabled);
+
+    // === 遍历 ===
+
+    /**
+     * @brief 按槽位顺序遍历窗口中带有指定标记的布局
+     * @param window 窗口索引，INVALID_ID 表示所有窗口
+     * @param flags 需要同时具备的标记（FLAG_ALIVE 总是隐含）
+     * @param callback 签名为 void(LayoutHandle, LayoutBase&)
+     * @details 回调中可以修改可见性等标记；插入或移除布局后本次遍历继续使用新的槽位数据，
+     *          移除的布局在最外层遍历结束后才销毁（见 erase()）
+     */
+    template <typename F>
+    void forEach(WindowIndex window, uint8_t flags, F&& callback) const {
+        IterationGuard guard(*this);
+        const uint8_t required = static_cast<uint8_t>(flags | FLAG_ALIVE);
+        for (uint32_t i = 0; i < flags_.size(); ++i) {
+            if ((flags_[i] & required) == required && (window == INVALID_ID || windows_[i] == window)) {
+                callback(LayoutHandle::make(i, generations_[i]), *layouts_[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief 收集窗口中的布局，按优先级从高到低、同优先级按名称排序
+     * @param window 窗口索引，INVALID_ID 表示所有窗口
+     * @param out 输出的句柄列表（先清空）
+     */
+    void collectByPriority(WindowIndex window, std::vector<LayoutHandle>& out) const;
+
+private:
+    /**
+     * @brief 最外层遍历结束（包括回调抛出异常）时销毁遍历期间移除的布局
+     */
+    class IterationGuard {
+    public:
+        explicit IterationGuard(const LayoutRegistry& registry) : registry_(registry) {
+            ++registry_.iterationDepth_;
+        }
+        ~IterationGuard() {
+            if (--registry_.iterationDepth_ == 0 && !registry_.pendingDestroy_.empty()) {
+                registry_.destroyPending();
+            }
+        }
+
+    private:
+        const LayoutRegistry& registry_;
+    };
+
+    /**
+     * @brief 按预先计算的哈希值查找名称
+     */
+    NameId findName(const std::string& name, size_t hash) const;
+    WindowIndex findWindowHashed(const std::string& windowId) const;
+    void insertNameSlot(NameId id);
+    void rehashNames(size_t slotCount);
+
+    void releaseSlot(uint32_t index);
+    void unlinkName(uint32_t index);
+    void destroyPending() const;
+
+    // 按槽位的列
+    std::vector<std::unique_ptr<LayoutBase>> layouts_; ///< 布局实例
+    std::vector<uint8_t> generations_;                ///< 槽位代数
+    std::vector<uint8_t> flags_;                      ///< 标记位
+    std::vector<WindowIndex> windows_;                ///< 所属窗口
+    std::vector<NameId> nameIds_;                     ///< 布局名称
+    std::vector<uint32_t> nextWithName_;              ///< 同名链表中的下一个槽位
+    std::vector<LayoutPriority> priorities_;          ///< 优先级
+    std::vector<LayoutState> states_;                 ///< 状态
+    std::vector<LayoutMetadata> metadata_;            ///< 元数据
+    std::vector<uint32_t> freeSlots_;                 ///< 空闲槽位
+    size_t aliveCount_;                               ///< 现存布局数量
+    uint64_t version_;                                ///< 结构版本
+    uint64_t boundsVersion_;                          ///< 命中范围版本
+
+    // 遍历期间移除的布局
+    mutable uint32_t iterationDepth_;                                  ///< 嵌套的 forEach() 层数
+    mutable std::vector<std::unique_ptr<LayoutBase>> pendingDestroy_;  ///< 等待遍历结束后销毁的布局
+
+    // API 边界的驻留表
+    std::vector<NameId> nameTable_;                       ///< 名称 -> ID 的开放寻址表（槽位数为 2 的幂，线性探测）
+    std::vector<size_t> nameHashes_;                      ///< ID -> 名称的哈希值
+    std::vector<std::string> names_;                      ///< ID -> 名称
+    std::vector<uint32_t> nameHeads_;                     ///< ID -> 同名链表的第一个槽位
+    std::unordered_map<std::string, WindowIndex> windowLookup_; ///< 窗口ID -> 索引
+    std::vector<std::string> windowIds_;                  ///< 索引 -> 窗口ID
+};
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
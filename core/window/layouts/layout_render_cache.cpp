@@ -0,0 +1,297 @@
+/**
+ * @file layout_render_cache.cpp
+ * @brief 布局离屏渲染缓存实现
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "layout_render_cache.h"
+#include "layout_base.h"
+#include "../../render/draw_data_hash.h"
+#include "../../utils/logger.h"
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <imgui_impl_sdlrenderer2.h>
+#include <cstring>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+namespace {
+
+/**
+ * @brief 预乘 alpha 的混合模式：dst = src + dst * (1 - srcA)，颜色和 alpha 相同
+ */
+SDL_BlendMode premultipliedAlphaBlendMode() {
+    static const SDL_BlendMode mode = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    return mode;
+}
+
+/**
+ * @brief 绘制列表是否属于指定窗口（包括它的子窗口，子窗口名为 "父窗口/子窗口"）
+ */
+bool isOwnedBy(const ImDrawList* list, const std::string& windowName) {
+    const char* owner = list->_OwnerName;
+    if (!owner) {
+        return false;
+    }
+    const size_t length = windowName.size();
+    return std::strncmp(owner, windowName.c_str(), length) == 0 && (owner[length] == '\0' || owner[length] == '/');
+}
+
+} // namespace
+
+LayoutRenderCache::LayoutRenderCache(const std::string& layoutName, const std::string& imguiWindowName)
+    : windowName_(imguiWindowName)
+    , texture_(nullptr)
+    , textureWidth_(0)
+    , textureHeight_(0)
+    , valid_(false)
+    , pendingCapture_(false)
+    , quietFrames_(0)
+    , windowX_(0.0f)
+    , windowY_(0.0f)
+    , windowWidth_(0.0f)
+    , windowHeight_(0.0f)
+    , layoutX_(0.0f)
+    , layoutY_(0.0f)
+    , layoutWidth_(0.0f)
+    , layoutHeight_(0.0f)
+    , displayWidth_(0.0f)
+    , displayHeight_(0.0f) {
+    stats_.layoutName = layoutName;
+}
+
+LayoutRenderCache::~LayoutRenderCache() {
+    destroyTexture();
+}
+
+void LayoutRenderCache::render(LayoutBase& layout) {
+    const bool quiet = layout.isRenderCacheable() && !hasInput();
+    if (!quiet) {
+        invalidate();
+    } else if (valid_ && !matchesGeometry(layout)) {
+        invalidate();
+    }
+
+    if (valid_) {
+        replay();
+        ++stats_.hits;
+        if (stats_.cachedVertices > IMAGE_VERTICES) {
+            stats_.savedVertices += stats_.cachedVertices - IMAGE_VERTICES;
+        }
+        return;
+    }
+
+    layout.render();
+    ++stats_.misses;
+    if (quiet && ++quietFrames_ >= CAPTURE_AFTER_QUIET_FRAMES) {
+        pendingCapture_ = true;
+        rememberGeometry(layout);
+    }
+}
+
+void LayoutRenderCache::capture(SDL_Renderer* renderer, const ImDrawData* drawData) {
+    if (!pendingCapture_) {
+        return;
+    }
+    pendingCapture_ = false;
+
+    // 字体等纹理还没上传时捕获会缺字，等下一次
+    if (!renderer || !drawData || !drawData->Valid || Render::drawDataHasPendingTextureUpdates(drawData)) {
+        return;
+    }
+    ImGuiWindow* window = ImGui::FindWindowByName(windowName_.c_str());
+    if (!window || !window->Active || window->Hidden || window->Size.x <= 0.0f || window->Size.y <= 0.0f) {
+        return;
+    }
+
+    // 与后端相同的像素尺寸换算：渲染器已设置缩放时由 SDL 负责缩放
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+    const float pixelScaleX = scaleX == 1.0f ? drawData->FramebufferScale.x : 1.0f;
+    const float pixelScaleY = scaleY == 1.0f ? drawData->FramebufferScale.y : 1.0f;
+    const int width = static_cast<int>(window->Size.x * pixelScaleX);
+    const int height = static_cast<int>(window->Size.y * pixelScaleY);
+    if (width <= 0 || height <= 0 || !ensureTexture(renderer, width, height)) {
+        return;
+    }
+
+    // 复制属于该窗口的绘制列表并平移到纹理原点，ImGui 自己的列表保持不变
+    ImDrawData local;
+    local.Valid = true;
+    local.DisplayPos = window->Pos;
+    local.DisplaySize = window->Size;
+    local.FramebufferScale = drawData->FramebufferScale;
+    local.OwnerViewport = drawData->OwnerViewport;
+    local.Textures = nullptr;
+    for (int i = 0; i < drawData->CmdListsCount; ++i) {
+        const ImDrawList* source = drawData->CmdLists[i];
+        if (!isOwnedBy(source, windowName_)) {
+            continue;
+        }
+        ImDrawList* copy = source->CloneOutput();
+        for (ImDrawVert& vertex : copy->VtxBuffer) {
+            vertex.pos.x -= window->Pos.x;
+            vertex.pos.y -= window->Pos.y;
+        }
+        local.CmdLists.push_back(copy);
+        local.TotalVtxCount += copy->VtxBuffer.Size;
+        local.TotalIdxCount += copy->IdxBuffer.Size;
+    }
+    local.CmdListsCount = local.CmdLists.Size;
+
+    bool captured = false;
+    if (local.CmdListsCount > 0) {
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+        if (SDL_SetRenderTarget(renderer, texture_) == 0) {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderClear(renderer);
+            ImGui_ImplSDLRenderer2_RenderDrawData(&local, renderer);
+            SDL_SetRenderTarget(renderer, previousTarget);
+            captured = true;
+        } else {
+            DEARTS_LOG_WARN("布局缓存: 无法切换渲染目标 " + stats_.layoutName + ": " + SDL_GetError());
+        }
+    }
+    for (ImDrawList* copy : local.CmdLists) {
+        IM_DELETE(copy);
+    }
+    if (!captured) {
+        return;
+    }
+
+    windowX_ = window->Pos.x;
+    windowY_ = window->Pos.y;
+    windowWidth_ = window->Size.x;
+    windowHeight_ = window->Size.y;
+    stats_.cachedVertices = static_cast<uint32_t>(local.TotalVtxCount);
+    ++stats_.captures;
+    valid_ = true;
+    DEARTS_LOG_TRACE("布局缓存: 已捕获 {} ({}x{}，{} 个顶点)", stats_.layoutName, width, height,
+                     stats_.cachedVertices);
+}
+
+void LayoutRenderCache::invalidate() {
+    valid_ = false;
+    pendingCapture_ = false;
+    quietFrames_ = 0;
+}
+
+void LayoutRenderCache::releaseTexture() {
+    destroyTexture();
+    invalidate();
+}
+
+bool LayoutRenderCache::hasInput() const {
+    ImGuiContext& g = *ImGui::GetCurrentContext();
+    ImGuiWindow* window = ImGui::FindWindowByName(windowName_.c_str());
+    if (!window) {
+        return true;
+    }
+
+    // 键盘、文本和焦点事件不区分位置，一律正常渲染（快捷键在布局的 render() 里处理）
+    for (const ImGuiInputEvent& event : g.InputEventsTrail) {
+        if (event.Type == ImGuiInputEventType_Key || event.Type == ImGuiInputEventType_Text ||
+            event.Type == ImGuiInputEventType_Focus) {
+            return true;
+        }
+    }
+
+    // 拖拽可能从别处开始、在布局上结束，按键按住期间不使用缓存
+    const ImGuiIO& io = g.IO;
+    for (bool down : io.MouseDown) {
+        if (down) {
+            return true;
+        }
+    }
+    if (ImGui::IsMousePosValid(&io.MousePos) && window->Rect().Contains(io.MousePos)) {
+        return true;
+    }
+
+    if (g.NavWindow && g.NavWindow->RootWindow == window) {
+        return true;
+    }
+    return g.ActiveId != 0 && g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window;
+}
+
+bool LayoutRenderCache::matchesGeometry(const LayoutBase& layout) const {
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    return layout.getX() == layoutX_ && layout.getY() == layoutY_ &&
+           layout.getWidth() == layoutWidth_ && layout.getHeight() == layoutHeight_ &&
+           displaySize.x == displayWidth_ && displaySize.y == displayHeight_;
+}
+
+void LayoutRenderCache::replay() {
+    const ImVec2 min(windowX_, windowY_);
+    const ImVec2 max(windowX_ + windowWidth_, windowY_ + windowHeight_);
+
+    // 同名窗口保持层级顺序和悬停检测，内容只有一张纹理
+    ImGui::SetNextWindowPos(min);
+    ImGui::SetNextWindowSize(ImVec2(windowWidth_, windowHeight_));
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.0f);
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove |
+                                   ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoBringToFrontOnFocus |
+                                   ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav |
+                                   ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoScrollWithMouse;
+    if (ImGui::Begin(windowName_.c_str(), nullptr, flags)) {
+        ImGui::GetWindowDrawList()->AddImage(static_cast<ImTextureID>(reinterpret_cast<intptr_t>(texture_)), min, max);
+    }
+    ImGui::End();
+    ImGui::PopStyleVar(3);
+}
+
+void LayoutRenderCache::rememberGeometry(const LayoutBase& layout) {
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    layoutX_ = layout.getX();
+    layoutY_ = layout.getY();
+    layoutWidth_ = layout.getWidth();
+    layoutHeight_ = layout.getHeight();
+    displayWidth_ = displaySize.x;
+    displayHeight_ = displaySize.y;
+}
+
+bool LayoutRenderCache::ensureTexture(SDL_Renderer* renderer, int width, int height) {
+    if (texture_ && textureWidth_ == width && textureHeight_ == height) {
+        return true;
+    }
+    destroyTexture();
+    if (!SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
+    texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture_) {
+        DEARTS_LOG_WARN("布局缓存: 创建目标纹理失败 " + stats_.layoutName + ": " + SDL_GetError());
+        return false;
+    }
+    // 捕获时 ImGui 以 SDL_BLENDMODE_BLEND 画到清成全透明的纹理上，颜色已经乘过一次 alpha（预乘）；
+    // 合成时再用 SDL_BLENDMODE_BLEND 会第二次乘 alpha，半透明和抗锯齿边缘变暗，所以按预乘 alpha 合成
+    if (SDL_SetTextureBlendMode(texture_, premultipliedAlphaBlendMode()) != 0) {
+        DEARTS_LOG_WARN("布局缓存: 渲染器不支持预乘 alpha 混合 " + stats_.layoutName + ": " + SDL_GetError());
+        destroyTexture();
+        return false;
+    }
+    textureWidth_ = width;
+    textureHeight_ = height;
+    return true;
+}
+
+void LayoutRenderCache::destroyTexture() {
+    if (texture_) {
+        SDL_DestroyTexture(texture_);
+        texture_ = nullptr;
+    }
+    textureWidth_ = 0;
+    textureHeight_ = 0;
+    valid_ = false;
+}
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
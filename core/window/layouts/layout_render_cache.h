@@ -0,0 +1,139 @@
+/**
+ * @file layout_render_cache.h
+ * @brief 布局离屏渲染缓存
+ * @details 标题栏、侧边栏这类布局在没有输入时每帧生成的控件完全相同。开启缓存的布局在画面稳定后，
+ *          把它的 ImGui 窗口绘制列表渲染到一张目标纹理，之后的帧只提交一个同名窗口和一个贴图四边形，
+ *          不再执行布局的 render()：
+ *          - 鼠标位于布局区域内、按下鼠标、有键盘或文本输入、布局窗口获得焦点时按正常方式渲染；
+ *          - 布局位置尺寸、显示区域变化，或通过 LayoutManager::markLayoutDirty 标记后缓存失效；
+ *          - 渲染目标重置后缓存失效，渲染设备重置后纹理销毁并在下一次捕获时重建；
+ *          - 布局可重写 LayoutBase::isRenderCacheable() 在动画、弹窗等期间暂停缓存；
+ *          - 失效后连续 CAPTURE_AFTER_QUIET_FRAMES 帧无输入才重新捕获，避免把悬停高亮等过渡状态存进纹理。
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+
+struct ImDrawData;
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+class LayoutBase;
+
+/**
+ * @brief 单个布局的缓存统计
+ */
+struct LayoutRenderCacheStats {
+    std::string layoutName;         ///< 布局名称
+    uint64_t hits = 0;              ///< 使用缓存纹理的帧数
+    uint64_t misses = 0;            ///< 正常渲染的帧数
+    uint64_t captures = 0;          ///< 捕获次数
+    uint64_t savedVertices = 0;     ///< 命中时少提交的顶点数（累计）
+    uint32_t cachedVertices = 0;    ///< 当前缓存对应的顶点数
+
+    /**
+     * @brief 命中率（0~1）
+     */
+    double hitRate() const {
+        const uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * @brief 布局离屏渲染缓存
+ * @details 每个开启缓存的布局对应一个实例，由 LayoutManager 持有。非线程安全，只在渲染线程使用。
+ */
+class LayoutRenderCache {
+public:
+    static constexpr uint32_t CAPTURE_AFTER_QUIET_FRAMES = 2;  ///< 重新捕获前需要的连续无输入帧数
+    static constexpr uint32_t IMAGE_VERTICES = 4;              ///< 命中时提交的顶点数
+
+    /**
+     * @brief 构造函数
+     * @param layoutName 布局名称
+     * @param imguiWindowName 布局绘制所用的 ImGui 窗口名称
+     */
+    LayoutRenderCache(const std::string& layoutName, const std::string& imguiWindowName);
+    ~LayoutRenderCache();
+
+    LayoutRenderCache(const LayoutRenderCache&) = delete;
+    LayoutRenderCache& operator=(const LayoutRenderCache&) = delete;
+
+    /**
+     * @brief 渲染布局，缓存有效时用缓存纹理代替 layout.render()
+     * @details 在 ImGui::NewFrame() 与 ImGui::Render() 之间调用
+     */
+    void render(LayoutBase& layout);
+
+    /**
+     * @brief 本帧需要捕获时把布局窗口的绘制列表渲染到目标纹理
+     * @details 在 ImGui::Render() 之后调用，会临时切换渲染目标，结束后恢复
+     * @param renderer 主窗口的 SDL 渲染器
+     * @param drawData 本帧的绘制数据
+     */
+    void capture(SDL_Renderer* renderer, const ImDrawData* drawData);
+
+    /**
+     * @brief 使缓存失效，下一帧起正常渲染
+     */
+    void invalidate();
+
+    /**
+     * @brief 销毁缓存纹理并使缓存失效，下一次捕获时重新创建
+     * @details 渲染设备重置（SDL_RENDER_DEVICE_RESET）后旧纹理已不可用
+     */
+    void releaseTexture();
+
+    bool isValid() const { return valid_; }
+    const LayoutRenderCacheStats& getStats() const { return stats_; }
+
+private:
+    /**
+     * @brief 本帧是否有会影响布局内容的输入
+     */
+    bool hasInput() const;
+
+    /**
+     * @brief 布局位置尺寸或显示区域是否与捕获时一致
+     */
+    bool matchesGeometry(const LayoutBase& layout) const;
+
+    void replay();
+    void rememberGeometry(const LayoutBase& layout);
+    bool ensureTexture(SDL_Renderer* renderer, int width, int height);
+    void destroyTexture();
+
+    std::string windowName_;        ///< ImGui 窗口名称
+    SDL_Texture* texture_;          ///< 缓存纹理
+    int textureWidth_;
+    int textureHeight_;
+    bool valid_;
+    bool pendingCapture_;           ///< 本帧结束后捕获
+    uint32_t quietFrames_;          ///< 连续无输入的正常渲染帧数
+
+    // 捕获时的几何信息，变化即失效
+    float windowX_;
+    float windowY_;
+    float windowWidth_;
+    float windowHeight_;
+    float layoutX_;
+    float layoutY_;
+    float layoutWidth_;
+    float layoutHeight_;
+    float displayWidth_;
+    float displayHeight_;
+
+    LayoutRenderCacheStats stats_;
+};
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
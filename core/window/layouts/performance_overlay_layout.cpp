@@ -0,0 +1,351 @@
+#include "performance_overlay_layout.h"
+#include "layout_manager.h"
+#include "../../app/application_manager.h"
+#include "../../app/frame_scheduler.h"
+#include "../../app/task_scheduler.h"
+#include "../../render/renderer.h"
+#include "../../utils/logger.h"
+#include "../../utils/memory_tracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <imgui.h>
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+namespace {
+
+constexpr auto PUBLISH_INTERVAL = std::chrono::milliseconds(500);  ///< 区间统计和分位数的刷新周期
+
+/**
+ * @brief 计算已排序样本的分位数
+ */
+float percentile(const std::vector<float>& sorted, float p) {
+    if (sorted.empty()) {
+        return 0.0f;
+    }
+    const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f));
+    return sorted[index];
+}
+
+/**
+ * @brief 以 KB/MB 形式格式化字节数
+ */
+void formatBytes(char* buffer, size_t size, uint64_t bytes) {
+    if (bytes >= 1024ull * 1024ull) {
+        std::snprintf(buffer, size, "%.1f MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    } else {
+        std::snprintf(buffer, size, "%.1f KB", static_cast<double>(bytes) / 1024.0);
+    }
+}
+
+} // namespace
+
+/**
+ * PerformanceOverlayLayout构造函数
+ */
+PerformanceOverlayLayout::PerformanceOverlayLayout()
+    : LayoutBase("PerformanceOverlay")
+    , appStats_(nullptr)
+    , frameTimes_{}
+    , frameIndex_(0)
+    , frameSamples_(0)
+    , p50_(0.0f)
+    , p95_(0.0f)
+    , p99_(0.0f)
+    , maxFrameTime_(0.0f)
+    , periodFrames_(0)
+    , lastVertices_(0)
+    , lastIndices_(0)
+    , lastDrawCalls_(0)
+    , lastCommandLists_(0)
+    , lastAllocations_(0)
+    , lastAllocatedBytes_(0)
+    , frameVertices_(0)
+    , frameIndices_(0)
+    , frameDrawCalls_(0)
+    , frameCommandLists_(0)
+    , frameAllocations_(0)
+    , frameAllocatedBytes_(0)
+    , liveBytes_(0)
+    , framesSkipped_(0)
+    , hasBaseline_(false) {
+    // 默认隐藏，按快捷键显示
+    visible_ = false;
+    sortScratch_.reserve(FRAME_HISTORY);
+    zoneRows_.reserve(MAX_ZONE_ROWS);
+}
+
+PerformanceOverlayLayout::~PerformanceOverlayLayout() {
+    if (visible_) {
+        Utils::Profiler::getInstance().setLiveStatsEnabled(false);
+    }
+}
+
+bool PerformanceOverlayLayout::isToggleShortcut(const SDL_Event& event) {
+    return event.type == SDL_KEYDOWN && event.key.repeat == 0 && event.key.keysym.sym == TOGGLE_KEY;
+}
+
+void PerformanceOverlayLayout::setOverlayVisible(bool visible) {
+    if (visible == visible_) {
+        return;
+    }
+    visible_ = visible;
+    Utils::Profiler::getInstance().setLiveStatsEnabled(visible);
+    if (visible) {
+        resetSamples();
+    }
+    DEARTS_LOG_DEBUG("性能浮层{}", visible ? "已显示" : "已隐藏");
+}
+
+void PerformanceOverlayLayout::updateLayout(float width, float height) {
+    width_ = width;
+    height_ = height;
+}
+
+void PerformanceOverlayLayout::handleEvent(const SDL_Event& event) {
+    (void)event;
+}
+
+void PerformanceOverlayLayout::resetSamples() {
+    frameTimes_.fill(0.0f);
+    frameIndex_ = 0;
+    frameSamples_ = 0;
+    p50_ = p95_ = p99_ = maxFrameTime_ = 0.0f;
+    zoneAccumulator_.clear();
+    zoneRows_.clear();
+    periodFrames_ = 0;
+    lastPublish_ = std::chrono::steady_clock::now();
+    hasBaseline_ = false;
+}
+
+void PerformanceOverlayLayout::sampleFrame() {
+    // 帧间隔
+    const float frameMs = ImGui::GetIO().DeltaTime * 1000.0f;
+    frameTimes_[frameIndex_] = frameMs;
+    frameIndex_ = (frameIndex_ + 1) % FRAME_HISTORY;
+    frameSamples_ = std::min(frameSamples_ + 1, FRAME_HISTORY);
+
+    // 区间耗时（调用线程，即渲染线程）
+    Utils::Profiler::getInstance().collectLiveStats(zoneTotals_, zoneMilliseconds_);
+    for (size_t i = 0; i < zoneTotals_.size(); ++i) {
+        const auto& total = zoneTotals_[i];
+        auto it = std::find_if(zoneAccumulator_.begin(), zoneAccumulator_.end(),
+                               [&total](const ZoneRow& row) { return row.name == total.name; });
+        if (it == zoneAccumulator_.end()) {
+            zoneAccumulator_.push_back({total.name, 0.0, 0.0, total.depth});
+            it = zoneAccumulator_.end() - 1;
+        }
+        it->msPerFrame += zoneMilliseconds_[i];
+        it->callsPerFrame += static_cast<double>(total.calls);
+        it->depth = total.depth;
+    }
+    ++periodFrames_;
+
+    // 绘制数据与分配计数：累计值取差
+    const Render::RenderStats renderStats = Render::RenderManager::getInstance().getGlobalStats();
+    const Utils::AllocationCounters allocs = Utils::MemoryTracker::counters();
+    if (hasBaseline_) {
+        frameVertices_ = renderStats.vertices_rendered - lastVertices_;
+        frameIndices_ = renderStats.indices_rendered - lastIndices_;
+        frameDrawCalls_ = renderStats.draw_calls - lastDrawCalls_;
+        frameCommandLists_ = renderStats.command_lists - lastCommandLists_;
+        frameAllocations_ = allocs.allocations - lastAllocations_;
+        frameAllocatedBytes_ = allocs.bytesAllocated - lastAllocatedBytes_;
+    }
+    lastVertices_ = renderStats.vertices_rendered;
+    lastIndices_ = renderStats.indices_rendered;
+    lastDrawCalls_ = renderStats.draw_calls;
+    lastCommandLists_ = renderStats.command_lists;
+    lastAllocations_ = allocs.allocations;
+    lastAllocatedBytes_ = allocs.bytesAllocated;
+    liveBytes_ = allocs.liveBytes();
+    framesSkipped_ = renderStats.frames_skipped;
+    hasBaseline_ = true;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastPublish_ >= PUBLISH_INTERVAL) {
+        publish();
+        lastPublish_ = now;
+    }
+}
+
+void PerformanceOverlayLayout::publish() {
+    // 帧时间分位数
+    sortScratch_.assign(frameTimes_.begin(), frameTimes_.begin() + static_cast<std::ptrdiff_t>(frameSamples_));
+    std::sort(sortScratch_.begin(), sortScratch_.end());
+    p50_ = percentile(sortScratch_, 0.50f);
+    p95_ = percentile(sortScratch_, 0.95f);
+    p99_ = percentile(sortScratch_, 0.99f);
+    maxFrameTime_ = sortScratch_.empty() ? 0.0f : sortScratch_.back();
+
+    // 区间耗时按周期内帧数平均
+    zoneRows_.clear();
+    if (periodFrames_ > 0) {
+        std::sort(zoneAccumulator_.begin(), zoneAccumulator_.end(),
+                  [](const ZoneRow& a, const ZoneRow& b) { return a.msPerFrame > b.msPerFrame; });
+        const size_t rows = std::min(zoneAccumulator_.size(), MAX_ZONE_ROWS);
+        for (size_t i = 0; i < rows; ++i) {
+            ZoneRow row = zoneAccumulator_[i];
+            row.msPerFrame /= periodFrames_;
+            row.callsPerFrame /= periodFrames_;
+            zoneRows_.push_back(row);
+        }
+    }
+    zoneAccumulator_.clear();
+    periodFrames_ = 0;
+    renderCaches_ = LayoutManager::getInstance().getRenderCacheStats();
+}
+
+void PerformanceOverlayLayout::render() {
+    if (!visible_) {
+        return;
+    }
+
+    // 显示期间持续绘制，否则空闲等待会让帧时间统计失去意义
+    App::FrameScheduler::getInstance().requestRedraw();
+
+    sampleFrame();
+
+    const ImGuiViewport* viewport = ImGui::GetMainViewport();
+    const float padding = 10.0f;
+    ImGui::SetNextWindowPos(ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - padding, viewport->WorkPos.y + 40.0f),
+                            ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.85f);
+
+    const ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration |
+                                   ImGuiWindowFlags_AlwaysAutoResize |
+                                   ImGuiWindowFlags_NoSavedSettings |
+                                   ImGuiWindowFlags_NoFocusOnAppearing |
+                                   ImGuiWindowFlags_NoNav |
+                                   ImGuiWindowFlags_NoMove;
+
+    if (ImGui::Begin("##PerformanceOverlay", nullptr, flags)) {
+        ImGui::Text("性能 (F3 关闭)");
+        ImGui::Separator();
+        renderFrameTimes();
+        ImGui::Separator();
+        renderZones();
+        ImGui::Separator();
+        renderCounters();
+    }
+    ImGui::End();
+}
+
+void PerformanceOverlayLayout::renderFrameTimes() {
+    const float latest = frameTimes_[(frameIndex_ + FRAME_HISTORY - 1) % FRAME_HISTORY];
+    ImGui::Text("帧时间 %.2f ms (%.0f FPS)", latest, latest > 0.0f ? 1000.0f / latest : 0.0f);
+    ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", p50_, p95_, p99_, maxFrameTime_);
+
+    // 按时间顺序绘制环形历史
+    const int offset = frameSamples_ < FRAME_HISTORY ? 0 : static_cast<int>(frameIndex_);
+    const float scaleMax = std::max(p99_ * 1.5f, 16.7f);
+    ImGui::PlotHistogram("##FrameTimes", frameTimes_.data(), static_cast<int>(frameSamples_), offset,
+                         nullptr, 0.0f, scaleMax, ImVec2(260.0f, 48.0f));
+
+    if (appStats_) {
+        char memory[32];
+        char peak[32];
+        formatBytes(memory, sizeof(memory), appStats_->memory_usage);
+        formatBytes(peak, sizeof(peak), appStats_->peak_memory_usage);
+        ImGui::Text("FPS %.1f (平均 %.1f)  工作 %.2f ms", appStats_->current_fps, appStats_->average_fps,
+                    appStats_->frame_time);
+        ImGui::Text("内存 %s (峰值 %s)", memory, peak);
+        const App::FramePacingStats& pacing = appStats_->pacing;
+        if (pacing.frames > 0) {
+            ImGui::Text("帧率控制误差 p50 %.0f  p99 %.0f  max %.0f us  错过 %llu  丢弃 %llu",
+                        pacing.p50_error_us, pacing.p99_error_us, pacing.max_error_us,
+                        static_cast<unsigned long long>(pacing.missed_deadlines),
+                        static_cast<unsigned long long>(pacing.dropped_frames));
+        }
+    }
+}
+
+void PerformanceOverlayLayout::renderZones() {
+#ifdef DEARTS_ENABLE_PROFILING
+    if (zoneRows_.empty()) {
+        ImGui::TextDisabled("等待区间数据...");
+        return;
+    }
+    if (ImGui::BeginTable("##Zones", 3, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("区间");
+        ImGui::TableSetupColumn("ms/帧");
+        ImGui::TableSetupColumn("次/帧");
+        ImGui::TableHeadersRow();
+        for (const ZoneRow& row : zoneRows_) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + static_cast<float>(std::min<uint32_t>(row.depth, 8)) * 8.0f);
+            ImGui::TextUnformatted(row.name);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.3f", row.msPerFrame);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.1f", row.callsPerFrame);
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("区间统计未编译 (DEARTS_ENABLE_PROFILING)");
+#endif
+}
+
+void PerformanceOverlayLayout::renderCounters() {
+    ImGui::Text("绘制: %llu 列表  %llu 命令  %llu 顶点  %llu 索引",
+                static_cast<unsigned long long>(frameCommandLists_),
+                static_cast<unsigned long long>(frameDrawCalls_),
+                static_cast<unsigned long long>(frameVertices_),
+                static_cast<unsigned long long>(frameIndices_));
+    ImGui::Text("画面未变化跳过: %llu 帧", static_cast<unsigned long long>(framesSkipped_));
+    const LayoutManager& layoutManager = LayoutManager::getInstance();
+    ImGui::Text("布局更新: %u / %zu 个", layoutManager.getUpdatedLayoutCount(), layoutManager.getLayoutCount());
+    for (const LayoutRenderCacheStats& cache : renderCaches_) {
+        ImGui::Text("布局缓存 %-10s 命中 %5.1f%%  节省 %llu 顶点 (缓存 %u 顶点)", cache.layoutName.c_str(),
+                    cache.hitRate() * 100.0, static_cast<unsigned long long>(cache.savedVertices),
+                    cache.cachedVertices);
+    }
+
+    const App::TaskSchedulerMetrics tasks = App::TaskScheduler::getInstance().getMetrics();
+    ImGui::Text("任务: %zu 线程  排队 %zu (峰值 %zu)  完成 %llu  窃取 %llu  等待 %.0f us (最长 %.0f)",
+                tasks.workers, tasks.queueDepth, tasks.maxQueueDepth,
+                static_cast<unsigned long long>(tasks.completed), static_cast<unsigned long long>(tasks.steals),
+                tasks.avgLatencyUs, tasks.maxLatencyUs);
+
+    if (Utils::MemoryTracker::isEnabled()) {
+        char frameBytes[32];
+        char live[32];
+        formatBytes(frameBytes, sizeof(frameBytes), frameAllocatedBytes_);
+        formatBytes(live, sizeof(live), liveBytes_);
+        ImGui::Text("分配: %llu 次/帧 (%s)  存活 %s",
+                    static_cast<unsigned long long>(frameAllocations_), frameBytes, live);
+        if (appStats_) {
+            ImGui::Text("分配速率 %.0f 次/秒", appStats_->heap_allocation_rate);
+        }
+
+        // 各子系统存活内存（未归类的 General 即总量减去其余标签，不单独列出）
+        for (size_t i = 1; i < Utils::MEMORY_TAG_COUNT; ++i) {
+            const Utils::MemoryTag tag = static_cast<Utils::MemoryTag>(i);
+            const uint64_t tagLive = Utils::MemoryTracker::tagCounters(tag).liveBytes();
+            if (tagLive == 0) {
+                continue;
+            }
+            char tagBytes[32];
+            formatBytes(tagBytes, sizeof(tagBytes), tagLive);
+            ImGui::Text("  %-16s %s", Utils::memoryTagName(tag), tagBytes);
+        }
+
+        if (ImGui::SmallButton("导出内存报告")) {
+            if (Utils::MemoryTracker::writeReport(MEMORY_REPORT_PATH)) {
+                DEARTS_LOG_INFO("内存报告已写入: {}", MEMORY_REPORT_PATH);
+            } else {
+                DEARTS_LOG_ERROR("无法写入内存报告: {}", MEMORY_REPORT_PATH);
+            }
+        }
+    } else {
+        ImGui::TextDisabled("分配计数未编译 (DEARTS_TRACK_ALLOCATIONS)");
+    }
+}
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
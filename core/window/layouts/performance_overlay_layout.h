@@ -0,0 +1,141 @@
+#pragma once
+
+#include "layout_base.h"
+#include "layout_render_cache.h"
+#include "../../utils/profiler.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// 前向声明
+namespace DearTs {
+namespace Core {
+namespace App {
+    struct ApplicationStats;
+}
+}
+}
+
+namespace DearTs {
+namespace Core {
+namespace Window {
+
+/**
+ * @brief 实时性能浮层
+ * 显示帧时间分布（p50/p95/p99）、各性能区间的 CPU 耗时、ImGui 绘制数据规模、布局渲染缓存命中率、每帧堆分配次数和各子系统存活内存，
+ * 并可导出内存报告。
+ * 隐藏时不参与渲染，也不开启分析器的实时统计，不产生任何开销；显示期间主循环不进入空闲等待。
+ */
+class PerformanceOverlayLayout : public LayoutBase {
+public:
+    static constexpr SDL_Keycode TOGGLE_KEY = SDLK_F3;   ///< 切换显示的快捷键
+    static constexpr size_t FRAME_HISTORY = 240;         ///< 帧时间历史长度
+    static constexpr size_t MAX_ZONE_ROWS = 16;          ///< 最多显示的区间数
+    static constexpr const char* MEMORY_REPORT_PATH = "logs/memory_report.txt"; ///< 内存报告导出路径
+
+    /**
+     * @brief 构造函数
+     */
+    PerformanceOverlayLayout();
+
+    /**
+     * @brief 析构函数，关闭分析器实时统计
+     */
+    ~PerformanceOverlayLayout() override;
+
+    /**
+     * @brief 渲染浮层
+     */
+    void render() override;
+
+    /**
+     * @brief 更新布局（浮层固定在右上角，忽略可用区域）
+     */
+    void updateLayout(float width, float height) override;
+
+    /**
+     * @brief 处理事件（浮层本身不消费事件，快捷键由所属窗口转发）
+     */
+    void handleEvent(const SDL_Event& event) override;
+
+    /**
+     * @brief 检查事件是否为切换浮层的快捷键
+     */
+    static bool isToggleShortcut(const SDL_Event& event);
+
+    /**
+     * @brief 显示或隐藏浮层，同时开启或关闭分析器实时统计
+     */
+    void setOverlayVisible(bool visible);
+
+    /**
+     * @brief 切换显示状态
+     */
+    void toggle() { setOverlayVisible(!isVisible()); }
+
+    /**
+     * @brief 设置应用程序统计来源（为空时不显示应用程序统计）
+     */
+    void setApplicationStats(const App::ApplicationStats* stats) { appStats_ = stats; }
+
+private:
+    /**
+     * @brief 区间统计行（按刷新周期平均到每帧）
+     */
+    struct ZoneRow {
+        const char* name = nullptr;
+        double msPerFrame = 0.0;
+        double callsPerFrame = 0.0;
+        uint32_t depth = 0;
+    };
+
+    void resetSamples();
+    void sampleFrame();
+    void publish();
+    void renderFrameTimes();
+    void renderZones();
+    void renderCounters();
+
+    const App::ApplicationStats* appStats_;  ///< 应用程序统计（不拥有）
+
+    // 帧时间环形历史
+    std::array<float, FRAME_HISTORY> frameTimes_;
+    size_t frameIndex_;
+    size_t frameSamples_;
+    std::vector<float> sortScratch_;
+    float p50_;
+    float p95_;
+    float p99_;
+    float maxFrameTime_;
+
+    // 区间耗时在刷新周期内累加，周期结束时发布
+    std::vector<Utils::ProfileZoneTotal> zoneTotals_;
+    std::vector<double> zoneMilliseconds_;
+    std::vector<ZoneRow> zoneAccumulator_;
+    std::vector<ZoneRow> zoneRows_;
+    uint32_t periodFrames_;
+    std::chrono::steady_clock::time_point lastPublish_;
+
+    // 绘制数据与分配计数（取相邻两帧的差值）
+    uint64_t lastVertices_;
+    uint64_t lastIndices_;
+    uint64_t lastDrawCalls_;
+    uint64_t lastCommandLists_;
+    uint64_t lastAllocations_;
+    uint64_t lastAllocatedBytes_;
+    uint64_t frameVertices_;
+    uint64_t frameIndices_;
+    uint64_t frameDrawCalls_;
+    uint64_t frameCommandLists_;
+    uint64_t frameAllocations_;
+    uint64_t frameAllocatedBytes_;
+    uint64_t liveBytes_;
+    uint64_t framesSkipped_;       ///< 因画面未变化跳过提交的帧数（累计）
+    std::vector<LayoutRenderCacheStats> renderCaches_; ///< 布局渲染缓存统计（按刷新周期更新）
+    bool hasBaseline_;
+};
+
+} // namespace Window
+} // namespace Core
+} // namespace DearTs
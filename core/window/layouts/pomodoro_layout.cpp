@@ -7,6 +7,7 @@
 #include "../utils/logger.h"
 #include "../window_base.h"
 #include "../resource/font_resource.h"
+#include "../../app/frame_scheduler.h"
 
 // WinToast库用于Windows通知
 #ifdef _WIN32
@@ -156,8 +157,11 @@ namespace DearTs {
       void PomodoroLayout::updateLayout(float width, float height) {
         // updateLayout方法被频繁调用，移除冗余日志输出
 
-        // 更新计时器
+        // 更新计时器，计时期间每帧继续更新
         updateTimer();
+        if (isRunning_) {
+          invalidateLayout();
+        }
 
         // 更新位置和大小
         setPosition(300, 100);
@@ -307,6 +311,7 @@ namespace DearTs {
         isRunning_ = true;
         accumulatedTime_ = 0.0;  // 重置累积时间
         lastUpdateTime_ = std::chrono::high_resolution_clock::now();  // 重置时间基准
+        invalidateLayout();
         DEARTS_LOG_INFO("番茄时钟开始计时");
 
         // 显示开始通知
@@ -494,6 +499,11 @@ namespace DearTs {
               switchMode();
             }
           }
+
+          // 主循环空闲时不会主动重绘，在下一个整秒时请求刷新倒计时
+          if (isRunning_) {
+            App::FrameScheduler::getInstance().requestRedrawIn(std::chrono::duration<double>(1.0 - accumulatedTime_));
+          }
         }
       }
 
@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include "../../app/frame_scheduler.h"
 #include "../resource/font_resource.h"
 #include "../utils/logger.h"
 #include "../window_base.h"
+#include "layout_manager.h"
 #include "title_bar_layout.h"
 
 namespace DearTs {
@@ -24,6 +26,7 @@ namespace DearTs {
           currentState_(SidebarState::EXPANDED) {
         currentWidth_ = isExpanded_ ? sidebarWidth_ : collapsedWidth_;
         targetWidth_ = isExpanded_ ? sidebarWidth_ : collapsedWidth_;
+        setRenderCacheEnabled(true);
       }
 
       /**
@@ -34,7 +37,8 @@ namespace DearTs {
         float titleBarHeight = 30.0f; // 默认高度
         if (parentWindow_) {
           // 尝试获取标题栏布局并获取其高度
-          auto *titleBarLayout = parentWindow_->getLayout("TitleBar");
+          auto *titleBarLayout = LayoutManager::getInstance().getWindowLayout(
+              titleBarHandle_, parentWindow_->getWindowId(), "TitleBar");
           if (titleBarLayout) {
             // 检查是否为TitleBarLayout类型并获取高度
             auto *titleBar = dynamic_cast<TitleBarLayout *>(titleBarLayout);
@@ -83,7 +87,8 @@ namespace DearTs {
         float titleBarHeight = 30.0f; // 默认高度
         if (parentWindow_) {
           // 尝试获取标题栏布局并获取其高度
-          auto *titleBarLayout = parentWindow_->getLayout("TitleBar");
+          auto *titleBarLayout = LayoutManager::getInstance().getWindowLayout(
+              titleBarHandle_, parentWindow_->getWindowId(), "TitleBar");
           if (titleBarLayout) {
             // 检查是否为TitleBarLayout类型并获取高度
             auto *titleBar = dynamic_cast<TitleBarLayout *>(titleBarLayout);
@@ -96,6 +101,12 @@ namespace DearTs {
         // 更新位置和大小（高度减去标题栏高度）
         setPosition(0, titleBarHeight);
         setSize(currentWidth_, height - titleBarHeight);
+
+        // 动画期间每帧继续更新宽度；空闲的主循环不会自己绘制下一帧，需要主动请求
+        if (isAnimating_) {
+          invalidateLayout();
+          App::FrameScheduler::getInstance().requestRedraw();
+        }
       }
 
       /**
@@ -121,6 +132,8 @@ namespace DearTs {
           isExpanded_ = expanded;
           targetWidth_ = isExpanded_ ? sidebarWidth_ : collapsedWidth_;
           isAnimating_ = true;
+          invalidateLayout();
+          App::FrameScheduler::getInstance().requestRedraw();
 
           // 在没有ImGui上下文的情况下使用当前时间
           animationStartTime_ = static_cast<float>(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -160,6 +173,7 @@ namespace DearTs {
 
         if (it == items_.end()) {
           items_.push_back(item);
+          LayoutManager::getInstance().markLayoutDirty(name_);
         }
       }
 
@@ -170,6 +184,7 @@ namespace DearTs {
         items_.erase(
             std::remove_if(items_.begin(), items_.end(), [&id](const SidebarItem &item) { return item.id == id; }),
             items_.end());
+        LayoutManager::getInstance().markLayoutDirty(name_);
       }
 
       /**
@@ -184,7 +199,10 @@ namespace DearTs {
       /**
        * 清除所有项目
        */
-      void SidebarLayout::clearItems() { items_.clear(); }
+      void SidebarLayout::clearItems() {
+        items_.clear();
+        LayoutManager::getInstance().markLayoutDirty(name_);
+      }
 
       /**
        * 设置当前激活项目
@@ -204,6 +222,7 @@ namespace DearTs {
           newItem->isActive = true;
           activeItemId_ = id;
         }
+        LayoutManager::getInstance().markLayoutDirty(name_);
       }
 
       /**
@@ -409,17 +428,17 @@ namespace DearTs {
         // 清空事件历史记录
         eventHistory_.clear();
 
-        // 清空事件回调
+        // 清空事件回调，取消通过父窗口订阅的事件
         eventCallback_ = nullptr;
+        eventSubscriptions_.clear();
 
         DEARTS_LOG_INFO("侧边栏事件系统清理完成");
       }
 
-      void SidebarLayout::subscribeSidebarEvent(Events::EventType eventType,
-                                              std::function<bool(const Events::Event&)> handler) {
+      void SidebarLayout::subscribeSidebarEvent(Events::EventType eventType, Events::EventHandler handler) {
         // 通过父窗口订阅事件
         if (parentWindow_) {
-          parentWindow_->subscribeEvent(eventType, handler);
+          eventSubscriptions_.push_back(parentWindow_->getEventDispatcher().subscribeScoped(eventType, std::move(handler)));
           DEARTS_LOG_DEBUG("侧边栏订阅事件: " + std::to_string(static_cast<uint32_t>(eventType)));
         }
       }
@@ -434,7 +453,7 @@ namespace DearTs {
               : Event(Events::EventType::EVT_LAYOUT_SWITCH_REQUEST),
                 fromLayout_(from), toLayout_(to), animated_(animated) {}
 
-          std::string getName() const override { return "LayoutSwitchEvent"; }
+          const char* getName() const override { return "LayoutSwitchEvent"; }
 
           std::string getFromLayout() const { return fromLayout_; }
           std::string getToLayout() const { return toLayout_; }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "layout_base.h"
+#include "layout_registry.h"
 #include <string>
 #include <vector>
 #include <imgui.h>
@@ -97,6 +98,16 @@ namespace DearTs {
          */
         void render() override;
 
+        /**
+         * @brief 侧边栏窗口名称（开启离屏渲染缓存）
+         */
+        const char *getRenderCacheWindowName() const override { return "Sidebar"; }
+
+        /**
+         * @brief 展开/折叠动画期间不使用缓存
+         */
+        bool isRenderCacheable() const override { return !isAnimating_; }
+
         /**
          * @brief 更新侧边栏布局
          * @param width 可用宽度
@@ -217,9 +228,9 @@ namespace DearTs {
          * @brief 订阅侧边栏事件
          * @param eventType 事件类型
          * @param handler 事件处理器
+         * 订阅在 cleanupEventSystem() 或侧边栏销毁时取消
          */
-        void subscribeSidebarEvent(Events::EventType eventType,
-                                  std::function<bool(const Events::Event&)> handler);
+        void subscribeSidebarEvent(Events::EventType eventType, Events::EventHandler handler);
 
         /**
          * @brief 发送布局切换请求
@@ -238,6 +249,7 @@ namespace DearTs {
         float animationDuration_; ///< 动画持续时间（毫秒）
         float animationStartTime_; ///< 动画开始时间
         std::string activeItemId_; ///< 当前激活的项目ID
+        LayoutHandle titleBarHandle_; ///< 标题栏布局的句柄缓存（每帧取标题栏高度）
 
         // 侧边栏项目
         std::vector<SidebarItem> items_; ///< 侧边栏项目列表
@@ -258,6 +270,7 @@ namespace DearTs {
     SidebarState currentState_; ///< 当前侧边栏状态
     std::vector<SidebarEventData> eventHistory_; ///< 事件历史记录
     std::function<void(const SidebarEventData&)> eventCallback_; ///< 事件回调函数
+    std::vector<Events::ScopedSubscription> eventSubscriptions_; ///< 通过父窗口订阅的事件，清理时取消
 
         /**
          * @brief 更新动画状态
@@ -1,5 +1,6 @@
 #include "title_bar_layout.h"
 #include "../window_base.h"
+#include "layout_manager.h"
 #include "../utils/logger.h"
 #include "../resource/font_resource.h"
 #include "../resource/material_symbols_icons.hpp"
@@ -40,6 +41,7 @@ TitleBarLayout::TitleBarLayout()
 #endif
 {
     memset(searchBuffer_, 0, sizeof(searchBuffer_));
+    setRenderCacheEnabled(true);
 }
 
 /**
@@ -119,7 +121,7 @@ void TitleBarLayout::handleEvent(const SDL_Event& event) {
     switch (event.type) {
         case SDL_MOUSEBUTTONDOWN:
             if (event.button.button == SDL_BUTTON_LEFT) {
-                DEARTS_LOG_INFO("TitleBarLayout::handleEvent - SDL_MOUSEBUTTONDOWN - 坐标: (" +
+                DEARTS_LOG_TRACE("TitleBarLayout::handleEvent - SDL_MOUSEBUTTONDOWN - 坐标: (" +
                                std::to_string(event.button.x) + "," + std::to_string(event.button.y) + ")");
 
                 // 重置按钮点击状态
@@ -127,26 +129,26 @@ void TitleBarLayout::handleEvent(const SDL_Event& event) {
 
                 // 如果按钮已被点击，不处理拖拽
                 if (buttonClicked_) {
-                    DEARTS_LOG_INFO("按钮已被点击，忽略SDL事件");
+                    DEARTS_LOG_TRACE("按钮已被点击，忽略SDL事件");
                     break;
                 }
 
                 // 检查是否在标题栏区域（排除按钮区域）
                 bool inTitleArea = isInTitleBarArea(event.button.x, event.button.y);
-                DEARTS_LOG_INFO("TitleBarLayout::handleEvent - isInTitleBarArea返回: " + std::string(inTitleArea ? "是" : "否"));
+                DEARTS_LOG_TRACE("TitleBarLayout::handleEvent - isInTitleBarArea返回: " + std::string(inTitleArea ? "是" : "否"));
 
                 if (inTitleArea) {
-                    DEARTS_LOG_INFO("SDL事件触发拖拽" + std::string(usingAeroSnap ? "（Aero Snap 模式）" : "（标准模式）"));
+                    DEARTS_LOG_TRACE("SDL事件触发拖拽" + std::string(usingAeroSnap ? "（Aero Snap 模式）" : "（标准模式）"));
                     startDragging(event.button.x, event.button.y);
                 } else {
-                    DEARTS_LOG_INFO("SDL事件不在标题栏区域，忽略");
+                    DEARTS_LOG_TRACE("SDL事件不在标题栏区域，忽略");
                 }
             }
             break;
 
         case SDL_MOUSEBUTTONUP:
             if (event.button.button == SDL_BUTTON_LEFT) {
-                DEARTS_LOG_INFO("SDL鼠标释放事件" + std::string(usingAeroSnap ? "（Aero Snap 模式）" : "（标准模式）"));
+                DEARTS_LOG_TRACE("SDL鼠标释放事件" + std::string(usingAeroSnap ? "（Aero Snap 模式）" : "（标准模式）"));
                 stopDragging();
                 // 重置按钮点击状态
                 buttonClicked_ = false;
@@ -166,6 +168,7 @@ void TitleBarLayout::handleEvent(const SDL_Event& event) {
  */
 void TitleBarLayout::setWindowTitle(const std::string& title) {
     windowTitle_ = title;
+    LayoutManager::getInstance().markLayoutDirty(name_);
 }
 
 /**
@@ -203,20 +206,20 @@ bool TitleBarLayout::isInTitleBarArea(int x, int y) const {
     const float buttonsStartX = windowWidth - buttonWidth * 3; // 3个按钮的起始位置
 
     // 详细日志，用于调试
-    DEARTS_LOG_INFO("标题栏区域检测 - 鼠标坐标: (" + std::to_string(x) + "," + std::to_string(y) +
+    DEARTS_LOG_TRACE("标题栏区域检测 - 鼠标坐标: (" + std::to_string(x) + "," + std::to_string(y) +
                      ") 窗口宽度: " + std::to_string(windowWidth) +
                      " 按钮区域起始: " + std::to_string(buttonsStartX) +
                      " 标题栏高度: " + std::to_string(static_cast<int>(titleBarHeight_)));
 
     // 检查是否在标题栏高度范围内
     if (y < 0 || y > static_cast<int>(titleBarHeight_)) {
-        DEARTS_LOG_INFO("鼠标在标题栏高度范围外: y=" + std::to_string(y) + " (标题栏高度=" + std::to_string(static_cast<int>(titleBarHeight_)) + ")");
+        DEARTS_LOG_TRACE("鼠标在标题栏高度范围外: y=" + std::to_string(y) + " (标题栏高度=" + std::to_string(static_cast<int>(titleBarHeight_)) + ")");
         return false;
     }
 
     // 排除按钮区域（右侧3个按钮区域）
     if (x >= buttonsStartX && x <= windowWidth) {
-        DEARTS_LOG_INFO("鼠标在按钮区域，不触发拖拽: x=" + std::to_string(x) + " 在按钮区域 [" + std::to_string(buttonsStartX) + "," + std::to_string(windowWidth) + "]");
+        DEARTS_LOG_TRACE("鼠标在按钮区域，不触发拖拽: x=" + std::to_string(x) + " 在按钮区域 [" + std::to_string(buttonsStartX) + "," + std::to_string(windowWidth) + "]");
         return false;
     }
 
@@ -224,9 +227,9 @@ bool TitleBarLayout::isInTitleBarArea(int x, int y) const {
     bool inTitleArea = x >= 0 && x < buttonsStartX && y >= 0 && y <= static_cast<int>(titleBarHeight_);
 
     if (inTitleArea) {
-        DEARTS_LOG_INFO("鼠标在标题栏拖拽区域 - (" + std::to_string(x) + "," + std::to_string(y) + ")");
+        DEARTS_LOG_TRACE("鼠标在标题栏拖拽区域 - (" + std::to_string(x) + "," + std::to_string(y) + ")");
     } else {
-        DEARTS_LOG_INFO("鼠标不在标题栏拖拽区域 - (" + std::to_string(x) + "," + std::to_string(y) + ") 有效区域: x>=0 && x<" + std::to_string(buttonsStartX) + " && y>=0 && y<=" + std::to_string(static_cast<int>(titleBarHeight_)));
+        DEARTS_LOG_TRACE("鼠标不在标题栏拖拽区域 - (" + std::to_string(x) + "," + std::to_string(y) + ") 有效区域: x>=0 && x<" + std::to_string(buttonsStartX) + " && y>=0 && y<=" + std::to_string(static_cast<int>(titleBarHeight_)));
     }
 
     return inTitleArea;
@@ -236,7 +239,7 @@ bool TitleBarLayout::isInTitleBarArea(int x, int y) const {
  * 开始拖拽窗口
  */
 void TitleBarLayout::startDragging(int mouseX, int mouseY) {
-    DEARTS_LOG_INFO("!!! startDragging 被调用 - 参数: (" + std::to_string(mouseX) + "," + std::to_string(mouseY) + ") !!!");
+    DEARTS_LOG_TRACE("!!! startDragging 被调用 - 参数: (" + std::to_string(mouseX) + "," + std::to_string(mouseY) + ") !!!");
 
     if (!parentWindow_ || !parentWindow_->getSDLWindow()) {
         return;
@@ -534,8 +537,10 @@ void TitleBarLayout::renderTitle() {
         ImGui::SetCursorPosX(iconXPos);
         ImGui::SetCursorPosY((currentTitleBarHeight - 16.0f) * 0.5f); // 假设图标高度为16px，使用当前高度居中
 
-        // 渲染图标（使用ImGui的Image函数）
-        ImGui::Image((ImTextureID)iconTexture_->getTexture(), ImVec2(16.0f, 16.0f));
+        // 渲染图标（使用ImGui的Image函数，图标可能位于共享图集中）
+        float u0, v0, u1, v1;
+        iconTexture_->getUV(u0, v0, u1, v1);
+        ImGui::Image((ImTextureID)iconTexture_->getTexture(), ImVec2(16.0f, 16.0f), ImVec2(u0, v0), ImVec2(u1, v1));
 
         // 更新标题文本的X位置，使其在图标右侧
         iconXPos += 20.0f; // 图标宽度(16) + 间距(4)
@@ -32,6 +32,16 @@ public:
      * @brief 渲染标题栏布局
      */
     void render() override;
+
+    /**
+     * @brief 标题栏窗口名称（开启离屏渲染缓存）
+     */
+    const char* getRenderCacheWindowName() const override { return "##MainWindowTitleBar"; }
+
+    /**
+     * @brief 拖拽或显示搜索对话框期间不使用缓存
+     */
+    bool isRenderCacheable() const override { return !isDragging_ && !showSearchDialog_; }
     
     /**
      * @brief 更新标题栏布局
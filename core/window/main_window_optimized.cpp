@@ -64,6 +64,9 @@ bool MainWindow::initialize() {
     registerLayouts();
     setupSidebarEventHandlers();
 
+    performanceOverlay_ = std::make_unique<PerformanceOverlayLayout>();
+    performanceOverlay_->setParentWindow(this);
+
     // 设置标题栏窗口标题
     if (auto* titleBar = static_cast<TitleBarLayout*>(getLayoutManager().getLayout("TitleBar", getWindowId()))) {
         titleBar->setWindowTitle(title_);
@@ -79,8 +82,7 @@ void MainWindow::render() {
     FontManager fontManager;
 
     // 记录渲染窗口ID用于调试
-    std::string renderWindowId = getWindowId();
-    DEARTS_LOG_INFO("!!! MainWindow::render 开始 - 使用窗口ID: " + renderWindowId);
+    DEARTS_LOG_TRACE("MainWindow::render 开始 - 使用窗口ID: {}", getWindowId());
 
     // 使用字体推送机制来获得更好的渲染质量
     auto fontManagerInstance = DearTs::Core::Resource::FontManager::getInstance();
@@ -100,15 +102,16 @@ void MainWindow::render() {
 
     // 渲染当前内容布局（如果有的话）
     std::string currentLayout = getLayoutManager().getCurrentContentLayout();
-    DEARTS_LOG_INFO("🎯 MainWindow渲染 - 当前布局: " + (currentLayout.empty() ? "无" : currentLayout) + " (窗口ID: " + getWindowId() + ")");
+    DEARTS_LOG_TRACE("MainWindow渲染 - 当前布局: {} (窗口ID: {})", currentLayout.empty() ? "无" : currentLayout,
+                     getWindowId());
 
     if (!currentLayout.empty()) {
-        LayoutBase* layout = getLayoutManager().getLayout(currentLayout, getWindowId());
+        LayoutBase* layout = getLayoutManager().getWindowLayout(contentHandle_, getWindowId(), currentLayout);
         if (layout) {
-            DEARTS_LOG_INFO("📋 布局存在: " + currentLayout + " 可见性: " + std::string(layout->isVisible() ? "✅可见" : "❌隐藏"));
+            DEARTS_LOG_TRACE("布局存在: {} 可见性: {}", currentLayout, layout->isVisible() ? "可见" : "隐藏");
 
             if (layout->isVisible()) {
-                DEARTS_LOG_INFO("🎨 开始渲染固定内容区域 - 布局: " + currentLayout);
+                DEARTS_LOG_TRACE("开始渲染固定内容区域 - 布局: {}", currentLayout);
                 // 创建固定的内容区域窗口
                 ImGui::SetNextWindowPos(ImVec2(content.x, content.y));
                 ImGui::SetNextWindowSize(ImVec2(content.width, content.height));
@@ -123,10 +126,10 @@ void MainWindow::render() {
                 ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.082f, 0.082f, 0.082f, 1.0f));
 
                 if (ImGui::Begin("##ContentArea", nullptr, contentFlags)) {
-                    DEARTS_LOG_DEBUG("调用renderInFixedArea - 布局: " + currentLayout);
+                    DEARTS_LOG_TRACE("调用renderInFixedArea - 布局: {}", currentLayout);
                     // 调用布局的固定区域渲染方法
                     layout->renderInFixedArea(content.x, content.y, content.width, content.height);
-                    DEARTS_LOG_DEBUG("renderInFixedArea完成 - 布局: " + currentLayout);
+                    DEARTS_LOG_TRACE("renderInFixedArea完成 - 布局: {}", currentLayout);
                 }
                 ImGui::End();
 
@@ -139,10 +142,15 @@ void MainWindow::render() {
         }
     } else {
         // 渲染默认内容
-        DEARTS_LOG_INFO("🔄 渲染默认内容 (没有可见的内容布局)");
+        DEARTS_LOG_TRACE("渲染默认内容 (没有可见的内容布局)");
         renderDefaultContent();
     }
 
+    // 性能浮层绘制在所有内容之上，隐藏时不做任何事
+    if (performanceOverlay_ && performanceOverlay_->isVisible()) {
+        performanceOverlay_->render();
+    }
+
     // 恢复字体
     if (defaultFont) {
         defaultFont->popFont();
@@ -154,7 +162,8 @@ void MainWindow::update() {
     WindowBase::update();
 
     // 更新标题栏
-    if (auto* titleBar = static_cast<TitleBarLayout*>(getLayoutManager().getLayout("TitleBar", getWindowId()))) {
+    if (auto* titleBar = static_cast<TitleBarLayout*>(
+            getLayoutManager().getWindowLayout(titleBarHandle_, getWindowId(), "TitleBar"))) {
         titleBar->setWindowTitle(getTitle());
     }
 
@@ -164,6 +173,10 @@ void MainWindow::update() {
 
 // 事件处理 - 简化
 void MainWindow::handleEvent(const SDL_Event& event) {
+    if (performanceOverlay_ && PerformanceOverlayLayout::isToggleShortcut(event)) {
+        performanceOverlay_->toggle();
+        return;
+    }
     WindowBase::handleEvent(event);
 }
 
@@ -408,7 +421,7 @@ void MainWindow::updateClipboardMonitoring() {
     if (clipboard_monitoring_started_) return;
 
     auto* clipboardLayout = static_cast<DearTs::Core::Window::Widgets::Clipboard::ClipboardHistoryLayout*>(
-        getLayoutManager().getLayout("ClipboardHelper", getWindowId()));
+        getLayoutManager().getWindowLayout(clipboardHandle_, getWindowId(), "ClipboardHelper"));
 
     if (clipboardLayout && clipboardLayout->isVisible()) {
         if (SDL_Window* sdl_window = getSDLWindow()) {
@@ -6,6 +6,7 @@
 #include "layouts/sidebar_layout.h"
 #include "layouts/pomodoro_layout.h"
 #include "layouts/exchange_record_layout.h"
+#include "layouts/performance_overlay_layout.h"
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -45,6 +46,11 @@ public:
     };
     ContentArea getContentArea() const;
 
+    /**
+     * @brief 获取性能浮层（F3 切换显示）
+     */
+    PerformanceOverlayLayout* getPerformanceOverlay() const { return performanceOverlay_.get(); }
+
 private:
     // 重要：保持与原始版本相同的成员变量结构
     ImVec4 clearColor_;  ///< 清屏颜色
@@ -52,9 +58,16 @@ private:
     // 系统布局引用（直接访问，不拥有所有权）
     SidebarLayout* sidebarLayout_;
 
+    // 每帧访问的布局句柄缓存
+    LayoutHandle titleBarHandle_;  ///< 标题栏布局（内容布局的句柄缓存在 WindowBase::contentHandle_）
+    LayoutHandle clipboardHandle_; ///< 剪切板布局（监听器启动前每帧检查）
+
     // 剪切板监听器状态
     bool clipboard_monitoring_started_;
 
+    // 性能浮层（不放入LayoutManager，避免随内容布局切换被隐藏）
+    std::unique_ptr<PerformanceOverlayLayout> performanceOverlay_;
+
     // 简化的布局初始化
     void registerLayouts();
     void setupSidebarEventHandlers();
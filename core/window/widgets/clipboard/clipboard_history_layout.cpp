@@ -57,16 +57,17 @@ void ClipboardHistoryLayout::setupClipboardManager() {
 
     // 注意：分词窗口现在由GUI应用程序统一管理，不再在此处创建
 
-    // 设置剪切板监听器回调
-    auto& monitor = ClipboardMonitor::getInstance();
-    monitor.setChangeCallback([this](const std::string& content) {
-        this->onClipboardContentChanged(content);
-    });
+    // 订阅剪切板变化事件：监听器投递延迟事件时唤醒空闲中的主循环，分发后主循环安排重绘
+    clipboard_subscription_ = Events::EventSystem::getInstance()->getDispatcher().subscribeScoped(
+        Events::EventType::EVT_CLIPBOARD_CHANGED, [this](const Events::Event& event) {
+            onClipboardContentChanged(static_cast<const ClipboardChangedEvent&>(event).getContent());
+            return false;
+        });
 
     // 初始化过滤列表
     filtered_items_ = history_items_;
 
-    DEARTS_LOG_INFO("剪切板管理器设置完成，监听器回调已设置");
+    DEARTS_LOG_INFO("剪切板管理器设置完成，已订阅剪切板变化事件");
 }
 
 void ClipboardHistoryLayout::render() {
@@ -108,6 +108,7 @@ private:
     std::vector<ClipboardItem> history_items_;            // 原始历史记录
     std::vector<ClipboardItem> filtered_items_;           // 过滤后的记录
     std::vector<std::string> categories_;                 // 分类列表
+    Events::ScopedSubscription clipboard_subscription_;   // 剪切板变化事件订阅
 
     // 状态
     bool is_visible_;                                    // 窗口可见性
@@ -1,5 +1,8 @@
 #include "clipboard_manager.h"
 #include "../../utils/logger.h"
+#include "../../utils/profiler.h"
+#include "../../utils/memory_tracker.h"
+#include "../../utils/file_utils.h"
 #include <algorithm>
 #include <sstream>
 #include <fstream>
@@ -15,11 +18,13 @@ ClipboardManager& ClipboardManager::getInstance() {
 }
 
 ClipboardManager::ClipboardManager()
-    : max_history_size_(DEFAULT_MAX_HISTORY)
-    , is_initialized_(false) {
+    : is_initialized_(false)
+    , max_history_size_(DEFAULT_MAX_HISTORY) {
     DEARTS_LOG_INFO("ClipboardManager构造函数");
 
+#ifdef _WIN32
     monitor_ = std::make_unique<ClipboardMonitor>();
+#endif
     url_extractor_ = std::make_unique<UrlExtractor>();
 
     instance_ = this;
@@ -33,6 +38,7 @@ ClipboardManager::~ClipboardManager() {
     }
 }
 
+#ifdef _WIN32
 bool ClipboardManager::initialize(HWND hwnd) {
     if (is_initialized_) {
         DEARTS_LOG_WARN("剪切板管理器已初始化");
@@ -44,10 +50,12 @@ bool ClipboardManager::initialize(HWND hwnd) {
         return false;
     }
 
-    // 设置剪切板变化回调
-    monitor_->setChangeCallback([this](const std::string& content) {
-        onClipboardChanged(content);
-    });
+    // 订阅剪切板变化事件（监听器经延迟队列投递，在主线程分发）
+    clipboard_subscription_ = Events::EventSystem::getInstance()->getDispatcher().subscribeScoped(
+        Events::EventType::EVT_CLIPBOARD_CHANGED, [this](const Events::Event& event) {
+            onClipboardChanged(static_cast<const ClipboardChangedEvent&>(event).getContent());
+            return false;
+        });
 
     is_initialized_ = true;
     DEARTS_LOG_INFO("剪切板管理器初始化成功");
@@ -57,16 +65,28 @@ bool ClipboardManager::initialize(HWND hwnd) {
 
     return true;
 }
+#endif
 
 void ClipboardManager::shutdown() {
     if (!is_initialized_) {
         return;
     }
 
+#ifdef _WIN32
     monitor_->stopMonitoring();
+#endif
+    clipboard_subscription_.reset();
     is_initialized_ = false;
 
-    // 保存历史记录
+    // 等待后台保存结束，再同步写入最终状态
+    App::TaskHandle<void> save_task;
+    {
+        std::lock_guard<std::mutex> lock(save_task_mutex_);
+        save_task = save_task_;
+    }
+    if (save_task.isPending()) {
+        save_task.wait();
+    }
     saveHistory();
 
     DEARTS_LOG_INFO("剪切板管理器已关闭");
@@ -97,6 +117,8 @@ std::vector<ClipboardItem> ClipboardManager::getHistory(size_t limit) {
 }
 
 std::vector<ClipboardItem> ClipboardManager::searchHistory(const std::string& keyword, size_t limit) {
+    DEARTS_PROFILE_SCOPE("ClipboardManager::searchHistory");
+    DEARTS_MEMORY_TAG(CLIPBOARD);
     std::lock_guard<std::mutex> lock(history_mutex_);
 
     std::vector<ClipboardItem> result;
@@ -150,7 +172,7 @@ void ClipboardManager::clearHistory() {
     history_.clear();
     DEARTS_LOG_INFO("清空剪切板历史记录");
 
-    saveHistory();
+    requestSave();
 }
 
 bool ClipboardManager::removeItem(const std::string& id) {
@@ -164,7 +186,7 @@ bool ClipboardManager::removeItem(const std::string& id) {
     if (it != history_.end()) {
         history_.erase(it);
         DEARTS_LOG_INFO("删除剪切板项目: " + id);
-        saveHistory();
+        requestSave();
         return true;
     }
 
@@ -182,7 +204,7 @@ bool ClipboardManager::setFavorite(const std::string& id, bool favorite) {
     if (it != history_.end()) {
         it->is_favorite = favorite;
         DEARTS_LOG_INFO("设置收藏状态: " + id + " -> " + (favorite ? "收藏" : "取消收藏"));
-        saveHistory();
+        requestSave();
         return true;
     }
 
@@ -200,7 +222,7 @@ bool ClipboardManager::setCategory(const std::string& id, const std::string& cat
     if (it != history_.end()) {
         it->category = category;
         DEARTS_LOG_INFO("设置分类: " + id + " -> " + category);
-        saveHistory();
+        requestSave();
         return true;
     }
 
@@ -264,10 +286,15 @@ ClipboardManager::Statistics ClipboardManager::getStatistics() {
 }
 
 std::string ClipboardManager::getCurrentContent() {
+#ifdef _WIN32
     return monitor_->getCurrentClipboardContent();
+#else
+    return std::string();
+#endif
 }
 
 bool ClipboardManager::setContent(const std::string& content) {
+#ifdef _WIN32
     if (OpenClipboard(nullptr)) {
         EmptyClipboard();
 
@@ -285,11 +312,17 @@ bool ClipboardManager::setContent(const std::string& content) {
         }
         CloseClipboard();
     }
+#else
+    (void)content;
+    DEARTS_LOG_WARN("当前平台不支持设置系统剪切板");
+#endif
 
     return false;
 }
 
 void ClipboardManager::onClipboardChanged(const std::string& content) {
+    DEARTS_PROFILE_SCOPE("ClipboardManager::onClipboardChanged");
+    DEARTS_MEMORY_TAG(CLIPBOARD);
     if (content.empty()) {
         return;
     }
@@ -311,13 +344,15 @@ void ClipboardManager::onClipboardChanged(const std::string& content) {
         }
     }
 
-    // 保存历史记录
-    saveHistory();
+    // 保存历史记录（后台写入，不阻塞剪切板消息处理）
+    requestSave();
 
     DEARTS_LOG_INFO("检测到新的剪切板内容: " + content.substr(0, 50) + "...");
 }
 
 ClipboardItem ClipboardManager::addClipboardItem(const std::string& content) {
+    DEARTS_PROFILE_SCOPE("ClipboardManager::addClipboardItem");
+    DEARTS_MEMORY_TAG(CLIPBOARD);
     ClipboardItem item(content);
 
     // 处理剪切板项目（提取URL等）
@@ -336,6 +371,8 @@ ClipboardItem ClipboardManager::addClipboardItem(const std::string& content) {
 }
 
 void ClipboardManager::processClipboardItem(ClipboardItem& item) {
+    DEARTS_PROFILE_SCOPE("ClipboardManager::processClipboardItem");
+    DEARTS_MEMORY_TAG(CLIPBOARD);
     // 提取URL
     item.urls = url_extractor_->extractUrls(item.content);
 
@@ -363,7 +400,37 @@ bool ClipboardManager::isDuplicateContent(const std::string& content) {
 }
 
 bool ClipboardManager::saveHistory() {
+    DEARTS_PROFILE_SCOPE("ClipboardManager::saveHistory");
     try {
+        // 在锁内序列化为字符串，文件写入在锁外进行，不阻塞剪切板消息和界面读取
+        std::ostringstream buffer;
+        {
+            std::lock_guard<std::mutex> lock(history_mutex_);
+
+            // 写入历史记录数量
+            buffer << history_.size() << '\n';
+
+            // 写入每个历史记录
+            for (const auto& item : history_) {
+                buffer << "ID:" << item.id << '\n';
+                buffer << "Content:" << item.content << '\n';
+                buffer << "Timestamp:" << std::chrono::duration_cast<std::chrono::milliseconds>(
+                              item.timestamp.time_since_epoch()).count() << '\n';
+                buffer << "Length:" << item.content_length << '\n';
+                buffer << "Favorite:" << (item.is_favorite ? "1" : "0") << '\n';
+                buffer << "Category:" << item.category << '\n';
+                buffer << "URLCount:" << item.urls.size() << '\n';
+
+                // 写入URL信息
+                for (const auto& url : item.urls) {
+                    buffer << "URL:" << url.url << '\n';
+                }
+
+                buffer << "---" << '\n';
+            }
+        }
+
+        std::lock_guard<std::mutex> file_lock(file_mutex_);
         std::string file_path = getHistoryFilePath();
         std::ofstream file(file_path, std::ios::out | std::ios::trunc);
 
@@ -372,28 +439,7 @@ bool ClipboardManager::saveHistory() {
             return false;
         }
 
-        // 写入历史记录数量
-        file << history_.size() << std::endl;
-
-        // 写入每个历史记录
-        for (const auto& item : history_) {
-            file << "ID:" << item.id << std::endl;
-            file << "Content:" << item.content << std::endl;
-            file << "Timestamp:" << std::chrono::duration_cast<std::chrono::milliseconds>(
-                         item.timestamp.time_since_epoch()).count() << std::endl;
-            file << "Length:" << item.content_length << std::endl;
-            file << "Favorite:" << (item.is_favorite ? "1" : "0") << std::endl;
-            file << "Category:" << item.category << std::endl;
-            file << "URLCount:" << item.urls.size() << std::endl;
-
-            // 写入URL信息
-            for (const auto& url : item.urls) {
-                file << "URL:" << url.url << std::endl;
-            }
-
-            file << "---" << std::endl;
-        }
-
+        file << buffer.str();
         file.close();
         DEARTS_LOG_INFO("保存剪切板历史记录到: " + file_path);
         return true;
@@ -404,7 +450,41 @@ bool ClipboardManager::saveHistory() {
     }
 }
 
+void ClipboardManager::requestSave() {
+    save_requested_.store(true, std::memory_order_release);
+    if (save_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        // 已有保存任务在排队或执行，它退出前会看到这次请求
+        return;
+    }
+
+    auto task = App::TaskScheduler::getInstance().submit([this]() { flushPendingSaves(); }, App::TaskPriority::LOW);
+    if (task.getStatus() == App::TaskStatus::CANCELLED) {
+        // 调度器已停止：修改留在内存中，由 shutdown() 同步写入
+        save_scheduled_.store(false, std::memory_order_release);
+        return;
+    }
+
+    // 任务可能已经执行完，此时不要覆盖之后的请求提交的任务
+    std::lock_guard<std::mutex> lock(save_task_mutex_);
+    if (task.isPending() || !save_task_.isPending()) {
+        save_task_ = std::move(task);
+    }
+}
+
+void ClipboardManager::flushPendingSaves() {
+    do {
+        while (save_requested_.exchange(false, std::memory_order_acq_rel)) {
+            saveHistory();
+        }
+        save_scheduled_.store(false, std::memory_order_release);
+        // 清除标志之后到来的请求可能没有提交新任务，由本任务继续处理
+    } while (save_requested_.load(std::memory_order_acquire) &&
+             !save_scheduled_.exchange(true, std::memory_order_acq_rel));
+}
+
 bool ClipboardManager::loadHistory() {
+    DEARTS_PROFILE_SCOPE("ClipboardManager::loadHistory");
+    DEARTS_MEMORY_TAG(CLIPBOARD);
     try {
         std::string file_path = getHistoryFilePath();
         std::ifstream file(file_path);
@@ -464,7 +544,16 @@ bool ClipboardManager::loadHistory() {
     }
 }
 
+void ClipboardManager::setHistoryFilePath(const std::string& path) {
+    history_file_path_ = path;
+}
+
 std::string ClipboardManager::getHistoryFilePath() {
+    if (!history_file_path_.empty()) {
+        return history_file_path_;
+    }
+
+#ifdef _WIN32
     // 获取可执行文件目录
     char path[MAX_PATH];
     GetModuleFileNameA(nullptr, path, MAX_PATH);
@@ -475,6 +564,9 @@ std::string ClipboardManager::getHistoryFilePath() {
     }
 
     return exe_dir + "\\clipboard_history.txt";
+#else
+    return Utils::FileUtils::getExecutableDirectory() + "/clipboard_history.txt";
+#endif
 }
 
 void ClipboardManager::limitHistorySize() {
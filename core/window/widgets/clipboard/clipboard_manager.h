@@ -5,9 +5,14 @@
 #include <memory>
 #include <chrono>
 #include <mutex>
+#include <atomic>
 #include <functional>
+#ifdef _WIN32
 #include "clipboard_monitor.h"
+#endif
 #include "url_extractor.h"
+#include "../../../app/task_scheduler.h"
+#include "../../../events/event_system.h"
 
 namespace DearTs::Core::Window::Widgets::Clipboard {
 
@@ -60,12 +65,14 @@ public:
      */
     ~ClipboardManager();
 
+#ifdef _WIN32
     /**
      * @brief 初始化剪切板管理器
      * @param hwnd 接收剪切板消息的窗口句柄
      * @return 是否初始化成功
      */
     bool initialize(HWND hwnd);
+#endif
 
     /**
      * @brief 关闭剪切板管理器
@@ -178,13 +185,6 @@ public:
      */
     static ClipboardManager& getInstance();
 
-private:
-    /**
-     * @brief 剪切板变化处理函数
-     * @param content 新的剪切板内容
-     */
-    void onClipboardChanged(const std::string& content);
-
     /**
      * @brief 添加剪切板项目到历史记录
      * @param content 剪切板内容
@@ -192,6 +192,37 @@ private:
      */
     ClipboardItem addClipboardItem(const std::string& content);
 
+    /**
+     * @brief 立即把历史记录写入文件（线程安全，调用方不得持有历史记录锁）
+     * @return 是否保存成功
+     */
+    bool saveHistory();
+
+    /**
+     * @brief 请求在后台保存历史记录
+     * @details 短时间内的多次请求合并为一次写入；可以在持有历史记录锁时调用
+     */
+    void requestSave();
+
+    /**
+     * @brief 从文件加载历史记录并追加到当前历史
+     * @return 是否加载成功
+     */
+    bool loadHistory();
+
+    /**
+     * @brief 设置历史记录文件路径
+     * @param path 文件路径，为空时使用可执行文件目录下的 clipboard_history.txt
+     */
+    void setHistoryFilePath(const std::string& path);
+
+private:
+    /**
+     * @brief 剪切板变化处理函数
+     * @param content 新的剪切板内容
+     */
+    void onClipboardChanged(const std::string& content);
+
     /**
      * @brief 处理剪切板项目（提取URL等）
      * @param item 要处理的项目
@@ -205,24 +236,17 @@ private:
      */
     bool isDuplicateContent(const std::string& content);
 
-    /**
-     * @brief 保存历史记录到文件
-     * @return 是否保存成功
-     */
-    bool saveHistory();
-
-    /**
-     * @brief 从文件加载历史记录
-     * @return 是否加载成功
-     */
-    bool loadHistory();
-
     /**
      * @brief 获取历史记录文件路径
      * @return 文件路径
      */
     std::string getHistoryFilePath();
 
+    /**
+     * @brief 后台保存任务：写入文件，直到没有新的保存请求
+     */
+    void flushPendingSaves();
+
     /**
      * @brief 限制历史记录数量
      */
@@ -242,14 +266,25 @@ private:
     std::string formatTime(const std::chrono::system_clock::time_point& time_point);
 
     // 成员变量
+#ifdef _WIN32
     std::unique_ptr<ClipboardMonitor> monitor_;     // 剪切板监听器
+#endif
     std::unique_ptr<UrlExtractor> url_extractor_; // URL提取器
     std::vector<ClipboardItem> history_;           // 历史记录
     ClipboardChangeCallback change_callback_;       // 变化回调
+    Events::ScopedSubscription clipboard_subscription_; // 剪切板变化事件订阅
 
     mutable std::mutex history_mutex_;             // 历史记录保护锁
     bool is_initialized_;                          // 是否已初始化
     size_t max_history_size_;                      // 最大历史记录数量
+    std::string history_file_path_;                // 历史记录文件路径（为空时使用默认路径）
+
+    // 后台保存
+    std::mutex file_mutex_;                        // 串行化文件写入
+    std::mutex save_task_mutex_;                   // 保护 save_task_
+    App::TaskHandle<void> save_task_;              // 最近一次提交的保存任务
+    std::atomic<bool> save_requested_{false};      // 有尚未写入文件的修改
+    std::atomic<bool> save_scheduled_{false};      // 保存任务已提交且尚未退出
 
     static ClipboardManager* instance_;             // 单例实例
 
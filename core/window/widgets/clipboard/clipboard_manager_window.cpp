@@ -152,9 +152,14 @@ void ClipboardManagerWindow::update() {
 
     // 更新剪切板布局
     if (clipboard_layout_) {
-        // 获取窗口大小并传递给布局
+        // 窗口大小变化或布局失效时才重新计算
         auto windowSize = getSize();
-        clipboard_layout_->updateLayout(windowSize.width, windowSize.height);
+        const float width = static_cast<float>(windowSize.width);
+        const float height = static_cast<float>(windowSize.height);
+        if (clipboard_layout_->isLayoutInvalid() || clipboard_layout_->getWidth() != width ||
+            clipboard_layout_->getHeight() != height) {
+            clipboard_layout_->refreshLayout(width, height);
+        }
 
         // 启动剪切板监听（如果还未启动）
         SDL_Window* sdl_window = getSDLWindow();
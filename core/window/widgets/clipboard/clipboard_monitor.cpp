@@ -1,4 +1,5 @@
 #include "clipboard_monitor.h"
+#include "../../../events/event_queue.h"
 #include "../../utils/logger.h"
 #include <algorithm>
 #include <sstream>
@@ -103,12 +104,6 @@ void ClipboardMonitor::stopMonitoring() {
     DEARTS_LOG_INFO("剪切板监听已停止");
 }
 
-void ClipboardMonitor::setChangeCallback(ClipboardChangeCallback callback) {
-    std::lock_guard<std::mutex> lock(callback_mutex_);
-    callback_ = callback;
-    DEARTS_LOG_INFO("剪切板变化回调函数已设置");
-}
-
 std::string ClipboardMonitor::getCurrentClipboardContent() {
     if (!OpenClipboard(nullptr)) {
         DEARTS_LOG_WARN("无法打开剪切板");
@@ -266,13 +261,9 @@ void ClipboardMonitor::handleClipboardChange() {
                 DEARTS_LOG_INFO("新剪切板内容: " +
                               std::to_string(current_content.length()) + " 字符");
 
-                // 调用回调函数
-                {
-                    std::lock_guard<std::mutex> lock(callback_mutex_);
-                    if (callback_) {
-                        callback_(current_content);
-                    }
-                }
+                // 投递到延迟事件队列：窗口消息在 SDL 取事件的过程中到达，
+                // 使用方在主循环下一次 pumpFrameWork() 时统一处理，投递同时唤醒空闲中的主循环
+                Events::EventSystem::getInstance()->getQueue().emplace<ClipboardChangedEvent>(current_content);
 
                 // 更新上次内容记录
                 last_clipboard_content_ = current_content;
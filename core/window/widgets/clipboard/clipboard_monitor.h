@@ -1,23 +1,43 @@
 #pragma once
 
 #include <windows.h>
+#include "../../../events/event_system.h"
 #include <functional>
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <string>
 
 namespace DearTs::Core::Window::Widgets::Clipboard {
 
 /**
- * @brief 剪切板监听器回调函数类型
+ * @brief 剪切板变化回调函数类型
  */
 using ClipboardChangeCallback = std::function<void(const std::string& content)>;
 
+/**
+ * @brief 剪切板内容变化事件
+ * 监听器在窗口消息中投递到 EventSystem 的延迟队列，主循环每帧分发一次；
+ * 使用方在 EventSystem 的调度器上订阅 EVT_CLIPBOARD_CHANGED
+ */
+class ClipboardChangedEvent : public Events::Event {
+public:
+    explicit ClipboardChangedEvent(std::string content)
+        : Event(Events::EventType::EVT_CLIPBOARD_CHANGED)
+        , content_(std::move(content)) {}
+
+    const char* getName() const override { return "ClipboardChanged"; }
+    const std::string& getContent() const { return content_; }
+
+private:
+    std::string content_;
+};
+
 /**
  * @brief 剪切板监听器类
  *
- * 负责监听系统剪切板的变化，当剪切板内容发生改变时触发回调函数。
+ * 负责监听系统剪切板的变化，当剪切板内容发生改变时投递 ClipboardChangedEvent。
  * 使用Windows API实现高效的剪切板监听机制。
  */
 class ClipboardMonitor {
@@ -44,12 +64,6 @@ public:
      */
     void stopMonitoring();
 
-    /**
-     * @brief 设置剪切板变化回调函数
-     * @param callback 回调函数，接收新的剪切板内容
-     */
-    void setChangeCallback(ClipboardChangeCallback callback);
-
     /**
      * @brief 获取当前剪切板内容
      * @return 当前剪切板中的文本内容，如果无内容则返回空字符串
@@ -108,9 +122,7 @@ private:
     // 成员变量
     HWND hwnd_;                                      // 监听窗口句柄
     std::atomic<bool> is_monitoring_;                // 监听状态
-    ClipboardChangeCallback callback_;                // 回调函数
     std::string last_clipboard_content_;             // 上次的剪切板内容
-    std::mutex callback_mutex_;                      // 回调函数保护锁
     static ClipboardMonitor* instance_;               // 单例实例
     static WNDPROC original_window_proc_;            // 原始窗口过程
 };
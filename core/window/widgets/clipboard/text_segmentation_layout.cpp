@@ -4,6 +4,7 @@
 #include <Windows.h>
 #include <shellapi.h>
 #include "../../utils/logger.h"
+#include "../../utils/memory_tracker.h"
 
 namespace DearTs::Core::Window::Widgets::Clipboard {
 
@@ -25,6 +26,9 @@ TextSegmentationLayout::TextSegmentationLayout()
 
 TextSegmentationLayout::~TextSegmentationLayout() {
     DEARTS_LOG_INFO("TextSegmentationLayout析构函数");
+
+    // 分词任务只持有文本副本和分词器的引用，不必等待；取消后完成回调不再调用
+    segmentation_task_.cancel();
 }
 
 void TextSegmentationLayout::initializeColors() {
@@ -52,7 +56,7 @@ void TextSegmentationLayout::initializeLayout() {
 
 void TextSegmentationLayout::initializeTextSegmenter() {
     try {
-        text_segmenter_ = std::make_unique<TextSegmenter>();
+        text_segmenter_ = std::make_shared<TextSegmenter>();
 
         if (text_segmenter_->initialize()) {
             is_segmenter_initialized_ = true;
@@ -192,6 +196,10 @@ void TextSegmentationLayout::renderSegmentedText() {
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.4f, 1.0f), "📝 文本分词结果");
         ImGui::Separator();
 
+        if (segmentation_task_.isPending()) {
+            ImGui::TextColored(colors_.tag_color, "正在分词...");
+        }
+
         // 渲染文本片段
         for (auto& segment : text_segments_) {
             renderTextSegment(segment);
@@ -437,6 +445,8 @@ void TextSegmentationLayout::copySelectedText() {
 
 void TextSegmentationLayout::togglePosTags() {
     show_pos_tags_ = !show_pos_tags_;
+    // 标签改变片段宽度，需要重新排列
+    invalidateLayout();
     DEARTS_LOG_INFO("词性标签显示: " + std::string(show_pos_tags_ ? "开启" : "关闭"));
 }
 
@@ -491,34 +501,56 @@ void TextSegmentationLayout::setText(const std::string& text) {
     // 处理文本
     extractAndProcessText();
 
-    // 显示窗口
+    // 显示窗口（分词结果就绪前显示“正在分词”）
     showWindow();
-
-    DEARTS_LOG_DEBUG("分词处理完成 - URL数量: " + std::to_string(url_infos_.size()) +
-                    ", 文本片段数量: " + std::to_string(text_segments_.size()) +
-                    ", 窗口可见性: " + (is_visible_ ? "可见" : "隐藏"));
 }
 
 void TextSegmentationLayout::extractAndProcessText() {
     text_segments_.clear();
     url_infos_.clear();
 
-    // 提取URL
-    extractUrls();
+    // 新文本到来时旧任务的结果已经没有用处；已在运行的旧任务不等待，它的回调不再调用
+    segmentation_task_.cancel();
+
+    // URL 提取和分词在工作线程进行，长文本不再阻塞界面。任务不捕获 this：
+    // 被取消的旧任务可能在布局销毁之后才结束，只持有文本副本和分词器的共享引用
+    // （分词器除初始化标记外没有可变状态，新旧任务可以同时调用 segmentText()）
+    std::shared_ptr<TextSegmenter> segmenter =
+        is_segmenter_initialized_ ? text_segmenter_ : nullptr;
+    segmentation_task_ = App::TaskScheduler::getInstance().submit(
+        [segmenter = std::move(segmenter), text = original_text_](App::TaskContext& context) {
+            DEARTS_MEMORY_TAG(TEXT_SEGMENTATION);
+            SegmentationResult result;
+            result.url_infos = extractUrls(text);
+            if (!context.isCancelled()) {
+                result.text_segments = performTextSegmentation(segmenter.get(), text);
+            }
+            return result;
+        },
+        App::TaskPriority::HIGH);
+    segmentation_task_.then([this](SegmentationResult& result) { onSegmentationCompleted(result); });
+}
 
-    // 执行文本分词
-    performTextSegmentation();
+void TextSegmentationLayout::onSegmentationCompleted(SegmentationResult& result) {
+    url_infos_ = std::move(result.url_infos);
+    text_segments_ = std::move(result.text_segments);
+    hovered_segment_ = -1;
+    hovered_url_ = -1;
 
-    // 计算布局
-    calculateLayout();
+    DEARTS_LOG_DEBUG("分词处理完成 - URL数量: " + std::to_string(url_infos_.size()) +
+                    ", 文本片段数量: " + std::to_string(text_segments_.size()));
+
+    // 片段变化后重新排列，在下一次 updateLayout() 中按当前尺寸计算（需要 ImGui 上下文）
+    invalidateLayout();
 }
 
-void TextSegmentationLayout::extractUrls() {
+std::vector<UrlInfo> TextSegmentationLayout::extractUrls(const std::string& text) {
     static const std::regex url_regex(
         R"(https?:\/\/(www\.)?[-a-zA-Z0-9@:%._\+~#=]{1,256}\.[a-zA-Z0-9()]{1,6}\b([-a-zA-Z0-9()@:%_\+.~#?&//=]*))"
     );
 
-    std::sregex_iterator iter(original_text_.begin(), original_text_.end(), url_regex);
+    std::vector<UrlInfo> url_infos;
+    std::sregex_iterator iter(text.begin(), text.end(), url_regex);
     std::sregex_iterator end;
 
     int url_index = 0;
@@ -528,20 +560,23 @@ void TextSegmentationLayout::extractUrls() {
         url_info.domain = url_info.url;
         url_info.discovered_time = std::chrono::system_clock::now();
         url_info.index = url_index++;
-        url_infos_.push_back(url_info);
+        url_infos.push_back(url_info);
     }
 
-    DEARTS_LOG_INFO("提取到 " + std::to_string(url_infos_.size()) + " 个URL");
+    DEARTS_LOG_INFO("提取到 " + std::to_string(url_infos.size()) + " 个URL");
+    return url_infos;
 }
 
-void TextSegmentationLayout::performTextSegmentation() {
-    if (!is_segmenter_initialized_) {
+std::vector<TextSegment> TextSegmentationLayout::performTextSegmentation(TextSegmenter* segmenter,
+                                                                         const std::string& text) {
+    std::vector<TextSegment> text_segments;
+    if (!segmenter) {
         DEARTS_LOG_WARN("文本分词器未初始化，跳过分词处理");
-        return;
+        return text_segments;
     }
 
     try {
-        auto segments = text_segmenter_->segmentText(original_text_, TextSegmenter::Method::MIXED_MODE);
+        auto segments = segmenter->segmentText(text, TextSegmenter::Method::MIXED_MODE);
 
         int segment_index = 0;
         for (const auto& seg : segments) {
@@ -554,14 +589,15 @@ void TextSegmentationLayout::performTextSegmentation() {
             segment.is_selected = false;
             segment.is_hovered = false;
 
-            text_segments_.push_back(segment);
+            text_segments.push_back(segment);
         }
 
-        DEARTS_LOG_INFO("文本分词完成，共分得 " + std::to_string(text_segments_.size()) + " 个词");
+        DEARTS_LOG_INFO("文本分词完成，共分得 " + std::to_string(text_segments.size()) + " 个词");
 
     } catch (const std::exception& e) {
         DEARTS_LOG_ERROR("文本分词过程出错: " + std::string(e.what()));
     }
+    return text_segments;
 }
 
 void TextSegmentationLayout::calculateLayout() {
@@ -8,6 +8,7 @@
 #include <imgui.h>
 #include "text_segmenter.h"
 #include "url_extractor.h"
+#include "../../../app/task_scheduler.h"
 
 namespace DearTs::Core::Window::Widgets::Clipboard {
 
@@ -93,9 +94,16 @@ private:
     std::vector<TextSegment> text_segments_;  // 文本片段列表
     std::vector<UrlInfo> url_infos_;     // URL信息列表
 
-    std::unique_ptr<TextSegmenter> text_segmenter_; // 文本分词器实例
+    std::shared_ptr<TextSegmenter> text_segmenter_; // 文本分词器实例（分词任务持有引用，不访问布局本身）
     bool is_segmenter_initialized_;             // 分词器是否已初始化
 
+    // 后台分词结果（在工作线程生成，完成回调在主线程写回 url_infos_ / text_segments_）
+    struct SegmentationResult {
+        std::vector<UrlInfo> url_infos;
+        std::vector<TextSegment> text_segments;
+    };
+    App::TaskHandle<SegmentationResult> segmentation_task_; // 当前文本的分词任务
+
     // 状态管理
     bool is_visible_ = false;            // 窗口是否可见
     bool show_pos_tags_ = true;          // 是否显示词性标签
@@ -149,8 +157,9 @@ private:
 
     // 文本处理
     void extractAndProcessText();
-    void extractUrls();
-    void performTextSegmentation();
+    void onSegmentationCompleted(SegmentationResult& result);
+    static std::vector<UrlInfo> extractUrls(const std::string& text);
+    static std::vector<TextSegment> performTextSegmentation(TextSegmenter* segmenter, const std::string& text);
 };
 
 } // namespace DearTs::Core::Window::Widgets::Clipboard
\ No newline at end of file
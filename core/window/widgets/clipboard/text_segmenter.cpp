@@ -1,5 +1,7 @@
 #include "text_segmenter.h"
 #include "../../utils/logger.h"
+#include "../../utils/profiler.h"
+#include "../../utils/memory_tracker.h"
 #include <sstream>
 #include <cctype>
 #include <algorithm>
@@ -39,6 +41,8 @@ bool TextSegmenter::initialize() {
 
 std::vector<TextSegment> TextSegmenter::segmentText(const std::string& text,
                                                       Method method) {
+    DEARTS_PROFILE_SCOPE("TextSegmenter::segmentText");
+    DEARTS_MEMORY_TAG(TEXT_SEGMENTATION);
     if (!is_initialized_) {
         DEARTS_LOG_WARN("文本分词器未初始化");
         return {};
@@ -71,6 +75,7 @@ std::string TextSegmenter::getWordTag(const std::string& word) {
 }
 
 std::vector<TextSegment> TextSegmenter::simpleSegmentation(const std::string& text) {
+    DEARTS_PROFILE_SCOPE("TextSegmenter::simpleSegmentation");
     std::vector<TextSegment> segments;
     size_t start = 0;
 
@@ -103,6 +108,7 @@ std::vector<TextSegment> TextSegmenter::simpleSegmentation(const std::string& te
 }
 
 std::vector<TextSegment> TextSegmenter::regexSegmentation(const std::string& text) {
+    DEARTS_PROFILE_SCOPE("TextSegmenter::regexSegmentation");
     std::vector<TextSegment> segments;
     std::vector<std::pair<std::regex, std::string>> patterns = {
         {URL_PATTERN, "url"},
@@ -191,6 +197,7 @@ std::vector<TextSegment> TextSegmenter::regexSegmentation(const std::string& tex
 }
 
 std::vector<TextSegment> TextSegmenter::mixedSegmentation(const std::string& text) {
+    DEARTS_PROFILE_SCOPE("TextSegmenter::mixedSegmentation");
     std::vector<TextSegment> segments;
     size_t pos = 0;
 
@@ -459,9 +466,8 @@ bool TextSegmenter::isDigitChar(char c) {
 }
 
 bool TextSegmenter::isPunctuationChar(char c) {
-    return std::ispunct(static_cast<unsigned char>(c)) || c == '，' || c == '。' ||
-           c == '！' || c == '？' || c == '；' || c == '：' || c == '"' || c == '"' ||
-           c == '\'' || c == '\'' || c == '（' || c == '）' || c == '【' || c == '】';
+    // 单个字节只能判断 ASCII 标点；全角标点是多字节 UTF-8 序列，无法与 char 比较
+    return std::ispunct(static_cast<unsigned char>(c));
 }
 
 } // namespace DearTs::Core::Window::Widgets::Clipboard
\ No newline at end of file
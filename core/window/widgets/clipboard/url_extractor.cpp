@@ -94,6 +94,7 @@ std::vector<UrlInfo> UrlExtractor::extractUrlsWithRegex(const std::string& text,
 UrlInfo UrlExtractor::createUrlInfoFromMatch(const std::smatch& match,
                                             const std::string& text,
                                             UrlInfo::Type type) {
+    (void)text;  // 位置直接取自 match
     UrlInfo url_info;
     url_info.url = match.str();
     url_info.type = type;
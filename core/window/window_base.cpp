@@ -55,7 +55,7 @@ bool WindowBase::initialize() {
     class WindowCreatedEvent : public Events::Event {
     public:
         WindowCreatedEvent() : Event(Events::EventType::EVT_WINDOW_CREATED) {}
-        std::string getName() const override { return "WindowCreated"; }
+        const char* getName() const override { return "WindowCreated"; }
     };
     WindowCreatedEvent windowCreatedEvent;
     dispatchWindowEvent(windowCreatedEvent);
@@ -402,9 +402,10 @@ void WindowBase::setupEventHandlers() {
  * @param eventType 事件类型
  * @param handler 事件处理器
  */
-void WindowBase::subscribeEvent(Events::EventType eventType, std::function<bool(const Events::Event&)> handler) {
-    eventDispatcher_.subscribe(eventType, handler);
+Events::SubscriptionId WindowBase::subscribeEvent(Events::EventType eventType, Events::EventHandler handler) {
+    const Events::SubscriptionId id = eventDispatcher_.subscribe(eventType, std::move(handler));
     DEARTS_LOG_DEBUG("订阅事件: " + std::to_string(static_cast<uint32_t>(eventType)) + " for window: " + title_);
+    return id;
 }
 
 /**
@@ -416,6 +417,15 @@ void WindowBase::unsubscribeEvent(Events::EventType eventType) {
     DEARTS_LOG_DEBUG("取消订阅事件: " + std::to_string(static_cast<uint32_t>(eventType)) + " for window: " + title_);
 }
 
+/**
+ * @brief 取消单个订阅
+ * @param id 订阅标识
+ * @return 是否取消成功
+ */
+bool WindowBase::unsubscribeEvent(Events::SubscriptionId id) {
+    return eventDispatcher_.unsubscribe(id);
+}
+
 /**
  * @brief 分发窗口事件
  * @param event 事件对象
@@ -494,7 +504,7 @@ void WindowBase::renderContent() {
     std::string currentLayout = layoutManager_.getCurrentContentLayout();
 
     if (!currentLayout.empty()) {
-        LayoutBase* layout = layoutManager_.getWindowLayout(windowId_, currentLayout);
+        LayoutBase* layout = layoutManager_.getWindowLayout(contentHandle_, windowId_, currentLayout);
         if (layout && layout->isVisible()) {
             // 创建固定的内容区域窗口
             ImGui::SetNextWindowPos(ImVec2(contentX, contentY));
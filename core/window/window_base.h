@@ -223,15 +223,23 @@ public:
      * @brief 订阅窗口事件
      * @param eventType 事件类型
      * @param handler 事件处理器
+     * @return 订阅标识，用于单独取消这一个处理器
      */
-    void subscribeEvent(Events::EventType eventType, std::function<bool(const Events::Event&)> handler);
+    Events::SubscriptionId subscribeEvent(Events::EventType eventType, Events::EventHandler handler);
 
     /**
-     * @brief 取消订阅窗口事件
+     * @brief 取消订阅窗口事件（该类型的全部处理器）
      * @param eventType 事件类型
      */
     void unsubscribeEvent(Events::EventType eventType);
 
+    /**
+     * @brief 取消单个订阅
+     * @param id 订阅标识
+     * @return 是否取消成功
+     */
+    bool unsubscribeEvent(Events::SubscriptionId id);
+
     /**
      * @brief 分发窗口事件
      * @param event 事件对象
@@ -294,6 +302,7 @@ protected:
     Events::EventDispatcher eventDispatcher_; ///< 事件调度器
     bool is_visible_;                 ///< 窗口可见性状态（与SDL状态同步）
     std::vector<std::string> registeredLayoutIds_; ///< 已注册的布局ID列表
+    LayoutHandle contentHandle_;      ///< 当前内容布局的句柄缓存（每帧渲染内容区域）
 
 private:
     static std::atomic<uint32_t> s_nextWindowId_; ///< 下一个窗口ID计数器
@@ -17,6 +17,7 @@
 #include <stdexcept>
 #include "../resource/resource_manager.h"
 #include "../utils/file_utils.h"
+#include "../render/draw_data_hash.h"
 
 // Windows特定头文件
 #if defined(_WIN32)
@@ -844,10 +845,11 @@ namespace DearTs {
                 ImGui::Render();
 
                 ImDrawData *draw_data = ImGui::GetDrawData();
-                sdlRenderer->renderImGui(draw_data);
 
-                // 呈现
-                sdlRenderer->present();
+                // 画面未变化时不提交也不呈现，屏幕上保留上一帧
+                if (sdlRenderer->renderImGui(draw_data)) {
+                  sdlRenderer->present();
+                }
               } else {
                 // 如果不是SDLRenderer，使用适配器渲染器
                 renderer->beginFrame();
@@ -873,7 +875,30 @@ namespace DearTs {
         
         // 只对重要事件记录日志，避免频繁输出
         if (event.type == SDL_WINDOWEVENT || event.type == SDL_QUIT) {
-          DEARTS_LOG_DEBUG("WindowManager处理事件，类型: " + std::to_string(event.type));
+          DEARTS_LOG_DEBUG("WindowManager处理事件，类型: {}", event.type);
+        }
+
+        // 渲染目标或渲染设备重置后后端缓冲和布局缓存纹理都已失效；这两个事件不带窗口 ID，直接交给布局管理器
+        if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+          Render::UnchangedFrameFilter::invalidateAll();
+          LayoutManager::getInstance().handleEvent(event);
+          return;
+        }
+
+        // 窗口暴露或尺寸变化后后端缓冲可能已失效，即使绘制数据相同也要重新提交
+        if (event.type == SDL_WINDOWEVENT) {
+          switch (event.window.event) {
+            case SDL_WINDOWEVENT_EXPOSED:
+            case SDL_WINDOWEVENT_SHOWN:
+            case SDL_WINDOWEVENT_RESIZED:
+            case SDL_WINDOWEVENT_SIZE_CHANGED:
+            case SDL_WINDOWEVENT_RESTORED:
+            case SDL_WINDOWEVENT_MAXIMIZED:
+              Render::UnchangedFrameFilter::invalidateAll();
+              break;
+            default:
+              break;
+          }
         }
 
         // 处理窗口事件
@@ -905,18 +930,17 @@ namespace DearTs {
 
       bool WindowManager::hasWindowsToClose() const {
         auto windows = getAllWindows();
-        DEARTS_LOG_DEBUG("Checking hasWindowsToClose, window count: " + std::to_string(windows.size()));
+        DEARTS_LOG_DEBUG("Checking hasWindowsToClose, window count: {}", windows.size());
 
         bool result = std::any_of(windows.begin(), windows.end(), [](const std::shared_ptr<Window> &window) {
           bool should_close = window && window->shouldClose();
           if (window) {
-            DEARTS_LOG_DEBUG("Window ID " + std::to_string(window->getId()) +
-                             " shouldClose: " + std::to_string(should_close));
+            DEARTS_LOG_DEBUG("Window ID {} shouldClose: {}", window->getId(), should_close);
           }
           return should_close;
         });
 
-        DEARTS_LOG_DEBUG("hasWindowsToClose result: " + std::to_string(result));
+        DEARTS_LOG_DEBUG("hasWindowsToClose result: {}", result);
         return result;
       }
 
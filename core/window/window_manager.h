@@ -265,59 +265,59 @@ public:
     /**
      * @brief 窗口关闭事件
      */
-    virtual bool onWindowClose(::DearTs::Core::Window::Window* window) {
+    virtual bool onWindowClose(::DearTs::Core::Window::Window* /*window*/) {
         return true;
     }
     
     /**
      * @brief 窗口大小改变事件
      */
-    virtual void onWindowResize(::DearTs::Core::Window::Window* window, int width, int height) {}
+    virtual void onWindowResize(::DearTs::Core::Window::Window* /*window*/, int /*width*/, int /*height*/) {}
     
     /**
      * @brief 窗口移动事件
      */
-    virtual void onWindowMove(::DearTs::Core::Window::Window* window, int x, int y) {}
+    virtual void onWindowMove(::DearTs::Core::Window::Window* /*window*/, int /*x*/, int /*y*/) {}
     
     /**
      * @brief 窗口获得焦点事件
      */
-    virtual void onWindowFocusGained(Window* window) {}
+    virtual void onWindowFocusGained(Window* /*window*/) {}
     
     /**
      * @brief 窗口失去焦点事件
      */
-    virtual void onWindowFocusLost(Window* window) {}
+    virtual void onWindowFocusLost(Window* /*window*/) {}
     
     /**
      * @brief 窗口最小化事件
      */
-    virtual void onWindowMinimized(Window* window) {}
+    virtual void onWindowMinimized(Window* /*window*/) {}
     
     /**
      * @brief 窗口最大化事件
      */
-    virtual void onWindowMaximized(Window* window) {}
+    virtual void onWindowMaximized(Window* /*window*/) {}
     
     /**
      * @brief 窗口恢复事件
      */
-    virtual void onWindowRestored(Window* window) {}
+    virtual void onWindowRestored(Window* /*window*/) {}
     
     /**
      * @brief 窗口显示事件
      */
-    virtual void onWindowShown(Window* window) {}
+    virtual void onWindowShown(Window* /*window*/) {}
     
     /**
      * @brief 窗口隐藏事件
      */
-    virtual void onWindowHidden(Window* window) {}
+    virtual void onWindowHidden(Window* /*window*/) {}
     
     /**
      * @brief 窗口暴露事件（需要重绘）
      */
-    virtual void onWindowExposed(Window* window) {}
+    virtual void onWindowExposed(Window* /*window*/) {}
 };
 
 // ============================================================================
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <dearts/dearts.hpp>
+#include <atomic>
 #include <functional>
 #include <list>
 #include <mutex>
@@ -8,17 +9,17 @@
 #include <string_view>
 #include <algorithm>
 
-#define EVENT_DEF_IMPL(event_name, event_name_string, should_log, ...)                                                                                      \
-    struct event_name final : public dearts::impl::Event<__VA_ARGS__> {                                                                                        \
-        constexpr static auto Id = [] { return dearts::impl::EventId(event_name_string); }();                                                                  \
-        constexpr static auto ShouldLog = (should_log);                                                                                                     \
-        explicit event_name(Callback func) noexcept : Event(std::move(func)) { }                                                                            \
-                                                                                                                                                            \
-        static EventManager::EventList::iterator subscribe(Event::Callback function) { return EventManager::subscribe<event_name>(std::move(function)); }   \
-        static void subscribe(void *token, Event::Callback function) { EventManager::subscribe<event_name>(token, std::move(function)); }                   \
-        static void unsubscribe(const EventManager::EventList::iterator &token) noexcept { EventManager::unsubscribe(token); }                              \
-        static void unsubscribe(void *token) noexcept { EventManager::unsubscribe<event_name>(token); }                                                     \
-        static void post(auto &&...args) { EventManager::post<event_name>(std::forward<decltype(args)>(args)...); }                                         \
+#define EVENT_DEF_IMPL(event_name, event_name_string, should_log, ...)                                                                                                      \
+    struct event_name final : public dearts::impl::Event<__VA_ARGS__> {                                                                                                     \
+        constexpr static auto Id = [] { return dearts::impl::EventId(event_name_string); }();                                                                               \
+        constexpr static auto ShouldLog = (should_log);                                                                                                                     \
+        explicit event_name(Callback func) noexcept : Event(std::move(func)) { }                                                                                            \
+                                                                                                                                                                            \
+        static dearts::EventManager::SubscriptionToken subscribe(Event::Callback function) { return dearts::EventManager::subscribe<event_name>(std::move(function)); }     \
+        static void subscribe(void *token, Event::Callback function) { dearts::EventManager::subscribe<event_name>(token, std::move(function)); }                           \
+        static void unsubscribe(const dearts::EventManager::SubscriptionToken &token) { dearts::EventManager::unsubscribe(token); }                                         \
+        static void unsubscribe(void *token) { dearts::EventManager::unsubscribe<event_name>(token); }                                                                      \
+        static void post(auto &&...args) { dearts::EventManager::post<event_name>(std::forward<decltype(args)>(args)...); }                                                 \
     }
 
 #define EVENT_DEF(event_name, ...)          EVENT_DEF_IMPL(event_name, #event_name, true, __VA_ARGS__)
@@ -87,26 +88,66 @@ namespace dearts {
         template<typename T>
         concept EventType = std::derived_from<T, EventBase>;
         
+        /**
+         * @brief 某个事件的一个订阅者
+         */
+        struct Subscriber {
+            u64 serial;                                 ///< 订阅序号，取消订阅时用来定位
+            std::shared_ptr<const EventBase> event;     ///< 多个订阅表副本共享同一个回调
+        };
+        
+        /**
+         * @brief 订阅表快照，发布后只读
+         */
+        struct SubscriberList {
+            std::vector<Subscriber> subscribers;
+        };
+        
+        /**
+         * @brief 单个事件ID的订阅通道
+         * @details 订阅变化时复制一份新的订阅表并原子替换，post() 读取时不加锁；
+         *          通道创建后一直存在（事件类型数量有限），post() 可以缓存它的地址
+         */
+        struct EventChannel {
+            explicit EventChannel(EventId eventId) : id(eventId) { }
+            
+            EventId id;
+            std::atomic<const SubscriberList *> subscribers { nullptr };
+        };
+        
     }
     
     /**
      * @brief 事件管理器，负责事件的订阅、发布和管理
      * 参考ImHex的事件系统设计，支持类型安全的事件处理
+     * 
+     * 每个事件ID的订阅表采用写时复制：订阅、取消订阅在写锁下复制一份新表并原子发布，
+     * 旧表等所有正在读取它的 post() 结束后再释放（基于纪元的回收，每个线程只写自己的缓存行）。
+     * post() 全程不加锁，多个线程同时发布互不阻塞，回调执行再慢也不会挡住其他线程。
+     * 由此带来的语义：
+     * - post() 调用的是开始发布时的订阅表，期间新增的订阅者从下一次发布开始收到事件；
+     * - unsubscribe() 返回时，其他线程上已经开始的 post() 仍可能正在调用被取消的回调；
+     * - unsubscribe()、clear() 要分配新的订阅表和待释放记录，内存不足时抛出 std::bad_alloc，未能取消的订阅保持有效。
      */
     class EventManager {
     public:
-        using EventList = std::multimap<impl::EventId, std::unique_ptr<impl::EventBase>>;
+        /**
+         * @brief 订阅令牌，用于取消单个订阅
+         */
+        struct SubscriptionToken {
+            impl::EventId id;
+            u64 serial;
+        };
         
         /**
          * @brief 订阅事件
          * @tparam E 事件类型
          * @param function 事件处理函数
-         * @return 事件迭代器，用于取消订阅
+         * @return 订阅令牌，用于取消订阅
          */
         template<impl::EventType E>
-        static EventList::iterator subscribe(typename E::Callback function) {
-            std::scoped_lock lock(getEventMutex());
-            return getEvents().emplace(E::Id, std::make_unique<E>(std::move(function)));
+        static SubscriptionToken subscribe(typename E::Callback function) {
+            return { E::Id, addSubscriber(E::Id, std::make_shared<const E>(std::move(function)), nullptr) };
         }
         
         /**
@@ -117,65 +158,85 @@ namespace dearts {
          */
         template<impl::EventType E>
         static void subscribe(void *token, typename E::Callback function) {
-            std::scoped_lock lock(getEventMutex());
-            if (!isAlreadyRegistered(token, E::Id)) {
-                auto iter = getEvents().emplace(E::Id, std::make_unique<E>(std::move(function)));
-                getTokenStore().emplace(token, iter);
-            }
+            addSubscriber(E::Id, std::make_shared<const E>(std::move(function)), token);
         }
         
         /**
          * @brief 取消订阅事件
-         * @param token 事件迭代器
+         * @param token 订阅令牌
+         * @throws std::bad_alloc 复制订阅表失败
          */
-        static void unsubscribe(const EventList::iterator &token) noexcept {
-            std::scoped_lock lock(getEventMutex());
-            getEvents().erase(token);
-        }
+        static void unsubscribe(const SubscriptionToken &token);
         
         /**
          * @brief 使用令牌取消订阅事件
          * @tparam E 事件类型
          * @param token 令牌指针
+         * @throws std::bad_alloc 复制订阅表失败
          */
         template<impl::EventType E>
-        static void unsubscribe(void *token) noexcept {
+        static void unsubscribe(void *token) {
             unsubscribe(token, E::Id);
         }
         
         /**
-         * @brief 发布事件
+         * @brief 发布事件（可在任意线程调用，不加锁）
          * @tparam E 事件类型
          * @param args 事件参数
          */
         template<impl::EventType E>
         static void post(auto && ...args) {
-            std::scoped_lock lock(getEventMutex());
+            // 通道永不销毁，每个模块对每种事件只查找一次
+            static impl::EventChannel &channel = getChannel(E::Id);
             
-            auto &events = getEvents();
-            auto range = events.equal_range(E::Id);
+            ReadGuard guard;
+            const impl::SubscriberList *list = channel.subscribers.load(std::memory_order_seq_cst);
+            if (list == nullptr) {
+                return;
+            }
             
-            for (auto it = range.first; it != range.second; ++it) {
-                auto event = static_cast<E*>(it->second.get());
-                event->template call<E>(std::forward<decltype(args)>(args)...);
+            for (const auto &subscriber : list->subscribers) {
+                auto event = static_cast<const E*>(subscriber.event.get());
+                event->template call<E>(args...);
             }
         }
         
         /**
          * @brief 清除所有事件订阅
+         * @throws std::bad_alloc 记录待释放的订阅表失败
          */
-        static void clear() noexcept {
-            std::scoped_lock lock(getEventMutex());
-            getEvents().clear();
-            getTokenStore().clear();
+        static void clear();
+        
+        /**
+         * @brief 某个事件当前的订阅者数量
+         */
+        template<impl::EventType E>
+        static size_t getSubscriberCount() {
+            static impl::EventChannel &channel = getChannel(E::Id);
+            
+            ReadGuard guard;
+            const impl::SubscriberList *list = channel.subscribers.load(std::memory_order_seq_cst);
+            return list != nullptr ? list->subscribers.size() : 0;
         }
         
     private:
-        static std::multimap<void *, EventList::iterator>& getTokenStore();
-        static EventList& getEvents();
-        static std::recursive_mutex& getEventMutex();
+        /**
+         * @brief 读侧临界区：标记当前线程正在读取订阅表，支持嵌套（回调中再次 post）
+         */
+        class ReadGuard {
+        public:
+            ReadGuard() { enterRead(); }
+            ~ReadGuard() { leaveRead(); }
+            
+            ReadGuard(const ReadGuard &) = delete;
+            ReadGuard &operator=(const ReadGuard &) = delete;
+        };
+        
+        static impl::EventChannel &getChannel(impl::EventId id);
+        static void enterRead() noexcept;
+        static void leaveRead() noexcept;
         
-        static bool isAlreadyRegistered(void *token, impl::EventId id);
+        static u64 addSubscriber(impl::EventId id, std::shared_ptr<const impl::EventBase> event, void *token);
         static void unsubscribe(void *token, impl::EventId id);
     };
     
@@ -1,6 +1,7 @@
 #include <dearts/api/event_manager.hpp>
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
@@ -8,51 +9,244 @@
 #include <functional>
 
 namespace dearts {
-    
-    // 静态成员变量定义
-    std::multimap<void *, EventManager::EventList::iterator>& EventManager::getTokenStore() {
-        static std::multimap<void *, EventList::iterator> tokenStore;
-        return tokenStore;
-    }
-    
-    EventManager::EventList& EventManager::getEvents() {
-        static EventList events;
-        return events;
-    }
-    
-    std::recursive_mutex& EventManager::getEventMutex() {
-        static std::recursive_mutex eventMutex;
-        return eventMutex;
-    }
-    
-    bool EventManager::isAlreadyRegistered(void *token, impl::EventId id) {
-        auto &tokenStore = getTokenStore();
-        auto range = tokenStore.equal_range(token);
-        
-        for (auto it = range.first; it != range.second; ++it) {
-            if (it->second->first == id) {
-                return true;
-            }
-        }
-        
-        return false;
-    }
-    
+
+    namespace {
+
+        /**
+         * @brief 每个线程的读侧状态，独占一条缓存行，post() 只写这里
+         */
+        struct alignas(64) ReaderRecord {
+            std::atomic<u64> activeEpoch { 0 };     ///< 正在读取时为进入时的纪元，否则为 0
+            u32 depth = 0;                          ///< post() 嵌套深度（只由所属线程访问）
+        };
+
+        /**
+         * @brief 写侧状态：通道、令牌、待释放的旧订阅表，以及所有线程的读侧记录
+         * @details 进程结束前不销毁：线程局部记录可能在静态对象析构之后才注销
+         */
+        struct EventState {
+            std::mutex mutex;                                                           ///< 写锁，post() 不使用
+            std::vector<std::unique_ptr<impl::EventChannel>> channels;
+            std::multimap<void *, EventManager::SubscriptionToken> tokenStore;
+            std::vector<std::pair<u64, const impl::SubscriberList *>> retired;          ///< (替换时的纪元, 旧订阅表)
+            std::vector<ReaderRecord *> readers;
+            std::atomic<u64> epoch { 1 };
+            u64 nextSerial = 1;
+        };
+
+        EventState &getState() {
+            static auto *state = new EventState();
+            return *state;
+        }
+
+        /**
+         * @brief 线程局部的读侧记录，首次 post() 时注册，线程结束时注销
+         */
+        struct ThreadReader {
+            ReaderRecord record;
+
+            ThreadReader() {
+                auto &state = getState();
+                std::scoped_lock lock(state.mutex);
+                state.readers.push_back(&record);
+            }
+
+            ~ThreadReader() {
+                auto &state = getState();
+                std::scoped_lock lock(state.mutex);
+                std::erase(state.readers, &record);
+            }
+        };
+
+        ReaderRecord &getThreadReader() {
+            thread_local ThreadReader reader;
+            return reader.record;
+        }
+
+        impl::EventChannel *findChannel(EventState &state, impl::EventId id) {
+            for (const auto &channel : state.channels) {
+                if (channel->id == id) {
+                    return channel.get();
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief 可以释放的旧订阅表；在写锁的作用域之外声明，回调的析构（可能再次订阅或取消订阅）发生在解锁之后
+         */
+        using Garbage = std::vector<std::unique_ptr<const impl::SubscriberList>>;
+
+        impl::EventChannel &findOrCreateChannel(EventState &state, impl::EventId id) {
+            if (auto channel = findChannel(state, id); channel != nullptr) {
+                return *channel;
+            }
+            state.channels.push_back(std::make_unique<impl::EventChannel>(id));
+            return *state.channels.back();
+        }
+
+        /**
+         * @brief 释放已没有线程在读的旧订阅表（持有写锁时调用）
+         */
+        void reclaim(EventState &state, Garbage &garbage) {
+            if (state.retired.empty()) {
+                return;
+            }
+
+            // 先预留空间，移出 retired 的过程中不再分配
+            garbage.reserve(garbage.size() + state.retired.size());
+
+            // 仍在读取的线程中最早的纪元；在它之前替换下来的表可能还被读着
+            u64 oldestActive = UINT64_MAX;
+            for (const auto reader : state.readers) {
+                const u64 active = reader->activeEpoch.load(std::memory_order_seq_cst);
+                if (active != 0) {
+                    oldestActive = std::min(oldestActive, active);
+                }
+            }
+
+            auto it = std::remove_if(state.retired.begin(), state.retired.end(), [oldestActive, &garbage](const auto &entry) {
+                if (entry.first <= oldestActive) {
+                    garbage.emplace_back(entry.second);
+                    return true;
+                }
+                return false;
+            });
+            state.retired.erase(it, state.retired.end());
+        }
+
+        /**
+         * @brief 发布新的订阅表，旧表进入待释放列表（持有写锁时调用）
+         * @details 待释放记录的空间在替换之前预留，分配失败时通道保持原来的订阅表
+         */
+        void publish(EventState &state, impl::EventChannel &channel, std::unique_ptr<const impl::SubscriberList> list, Garbage &garbage) {
+            state.retired.reserve(state.retired.size() + 1);
+            const impl::SubscriberList *previous = channel.subscribers.exchange(list.release(), std::memory_order_seq_cst);
+            if (previous != nullptr) {
+                // 纪元在替换之后递增：之后进入读取的线程纪元不小于新值，一定读到新表
+                const u64 epoch = state.epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+                state.retired.emplace_back(epoch, previous);
+            }
+            reclaim(state, garbage);
+        }
+
+        /**
+         * @brief 从通道中移除一个订阅者（持有写锁时调用）
+         */
+        bool removeSubscriber(EventState &state, impl::EventChannel &channel, u64 serial, Garbage &garbage) {
+            const impl::SubscriberList *current = channel.subscribers.load(std::memory_order_relaxed);
+            if (current == nullptr) {
+                return false;
+            }
+
+            auto it = std::find_if(current->subscribers.begin(), current->subscribers.end(),
+                                   [serial](const impl::Subscriber &subscriber) { return subscriber.serial == serial; });
+            if (it == current->subscribers.end()) {
+                return false;
+            }
+
+            std::unique_ptr<impl::SubscriberList> next;
+            if (current->subscribers.size() > 1) {
+                next = std::make_unique<impl::SubscriberList>();
+                next->subscribers.reserve(current->subscribers.size() - 1);
+                next->subscribers.insert(next->subscribers.end(), current->subscribers.begin(), it);
+                next->subscribers.insert(next->subscribers.end(), it + 1, current->subscribers.end());
+            }
+            publish(state, channel, std::move(next), garbage);
+            return true;
+        }
+
+    }
+
+    impl::EventChannel &EventManager::getChannel(impl::EventId id) {
+        auto &state = getState();
+        std::scoped_lock lock(state.mutex);
+        return findOrCreateChannel(state, id);
+    }
+
+    void EventManager::enterRead() noexcept {
+        auto &reader = getThreadReader();
+        if (reader.depth++ == 0) {
+            reader.activeEpoch.store(getState().epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+    }
+
+    void EventManager::leaveRead() noexcept {
+        auto &reader = getThreadReader();
+        if (--reader.depth == 0) {
+            reader.activeEpoch.store(0, std::memory_order_release);
+        }
+    }
+
+    u64 EventManager::addSubscriber(impl::EventId id, std::shared_ptr<const impl::EventBase> event, void *token) {
+        auto &state = getState();
+        Garbage garbage;
+        std::scoped_lock lock(state.mutex);
+
+        if (token != nullptr) {
+            auto range = state.tokenStore.equal_range(token);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second.id == id) {
+                    return it->second.serial;
+                }
+            }
+        }
+
+        auto &channel = findOrCreateChannel(state, id);
+        const u64 serial = state.nextSerial++;
+
+        // 复制当前订阅表并追加，原表保持不变，正在读取它的线程不受影响
+        auto list = std::make_unique<impl::SubscriberList>();
+        if (const auto current = channel.subscribers.load(std::memory_order_relaxed); current != nullptr) {
+            list->subscribers.reserve(current->subscribers.size() + 1);
+            list->subscribers.insert(list->subscribers.end(), current->subscribers.begin(), current->subscribers.end());
+        }
+        list->subscribers.push_back({ serial, std::move(event) });
+        publish(state, channel, std::move(list), garbage);
+
+        if (token != nullptr) {
+            state.tokenStore.emplace(token, SubscriptionToken { id, serial });
+        }
+        return serial;
+    }
+
+    void EventManager::unsubscribe(const SubscriptionToken &token) {
+        auto &state = getState();
+        Garbage garbage;
+        std::scoped_lock lock(state.mutex);
+
+        if (auto channel = findChannel(state, token.id); channel != nullptr) {
+            removeSubscriber(state, *channel, token.serial, garbage);
+        }
+    }
+
     void EventManager::unsubscribe(void *token, impl::EventId id) {
-        std::lock_guard<std::recursive_mutex> lock(getEventMutex());
-        
-        auto &tokenStore = getTokenStore();
-        auto range = tokenStore.equal_range(token);
-        
+        auto &state = getState();
+        Garbage garbage;
+        std::scoped_lock lock(state.mutex);
+
+        auto range = state.tokenStore.equal_range(token);
         for (auto it = range.first; it != range.second;) {
-            if (it->second->first == id) {
-                auto &events = getEvents();
-                events.erase(it->second);
-                it = tokenStore.erase(it);
+            if (it->second.id == id) {
+                if (auto channel = findChannel(state, id); channel != nullptr) {
+                    removeSubscriber(state, *channel, it->second.serial, garbage);
+                }
+                it = state.tokenStore.erase(it);
             } else {
                 ++it;
             }
         }
     }
-    
-}
\ No newline at end of file
+
+    void EventManager::clear() {
+        auto &state = getState();
+        Garbage garbage;
+        std::scoped_lock lock(state.mutex);
+
+        for (const auto &channel : state.channels) {
+            publish(state, *channel, nullptr, garbage);
+        }
+        state.tokenStore.clear();
+    }
+
+}
@@ -5,6 +5,7 @@
 #include "../../../core/window/main_window_optimized.h"
 #include "../../../core/resource/font_resource.h"
 #include "../../../core/resource/resource_manager.h"
+#include "../../../core/render/draw_data_hash.h"
 #include <SDL.h>
 #include <imgui.h>
 #include <imgui_impl_sdl2.h>
@@ -85,12 +86,18 @@ public:
 
     
 private:
+    static constexpr int TEXT_CURSOR_REDRAW_MS = 400;  ///< 文本输入聚焦时的重绘间隔（ImGui 光标闪烁周期的三分之一）
+
     // 静态实例指针
     static GUIApplication* currentInstance_;  ///< 当前实例指针
 
     // 核心组件
     SDL_Window* m_window;           ///< SDL窗口句柄
     SDL_Renderer* m_renderer;       ///< SDL渲染器句柄
+
+    // 画面未变化检测
+    Core::Render::UnchangedFrameFilter m_frameFilter;  ///< 主窗口的绘制数据比较
+    bool m_lastFramePresented = true;                   ///< 上一次 render() 是否呈现了画面
     
     // 主窗口
     std::unique_ptr<DearTs::Core::Window::MainWindow> mainWindow_;  ///< 主窗口
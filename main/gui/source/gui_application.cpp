@@ -1,5 +1,6 @@
 #include "gui_application.h"
 #include "../../core/render/renderer.h"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -63,10 +64,26 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
    * @return 退出代码
    */
   int GUIApplication::run() {
+    auto &scheduler = Core::App::FrameScheduler::getInstance();
+
     // 运行主循环直到应用程序请求退出或所有窗口都关闭
     while (getState() != Core::App::ApplicationState::STOPPING && getState() != Core::App::ApplicationState::STOPPED) {
-      // 更新应用程序状态
-      update(1.0 / m_config.target_fps); // 假设60FPS
+      // 空闲时阻塞在 SDL_WaitEventTimeout 上，直到输入、剪切板变化、定时器或后台任务唤醒
+      {
+        DEARTS_PROFILE_SCOPE("GUIApplication::waitForWork");
+        prepareIdleWait();
+        scheduler.waitForWork();
+      }
+
+      DEARTS_PROFILE_SCOPE("Frame");
+      m_lastFrameTime = std::chrono::steady_clock::now();
+
+      // 延迟事件、后台任务完成回调、协程续体等在处理输入和更新之前执行
+      pumpFrameWork();
+
+      // 更新应用程序状态（帧率控制开启时使用平滑后的帧间隔）
+      const double smoothedDelta = m_framePacer.getSmoothedDeltaTime();
+      update(smoothedDelta > 0.0 ? smoothedDelta : 1.0 / std::max<uint32_t>(m_config.target_fps, 1));
 
       // 检查主窗口是否已被销毁，如果是则立即退出
       if (!mainWindow_) {
@@ -80,11 +97,22 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
         break;
       }
 
+      // 画面没有变化时不重绘；空闲之后帧率控制重新排程
+      if (!scheduler.beginFrame()) {
+        m_framePacer.reset();
+        continue;
+      }
+
       // 渲染应用程序界面
       render();
 
-      // 简单的帧率控制
-      // std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(m_config.target_fps / 4))); // 约60 FPS
+      // 更新帧时间、帧率和内存统计（性能浮层读取）
+      updateStats();
+
+      // 垂直同步由 SDL_RenderPresent 限速；关闭垂直同步或本帧跳过了呈现时按 target_fps 控制帧率
+      if (!m_config.enable_vsync || !m_lastFramePresented) {
+        limitFrameRate();
+      }
     }
 
     return 0;
@@ -116,6 +144,7 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
    * @param delta_time 时间增量（秒）
    */
   void GUIApplication::update(double delta_time) {
+    DEARTS_PROFILE_SCOPE("GUIApplication::update");
     // 处理SDL事件
     processSDLEvents();
 
@@ -136,6 +165,7 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
    * 渲染应用程序界面
    */
   void GUIApplication::render() {
+    DEARTS_PROFILE_SCOPE("GUIApplication::render");
     // 检查是否还有有效的窗口和渲染器
     if (!m_renderer || !m_window) {
       return;
@@ -169,10 +199,27 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
 
     // 结束帧
     ImGui::Render();
-    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), m_renderer);
 
-    // 呈现主窗口
-    SDL_RenderPresent(m_renderer);
+    // 文本输入框的光标闪烁没有对应的事件，聚焦期间定时重绘
+    if (ImGui::GetIO().WantTextInput) {
+      Core::App::FrameScheduler::getInstance().requestRedrawIn(std::chrono::milliseconds(TEXT_CURSOR_REDRAW_MS));
+    }
+
+    // 绘制数据与上一帧相同时跳过后端提交和呈现，屏幕上保留上一帧
+    ImDrawData *drawData = ImGui::GetDrawData();
+    m_lastFramePresented = m_frameFilter.shouldSubmit(drawData);
+    if (m_lastFramePresented) {
+      ImGui_ImplSDLRenderer2_RenderDrawData(drawData, m_renderer);
+      DearTs::Core::Render::RenderManager::getInstance().recordDrawData(drawData);
+
+      // 呈现主窗口
+      SDL_RenderPresent(m_renderer);
+    } else {
+      DearTs::Core::Render::RenderManager::getInstance().recordSkippedFrame();
+    }
+
+    // 画面稳定的系统布局在呈现之后渲染到缓存纹理，下一帧起直接贴图
+    DearTs::Core::Window::LayoutManager::getInstance().captureRenderCaches(m_renderer, drawData);
 
     // 渲染所有其他窗口（包括分词窗口）
     auto &windowManager = DearTs::Core::Window::WindowManager::getInstance();
@@ -241,7 +288,11 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
 
 
     // 创建渲染器
-    m_renderer = SDL_CreateRenderer(m_window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (m_config.enable_vsync) {
+      rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    m_renderer = SDL_CreateRenderer(m_window, -1, rendererFlags);
 
     if (!m_renderer) {
       std::cerr << "Renderer creation failed: " << SDL_GetError() << std::endl;
@@ -250,6 +301,11 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
 
     windowManager.addWindow("MainWindow", mainWindow_->getWindow());
 
+    // 性能浮层显示本应用程序的统计
+    if (auto* overlay = mainWindow_->getPerformanceOverlay()) {
+      overlay->setApplicationStats(&getStats());
+    }
+
     return true;
   }
 
@@ -320,9 +376,14 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
   void GUIApplication::processSDLEvents() {
     // 调用父类的processEvents()来处理所有SDL事件，包括SDL_QUIT
     // DearTs::Core::App::Application::processEvents();
+    auto &scheduler = Core::App::FrameScheduler::getInstance();
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
-      
+      // 调度器的唤醒事件只用于打断等待，不需要继续分发
+      if (scheduler.notifyEvent(event)) {
+        continue;
+      }
+
       // 关键修复：先让我们的系统处理事件，再传递给ImGui
       // 这样可以确保侧边栏等自定义UI组件能接收到鼠标事件
       DearTs::Core::Window::WindowManager::getInstance().handleSDLEvent(event);
@@ -379,6 +440,9 @@ GUIApplication* GUIApplication::currentInstance_ = nullptr;
    * 关闭ImGui
    */
   void GUIApplication::shutdownImGui() {
+    // 布局缓存纹理属于渲染器，先于渲染器释放
+    DearTs::Core::Window::LayoutManager::getInstance().releaseRenderCaches();
+
     ImGui_ImplSDLRenderer2_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
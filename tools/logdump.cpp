@@ -0,0 +1,219 @@
+/**
+ * @file logdump.cpp
+ * @brief 二进制日志解码工具
+ * @details 读取 Logger 以 LogFileFormat::BINARY 写出的日志文件，按级别/源文件过滤，
+ *          输出为与文本日志相同格式的文本或 JSON Lines。
+ *
+ *          用法：dearts_logdump [--level LEVEL] [--file SUBSTR] [--json] [-o OUTPUT] INPUT...
+ * @author DearTs Team
+ * @date 2025
+ */
+
+#include "utils/log_binary.h"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    using DearTs::Utils::LogBinary::Decoder;
+    using DearTs::Utils::LogBinary::Entry;
+
+    constexpr const char* LEVEL_NAMES[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    constexpr int LEVEL_COUNT = static_cast<int>(sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]));
+
+    /**
+     * @brief 命令行选项
+     */
+    struct Options {
+        int minLevel = 0;
+        std::string fileFilter;
+        bool json = false;
+        std::string output;
+        std::vector<std::string> inputs;
+    };
+
+    const char* levelName(int level) {
+        return (level >= 0 && level < LEVEL_COUNT) ? LEVEL_NAMES[level] : "UNKNOWN";
+    }
+
+    int parseLevel(std::string_view text) {
+        for (int i = 0; i < LEVEL_COUNT; ++i) {
+            if (text == LEVEL_NAMES[i]) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void printUsage() {
+        std::cerr << "用法: dearts_logdump [选项] <日志文件>...\n"
+                  << "  --level LEVEL   只输出不低于该级别的记录（TRACE/DEBUG/INFO/WARN/ERROR/FATAL）\n"
+                  << "  --file SUBSTR   只输出源文件名包含 SUBSTR 的记录\n"
+                  << "  --json          输出 JSON Lines（每行一个对象）\n"
+                  << "  -o OUTPUT       写入文件而不是标准输出\n";
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg(argv[i]);
+            if (arg == "--level" && i + 1 < argc) {
+                options.minLevel = parseLevel(argv[++i]);
+                if (options.minLevel < 0) {
+                    std::cerr << "未知的日志级别: " << argv[i] << "\n";
+                    return false;
+                }
+            } else if (arg == "--file" && i + 1 < argc) {
+                options.fileFilter = argv[++i];
+            } else if (arg == "--json") {
+                options.json = true;
+            } else if (arg == "-o" && i + 1 < argc) {
+                options.output = argv[++i];
+            } else if (arg == "-h" || arg == "--help" || (!arg.empty() && arg[0] == '-')) {
+                return false;
+            } else {
+                options.inputs.emplace_back(arg);
+            }
+        }
+        return !options.inputs.empty();
+    }
+
+    /**
+     * @brief 追加本地时间文本 "YYYY-mm-dd HH:MM:SS.mmm"
+     */
+    void appendTime(std::string& out, int64_t systemNs) {
+        int64_t second = systemNs / 1000000000;
+        int64_t millis = (systemNs / 1000000) % 1000;
+        if (millis < 0) {
+            millis += 1000;
+            --second;
+        }
+        const std::time_t time = static_cast<std::time_t>(second);
+        std::tm localTime{};
+#ifdef _WIN32
+        localtime_s(&localTime, &time);
+#else
+        localtime_r(&time, &localTime);
+#endif
+        char buffer[40];
+        const size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &localTime);
+        out.append(buffer, length);
+        std::snprintf(buffer, sizeof(buffer), ".%03d", static_cast<int>(millis));
+        out += buffer;
+    }
+
+    std::string_view baseName(std::string_view path) {
+        const size_t pos = path.find_last_of("/\\");
+        return pos == std::string_view::npos ? path : path.substr(pos + 1);
+    }
+
+    void appendJsonString(std::string& out, std::string_view text) {
+        out += '"';
+        for (const char c : text) {
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char buffer[8];
+                        std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                        out += buffer;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        out += '"';
+    }
+
+    void appendText(std::string& out, const Entry& entry) {
+        out += '[';
+        appendTime(out, entry.systemNs);
+        out += "] [";
+        out += levelName(entry.level);
+        out += "] [";
+        out += baseName(entry.file);
+        out += ':';
+        out += std::to_string(entry.line);
+        out += "] ";
+        out += entry.message;
+        out += '\n';
+    }
+
+    void appendJson(std::string& out, const Entry& entry) {
+        out += "{\"time\":";
+        std::string time;
+        appendTime(time, entry.systemNs);
+        appendJsonString(out, time);
+        out += ",\"timestamp_ns\":";
+        out += std::to_string(entry.systemNs);
+        out += ",\"level\":";
+        appendJsonString(out, levelName(entry.level));
+        out += ",\"file\":";
+        appendJsonString(out, entry.file);
+        out += ",\"line\":";
+        out += std::to_string(entry.line);
+        out += ",\"message\":";
+        appendJsonString(out, entry.message);
+        out += "}\n";
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::ofstream outputFile;
+    if (!options.output.empty()) {
+        outputFile.open(options.output, std::ios::binary);
+        if (!outputFile.is_open()) {
+            std::cerr << "无法创建输出文件: " << options.output << "\n";
+            return 2;
+        }
+    }
+    std::ostream& output = options.output.empty() ? std::cout : outputFile;
+
+    int result = 0;
+    std::string text;
+    Entry entry;
+    for (const std::string& input : options.inputs) {
+        std::ifstream file(input, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "无法打开日志文件: " << input << "\n";
+            result = 2;
+            continue;
+        }
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        Decoder decoder(data.data(), data.size());
+        while (decoder.next(entry)) {
+            if (entry.level < options.minLevel ||
+                (!options.fileFilter.empty() && entry.file.find(options.fileFilter) == std::string_view::npos)) {
+                continue;
+            }
+            text.clear();
+            options.json ? appendJson(text, entry) : appendText(text, entry);
+            output.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+
+        if (decoder.isCorrupted()) {
+            // 进程异常退出时文件末尾可能不完整，已解码的部分仍然有效
+            std::cerr << "警告: " << input << " 含有损坏或截断的数据，已停止解码该文件\n";
+            result = 3;
+        }
+    }
+    return result;
+}